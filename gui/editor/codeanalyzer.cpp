@@ -37,13 +37,28 @@ static void replaceDocStrings(std::string& sStr)
     sStr.replace(sStr.find_first_of(" ("), std::string::npos, "()");
 }
 
+
+/////////////////////////////////////////////////
+/// \brief Combines the hash of the passed string
+/// with the passed seed.
+///
+/// \param nSeed size_t
+/// \param sValue const std::string&
+/// \return size_t
+///
+/////////////////////////////////////////////////
+static size_t combineHash(size_t nSeed, const std::string& sValue)
+{
+    return nSeed ^ (std::hash<std::string>()(sValue) + 0x9e3779b9 + (nSeed << 6) + (nSeed >> 2));
+}
+
 /////////////////////////////////////////////////
 /// Constructor
 /// \param parent NumeReEditor*
 /// \param opts Options*
 ///
 /////////////////////////////////////////////////
-CodeAnalyzer::CodeAnalyzer(NumeReEditor* parent, Options* opts) : m_editor(parent), m_options(opts), m_nCurPos(0), m_nCurrentLine(0), m_hasProcedureDefinition(false)
+CodeAnalyzer::CodeAnalyzer(NumeReEditor* parent, Options* opts) : m_editor(parent), m_options(opts), m_nCurPos(0), m_nCurrentLine(0), m_hasProcedureDefinition(false), m_nSymDefHash(0), m_isVolatileLine(true)
 {
     m_STRING_FUNCS = _guilang.getList("PARSERFUNCS_LISTFUNC_FUNC_*_[STRING]");
     m_STRING_METHODS = _guilang.getList("PARSERFUNCS_LISTFUNC_METHOD_*_[STRING]");
@@ -67,37 +82,43 @@ CodeAnalyzer::CodeAnalyzer(NumeReEditor* parent, Options* opts) : m_editor(paren
 /// \return void
 ///
 /// This member function is the wrapper for the static code analyzer
-/// It may handle NumeRe and MATLAB files. The results are written
-/// directly as annotations in the editor.
+/// It may handle NumeRe and MATLAB files. The results of lines, which
+/// only depend on their own contents and the state of the analyzer at
+/// their start, are cached by their hash and reused in the next run.
+/// All results are collected and written as annotations in the editor
+/// at once.
 /////////////////////////////////////////////////
 void CodeAnalyzer::run()
 {
     if (!m_editor || !m_options)
         return;
 
-    // Clear all annotations
-	m_editor->AnnotationClearAll();
-	m_symdefs.clear();
-
-	// Clear the corresponding indicators
-    m_editor->SetIndicatorCurrent(HIGHLIGHT_ANNOTATION);
-	m_editor->IndicatorClearRange(0, m_editor->GetLastPosition());
-	m_editor->IndicatorSetStyle(HIGHLIGHT_ANNOTATION, wxSTC_INDIC_ROUNDBOX);
-	m_editor->IndicatorSetForeground(HIGHLIGHT_ANNOTATION, wxColor(0, 0, 255));
-
 	// Ensure that the correct file type is used and that the setting is active
     if (!m_editor->getEditorSetting(NumeReEditor::SETTING_USEANALYZER)
         || (m_editor->m_fileType != FILE_NSCR
             && m_editor->m_fileType != FILE_NPRC
             && m_editor->m_fileType != FILE_MATLAB
             && m_editor->m_fileType != FILE_CPP))
+    {
+        // Clear all annotations and the corresponding indicators
+        m_editor->AnnotationClearAll();
+        m_editor->SetIndicatorCurrent(HIGHLIGHT_ANNOTATION);
+        m_editor->IndicatorClearRange(0, m_editor->GetLastPosition());
+        m_lineCache.clear();
 		return;
+    }
 
     // Determine the annotation style
 	m_editor->AnnotationSetVisible(wxSTC_ANNOTATION_BOXED);
 
+	m_symdefs.clear();
+	m_nSymDefHash = 0;
+	m_vIndicators.clear();
+	m_vLocalVariables.clear();
+
 	m_nCurrentLine = -1;
 	m_hasProcedureDefinition = false;
+	m_isVolatileLine = true;
 
 	bool isContinuedLine = false;
 	bool isAlreadyMeasured = false;
@@ -111,6 +132,12 @@ void CodeAnalyzer::run()
 	int nFirstLine = -1;
 
 	AnnotationCount AnnotCount;
+	AnnotationCount lineStartCount;
+	size_t nLineIndicators = 0;
+	size_t nLineHash = 0;
+
+	std::map<int,std::pair<std::string,std::string>> mAnnotations;
+	std::unordered_map<size_t,LineAnalysis> mNewCache;
 
 	// Go through the whole file
 	for (m_nCurPos = 0; m_nCurPos < m_editor->GetLastPosition(); m_nCurPos++)
@@ -124,6 +151,24 @@ void CodeAnalyzer::run()
 		// and display the contents as annotation
 		if (m_nCurrentLine < m_editor->LineFromPosition(m_nCurPos))
 		{
+		    // Cache the results of the last line, if they only
+		    // depend on the line itself and its context
+		    if (m_nCurrentLine >= 0 && !m_isVolatileLine)
+            {
+                LineAnalysis& analysis = mNewCache[nLineHash];
+                int nLineStart = m_editor->PositionFromLine(m_nCurrentLine);
+
+                analysis.sAnnotation = m_sCurrentLine;
+                analysis.sStyles = m_sStyles;
+                analysis.annotCount.nNotes = AnnotCount.nNotes - lineStartCount.nNotes;
+                analysis.annotCount.nWarnings = AnnotCount.nWarnings - lineStartCount.nWarnings;
+                analysis.annotCount.nErrors = AnnotCount.nErrors - lineStartCount.nErrors;
+                analysis.vIndicators.assign(m_vIndicators.begin() + nLineIndicators, m_vIndicators.end());
+
+                for (auto& indicator : analysis.vIndicators)
+                    indicator.first -= nLineStart;
+            }
+
 		    // Get the line's contents
 			string sLine = m_editor->GetLine(m_nCurrentLine).ToStdString();
 			StripSpaces(sLine);
@@ -157,9 +202,8 @@ void CodeAnalyzer::run()
             }
             else if (m_sCurrentLine.length())
             {
-                // Write the annotion to the current line
-                m_editor->AnnotationSetText(m_nCurrentLine, m_sCurrentLine);
-                m_editor->AnnotationSetStyles(m_nCurrentLine, m_sStyles);
+                // Store the annotion for the current line
+                mAnnotations[m_nCurrentLine] = std::make_pair(m_sCurrentLine, m_sStyles);
             }
 
 			m_nCurrentLine = m_editor->LineFromPosition(m_nCurPos);
@@ -199,6 +243,32 @@ void CodeAnalyzer::run()
 
 			m_sCurrentLine.clear();
 			m_sStyles.clear();
+
+			lineStartCount = AnnotCount;
+			nLineIndicators = m_vIndicators.size();
+			m_isVolatileLine = false;
+			nLineHash = getLineHash(isContinuedLine, isSuppressed);
+
+			auto iter = m_lineCache.find(nLineHash);
+
+			// Reuse the cached results, if neither the line nor its
+			// context changed. The metrics of scripts have to be
+			// calculated first, though
+			if (iter != m_lineCache.end() && (m_editor->m_fileType != FILE_NSCR || isAlreadyMeasured))
+            {
+                int nLineStart = m_editor->PositionFromLine(m_nCurrentLine);
+
+                m_sCurrentLine = iter->second.sAnnotation;
+                m_sStyles = iter->second.sStyles;
+                AnnotCount += iter->second.annotCount;
+
+                for (const auto& indicator : iter->second.vIndicators)
+                    m_vIndicators.push_back(std::make_pair(indicator.first + nLineStart, indicator.second));
+
+                // Jump to the last character of this line
+                m_nCurPos = nLineStart + m_editor->LineLength(m_nCurrentLine) - 1;
+                continue;
+            }
 		}
 
 		// Get code metrics for scripts if not already done
@@ -210,6 +280,7 @@ void CodeAnalyzer::run()
 			{
 				string sSyntaxElement =  m_editor->GetFilenameString().ToStdString();
 				isAlreadyMeasured = true;
+				m_isVolatileLine = true;
 
 				// Calculate the code metrics:
 				// Complexity
@@ -252,7 +323,9 @@ void CodeAnalyzer::run()
                 if (sWord != "matop" && sWord != "mtrxop")
                     isSuppressed = true;
             }
-		    // Handle commands
+		    // Handle commands. Those depend on other lines or
+		    // change the context of the following lines
+		    m_isVolatileLine = true;
 		    AnnotCount += analyseCommands();
 		}
         else if (m_editor->isStyleType(NumeReEditor::STYLE_FUNCTION, m_nCurPos)
@@ -270,7 +343,9 @@ void CodeAnalyzer::run()
 		}
 		else if (m_editor->isStyleType(NumeReEditor::STYLE_PROCEDURE, m_nCurPos))
 		{
-		    // Handle NumeRe procedure calls (NumeRe only)
+		    // Handle NumeRe procedure calls (NumeRe only). Those
+		    // depend on the procedure files
+		    m_isVolatileLine = true;
 		    AnnotCount += analyseProcedures();
 		}
         else if ((m_editor->isStyleType(NumeReEditor::STYLE_IDENTIFIER, m_nCurPos)
@@ -309,8 +384,16 @@ void CodeAnalyzer::run()
         {
             AnnotCount += analysePreDefs();
         }
+
+        // An analysis, which advanced into another line,
+        // cannot be cached
+        if (m_editor->LineFromPosition(m_nCurPos) != m_nCurrentLine)
+            m_isVolatileLine = true;
 	}
 
+	// Only keep the lines of the current file
+	m_lineCache.swap(mNewCache);
+
 	// Clear the annotation and style cache
 	m_sCurrentLine.clear();
 	m_sStyles.clear();
@@ -337,12 +420,11 @@ void CodeAnalyzer::run()
 		m_sStyles = sFirstStyles;
 	}
 
-	// Write the first line if it is not empty
+	// Store the first line if it is not empty
 	if (m_sCurrentLine.length())
-	{
-		m_editor->AnnotationSetText(nFirstLine, m_sCurrentLine);
-		m_editor->AnnotationSetStyles(nFirstLine, m_sStyles);
-	}
+		mAnnotations[nFirstLine] = std::make_pair(m_sCurrentLine, m_sStyles);
+
+	applyResults(mAnnotations);
 }
 
 
@@ -984,6 +1066,7 @@ AnnotationCount CodeAnalyzer::analyseCommands()
             sDefinition.pop_back();
 
         m_symdefs.createSymbol(sDefinition);
+        m_nSymDefHash = combineHash(m_nSymDefHash, sDefinition);
 
         // increment the position variable to the last position
         // in the current line, so that we may jump over the definition
@@ -1010,7 +1093,10 @@ AnnotationCount CodeAnalyzer::analyseCommands()
 
                 // Is it a declare?
                 if (_mMatch.sString == SYMDEF_COMMAND)
+                {
                     m_symdefs.createSymbol(sLine.substr(_mMatch.nPos + _mMatch.sString.length()));
+                    m_nSymDefHash = combineHash(m_nSymDefHash, sLine);
+                }
 
                 // Is it a define?
                 if (_mMatch.sString == "define"
@@ -1261,7 +1347,7 @@ AnnotationCount CodeAnalyzer::analyseFunctions(bool isContinuedLine)
     }
 
     // There's a missing parenthesis?
-    if (m_editor->BraceMatch(wordend) < wordend && sSyntaxElement.find('(') != string::npos)
+    if (matchBrace(wordend) < wordend && sSyntaxElement.find('(') != string::npos)
     {
         // MATLAB doesn't require a parenthesis pair for empty arguments.
         // However, issue a warning as it is good practice to visually distinguish between variables and functions
@@ -1280,7 +1366,7 @@ AnnotationCount CodeAnalyzer::analyseFunctions(bool isContinuedLine)
              && sSyntaxElement.find('(') != string::npos)
     {
         // Check for missing arguments
-        int nPos = m_editor->BraceMatch(wordend);
+        int nPos = matchBrace(wordend);
         string sArgument = m_editor->GetTextRange(wordend + 1, nPos).ToStdString();
         StripSpaces(sArgument);
         if (!sArgument.length())
@@ -1508,7 +1594,7 @@ AnnotationCount CodeAnalyzer::analyseOperators()
     if (m_editor->GetCharAt(m_nCurPos) == '(' || m_editor->GetCharAt(m_nCurPos) == '[' || m_editor->GetCharAt(m_nCurPos) == '{'
             || m_editor->GetCharAt(m_nCurPos) == ')' || m_editor->GetCharAt(m_nCurPos) == ']' || m_editor->GetCharAt(m_nCurPos) == '}')
     {
-        int nPos = m_editor->BraceMatch(m_nCurPos);
+        int nPos = matchBrace(m_nCurPos);
         if (nPos < 0)
         {
             AnnotCount += addToAnnotation(_guilang.get("GUI_ANALYZER_TEMPLATE", highlightFoundOccurence(string(1, m_editor->GetCharAt(m_nCurPos)), m_nCurPos, 1), m_sError, _guilang.get("GUI_ANALYZER_MISSINGPARENTHESIS")), ANNOTATION_ERROR);
@@ -1590,7 +1676,7 @@ AnnotationCount CodeAnalyzer::analysePreDefs()
     for (int i = m_nCurPos; i > m_editor->PositionFromLine(m_nCurrentLine); i--)
     {
         if ((m_editor->GetCharAt(i) == '(' || m_editor->GetCharAt(i) == '{')
-            && (m_editor->BraceMatch(i) >= m_nCurPos || m_editor->BraceMatch(i) == -1) // either no brace (yet) or the brace further right
+            && (matchBrace(i) >= m_nCurPos || matchBrace(i) == -1) // either no brace (yet) or the brace further right
             && (m_editor->GetStyleAt(i - 1) == wxSTC_NSCR_CLUSTER
                 || m_editor->GetStyleAt(i - 1) == wxSTC_NSCR_CUSTOM_FUNCTION
                 || m_editor->GetStyleAt(i - 1) == wxSTC_NSCR_PREDEFS)) // table() or data()
@@ -1648,7 +1734,7 @@ AnnotationCount CodeAnalyzer::analysePreDefs()
                                           ANNOTATION_WARN);
 
         // Now, check for mixed up orientations
-        int contextEnd = m_editor->BraceMatch(contextPoint);
+        int contextEnd = matchBrace(contextPoint);
 
         if (contextEnd == wxNOT_FOUND)
             contextEnd = m_editor->GetLineEndPosition(m_nCurrentLine);
@@ -1728,6 +1814,99 @@ AnnotationCount CodeAnalyzer::addToAnnotation(const string& sMessage, int nStyle
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Calculates the hash of the current line
+/// including its styles and the state of the
+/// analyzer at its start.
+///
+/// \param isContinuedLine bool
+/// \param isSuppressed bool
+/// \return size_t
+///
+/////////////////////////////////////////////////
+size_t CodeAnalyzer::getLineHash(bool isContinuedLine, bool isSuppressed)
+{
+    // The styled text contains the characters and their styles interleaved
+    wxMemoryBuffer styledText = m_editor->GetStyledText(m_editor->PositionFromLine(m_nCurrentLine),
+                                                        m_editor->GetLineEndPosition(m_nCurrentLine));
+    std::string sContext(static_cast<const char*>(styledText.GetData()), styledText.GetDataLen());
+
+    sContext += std::string(1, '\0') + toString((int)m_editor->m_fileType) + "|" + m_currentMode + "|";
+    sContext += isContinuedLine ? '1' : '0';
+    sContext += isSuppressed ? '1' : '0';
+    sContext += m_hasProcedureDefinition ? '1' : '0';
+    sContext += m_options->getSetting(SETTING_B_TABLEREFS).active() ? '1' : '0';
+
+    for (int i = 0; i < Options::ANALYZER_OPTIONS_END; i++)
+        sContext += "|" + toString(m_options->GetAnalyzerOption((Options::AnalyzerOptions)i));
+
+    for (const auto& var : m_vLocalVariables)
+        sContext += "|" + var.first + ":" + toString(var.second);
+
+    return combineHash(m_nSymDefHash, sContext);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Finds the matching brace and marks the
+/// current line as volatile, if the brace is
+/// missing or located in another line.
+///
+/// \param nPos int
+/// \return int
+///
+/////////////////////////////////////////////////
+int CodeAnalyzer::matchBrace(int nPos)
+{
+    int nMatch = m_editor->BraceMatch(nPos);
+
+    if (std::string("()[]{}<>").find(m_editor->GetCharAt(nPos)) != std::string::npos
+        && (nMatch == wxSTC_INVALID_POSITION || m_editor->LineFromPosition(nMatch) != m_nCurrentLine))
+        m_isVolatileLine = true;
+
+    return nMatch;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Writes the collected annotations and
+/// indicators to the editor. Only the annotations
+/// of lines, which actually changed, are updated.
+///
+/// \param mAnnotations const std::map<int,std::pair<std::string,std::string>>&
+/// \return void
+///
+/////////////////////////////////////////////////
+void CodeAnalyzer::applyResults(const std::map<int,std::pair<std::string,std::string>>& mAnnotations)
+{
+    for (int i = 0; i < m_editor->GetLineCount(); i++)
+    {
+        auto iter = mAnnotations.find(i);
+
+        if (iter == mAnnotations.end())
+        {
+            if (m_editor->AnnotationGetLines(i))
+                m_editor->AnnotationClearLine(i);
+        }
+        else if (m_editor->AnnotationGetText(i).ToStdString() != iter->second.first
+                 || m_editor->AnnotationGetStyles(i).ToStdString() != iter->second.second)
+        {
+            m_editor->AnnotationSetText(i, iter->second.first);
+            m_editor->AnnotationSetStyles(i, iter->second.second);
+        }
+    }
+
+    // Replace the corresponding indicators
+    m_editor->SetIndicatorCurrent(HIGHLIGHT_ANNOTATION);
+	m_editor->IndicatorClearRange(0, m_editor->GetLastPosition());
+	m_editor->IndicatorSetStyle(HIGHLIGHT_ANNOTATION, wxSTC_INDIC_ROUNDBOX);
+	m_editor->IndicatorSetForeground(HIGHLIGHT_ANNOTATION, wxColor(0, 0, 255));
+
+	for (const auto& indicator : m_vIndicators)
+        m_editor->IndicatorFillRange(indicator.first, indicator.second);
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Checks for assignments
 ///
@@ -1769,13 +1948,12 @@ bool CodeAnalyzer::containsAssignment(const string& sCurrentLine)
 /// \param nLength int
 /// \return string The passed sElement string with an additional white space
 ///
-/// The found occurence is highlighted in the editor using
-/// an indicator
+/// The found occurence is stored to be highlighted in the
+/// editor using an indicator
 /////////////////////////////////////////////////
 string CodeAnalyzer::highlightFoundOccurence(const string& sElement, int nPos, int nLength)
 {
-    m_editor->SetIndicatorCurrent(HIGHLIGHT_ANNOTATION);
-    m_editor->IndicatorFillRange(nPos, nLength);
+    m_vIndicators.push_back(std::make_pair(nPos, nLength));
 	return sElement;
 }
 
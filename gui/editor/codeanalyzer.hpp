@@ -22,6 +22,8 @@
 #include <string>
 #include <vector>
 #include <utility>
+#include <map>
+#include <unordered_map>
 
 #include "../../kernel/core/symdef.hpp"
 
@@ -46,6 +48,20 @@ struct AnnotationCount
 };
 
 
+/////////////////////////////////////////////////
+/// \brief Stores the analysis results of a single
+/// line, which can be reused as long as neither
+/// the line nor its context changed.
+/////////////////////////////////////////////////
+struct LineAnalysis
+{
+    std::string sAnnotation;
+    std::string sStyles;
+    AnnotationCount annotCount;
+    std::vector<std::pair<int,int>> vIndicators;
+};
+
+
 class NumeReEditor;
 class Options;
 
@@ -82,6 +98,11 @@ class CodeAnalyzer
         bool m_hasProcedureDefinition;
         std::vector<std::pair<std::string,int>> m_vLocalVariables;
 
+        std::unordered_map<size_t,LineAnalysis> m_lineCache;
+        std::vector<std::pair<int,int>> m_vIndicators;
+        size_t m_nSymDefHash;
+        bool m_isVolatileLine;
+
         const double MINCOMMENTDENSITY = 0.5;
         const double MAXCOMMENTDENSITY = 1.5;
         const int MAXCOMPLEXITYNOTIFY = 15;
@@ -97,6 +118,10 @@ class CodeAnalyzer
         AnnotationCount analysePreDefs();
         AnnotationCount addToAnnotation(const std::string& sMessage, int nStyle);
 
+        size_t getLineHash(bool isContinuedLine, bool isSuppressed);
+        int matchBrace(int nPos);
+        void applyResults(const std::map<int,std::pair<std::string,std::string>>& mAnnotations);
+
         std::string highlightFoundOccurence(const std::string& sElement, int nPos, int nLength);
         bool containsAssignment(const std::string& sCurrentLine);
         int calculateCyclomaticComplexity(int startline, int endline);
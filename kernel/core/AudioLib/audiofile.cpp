@@ -22,6 +22,68 @@
 
 namespace Audio
 {
+    /////////////////////////////////////////////////
+    /// \brief Reads a block of up to len samples
+    /// and splits it into one vector per channel.
+    /// This default implementation falls back to
+    /// reading single samples and does therefore
+    /// only support up to two channels. File types
+    /// with a more efficient access to their data
+    /// shall override this member function.
+    ///
+    /// \param vChannels std::vector<std::vector<double>>&
+    /// \param len size_t
+    /// \return size_t
+    ///
+    /////////////////////////////////////////////////
+    size_t File::readBlock(std::vector<std::vector<double>>& vChannels, size_t len) const
+    {
+        size_t nChannels = getChannels() > 1 ? 2 : 1;
+        vChannels.resize(nChannels);
+
+        for (size_t c = 0; c < nChannels; c++)
+        {
+            vChannels[c].resize(len);
+        }
+
+        for (size_t i = 0; i < len; i++)
+        {
+            Sample sample = read();
+
+            vChannels[0][i] = sample.leftOrMono;
+
+            if (nChannels > 1)
+                vChannels[1][i] = sample.right;
+        }
+
+        return len;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Writes a block of len samples, which
+    /// are passed as one vector per channel. This
+    /// default implementation falls back to writing
+    /// single samples and does therefore only
+    /// support up to two channels.
+    ///
+    /// \param vChannels const std::vector<std::vector<double>>&
+    /// \param len size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void File::writeBlock(const std::vector<std::vector<double>>& vChannels, size_t len)
+    {
+        if (!vChannels.size())
+            return;
+
+        for (size_t i = 0; i < len; i++)
+        {
+            write(Sample(vChannels[0][i], vChannels.size() > 1 ? vChannels[1][i] : NAN));
+        }
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief Return a audio file type depending on
     /// the file extension or a nullptr if the file
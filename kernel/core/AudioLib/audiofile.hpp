@@ -61,6 +61,9 @@ namespace Audio
             virtual size_t getLength() const = 0;
             virtual Sample read() const = 0;
 
+            virtual size_t readBlock(std::vector<std::vector<double>>& vChannels, size_t len) const;
+            virtual void writeBlock(const std::vector<std::vector<double>>& vChannels, size_t len);
+
             /////////////////////////////////////////////////
             /// \brief Audio files, which inherit from this
             /// class do not have any seeking functionality.
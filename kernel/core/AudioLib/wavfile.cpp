@@ -18,39 +18,187 @@
 
 #include "wavfile.hpp"
 #include <cstring>
+#include <algorithm>
 
 #define PCM 0x0001
+#define IEEE_FLOAT 0x0003
+#define EXTENSIBLE 0xFFFE
+
+// Number of samples, which are decoded or encoded
+// within a single stream access
+#define WAV_BLOCKSIZE (size_t)65536
 
 namespace Audio
 {
     /////////////////////////////////////////////////
-    /// \brief Applies the necessary conversion to
-    /// obtain a signed floating point value from an
-    /// unsigned integer.
+    /// \brief Calculates the maximal value available
+    /// with the current bitdepth.
     ///
-    /// \param val double
+    /// \param bitdepth uint16_t
     /// \return double
     ///
     /////////////////////////////////////////////////
-    static double convertFromUnsigned(double val)
+    static double getMaxVal(uint16_t bitdepth)
     {
-        return val > 1.0 ? val-2.0 : val;
+        return (1LL << (bitdepth-1)) - 1;
     }
 
 
     /////////////////////////////////////////////////
-    /// \brief Calculates the maximal value available
-    /// with the current bitdepth.
+    /// \brief Determines, whether the passed header
+    /// describes a sample format, which can be
+    /// decoded. The size of a single value is
+    /// derived from the block alignment, because
+    /// the bits per sample may be smaller than the
+    /// container.
     ///
-    /// \param bitdepth uint16_t
-    /// \return double
+    /// \param header const WavFileHeader&
+    /// \return bool
     ///
     /////////////////////////////////////////////////
-    static double getMaxVal(uint16_t bitdepth)
+    static bool isSupportedFormat(const WavFileHeader& header)
+    {
+        if (!header.channels || !header.blockAlign || header.blockAlign % header.channels)
+            return false;
+
+        size_t nBytes = header.blockAlign / header.channels;
+
+        if (header.formatTag == PCM)
+            return nBytes <= 4;
+
+        if (header.formatTag == IEEE_FLOAT)
+            return nBytes == 4 || nBytes == 8;
+
+        return false;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Decodes the values of a single channel
+    /// from an interleaved buffer. The loop does not
+    /// contain any branches and can therefore be
+    /// vectorized by the compiler.
+    ///
+    /// \param src const char*
+    /// \param dest double*
+    /// \param nFrames size_t
+    /// \param nStride size_t
+    /// \param dScale double
+    /// \param dOffset double
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    template<class T>
+    static void decodeSamples(const char* src, double* dest, size_t nFrames, size_t nStride, double dScale, double dOffset)
+    {
+        for (size_t i = 0; i < nFrames; i++)
+        {
+            T val;
+            memcpy(&val, src + i*nStride, sizeof(T));
+            dest[i] = (val - dOffset) * dScale;
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Decodes the values of a single channel
+    /// with 24 bit integer samples from an
+    /// interleaved buffer.
+    ///
+    /// \param src const char*
+    /// \param dest double*
+    /// \param nFrames size_t
+    /// \param nStride size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void decodeSamples24(const char* src, double* dest, size_t nFrames, size_t nStride)
     {
-        return (1 << (bitdepth-1)) - 1;
+        const double dScale = 1.0 / getMaxVal(24);
+
+        for (size_t i = 0; i < nFrames; i++)
+        {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(src + i*nStride);
+
+            // Place the three bytes in the upper part of
+            // a 32 bit integer to restore the sign
+            int32_t val = (int32_t)((uint32_t)bytes[0] << 8 | (uint32_t)bytes[1] << 16 | (uint32_t)bytes[2] << 24) >> 8;
+            dest[i] = val * dScale;
+        }
     }
 
+
+    /////////////////////////////////////////////////
+    /// \brief Decodes an interleaved buffer of
+    /// frames into the channel vectors starting at
+    /// the passed offset.
+    ///
+    /// \param buffer const char*
+    /// \param nFrames size_t
+    /// \param header const WavFileHeader&
+    /// \param vChannels std::vector<std::vector<double>>&
+    /// \param nOffset size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void decodeBlock(const char* buffer, size_t nFrames, const WavFileHeader& header, std::vector<std::vector<double>>& vChannels, size_t nOffset)
+    {
+        size_t nBytes = header.blockAlign / header.channels;
+
+        for (size_t c = 0; c < header.channels; c++)
+        {
+            const char* src = buffer + c*nBytes;
+            double* dest = vChannels[c].data() + nOffset;
+
+            if (header.formatTag == IEEE_FLOAT)
+            {
+                if (nBytes == 4)
+                    decodeSamples<float>(src, dest, nFrames, header.blockAlign, 1.0, 0.0);
+                else
+                    decodeSamples<double>(src, dest, nFrames, header.blockAlign, 1.0, 0.0);
+
+                continue;
+            }
+
+            switch (nBytes)
+            {
+                case 1:
+                    // 8 bit samples are unsigned
+                    decodeSamples<uint8_t>(src, dest, nFrames, header.blockAlign, 1.0 / getMaxVal(8), 128.0);
+                    break;
+                case 2:
+                    decodeSamples<int16_t>(src, dest, nFrames, header.blockAlign, 1.0 / getMaxVal(16), 0.0);
+                    break;
+                case 3:
+                    decodeSamples24(src, dest, nFrames, header.blockAlign);
+                    break;
+                case 4:
+                    decodeSamples<int32_t>(src, dest, nFrames, header.blockAlign, 1.0 / getMaxVal(32), 0.0);
+                    break;
+            }
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Converts a floating point value into
+    /// a 16 bit integer sample. Values outside of
+    /// [-1,1] are clipped and NaNs are written as
+    /// silence.
+    ///
+    /// \param val double
+    /// \return int16_t
+    ///
+    /////////////////////////////////////////////////
+    static int16_t encodeSample16(double val)
+    {
+        if (std::isnan(val))
+            return 0;
+
+        return std::max(-1.0, std::min(1.0, val)) * getMaxVal(16);
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief Constructor. Tries to open the wave
     /// file, if it exists.
@@ -58,7 +206,7 @@ namespace Audio
     /// \param sFileName const std::string&
     ///
     /////////////////////////////////////////////////
-    WavFile::WavFile(const std::string& sFileName)
+    WavFile::WavFile(const std::string& sFileName) : isNewFile(false)
     {
         m_WavFileStream.open(sFileName.c_str(), std::ios_base::in | std::ios_base::binary);
         sName = sFileName;
@@ -82,58 +230,102 @@ namespace Audio
     /// \brief Private member function to read the
     /// wave file header to memory. It will
     /// ensure that the current file is actually a
-    /// RIFF WAVE file.
+    /// RIFF WAVE file and walks through its chunks
+    /// to find the format and the data chunk.
     ///
     /// \return bool
     ///
     /////////////////////////////////////////////////
     bool WavFile::readHeader()
     {
+        m_DataBlockLength = 0;
+
         if (!m_WavFileStream.good())
-        {
-            m_DataBlockLength = 0;
             return false;
-        }
-        else
+
+        char headerInfo[5] = {0,0,0,0,0};
+        m_WavFileStream.read(headerInfo, 4);
+
+        if (strcmp(headerInfo, "RIFF"))
+            return false;
+
+        m_WavFileStream.read(headerInfo, 4);
+        m_WavFileStream.read(headerInfo, 4);
+
+        if (strcmp(headerInfo, "WAVE"))
+            return false;
+
+        bool hasFormat = false;
+
+        // Walk through the chunks until the data chunk
+        // is found. Unknown chunks (e.g. "LIST") are
+        // skipped
+        while (true)
         {
-            char headerInfo[5] = {0,0,0,0,0};
+            uint32_t nChunkSize = 0;
             m_WavFileStream.read(headerInfo, 4);
+            m_WavFileStream.read((char*)&nChunkSize, 4);
 
-            if (strcmp(headerInfo, "RIFF"))
-            {
-                m_DataBlockLength = 0;
+            if (!m_WavFileStream.good())
                 return false;
-            }
 
-            m_WavFileStream.read(headerInfo, 4);
-            m_WavFileStream.read(headerInfo, 4);
+            long long int nChunkStart = m_WavFileStream.tellg();
 
-            if (strcmp(headerInfo, "WAVE"))
+            if (!strcmp(headerInfo, "fmt "))
             {
-                m_DataBlockLength = 0;
-                return false;
-            }
+                if (nChunkSize < sizeof(WavFileHeader))
+                    return false;
 
-            m_WavFileStream.seekg(20);
-            m_WavFileStream.read((char*)&m_Header, sizeof(WavFileHeader));
+                m_WavFileStream.read((char*)&m_Header, sizeof(WavFileHeader));
 
-            if (m_Header.formatTag != PCM)
+                // The extensible format stores the actual
+                // format tag in the first two bytes of the
+                // sub format GUID
+                if (m_Header.formatTag == EXTENSIBLE && nChunkSize >= 40)
+                {
+                    m_WavFileStream.seekg(nChunkStart + 24);
+                    m_WavFileStream.read((char*)&m_Header.formatTag, 2);
+                }
+
+                hasFormat = true;
+            }
+            else if (!strcmp(headerInfo, "data"))
             {
-                m_DataBlockLength = 0;
-                return false;
+                m_StreamOffset = nChunkStart;
+                m_DataBlockLength = nChunkSize;
+                break;
             }
 
-            m_WavFileStream.seekg(40);
-            m_WavFileStream.read((char*)&m_DataBlockLength, 4);
+            // Chunks are padded to an even size
+            m_WavFileStream.seekg(nChunkStart + nChunkSize + (nChunkSize & 1));
+        }
+
+        if (!hasFormat || !isSupportedFormat(m_Header))
+        {
+            m_DataBlockLength = 0;
+            return false;
         }
 
-        return true;
+        // Streamed files may contain a placeholder for
+        // the length of the data chunk. Clamp it to the
+        // actual file size
+        m_WavFileStream.seekg(0, std::ios_base::end);
+        long long int nFileSize = m_WavFileStream.tellg();
+
+        if (m_StreamOffset + m_DataBlockLength > nFileSize)
+            m_DataBlockLength = nFileSize - m_StreamOffset;
+
+        m_DataBlockLength -= m_DataBlockLength % m_Header.blockAlign;
+        m_WavFileStream.seekg(m_StreamOffset);
+
+        return m_WavFileStream.good();
     }
 
 
     /////////////////////////////////////////////////
-    /// \brief Updates the wave file header, which is
-    /// currently open, and closes the file afterwards.
+    /// \brief Updates the wave file header, if the
+    /// currently open file has been created by this
+    /// instance, and closes the file afterwards.
     ///
     /// \return void
     ///
@@ -142,15 +334,21 @@ namespace Audio
     {
         if (m_WavFileStream.is_open())
         {
-            m_WavFileStream.seekp(0, std::ios_base::end);
-            uint32_t pos = m_WavFileStream.tellp()-8LL;
-            m_WavFileStream.seekp(4);
-            m_WavFileStream.write((char*)&pos, 4);
-            m_WavFileStream.seekp(40);
-            pos -= 36;
-            m_WavFileStream.write((char*)&pos, 4);
+            if (isNewFile)
+            {
+                m_WavFileStream.seekp(0, std::ios_base::end);
+                uint32_t pos = m_WavFileStream.tellp()-8LL;
+                m_WavFileStream.seekp(4);
+                m_WavFileStream.write((char*)&pos, 4);
+                m_WavFileStream.seekp(40);
+                pos -= 36;
+                m_WavFileStream.write((char*)&pos, 4);
+            }
+
             m_WavFileStream.close();
         }
+
+        isNewFile = false;
     }
 
 
@@ -180,6 +378,10 @@ namespace Audio
         m_WavFileStream.write((char*)&nSize, 4);
         m_WavFileStream.write((char*)&m_Header, sizeof(WavFileHeader));
         m_WavFileStream.write("data    ", 8);
+
+        m_StreamOffset = 44;
+        m_DataBlockLength = 0;
+        isNewFile = true;
     }
 
 
@@ -192,17 +394,12 @@ namespace Audio
     /////////////////////////////////////////////////
     void WavFile::write(const Sample& sample)
     {
-        if (m_WavFileStream.is_open() && m_WavFileStream.good())
-        {
-            int16_t channelvalue = sample.leftOrMono * getMaxVal(16);
-            m_WavFileStream.write((char*)&channelvalue, 2);
+        std::vector<std::vector<double>> vChannels(1, std::vector<double>(1, sample.leftOrMono));
 
-            if (m_Header.channels > 1 && !std::isnan(sample.right))
-            {
-                channelvalue = sample.right * getMaxVal(16);
-                m_WavFileStream.write((char*)&channelvalue, 2);
-            }
-        }
+        if (m_Header.channels > 1)
+            vChannels.push_back(std::vector<double>(1, sample.right));
+
+        writeBlock(vChannels, 1);
     }
 
 
@@ -214,21 +411,15 @@ namespace Audio
     /////////////////////////////////////////////////
     Sample WavFile::read() const
     {
-        uint32_t samples[2] = {0,0};
+        std::vector<std::vector<double>> vChannels;
 
-        if (m_Header.channels == 1)
-        {
-            m_WavFileStream.read((char*)samples, m_Header.blockAlign);
-            return Sample(convertFromUnsigned(samples[0] / getMaxVal(m_Header.bitsPerSample)));
-        }
-        else
-        {
-            m_WavFileStream.read((char*)&samples[0], m_Header.blockAlign/m_Header.channels);
-            m_WavFileStream.read((char*)&samples[1], m_Header.blockAlign/m_Header.channels);
-            return Sample(convertFromUnsigned(samples[0] / getMaxVal(m_Header.bitsPerSample)), convertFromUnsigned(samples[1] / getMaxVal(m_Header.bitsPerSample)));
-        }
+        if (!readBlock(vChannels, 1))
+            return Sample(NAN);
+
+        if (vChannels.size() > 1)
+            return Sample(vChannels[0][0], vChannels[1][0]);
 
-        return Sample(NAN);
+        return Sample(vChannels[0][0]);
     }
 
 
@@ -242,14 +433,18 @@ namespace Audio
     /////////////////////////////////////////////////
     std::vector<Sample> WavFile::readSome(size_t len) const
     {
+        std::vector<std::vector<double>> vChannels;
         std::vector<Sample> vSamples;
 
+        len = readBlock(vChannels, len);
+        vSamples.reserve(len);
+
         for (size_t i = 0; i < len; i++)
         {
-            if (m_WavFileStream.eof() || !m_WavFileStream.good())
-                break;
-
-            vSamples.push_back(read());
+            if (vChannels.size() > 1)
+                vSamples.push_back(Sample(vChannels[0][i], vChannels[1][i]));
+            else
+                vSamples.push_back(Sample(vChannels[0][i]));
         }
 
         return vSamples;
@@ -266,9 +461,117 @@ namespace Audio
     /////////////////////////////////////////////////
     void WavFile::writeSome(const std::vector<Sample> vSamples)
     {
-        for (const Sample& s : vSamples)
+        std::vector<std::vector<double>> vChannels(std::min((size_t)m_Header.channels, (size_t)2), std::vector<double>(vSamples.size()));
+
+        for (size_t i = 0; i < vSamples.size(); i++)
+        {
+            vChannels[0][i] = vSamples[i].leftOrMono;
+
+            if (vChannels.size() > 1)
+                vChannels[1][i] = vSamples[i].right;
+        }
+
+        writeBlock(vChannels, vSamples.size());
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Reads up to len samples from the
+    /// current position and decodes them into one
+    /// vector per channel. The data is read in large
+    /// blocks with a single stream access each.
+    /// Returns the number of samples, which were
+    /// actually read.
+    ///
+    /// \param vChannels std::vector<std::vector<double>>&
+    /// \param len size_t
+    /// \return size_t
+    ///
+    /////////////////////////////////////////////////
+    size_t WavFile::readBlock(std::vector<std::vector<double>>& vChannels, size_t len) const
+    {
+        vChannels.resize(m_Header.channels);
+
+        if (!m_WavFileStream.good())
+            len = 0;
+        else
+            len = std::min(len, getLength() - std::min(getPosition(), getLength()));
+
+        for (std::vector<double>& vChannel : vChannels)
+        {
+            vChannel.resize(len);
+        }
+
+        std::vector<char> vBuffer(std::min(len, WAV_BLOCKSIZE) * m_Header.blockAlign);
+        size_t nRead = 0;
+
+        while (nRead < len)
         {
-            write(s);
+            size_t nFrames = std::min(WAV_BLOCKSIZE, len - nRead);
+            m_WavFileStream.read(vBuffer.data(), nFrames * m_Header.blockAlign);
+            nFrames = m_WavFileStream.gcount() / m_Header.blockAlign;
+
+            decodeBlock(vBuffer.data(), nFrames, m_Header, vChannels, nRead);
+            nRead += nFrames;
+
+            if (!m_WavFileStream.good())
+                break;
+        }
+
+        if (nRead < len)
+        {
+            for (std::vector<double>& vChannel : vChannels)
+            {
+                vChannel.resize(nRead);
+            }
+        }
+
+        return nRead;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Encodes len samples, which are passed
+    /// as one vector per channel, and writes them
+    /// to the audio stream in large blocks. Missing
+    /// channels are filled with silence.
+    ///
+    /// \param vChannels const std::vector<std::vector<double>>&
+    /// \param len size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void WavFile::writeBlock(const std::vector<std::vector<double>>& vChannels, size_t len)
+    {
+        if (!m_WavFileStream.is_open() || !m_WavFileStream.good())
+            return;
+
+        size_t nChannels = m_Header.channels;
+        std::vector<int16_t> vBuffer(std::min(len, WAV_BLOCKSIZE) * nChannels);
+
+        for (size_t nWritten = 0; nWritten < len; nWritten += WAV_BLOCKSIZE)
+        {
+            size_t nFrames = std::min(WAV_BLOCKSIZE, len - nWritten);
+
+            for (size_t c = 0; c < nChannels; c++)
+            {
+                if (c >= vChannels.size())
+                {
+                    for (size_t i = 0; i < nFrames; i++)
+                        vBuffer[i*nChannels + c] = 0;
+
+                    continue;
+                }
+
+                const double* src = vChannels[c].data() + nWritten;
+
+                for (size_t i = 0; i < nFrames; i++)
+                {
+                    vBuffer[i*nChannels + c] = encodeSample16(src[i]);
+                }
+            }
+
+            m_WavFileStream.write((char*)vBuffer.data(), nFrames * nChannels * sizeof(int16_t));
         }
     }
 }
@@ -47,7 +47,11 @@ namespace Audio
     /// \brief This class implements the wave file
     /// type using PCM encoding (the simplest
     /// encoding). Due to its simplicity it is a
-    /// seekable file type.
+    /// seekable file type. Files are read with 8,
+    /// 16, 24 or 32 bit integer and 32 or 64 bit
+    /// floating point samples and an arbitrary
+    /// number of channels and are written with 16
+    /// bit integer samples.
     /////////////////////////////////////////////////
     class WavFile : public SeekableFile
     {
@@ -56,7 +60,7 @@ namespace Audio
             mutable std::fstream m_WavFileStream;
             WavFileHeader m_Header;
             uint32_t m_DataBlockLength;
-            const long long int m_StreamOffset = 44;
+            long long int m_StreamOffset = 44;
             bool isNewFile;
 
             bool readHeader();
@@ -141,7 +145,7 @@ namespace Audio
             /////////////////////////////////////////////////
             virtual size_t getLength() const override
             {
-                return m_DataBlockLength / (m_Header.channels * m_Header.bitsPerSample/8);
+                return m_DataBlockLength / m_Header.blockAlign;
             }
 
             virtual Sample read() const override;
@@ -156,7 +160,7 @@ namespace Audio
             virtual size_t getPosition() const override
             {
                 if (m_WavFileStream.good())
-                    return (m_WavFileStream.tellg() - m_StreamOffset) / (m_Header.channels * m_Header.bitsPerSample/8);
+                    return (m_WavFileStream.tellg() - m_StreamOffset) / m_Header.blockAlign;
 
                 return 0;
             }
@@ -171,12 +175,15 @@ namespace Audio
             /////////////////////////////////////////////////
             virtual void setPosition(size_t pos) override
             {
-                if (m_WavFileStream.good() && pos * (m_Header.channels * m_Header.bitsPerSample/8) < m_DataBlockLength)
-                    m_WavFileStream.seekg(pos * (m_Header.channels * m_Header.bitsPerSample/8) + m_StreamOffset);
+                if (m_WavFileStream.good() && pos * m_Header.blockAlign < m_DataBlockLength)
+                    m_WavFileStream.seekg(pos * m_Header.blockAlign + m_StreamOffset);
             }
 
             virtual std::vector<Sample> readSome(size_t len) const override;
             virtual void writeSome(const std::vector<Sample> vSamples) override;
+
+            virtual size_t readBlock(std::vector<std::vector<double>>& vChannels, size_t len) const override;
+            virtual void writeBlock(const std::vector<std::vector<double>>& vChannels, size_t len) override;
     };
 }
 
@@ -1355,6 +1355,11 @@ namespace mu
 
 	const std::map<std::string, std::vector<mu::value_type> >& ParserBase::GetVectors() const
 	{
+	    // Views are only valid for the evaluation of the
+	    // line, which bound them, and cannot be handed out.
+	    // Their data is copied to the vectors instead
+	    ReleaseVectorViews();
+
 	    for (auto iter = mVectorVars.begin(); iter != mVectorVars.end(); ++iter)
         {
             if (m_VarDef.find(iter->first) != m_VarDef.end()) // FIX needed because both maps do not have to be identical
@@ -2940,7 +2945,10 @@ namespace mu
         if (mVectorVars.size())
         {
             std::vector<std::vector<value_type>*> vUsedVectorVars;
+            std::vector<const VectorView*> vUsedVectorViews;
+            std::vector<const std::string*> vUsedVectorNames;
             std::vector<value_type*> vUsedVectorVarAddresses;
+            std::vector<value_type*> vUsedVectorData;
             varmap_type& vars = m_state->m_usedVar;
             size_t nVectorLength = 0;
 
@@ -2952,11 +2960,17 @@ namespace mu
             {
                 if (iterVector->first == iterVar->first)
                 {
-                    if (iterVector->second.size() > 1 && iterVector->first != "_~TRGTVCT[~]")
+                    auto iterView = mVectorViews.find(iterVector->first);
+                    const VectorView* view = iterView != mVectorViews.end() ? &iterView->second : nullptr;
+                    size_t nSize = view ? view->m_size : iterVector->second.size();
+
+                    if (nSize > 1 && iterVector->first != "_~TRGTVCT[~]")
                     {
                         vUsedVectorVarAddresses.push_back(iterVar->second);
                         vUsedVectorVars.push_back(&(iterVector->second));
-                        nVectorLength = std::max(nVectorLength, iterVector->second.size());
+                        vUsedVectorViews.push_back(view);
+                        vUsedVectorNames.push_back(&iterVector->first);
+                        nVectorLength = std::max(nVectorLength, nSize);
                     }
 
                     ++iterVector;
@@ -2974,11 +2988,35 @@ namespace mu
             // Any vectors larger than 1 element in this equation?
             if (vUsedVectorVarAddresses.size())
             {
-                // Replace all addresses and resize all vectors to fit
+                // Replace all addresses and resize all vectors to fit.
+                // Bound views are read directly, if they have the
+                // needed size and do not share their storage with
+                // another variable (the addresses are restored by
+                // value afterwards). Otherwise they are copied
                 for (size_t i = 0; i < vUsedVectorVarAddresses.size(); i++)
                 {
-                    vUsedVectorVars[i]->resize(nVectorLength);
-                    m_state->m_byteCode.ChangeVar(vUsedVectorVarAddresses[i], vUsedVectorVars[i]->data(), true);
+                    const VectorView* view = vUsedVectorViews[i];
+
+                    if (view
+                        && view->m_size == nVectorLength
+                        && std::find(vUsedVectorData.begin(), vUsedVectorData.end(), view->m_data) == vUsedVectorData.end())
+                    {
+                        // The bytecode only reads from variable addresses
+                        vUsedVectorData.push_back(const_cast<value_type*>(view->m_data));
+                    }
+                    else
+                    {
+                        if (view)
+                        {
+                            vUsedVectorVars[i]->assign(view->m_data, view->m_data + view->m_size);
+                            mVectorViews.erase(*vUsedVectorNames[i]);
+                        }
+
+                        vUsedVectorVars[i]->resize(nVectorLength);
+                        vUsedVectorData.push_back(vUsedVectorVars[i]->data());
+                    }
+
+                    m_state->m_byteCode.ChangeVar(vUsedVectorVarAddresses[i], vUsedVectorData[i], true);
                 }
 
                 // Resize the target buffer correspondingly
@@ -3027,7 +3065,7 @@ namespace mu
                 // Replace all addresses (they are temporary!)
                 for (size_t i = 0; i < vUsedVectorVarAddresses.size(); i++)
                 {
-                    m_state->m_byteCode.ChangeVar(vUsedVectorVars[i]->data(), vUsedVectorVarAddresses[i], false);
+                    m_state->m_byteCode.ChangeVar(vUsedVectorData[i], vUsedVectorVarAddresses[i], false);
                 }
 
                 // Repeat the first component to resolve possible overwrites (needs additional time)
@@ -3060,6 +3098,12 @@ namespace mu
                 m_stateStacks[nthLoopElement].m_states.push_back(State());
 
             m_state = &m_stateStacks(nthLoopElement, nthLoopPartEquation);
+
+            // All parts of the current loop element have been
+            // evaluated. The views are copied now, because their
+            // storage might change before the next evaluation
+            if (nthLoopPartEquation+1 >= m_stateStacks[nthLoopElement].m_states.size())
+                ReleaseVectorViews();
         }
 
         return &m_buffer[0];
@@ -3135,13 +3179,15 @@ namespace mu
             bCompiling = false;
             m_stateStacks.clear();
             m_state = &m_compilingState;
+            ReleaseVectorViews();
         }
     }
 
 
     /////////////////////////////////////////////////
     /// \brief Activates the selected position in the
-    /// internally stored bytecode.
+    /// internally stored bytecode and releases the
+    /// bound vector views.
     ///
     /// \param _nLoopElement unsigned int
     /// \return void
@@ -3149,6 +3195,11 @@ namespace mu
     /////////////////////////////////////////////////
     void ParserBase::SetIndex(unsigned int _nLoopElement)
     {
+        // The views of the previous element are
+        // only valid during its evaluation. They are
+        // usually already released by Eval()
+        ReleaseVectorViews();
+
         nthLoopElement = _nLoopElement;
         nCurrVectorIndex = 0;
         nthLoopPartEquation = 0;
@@ -3571,12 +3622,15 @@ namespace mu
 			*(m_VarDef.find(sVarName)->second) = vVar[0];
 
 		mVectorVars[sVarName] = vVar;
+		mVectorViews.erase(sVarName);
 	}
 
 
     /////////////////////////////////////////////////
     /// \brief This member function returns a pointer
-    /// to the vector stored internally.
+    /// to the vector stored internally. A bound view
+    /// is released, because the caller is expected
+    /// to overwrite the vector's contents.
     ///
     /// \param sVarName const std::string&
     /// \return std::vector<mu::value_type>*
@@ -3587,10 +3641,68 @@ namespace mu
 		if (mVectorVars.find(sVarName) == mVectorVars.end())
 			return nullptr;
 
+        mVectorViews.erase(sVarName);
 		return &mVectorVars[sVarName];
 	}
 
 
+    /////////////////////////////////////////////////
+    /// \brief This member function binds a read-only
+    /// view on external storage to an already
+    /// existing vector variable. The values are not
+    /// copied and will only be read during the
+    /// evaluation. The view is released as soon as
+    /// the variable is set or accessed otherwise and
+    /// latest, when all parts of the current loop
+    /// element are evaluated. Therefore it
+    /// has to be bound again before every
+    /// evaluation and the storage must not change in
+    /// between. Returns false, if the variable does
+    /// not exist.
+    ///
+    /// \param sVarName const std::string&
+    /// \param data const value_type*
+    /// \param nElems size_t
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	bool ParserBase::BindVectorVar(const std::string& sVarName, const value_type* data, size_t nElems)
+	{
+	    auto iter = mVectorVars.find(sVarName);
+
+		if (iter == mVectorVars.end() || !data || !nElems)
+			return false;
+
+        mVectorViews[sVarName] = {data, nElems};
+        return true;
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief This member function releases all
+    /// views bound by BindVectorVar(), because their
+    /// storage might be reallocated after the
+    /// evaluation. The viewed data is copied to the
+    /// corresponding vector variables first, so that
+    /// they keep the values of the last evaluation.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+	void ParserBase::ReleaseVectorViews() const
+	{
+	    for (const auto& iter : mVectorViews)
+        {
+            auto vectIter = mVectorVars.find(iter.first);
+
+            if (vectIter != mVectorVars.end())
+                vectIter->second.assign(iter.second.m_data, iter.second.m_data + iter.second.m_size);
+        }
+
+	    mVectorViews.clear();
+	}
+
+
     /////////////////////////////////////////////////
     /// \brief This member function updates the
     /// corresponding variable of a vector with the
@@ -3607,7 +3719,12 @@ namespace mu
 
         //g_logger.debug("Updating " + sVarName + " Exists: " + toString(GetVar().find(sVarName) != GetVar().end()));
 
-		*(GetVar().find(sVarName)->second) = mVectorVars[sVarName][0];
+        auto viewIter = mVectorViews.find(sVarName);
+
+        if (viewIter != mVectorViews.end())
+            *(GetVar().find(sVarName)->second) = viewIter->second.m_data[0];
+        else
+            *(GetVar().find(sVarName)->second) = mVectorVars[sVarName][0];
 	}
 
 
@@ -3621,6 +3738,8 @@ namespace mu
     /////////////////////////////////////////////////
 	void ParserBase::ClearVectorVars(bool bIgnoreProcedureVects)
 	{
+	    mVectorViews.clear();
+
 		if (!mVectorVars.size())
 			return;
 
@@ -3667,7 +3786,8 @@ namespace mu
 	{
 	    for (auto iter = mVectorVars.begin(); iter != mVectorVars.end(); ++iter)
         {
-            if (ignoreSingletons && iter->second.size() == 1)
+            if (ignoreSingletons && iter->second.size() == 1
+                && (mVectorViews.find(iter->first) == mVectorViews.end() || mVectorViews[iter->first].m_size == 1))
                 continue;
 
             size_t nPos = sExpr.find(iter->first);
@@ -54,6 +54,21 @@ namespace mu
     typedef std::map<std::string,std::vector<value_type>> vectormap_type;
 
 
+    /////////////////////////////////////////////////
+    /// \brief A read-only view on external numerical
+    /// storage (e.g. a table column), which is bound
+    /// to a vector variable instead of copying its
+    /// values.
+    /////////////////////////////////////////////////
+    struct VectorView
+    {
+        const value_type* m_data;
+        size_t m_size;
+    };
+
+    typedef std::map<std::string,VectorView> vectorviewmap_type;
+
+
 	//--------------------------------------------------------------------------------------------------
 	/** \brief Mathematical expressions parser (base parser engine).
 	    \author (C) 2012 Ingo Berg
@@ -209,6 +224,8 @@ namespace mu
 			string_type CreateTempVectorVar(const std::vector<mu::value_type>& vVar);
 			void SetVectorVar(const std::string& sVarName, const std::vector<mu::value_type>& vVar, bool bAddVectorType = false);
 			std::vector<mu::value_type>* GetVectorVar(const std::string& sVarName);
+			bool BindVectorVar(const std::string& sVarName, const value_type* data, size_t nElems);
+			void ReleaseVectorViews() const;
 			void UpdateVectorVar(const std::string& sVarName);
 			void ClearVectorVars(bool bIgnoreProcedureVects = false);
 			bool ContainsVectorVars(StringView sExpr, bool ignoreSingletons);
@@ -338,6 +355,7 @@ namespace mu
 			//static const int s_MaxNumOpenMPThreads = 4;
 
 			mutable vectormap_type mVectorVars;
+			mutable vectorviewmap_type mVectorViews;
 
 			unsigned int nthLoopElement;
 			unsigned int nthLoopPartEquation;
@@ -30,6 +30,38 @@ class StringView;
 
 namespace mu
 {
+    /////////////////////////////////////////////////
+    /// \brief Describes the precompiled index part
+    /// of a cached data access. The textual indices
+    /// are split only once into the expressions,
+    /// which have to be evaluated, and the positions
+    /// of their results. Empty components are stored
+    /// as signed positions as well (rows are
+    /// positive, columns are negative).
+    /////////////////////////////////////////////////
+	struct IndexProgram
+	{
+	    std::string m_rowExpr; // single row index (may be a vector)
+	    std::string m_colExpr; // single column index (may be a vector)
+	    std::string m_casualExpr; // all remaining index expressions, comma-separated
+	    std::vector<int> m_casualPositions; // assignment of the results of m_casualExpr
+	    std::vector<int> m_emptyPositions; // empty components, i.e. first or open-ended indices
+	    bool m_compiled;
+
+	    IndexProgram() : m_compiled(false) {}
+
+	    void clear()
+	    {
+	        m_rowExpr.clear();
+	        m_colExpr.clear();
+	        m_casualExpr.clear();
+	        m_casualPositions.clear();
+	        m_emptyPositions.clear();
+	        m_compiled = false;
+	    }
+	};
+
+
     /////////////////////////////////////////////////
     /// \brief Describes an already evaluated data
     /// access, which can be reconstructed from the
@@ -48,6 +80,7 @@ namespace mu
 		std::string sVectorName; // target of the created vector -> use SetVectorVar
 		std::string sCacheName; // needed for reading the data -> create a vector var
 		int flags;
+		IndexProgram program; // precompiled version of the indices in sAccessEquation
 	};
 
 
@@ -50,8 +50,6 @@ enum WindowType
 
 typedef CommandReturnValues (*CommandFunc)(string&);
 
-extern mglGraph _fontData;
-
 string removeQuotationMarks(const string& sString);
 static size_t findSettingOption(const std::string& sCmd, const std::string& sOption);
 
@@ -3802,7 +3800,7 @@ static CommandReturnValues cmd_set(string& sCmd)
                             if (iter->first == SETTING_S_PLOTFONT)
                             {
                                 _option.setDefaultPlotFont(sArgument);
-                                _fontData.LoadFont(mSettings[SETTING_S_PLOTFONT].stringval().c_str(), mSettings[SETTING_S_EXEPATH].stringval().c_str());
+                                requestPlotFont(mSettings[SETTING_S_PLOTFONT].stringval(), mSettings[SETTING_S_EXEPATH].stringval());
                                 _pData.setFont(mSettings[SETTING_S_PLOTFONT].stringval());
                             }
                             else
@@ -4969,8 +4967,11 @@ static CommandReturnValues cmd_load(string& sCmd)
                 if (!vFilelist.size())
                     throw SyntaxError(SyntaxError::FILE_NOT_EXIST, sCmd, sFileName, sFileName);
 
+                std::vector<NumeRe::FileHeaderInfo> vInfo = _data.openFiles(vFilelist, true, cmdParser.hasParam("ignore") || cmdParser.hasParam("i"),
+                                                                            nArgument, getTargetTable(cmdParser.getParameterList()), _option.getLoadThreads());
+
                 for (size_t i = 0; i < vFilelist.size(); i++)
-                    vFilelist[i] = _data.openFile(vFilelist[i], true, cmdParser.hasParam("ignore") || cmdParser.hasParam("i"), nArgument, getTargetTable(cmdParser.getParameterList())).sTableName;
+                    vFilelist[i] = vInfo[i].sTableName;
 
                 if (!_data.isEmpty(vFilelist.front()) && _option.systemPrints())
                     NumeReKernel::print(_lang.get("BUILTIN_CHECKKEYOWRD_LOAD_ALL_CACHES_SUCCESS", toString(vFilelist.size()), sFileName));
@@ -4997,11 +4998,8 @@ static CommandReturnValues cmd_load(string& sCmd)
                     if (!vFilelist.size())
                         throw SyntaxError(SyntaxError::FILE_NOT_EXIST, sCmd, sFileName, sFileName);
 
-                    for (size_t i = 0; i < vFilelist.size(); i++)
-                    {
-                        // Melting is done automatically
-                        _data.openFile(vFilelist[i], false, false, nArgument);
-                    }
+                    // Melting is done automatically
+                    _data.openFiles(vFilelist, false, false, nArgument, "", _option.getLoadThreads());
 
                     if (!_data.isEmpty("data") && _option.systemPrints())
                         NumeReKernel::print(_lang.get("BUILTIN_CHECKKEYOWRD_LOAD_ALL_SUCCESS", toString(vFilelist.size()), sFileName, toString(_data.getLines("data", false)), toString(_data.getCols("data", false))));
@@ -5160,6 +5158,91 @@ static CommandReturnValues cmd_progress(string& sCmd)
 }
 
 
+/////////////////////////////////////////////////
+/// \brief This static function implements the
+/// "profile" command, which controls the line-
+/// level execution profiler.
+///
+/// \param sCmd string&
+/// \return CommandReturnValues
+///
+/////////////////////////////////////////////////
+static CommandReturnValues cmd_profile(string& sCmd)
+{
+    CommandLineParser cmdParser(sCmd, "profile", CommandLineParser::CMD_PAR);
+    NumeReProfiler& _profiler = NumeReKernel::getInstance()->getProfiler();
+
+    if (cmdParser.hasParam("reset"))
+        _profiler.reset();
+
+    if (cmdParser.hasParam("start"))
+    {
+        _profiler.start();
+        return COMMAND_PROCESSED;
+    }
+
+    if (cmdParser.hasParam("stop"))
+        _profiler.stop();
+
+    // Export the collapsed stacks for the flamegraph
+    // tools
+    if (cmdParser.hasParam("export"))
+    {
+        std::string sFileName = cmdParser.getFileParameterValueForSaving(".txt", "<savepath>", "<savepath>/profile.txt");
+
+        if (!_profiler.exportCollapsedStacks(sFileName))
+            throw SyntaxError(SyntaxError::CANNOT_GENERATE_FILE, sCmd, SyntaxError::invalid_position, sFileName);
+
+        return COMMAND_PROCESSED;
+    }
+
+    if (!cmdParser.hasParam("report"))
+        return COMMAND_PROCESSED;
+
+    NumeRe::Table report = _profiler.createReport();
+
+    // Write the report to a table, if the user
+    // selected one
+    if (cmdParser.hasParam("target"))
+    {
+        Indices _idx;
+        std::string sTarget = cmdParser.getTargetTable(_idx, "profile");
+        NumeReKernel::getInstance()->getMemoryManager().importTable(report, sTarget, _idx.row, _idx.col);
+        cmdParser.setReturnValue("\"" + sTarget + "()\"");
+        return COMMAND_PROCESSED;
+    }
+
+    // Print the most expensive procedures and lines
+    const size_t MAXROWS = 20;
+    NumeReKernel::toggleTableStatus();
+    make_hline();
+    NumeReKernel::print("NUMERE: " + toUpperCase("Profiler"));
+    make_hline();
+    NumeReKernel::printPreFmt("|   " + strlfill("Procedure", 32) + strfill("Line", 6) + strfill("Calls", 10)
+                              + strfill("Misses", 8) + strfill("Incl. [ms]", 12) + strfill("Excl. [ms]", 12) + "\n");
+
+    for (size_t i = 0, nLinesPrinted = 0; i < report.getLines(); i++)
+    {
+        // Print all procedures but only the most
+        // expensive lines
+        if (!std::isnan(report.getValue(i, 1).real()) && nLinesPrinted++ >= MAXROWS)
+            break;
+
+        NumeReKernel::printPreFmt("|   " + strlfill(ellipsize(report.getValueAsString(i, 0), 30), 32)
+                                  + strfill(report.getValueAsString(i, 1), 6)
+                                  + strfill(report.getValueAsString(i, 2), 10)
+                                  + strfill(report.getValueAsString(i, 3), 8)
+                                  + strfill(toString(report.getValue(i, 4).real(), 5), 12)
+                                  + strfill(toString(report.getValue(i, 5).real(), 5), 12) + "\n");
+    }
+
+    NumeReKernel::toggleTableStatus();
+    make_hline();
+
+    return COMMAND_PROCESSED;
+}
+
+
 /////////////////////////////////////////////////
 /// \brief This static function implements the
 /// "print" command.
@@ -5326,6 +5409,7 @@ static std::map<std::string,CommandFunc> getCommandFunctions()
     mCommandFuncMap["plot3d"] = cmd_plotting;
     mCommandFuncMap["plotcompose"] = cmd_plotting;
     mCommandFuncMap["print"] = cmd_print;
+    mCommandFuncMap["profile"] = cmd_profile;
     mCommandFuncMap["progress"] = cmd_progress;
     mCommandFuncMap["quit"] = cmd_quit;
     mCommandFuncMap["random"] = cmd_random;
@@ -20,9 +20,105 @@
 
 #include "cluster.hpp"
 #include "../ui/error.hpp"
+#include "../maths/orderstatistics.hpp"
 
 namespace NumeRe
 {
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to release the
+    /// memory of an array, which is not used by the
+    /// current storage type.
+    ///
+    /// \param vArray std::vector<T>&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    template <class T>
+    static void freeArray(std::vector<T>& vArray)
+    {
+        std::vector<T>().swap(vArray);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to remove the
+    /// marked elements from an array by moving the
+    /// remaining elements to the front.
+    ///
+    /// \param vArray std::vector<T>&
+    /// \param vDelete const std::vector<bool>&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    template <class T>
+    static void eraseMarkedElements(std::vector<T>& vArray, const std::vector<bool>& vDelete)
+    {
+        if (vArray.empty())
+            return;
+
+        size_t nTarget = 0;
+
+        for (size_t i = 0; i < vArray.size(); i++)
+        {
+            if (vDelete[i])
+                continue;
+
+            if (nTarget != i)
+                vArray[nTarget] = std::move(vArray[i]);
+
+            nTarget++;
+        }
+
+        vArray.resize(nTarget);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to reorder the
+    /// elements of an array between i1 and i2 based
+    /// upon the passed index vector.
+    ///
+    /// \param vArray std::vector<T>&
+    /// \param vIndex const std::vector<int>&
+    /// \param i1 int
+    /// \param i2 int
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    template <class T>
+    static void reorderArray(std::vector<T>& vArray, const std::vector<int>& vIndex, int i1, int i2)
+    {
+        if (vArray.empty())
+            return;
+
+        std::vector<T> vSortVector(std::make_move_iterator(vArray.begin()+i1), std::make_move_iterator(vArray.begin()+i2+1));
+
+        // Copy the contents directly from the
+        // prepared in the new order
+        for (int i = 0; i <= i2-i1; i++)
+        {
+            vArray[i+i1] = std::move(vSortVector[vIndex[i]-i1]);
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to convert a
+    /// value item into a string.
+    ///
+    /// \param val const mu::value_type&
+    /// \return std::string
+    ///
+    /////////////////////////////////////////////////
+    static std::string valueToString(const mu::value_type& val)
+    {
+        if (std::isnan(std::abs(val)))
+            return "nan";
+
+        return toString(val, 7);
+    }
+
+
     //
     // class CLUSTER
     //
@@ -40,19 +136,12 @@ namespace NumeRe
     {
         bSortCaseInsensitive = false;
 
-        // Clear the contents first
-        clear();
-
-        nGlobalType = cluster.nGlobalType;
-
-        // Fill the cluster with copies from the passed cluster
-        for (size_t i = 0; i < cluster.vClusterArray.size(); i++)
-        {
-            if (cluster.vClusterArray[i]->getType() == ClusterItem::ITEMTYPE_DOUBLE)
-                vClusterArray.push_back(new ClusterDoubleItem(cluster.vClusterArray[i]->getDouble()));
-            else
-                vClusterArray.push_back(new ClusterStringItem(cluster.vClusterArray[i]->getInternalString()));
-        }
+        // Copy the typed arrays directly
+        vDoubleArray = cluster.vDoubleArray;
+        vStringArray = cluster.vStringArray;
+        vTypeArray = cluster.vTypeArray;
+        nStringItems = cluster.nStringItems;
+        nStorageType = cluster.nStorageType;
     }
 
 
@@ -67,17 +156,8 @@ namespace NumeRe
     void Cluster::assign(const std::vector<mu::value_type>& vVals)
     {
         bSortCaseInsensitive = false;
-
-        // clear the contents first
-        clear();
-
-        nGlobalType = ClusterItem::ITEMTYPE_DOUBLE;
-
-        // Fill the cluster with new double items
-        for (size_t i = 0; i < vVals.size(); i++)
-        {
-            vClusterArray.push_back(new ClusterDoubleItem(vVals[i]));
-        }
+        nStorageType = ClusterItem::ITEMTYPE_INVALID;
+        setDoubleArray(vVals);
     }
 
 
@@ -92,17 +172,8 @@ namespace NumeRe
     void Cluster::assign(const std::vector<std::string>& vStrings)
     {
         bSortCaseInsensitive = false;
-
-        // Clear the contents first
-        clear();
-
-        nGlobalType = ClusterItem::ITEMTYPE_STRING;
-
-        // Fill the cluster with new string items
-        for (size_t i = 0; i < vStrings.size(); i++)
-        {
-            vClusterArray.push_back(new ClusterStringItem(vStrings[i]));
-        }
+        nStorageType = ClusterItem::ITEMTYPE_INVALID;
+        setStringArray(vStrings);
     }
 
 
@@ -118,31 +189,18 @@ namespace NumeRe
     /////////////////////////////////////////////////
     void Cluster::assignVectorResults(Indices _idx, int nNum, mu::value_type* data)
     {
-        if (nGlobalType != ClusterItem::ITEMTYPE_DOUBLE)
-            nGlobalType = ClusterItem::ITEMTYPE_INVALID;
-
         if (nNum == 1)
             _idx.row.setOpenEndIndex(std::max((size_t)_idx.row.front(), size()) - 1);
 
-        // Assign the single results
+        // Assign the single results. The cluster is
+        // expanded on-the-fly and the types of the
+        // items are adapted
         for (size_t i = 0; i < _idx.row.size(); i++)
         {
             if (nNum > 1 && (size_t)nNum <= i)
                 return;
 
-            // Expand the current cluster on-the-fly
-            while (_idx.row[i] >= (int)vClusterArray.size())
-                push_back(new ClusterDoubleItem(NAN));
-
-            // Assign the value and expand singletons
-            if (vClusterArray[_idx.row[i]]->getType() != ClusterItem::ITEMTYPE_DOUBLE)
-            {
-                // Re-create the current item as double
-                delete vClusterArray[_idx.row[i]];
-                vClusterArray[_idx.row[i]] = new ClusterDoubleItem(nNum == 1 ? data[0] : data[i]);
-            }
-            else
-                vClusterArray[_idx.row[i]]->setDouble(nNum == 1 ? data[0] : data[i]);
+            setDouble(_idx.row[i], nNum == 1 ? data[0] : data[i]);
         }
     }
 
@@ -163,18 +221,18 @@ namespace NumeRe
         {
             if (bSortCaseInsensitive)
             {
-                if (toLowerCase(vClusterArray[i]->getParserString()) < toLowerCase(vClusterArray[j]->getParserString()))
+                if (toLowerCase(getParserString(i)) < toLowerCase(getParserString(j)))
                     return -1;
 
-                if (toLowerCase(vClusterArray[i]->getParserString()) == toLowerCase(vClusterArray[j]->getParserString()))
+                if (toLowerCase(getParserString(i)) == toLowerCase(getParserString(j)))
                     return 0;
             }
             else
             {
-                if (vClusterArray[i]->getParserString() < vClusterArray[j]->getParserString())
+                if (getParserString(i) < getParserString(j))
                     return -1;
 
-                if (vClusterArray[i]->getParserString() == vClusterArray[j]->getParserString())
+                if (getParserString(i) == getParserString(j))
                     return 0;
             }
 
@@ -182,10 +240,10 @@ namespace NumeRe
         }
         else if (isDouble())
         {
-            if (vClusterArray[i]->getDouble().real() < vClusterArray[j]->getDouble().real())
+            if (vDoubleArray[i].real() < vDoubleArray[j].real())
                 return -1;
 
-            if (vClusterArray[i]->getDouble() == vClusterArray[j]->getDouble())
+            if (vDoubleArray[i] == vDoubleArray[j])
                 return 0;
 
             return 1;
@@ -206,10 +264,10 @@ namespace NumeRe
     /////////////////////////////////////////////////
     bool Cluster::isValue(int line, int col)
     {
-        if (vClusterArray[line]->getType() == ClusterItem::ITEMTYPE_DOUBLE && !std::isnan(vClusterArray[line]->getDouble().real()))
+        if (getType(line) == ClusterItem::ITEMTYPE_DOUBLE && !std::isnan(vDoubleArray[line].real()))
             return true;
 
-        if (vClusterArray[line]->getType() == ClusterItem::ITEMTYPE_STRING && vClusterArray[line]->getParserString() != "\"\"")
+        if (getType(line) == ClusterItem::ITEMTYPE_STRING && vStringArray[line].length())
             return true;
 
         return false;
@@ -229,65 +287,154 @@ namespace NumeRe
     /////////////////////////////////////////////////
     void Cluster::reorderElements(std::vector<int> vIndex, int i1, int i2)
     {
-        std::vector<ClusterItem*> vSortVector = vClusterArray;
+        // Unused arrays are empty and will be ignored
+        reorderArray(vDoubleArray, vIndex, i1, i2);
+        reorderArray(vStringArray, vIndex, i1, i2);
+        reorderArray(vTypeArray, vIndex, i1, i2);
+    }
 
-        // Copy the contents directly from the
-        // prepared in the new order
-        for (int i = 0; i <= i2-i1; i++)
+
+    /////////////////////////////////////////////////
+    /// \brief Converts the storage of a cluster
+    /// containing only values or only strings into
+    /// the storage for mixed clusters, i.e. both
+    /// typed arrays and the type tags are filled.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void Cluster::toMixedStorage()
+    {
+        if (nStorageType == ClusterItem::ITEMTYPE_MIXED)
+            return;
+
+        size_t nSize = size();
+
+        if (nStorageType == ClusterItem::ITEMTYPE_STRING)
         {
-            vClusterArray[i+i1] = vSortVector[vIndex[i]];
+            vDoubleArray.assign(nSize, NAN);
+            vTypeArray.assign(nSize, ClusterItem::ITEMTYPE_STRING);
+            nStringItems = nSize;
         }
+        else
+        {
+            vStringArray.assign(nSize, "");
+            vTypeArray.assign(nSize, ClusterItem::ITEMTYPE_DOUBLE);
+            nStringItems = 0;
+        }
+
+        nStorageType = ClusterItem::ITEMTYPE_MIXED;
     }
 
 
     /////////////////////////////////////////////////
-    /// \brief Reduces the size of this cluster to
-    /// the specified number of elements. Does not
-    /// create anything, if the cluster is already
-    /// smaller.
+    /// \brief Converts the storage of a mixed
+    /// cluster back into a single typed array, if
+    /// all items have the same type. Empty clusters
+    /// release all of their storage.
     ///
-    /// \param s size_t
     /// \return void
     ///
     /////////////////////////////////////////////////
-    void Cluster::reduceSize(size_t s)
+    void Cluster::compactStorage()
     {
-        if (vClusterArray.size() <= s)
+        if (!size())
+        {
+            clear();
             return;
+        }
 
-        for (size_t i = s; i < vClusterArray.size(); i++)
-            delete vClusterArray[i];
+        if (nStorageType != ClusterItem::ITEMTYPE_MIXED)
+            return;
 
-        vClusterArray.resize(s);
+        if (!nStringItems)
+        {
+            freeArray(vStringArray);
+            freeArray(vTypeArray);
+            nStorageType = ClusterItem::ITEMTYPE_DOUBLE;
+        }
+        else if (nStringItems == vTypeArray.size())
+        {
+            freeArray(vDoubleArray);
+            freeArray(vTypeArray);
+            nStorageType = ClusterItem::ITEMTYPE_STRING;
+        }
     }
 
 
     /////////////////////////////////////////////////
-    /// \brief This member function appends an
-    /// arbitrary cluster item at the back of the
-    /// internal cluster array buffer.
+    /// \brief Expands the cluster to n items. The new
+    /// items have the passed type and are either NaN
+    /// or an empty string.
     ///
-    /// \param item ClusterItem*
+    /// \param n size_t
+    /// \param nType int
     /// \return void
     ///
     /////////////////////////////////////////////////
-    void Cluster::push_back(ClusterItem* item)
+    void Cluster::expandStorage(size_t n, int nType)
     {
-        if (item)
-            vClusterArray.push_back(item);
+        size_t nSize = size();
+
+        if (n <= nSize)
+            return;
+
+        if (!nSize)
+            nStorageType = nType;
+
+        if (nStorageType == nType)
+        {
+            if (nType == ClusterItem::ITEMTYPE_DOUBLE)
+                vDoubleArray.resize(n, NAN);
+            else
+                vStringArray.resize(n);
 
-        if (nGlobalType == ClusterItem::ITEMTYPE_INVALID)
             return;
+        }
+
+        toMixedStorage();
+
+        vDoubleArray.resize(n, NAN);
+        vStringArray.resize(n);
+        vTypeArray.resize(n, nType);
+
+        if (nType == ClusterItem::ITEMTYPE_STRING)
+            nStringItems += n - nSize;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Removes all marked items from the
+    /// cluster.
+    ///
+    /// \param vDelete const std::vector<bool>&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void Cluster::eraseItems(const std::vector<bool>& vDelete)
+    {
+        // Count the removed strings in mixed clusters
+        if (nStorageType == ClusterItem::ITEMTYPE_MIXED)
+        {
+            for (size_t i = 0; i < vTypeArray.size(); i++)
+            {
+                if (vDelete[i] && vTypeArray[i] == ClusterItem::ITEMTYPE_STRING)
+                    nStringItems--;
+            }
+        }
 
-        if (item->getType() != nGlobalType)
-            nGlobalType = ClusterItem::ITEMTYPE_MIXED;
+        // Unused arrays are empty and will be ignored
+        eraseMarkedElements(vDoubleArray, vDelete);
+        eraseMarkedElements(vStringArray, vDelete);
+        eraseMarkedElements(vTypeArray, vDelete);
+
+        compactStorage();
     }
 
 
     /////////////////////////////////////////////////
-    /// \brief This member function constructs a new
-    /// double cluster item at the back of the
-    /// internal cluster array buffer.
+    /// \brief This member function appends a new
+    /// value item at the back of the cluster.
     ///
     /// \param val const mu::value_type&
     /// \return void
@@ -295,20 +442,26 @@ namespace NumeRe
     /////////////////////////////////////////////////
     void Cluster::push_back(const mu::value_type& val)
     {
-        vClusterArray.push_back(new ClusterDoubleItem(val));
+        if (nStorageType == ClusterItem::ITEMTYPE_INVALID)
+            nStorageType = ClusterItem::ITEMTYPE_DOUBLE;
 
-        if (nGlobalType == ClusterItem::ITEMTYPE_INVALID)
+        if (nStorageType == ClusterItem::ITEMTYPE_DOUBLE)
+        {
+            vDoubleArray.push_back(val);
             return;
+        }
 
-        if (nGlobalType == ClusterItem::ITEMTYPE_STRING)
-            nGlobalType = ClusterItem::ITEMTYPE_MIXED;
+        toMixedStorage();
+
+        vDoubleArray.push_back(val);
+        vStringArray.push_back("");
+        vTypeArray.push_back(ClusterItem::ITEMTYPE_DOUBLE);
     }
 
 
     /////////////////////////////////////////////////
-    /// \brief This member function constructs a new
-    /// string cluster item at the back of the
-    /// internal cluster array buffer.
+    /// \brief This member function appends a new
+    /// string item at the back of the cluster.
     ///
     /// \param strval const std::string&
     /// \return void
@@ -316,46 +469,51 @@ namespace NumeRe
     /////////////////////////////////////////////////
     void Cluster::push_back(const std::string& strval)
     {
-        vClusterArray.push_back(new ClusterStringItem(strval));
+        if (nStorageType == ClusterItem::ITEMTYPE_INVALID)
+            nStorageType = ClusterItem::ITEMTYPE_STRING;
 
-        if (nGlobalType == ClusterItem::ITEMTYPE_INVALID)
+        if (nStorageType == ClusterItem::ITEMTYPE_STRING)
+        {
+            vStringArray.push_back(strval);
             return;
+        }
 
-        if (nGlobalType == ClusterItem::ITEMTYPE_DOUBLE)
-            nGlobalType = ClusterItem::ITEMTYPE_MIXED;
+        toMixedStorage();
+
+        vDoubleArray.push_back(NAN);
+        vStringArray.push_back(strval);
+        vTypeArray.push_back(ClusterItem::ITEMTYPE_STRING);
+        nStringItems++;
     }
 
 
     /////////////////////////////////////////////////
     /// \brief This member function removes the last
-    /// item in the internal memory buffer and frees
-    /// the associated memory.
+    /// item in the cluster.
     ///
     /// \return void
     ///
     /////////////////////////////////////////////////
     void Cluster::pop_back()
     {
-        if (vClusterArray.size())
+        if (!size())
+            return;
+
+        if (nStorageType == ClusterItem::ITEMTYPE_MIXED)
         {
-            delete vClusterArray.back();
-            vClusterArray.pop_back();
+            if (vTypeArray.back() == ClusterItem::ITEMTYPE_STRING)
+                nStringItems--;
 
-            nGlobalType = ClusterItem::ITEMTYPE_INVALID;
+            vTypeArray.pop_back();
         }
-    }
 
+        if (vDoubleArray.size())
+            vDoubleArray.pop_back();
 
-    /////////////////////////////////////////////////
-    /// \brief This member function returns the size
-    /// of the internal memory buffer as items.
-    ///
-    /// \return size_t
-    ///
-    /////////////////////////////////////////////////
-    size_t Cluster::size() const
-    {
-        return vClusterArray.size();
+        if (vStringArray.size())
+            vStringArray.pop_back();
+
+        compactStorage();
     }
 
 
@@ -368,16 +526,19 @@ namespace NumeRe
     /////////////////////////////////////////////////
     size_t Cluster::getBytes() const
     {
+        if (nStorageType == ClusterItem::ITEMTYPE_DOUBLE)
+            return vDoubleArray.size() * sizeof(mu::value_type);
+
         size_t nBytes = 0;
 
-        // Go through the internal cluster array and calculate
-        // the bytes needed for each single cluster item
-        for (size_t i = 0; i < vClusterArray.size(); i++)
+        // Go through the items and calculate the bytes
+        // needed for each single item
+        for (size_t i = 0; i < size(); i++)
         {
-            if (vClusterArray[i]->getType() == ClusterItem::ITEMTYPE_DOUBLE)
+            if (getType(i) == ClusterItem::ITEMTYPE_DOUBLE)
                 nBytes += sizeof(mu::value_type);
-            else if (vClusterArray[i]->getType() == ClusterItem::ITEMTYPE_STRING)
-                nBytes += sizeof(char) * (vClusterArray[i]->getParserString().length()-2);
+            else
+                nBytes += sizeof(char) * vStringArray[i].length();
         }
 
         return nBytes;
@@ -386,21 +547,18 @@ namespace NumeRe
 
     /////////////////////////////////////////////////
     /// \brief This member function clears the
-    /// internal memory buffer and frees the
-    /// associated memory.
+    /// cluster and frees the associated memory.
     ///
     /// \return void
     ///
     /////////////////////////////////////////////////
     void Cluster::clear()
     {
-        for (size_t i = 0; i < vClusterArray.size(); i++)
-        {
-            delete vClusterArray[i];
-        }
-
-        vClusterArray.clear();
-        nGlobalType = ClusterItem::ITEMTYPE_INVALID;
+        freeArray(vDoubleArray);
+        freeArray(vStringArray);
+        freeArray(vTypeArray);
+        nStringItems = 0;
+        nStorageType = ClusterItem::ITEMTYPE_INVALID;
     }
 
 
@@ -413,30 +571,7 @@ namespace NumeRe
     /////////////////////////////////////////////////
     bool Cluster::isMixed() const
     {
-        // Only do something, if the array has a length
-        if (vClusterArray.size())
-        {
-            if (nGlobalType != ClusterItem::ITEMTYPE_INVALID)
-                return nGlobalType == ClusterItem::ITEMTYPE_MIXED;
-
-            // Store the first type
-            int nFirstType = vClusterArray[0]->getType();
-
-            for (size_t i = 1; i < vClusterArray.size(); i++)
-            {
-                // Is there any item with a different type?
-                if (vClusterArray[i]->getType() != nFirstType)
-                {
-                    nGlobalType = ClusterItem::ITEMTYPE_MIXED;
-                    return true;
-                }
-            }
-
-            nGlobalType = nFirstType;
-            return false;
-        }
-
-        return false;
+        return nStorageType == ClusterItem::ITEMTYPE_MIXED;
     }
 
 
@@ -450,29 +585,7 @@ namespace NumeRe
     /////////////////////////////////////////////////
     bool Cluster::isDouble() const
     {
-        // Only do something, if the array has a length
-        if (vClusterArray.size())
-        {
-            if (nGlobalType != ClusterItem::ITEMTYPE_INVALID)
-                return nGlobalType == ClusterItem::ITEMTYPE_DOUBLE;
-
-            for (size_t i = 0; i < vClusterArray.size(); i++)
-            {
-                // Is there any item, which is NOT a double?
-                if (vClusterArray[i]->getType() != ClusterItem::ITEMTYPE_DOUBLE)
-                {
-                    if (i)
-                        nGlobalType = ClusterItem::ITEMTYPE_MIXED;
-
-                    return false;
-                }
-            }
-
-            nGlobalType = ClusterItem::ITEMTYPE_DOUBLE;
-            return true;
-        }
-
-        return false;
+        return nStorageType == ClusterItem::ITEMTYPE_DOUBLE;
     }
 
 
@@ -486,64 +599,7 @@ namespace NumeRe
     /////////////////////////////////////////////////
     bool Cluster::isString() const
     {
-        // Only do something, if the array has a length
-        if (vClusterArray.size())
-        {
-            if (nGlobalType != ClusterItem::ITEMTYPE_INVALID)
-                return nGlobalType == ClusterItem::ITEMTYPE_STRING;
-
-            for (size_t i = 0; i < vClusterArray.size(); i++)
-            {
-                // Is there any item, which is NOT a string?
-                if (vClusterArray[i]->getType() != ClusterItem::ITEMTYPE_STRING)
-                {
-                    if (i)
-                        nGlobalType = ClusterItem::ITEMTYPE_MIXED;
-
-                    return false;
-                }
-            }
-
-            nGlobalType = ClusterItem::ITEMTYPE_STRING;
-            return true;
-        }
-
-        return false;
-    }
-
-
-    /////////////////////////////////////////////////
-    /// \brief This member function returns the type
-    /// of the i-th cluster item in the internal
-    /// memory buffer.
-    ///
-    /// \param i size_t
-    /// \return unsigned short
-    ///
-    /////////////////////////////////////////////////
-    unsigned short Cluster::getType(size_t i) const
-    {
-        if (vClusterArray.size() > i)
-            return vClusterArray[i]->getType();
-
-        return ClusterItem::ITEMTYPE_INVALID;
-    }
-
-
-    /////////////////////////////////////////////////
-    /// \brief This member function returns the data
-    /// of the i-th cluster item in memory as a value.
-    ///
-    /// \param i size_t
-    /// \return mu::value_type
-    ///
-    /////////////////////////////////////////////////
-    mu::value_type Cluster::getDouble(size_t i) const
-    {
-        if (vClusterArray.size() > i)
-            return vClusterArray[i]->getDouble();
-
-        return NAN;
+        return nStorageType == ClusterItem::ITEMTYPE_STRING;
     }
 
 
@@ -561,20 +617,23 @@ namespace NumeRe
     void Cluster::setDouble(size_t i, const mu::value_type& value)
     {
         // Create new items if needed
-        while (vClusterArray.size() <= i)
-            push_back(new ClusterDoubleItem(NAN));
+        expandStorage(i+1, ClusterItem::ITEMTYPE_DOUBLE);
 
-        // Assign the data
-        if (vClusterArray[i]->getType() != ClusterItem::ITEMTYPE_DOUBLE)
+        if (getType(i) == ClusterItem::ITEMTYPE_DOUBLE)
         {
-            // Re-create the item as double item
-            delete vClusterArray[i];
-            vClusterArray[i] = new ClusterDoubleItem(value);
+            vDoubleArray[i] = value;
+            return;
         }
-        else
-            vClusterArray[i]->setDouble(value);
 
-        nGlobalType = ClusterItem::ITEMTYPE_INVALID;
+        // Change the type of the item
+        toMixedStorage();
+
+        vTypeArray[i] = ClusterItem::ITEMTYPE_DOUBLE;
+        vDoubleArray[i] = value;
+        vStringArray[i].clear();
+        nStringItems--;
+
+        compactStorage();
     }
 
 
@@ -587,11 +646,14 @@ namespace NumeRe
     /////////////////////////////////////////////////
     std::vector<mu::value_type> Cluster::getDoubleArray() const
     {
-        std::vector<mu::value_type> vArray;
+        if (nStorageType == ClusterItem::ITEMTYPE_DOUBLE)
+            return vDoubleArray;
+
+        std::vector<mu::value_type> vArray(size());
 
-        for (size_t i = 0; i < vClusterArray.size(); i++)
+        for (size_t i = 0; i < vArray.size(); i++)
         {
-            vArray.push_back(vClusterArray[i]->getDouble());
+            vArray[i] = getDouble(i);
         }
 
         return vArray;
@@ -614,22 +676,39 @@ namespace NumeRe
         if (vTarget == nullptr)
             return;
 
+        size_t nSize = size();
+
         // Try to resize the array as copy-efficient as
         // possible
-        if (_vLine.size() > 1 && !vClusterArray.size())
+        if (_vLine.size() > 1 && !nSize)
             vTarget->resize(1, NAN);
         else
         {
             vTarget->resize(_vLine.size(), NAN);
+            mu::value_type* target = vTarget->data();
+
+            // Copy the values directly from the typed
+            // array, if possible
+            if (nStorageType == ClusterItem::ITEMTYPE_DOUBLE)
+            {
+                const mu::value_type* source = vDoubleArray.data();
+
+                for (size_t i = 0; i < _vLine.size(); i++)
+                {
+                    int nLine = _vLine[i];
+                    target[i] = nLine >= 0 && nLine < (int)nSize ? source[nLine] : NAN;
+                }
+
+                return;
+            }
 
             // Insert the elements in the passed array
-            for (unsigned int i = 0; i < _vLine.size(); i++)
+            for (size_t i = 0; i < _vLine.size(); i++)
             {
-                if (_vLine[i] >= (int)vClusterArray.size() || _vLine[i] < 0)
-                    (*vTarget)[i] = NAN;
+                if (_vLine[i] >= (int)nSize || _vLine[i] < 0)
+                    target[i] = NAN;
                 else
-                    (*vTarget)[i] = vClusterArray[_vLine[i]]->getDouble();
-
+                    target[i] = getDouble(_vLine[i]);
             }
         }
     }
@@ -638,8 +717,7 @@ namespace NumeRe
     /////////////////////////////////////////////////
     /// \brief This member function assigns values as
     /// data for the all cluster items in memory. The
-    /// type of the cluster items is adapted
-    /// on-the-fly.
+    /// cluster will only contain values afterwards.
     ///
     /// \param vVals const std::vector<mu::value_type>&
     /// \return void
@@ -647,33 +725,14 @@ namespace NumeRe
     /////////////////////////////////////////////////
     void Cluster::setDoubleArray(const std::vector<mu::value_type>& vVals)
     {
-        // Create new cluster items, if needed
-        while (vClusterArray.size() < vVals.size())
-            push_back(new ClusterDoubleItem(NAN));
-
-        for (size_t i = 0; i < vVals.size(); i++)
-        {
-            // Assign the value
-            if (vClusterArray[i]->getType() != ClusterItem::ITEMTYPE_DOUBLE)
-            {
-                // Re-create the current item as double
-                delete vClusterArray[i];
-                vClusterArray[i] = new ClusterDoubleItem(vVals[i]);
-            }
-            else
-                static_cast<ClusterDoubleItem*>(vClusterArray[i])->setDouble(vVals[i]);
-        }
-
-        reduceSize(vVals.size());
-        nGlobalType = ClusterItem::ITEMTYPE_DOUBLE;
+        setDoubleArray(vVals.size(), const_cast<mu::value_type*>(vVals.data()));
     }
 
 
     /////////////////////////////////////////////////
     /// \brief This member function assigns values as
     /// data for the all cluster items in memory. The
-    /// type of the cluster items is adapted
-    /// on-the-fly.
+    /// cluster will only contain values afterwards.
     ///
     /// \param nNum int
     /// \param data mu::value_type*
@@ -682,25 +741,14 @@ namespace NumeRe
     /////////////////////////////////////////////////
     void Cluster::setDoubleArray(int nNum, mu::value_type* data)
     {
-        // Create new cluster items, if needed
-        while (vClusterArray.size() < (size_t)nNum)
-            push_back(new ClusterDoubleItem(NAN));
+        freeArray(vStringArray);
+        freeArray(vTypeArray);
+        nStringItems = 0;
 
-        for (int i = 0; i < nNum; i++)
-        {
-            // Assign the value
-            if (vClusterArray[i]->getType() != ClusterItem::ITEMTYPE_DOUBLE)
-            {
-                // Re-create the current item as double
-                delete vClusterArray[i];
-                vClusterArray[i] = new ClusterDoubleItem(data[i]);
-            }
-            else
-                static_cast<ClusterDoubleItem*>(vClusterArray[i])->setDouble(data[i]);
-        }
+        vDoubleArray.assign(data, data+std::max(nNum, 0));
+        nStorageType = ClusterItem::ITEMTYPE_DOUBLE;
 
-        reduceSize(nNum);
-        nGlobalType = ClusterItem::ITEMTYPE_DOUBLE;
+        compactStorage();
     }
 
 
@@ -744,8 +792,12 @@ namespace NumeRe
     /////////////////////////////////////////////////
     std::string Cluster::getString(size_t i) const
     {
-        if (vClusterArray.size() > i)
-            return vClusterArray[i]->getString();
+        unsigned short nType = getType(i);
+
+        if (nType == ClusterItem::ITEMTYPE_DOUBLE)
+            return valueToString(vDoubleArray[i]);
+        else if (nType == ClusterItem::ITEMTYPE_STRING)
+            return toExternalString(vStringArray[i]);
 
         return "\"\"";
     }
@@ -762,8 +814,12 @@ namespace NumeRe
     /////////////////////////////////////////////////
     std::string Cluster::getInternalString(size_t i) const
     {
-        if (vClusterArray.size() > i)
-            return vClusterArray[i]->getInternalString();
+        unsigned short nType = getType(i);
+
+        if (nType == ClusterItem::ITEMTYPE_DOUBLE)
+            return valueToString(vDoubleArray[i]);
+        else if (nType == ClusterItem::ITEMTYPE_STRING)
+            return vStringArray[i];
 
         return "";
     }
@@ -780,8 +836,12 @@ namespace NumeRe
     /////////////////////////////////////////////////
     std::string Cluster::getParserString(size_t i) const
     {
-        if (vClusterArray.size() > i)
-            return vClusterArray[i]->getParserString();
+        unsigned short nType = getType(i);
+
+        if (nType == ClusterItem::ITEMTYPE_DOUBLE)
+            return valueToString(vDoubleArray[i]);
+        else if (nType == ClusterItem::ITEMTYPE_STRING)
+            return "\"" + vStringArray[i] + "\"";
 
         return "\"\"";
     }
@@ -800,21 +860,24 @@ namespace NumeRe
     /////////////////////////////////////////////////
     void Cluster::setString(size_t i, const std::string& strval)
     {
-        // Create new cluster items, if needed
-        while (vClusterArray.size() <= i)
-            push_back(new ClusterStringItem(""));
+        // Create new items if needed
+        expandStorage(i+1, ClusterItem::ITEMTYPE_STRING);
 
-        // Assign the value
-        if (vClusterArray[i]->getType() != ClusterItem::ITEMTYPE_STRING)
+        if (getType(i) == ClusterItem::ITEMTYPE_STRING)
         {
-            // Re-create the current item as a string
-            delete vClusterArray[i];
-            vClusterArray[i] = new ClusterStringItem(strval);
+            vStringArray[i] = strval;
+            return;
         }
-        else
-            vClusterArray[i]->setString(strval);
 
-        nGlobalType = ClusterItem::ITEMTYPE_INVALID;
+        // Change the type of the item
+        toMixedStorage();
+
+        vTypeArray[i] = ClusterItem::ITEMTYPE_STRING;
+        vDoubleArray[i] = NAN;
+        vStringArray[i] = strval;
+        nStringItems++;
+
+        compactStorage();
     }
 
 
@@ -827,11 +890,11 @@ namespace NumeRe
     /////////////////////////////////////////////////
     std::vector<std::string> Cluster::getStringArray() const
     {
-        std::vector<std::string> vArray;
+        std::vector<std::string> vArray(size());
 
-        for (size_t i = 0; i < vClusterArray.size(); i++)
+        for (size_t i = 0; i < vArray.size(); i++)
         {
-            vArray.push_back(vClusterArray[i]->getParserString());
+            vArray[i] = getParserString(i);
         }
 
         return vArray;
@@ -847,11 +910,14 @@ namespace NumeRe
     /////////////////////////////////////////////////
     std::vector<std::string> Cluster::getInternalStringArray() const
     {
-        std::vector<std::string> vArray;
+        if (nStorageType == ClusterItem::ITEMTYPE_STRING)
+            return vStringArray;
+
+        std::vector<std::string> vArray(size());
 
-        for (size_t i = 0; i < vClusterArray.size(); i++)
+        for (size_t i = 0; i < vArray.size(); i++)
         {
-            vArray.push_back(vClusterArray[i]->getInternalString());
+            vArray[i] = getInternalString(i);
         }
 
         return vArray;
@@ -859,10 +925,10 @@ namespace NumeRe
 
 
     /////////////////////////////////////////////////
-    /// \brief This member function assigns values as
-    /// data for the all cluster items in memory. The
-    /// type of the cluster items is adapted
-    /// on-the-fly.
+    /// \brief This member function assigns strings
+    /// as data for the all cluster items in memory.
+    /// The cluster will only contain strings
+    /// afterwards.
     ///
     /// \param sVals const std::vector<std::string>&
     /// \return void
@@ -870,25 +936,14 @@ namespace NumeRe
     /////////////////////////////////////////////////
     void Cluster::setStringArray(const std::vector<std::string>& sVals)
     {
-        // Create new cluster items, if needed
-        while (vClusterArray.size() < sVals.size())
-            push_back(new ClusterStringItem(""));
+        freeArray(vDoubleArray);
+        freeArray(vTypeArray);
 
-        for (size_t i = 0; i < sVals.size(); i++)
-        {
-            // Assign the value
-            if (vClusterArray[i]->getType() != ClusterItem::ITEMTYPE_STRING)
-            {
-                // Re-create the current item as a string
-                delete vClusterArray[i];
-                vClusterArray[i] = new ClusterStringItem(sVals[i]);
-            }
-            else
-                vClusterArray[i]->setString(sVals[i]);
-        }
+        vStringArray = sVals;
+        nStringItems = 0;
+        nStorageType = ClusterItem::ITEMTYPE_STRING;
 
-        reduceSize(sVals.size());
-        nGlobalType = ClusterItem::ITEMTYPE_STRING;
+        compactStorage();
     }
 
 
@@ -902,15 +957,15 @@ namespace NumeRe
     /////////////////////////////////////////////////
     std::vector<std::string> Cluster::to_string() const
     {
-        std::vector<std::string> vString(vClusterArray.size());
+        std::vector<std::string> vString(size());
 
         // Append the contained data depending on its type
-        for (size_t i = 0; i < vClusterArray.size(); i++)
+        for (size_t i = 0; i < vString.size(); i++)
         {
-            if (vClusterArray[i]->getType() == ClusterItem::ITEMTYPE_DOUBLE)
-                vString[i] = toCmdString(vClusterArray[i]->getDouble());
+            if (getType(i) == ClusterItem::ITEMTYPE_DOUBLE)
+                vString[i] = toCmdString(vDoubleArray[i]);
             else
-                vString[i] = vClusterArray[i]->getParserString();
+                vString[i] = getParserString(i);
         }
 
         return vString;
@@ -929,15 +984,15 @@ namespace NumeRe
     std::string Cluster::serialize() const
     {
         // Return nan, if no data is available
-        if (!vClusterArray.size())
+        if (!size())
             return "nan";
 
         std::string sSerialization;
 
         // Append the contained data depending on its type
-        for (size_t i = 0; i < vClusterArray.size(); i++)
+        for (size_t i = 0; i < size(); i++)
         {
-            sSerialization += vClusterArray[i]->getString() + ",";
+            sSerialization += getString(i) + ",";
         }
 
         // Replace the last comma with a closing brace
@@ -959,7 +1014,7 @@ namespace NumeRe
     std::string Cluster::getVectorRepresentation() const
     {
         // Return nan, if no data is available
-        if (!vClusterArray.size())
+        if (!size())
             return "nan";
 
         std::string sVector = "{";
@@ -993,7 +1048,7 @@ namespace NumeRe
     {
         // Return an empty brace pair, if no data is
         // available
-        if (!vClusterArray.size())
+        if (!size())
             return "{}";
 
         std::string sVector = "{";
@@ -1001,20 +1056,20 @@ namespace NumeRe
         // Append the contained data depending on its type but
         // restrict the number to maximal five values (use the first
         // and the last ones) and insert an ellipsis in the middle
-        for (size_t i = 0; i < vClusterArray.size(); i++)
+        for (size_t i = 0; i < size(); i++)
         {
-            if (vClusterArray[i]->getType() == ClusterItem::ITEMTYPE_DOUBLE)
-                sVector += toString(vClusterArray[i]->getDouble(), 5) + ", ";
+            if (getType(i) == ClusterItem::ITEMTYPE_DOUBLE)
+                sVector += toString(vDoubleArray[i], 5) + ", ";
             else if (maxStringLength < std::string::npos)
-                sVector += ellipsize(vClusterArray[i]->getString(), maxStringLength/4) + ", ";
+                sVector += ellipsize(getString(i), maxStringLength/4) + ", ";
             else
-                sVector += vClusterArray[i]->getString() + ", ";
+                sVector += getString(i) + ", ";
 
             // Insert the ellipsis in the middle
-            if (i == 1 && vClusterArray.size() > 5)
+            if (i == 1 && size() > 5)
             {
                 sVector += "..., ";
-                i = vClusterArray.size()-3;
+                i = size()-3;
             }
         }
 
@@ -1038,7 +1093,7 @@ namespace NumeRe
     /////////////////////////////////////////////////
     std::vector<int> Cluster::sortElements(long long int i1, long long int i2, const std::string& sSortingExpression)
     {
-        if (!vClusterArray.size())
+        if (!size())
             return std::vector<int>();
 
         bool bReturnIndex = false;
@@ -1101,37 +1156,24 @@ namespace NumeRe
     /////////////////////////////////////////////////
     void Cluster::deleteItems(long long int i1, long long int i2)
     {
-        if (i2 >= vClusterArray.size())
-            i2 = vClusterArray.size()-1;
+        if (i2 >= (long long int)size())
+            i2 = size()-1;
 
         // If everything shall be erased, use the
         // "clear()" function
-        if (!i1 && i2+1 == vClusterArray.size())
+        if (!i1 && i2+1 == (long long int)size())
         {
             clear();
             return;
         }
 
-        // Delete the cluster items first and
-        // set the pointer to a nullpointer
-        for (long long int i = i1; i < i2; i++)
-        {
-            delete vClusterArray[i];
-            vClusterArray[i] = nullptr;
-        }
+        // Mark the items to be deleted
+        std::vector<bool> vDelete(size(), false);
 
-        auto iter = vClusterArray.begin();
+        for (long long int i = std::max(i1, 0LL); i < i2; i++)
+            vDelete[i] = true;
 
-        // Remove all nullpointers from the array
-        while (iter != vClusterArray.end())
-        {
-            if (!(*iter))
-                iter = vClusterArray.erase(iter);
-            else
-                ++iter;
-        }
-
-        nGlobalType = ClusterItem::ITEMTYPE_INVALID;
+        eraseItems(vDelete);
     }
 
 
@@ -1145,31 +1187,18 @@ namespace NumeRe
     /////////////////////////////////////////////////
     void Cluster::deleteItems(const VectorIndex& vLines)
     {
-        // Delete the cluster items first and
-        // set the pointer to a nullpointer
+        // Mark the items to be deleted
+        std::vector<bool> vDelete(size(), false);
+
         for (size_t i = 0; i < vLines.size(); i++)
         {
-            if (vLines[i] < 0 || vLines[i] >= (int)vClusterArray.size())
+            if (vLines[i] < 0 || vLines[i] >= (int)size())
                 continue;
 
-            if (vClusterArray[vLines[i]])
-                delete vClusterArray[vLines[i]];
-
-            vClusterArray[vLines[i]] = nullptr;
+            vDelete[vLines[i]] = true;
         }
 
-        auto iter = vClusterArray.begin();
-
-        // Remove all nullpointers from the array
-        while (iter != vClusterArray.end())
-        {
-            if (!(*iter))
-                iter = vClusterArray.erase(iter);
-            else
-                ++iter;
-        }
-
-        nGlobalType = ClusterItem::ITEMTYPE_INVALID;
+        eraseItems(vDelete);
     }
 
 
@@ -1189,7 +1218,7 @@ namespace NumeRe
     /////////////////////////////////////////////////
     mu::value_type Cluster::std(const VectorIndex& _vLine)
     {
-        if (!vClusterArray.size())
+        if (!size())
             return NAN;
 
         // Calculate the average of the referenced items
@@ -1200,12 +1229,12 @@ namespace NumeRe
         // Apply the operation and ignore invalid or non-double items
         for (unsigned int i = 0; i < _vLine.size(); i++)
         {
-            if (_vLine[i] < 0 || _vLine[i] >= (int)vClusterArray.size())
+            if (_vLine[i] < 0 || _vLine[i] >= (int)size())
                 nInvalid++;
-            else if (vClusterArray[_vLine[i]]->getType() != ClusterItem::ITEMTYPE_DOUBLE || std::isnan(std::abs(vClusterArray[_vLine[i]]->getDouble())))
+            else if (getType(_vLine[i]) != ClusterItem::ITEMTYPE_DOUBLE || std::isnan(std::abs(getDouble(_vLine[i]))))
                 nInvalid++;
             else
-                dStd += (dAvg - vClusterArray[_vLine[i]]->getDouble()) * conj(dAvg - vClusterArray[_vLine[i]]->getDouble());
+                dStd += (dAvg - getDouble(_vLine[i])) * conj(dAvg - getDouble(_vLine[i]));
         }
 
         if (nInvalid >= _vLine.size() - 1)
@@ -1227,7 +1256,7 @@ namespace NumeRe
     /////////////////////////////////////////////////
     mu::value_type Cluster::avg(const VectorIndex& _vLine)
     {
-        if (!vClusterArray.size())
+        if (!size())
             return NAN;
 
         mu::value_type dAvg = 0.0;
@@ -1236,12 +1265,12 @@ namespace NumeRe
         // Apply the operation and ignore invalid or non-double items
         for (unsigned int i = 0; i < _vLine.size(); i++)
         {
-            if (_vLine[i] < 0 || _vLine[i] >= (int)vClusterArray.size())
+            if (_vLine[i] < 0 || _vLine[i] >= (int)size())
                 nInvalid++;
-            else if (vClusterArray[_vLine[i]]->getType() != ClusterItem::ITEMTYPE_DOUBLE || std::isnan(std::abs(vClusterArray[_vLine[i]]->getDouble())))
+            else if (getType(_vLine[i]) != ClusterItem::ITEMTYPE_DOUBLE || std::isnan(std::abs(getDouble(_vLine[i]))))
                 nInvalid++;
             else
-                dAvg += vClusterArray[_vLine[i]]->getDouble();
+                dAvg += getDouble(_vLine[i]);
         }
 
         if (nInvalid >= _vLine.size())
@@ -1263,7 +1292,7 @@ namespace NumeRe
     /////////////////////////////////////////////////
     mu::value_type Cluster::max(const VectorIndex& _vLine)
     {
-        if (!vClusterArray.size() || isString())
+        if (!size() || isString())
             return NAN;
 
         double dMax = NAN;
@@ -1271,17 +1300,17 @@ namespace NumeRe
         // Apply the operation and ignore invalid or non-double items
         for (unsigned int i = 0; i < _vLine.size(); i++)
         {
-            if (_vLine[i] < 0 || _vLine[i] >= (int)vClusterArray.size())
+            if (_vLine[i] < 0 || _vLine[i] >= (int)size())
                 continue;
 
-            if (vClusterArray[_vLine[i]]->getType() != ClusterItem::ITEMTYPE_DOUBLE || std::isnan(vClusterArray[_vLine[i]]->getDouble().real()))
+            if (getType(_vLine[i]) != ClusterItem::ITEMTYPE_DOUBLE || std::isnan(getDouble(_vLine[i]).real()))
                 continue;
 
             if (std::isnan(dMax))
-                dMax = vClusterArray[_vLine[i]]->getDouble().real();
+                dMax = getDouble(_vLine[i]).real();
 
-            if (dMax < vClusterArray[_vLine[i]]->getDouble().real())
-                dMax = vClusterArray[_vLine[i]]->getDouble().real();
+            if (dMax < getDouble(_vLine[i]).real())
+                dMax = getDouble(_vLine[i]).real();
         }
 
         return dMax;
@@ -1300,7 +1329,7 @@ namespace NumeRe
     /////////////////////////////////////////////////
     std::string Cluster::strmax(const VectorIndex& _vLine)
     {
-        if (!vClusterArray.size() || isDouble())
+        if (!size() || isDouble())
             return "";
 
         std::string sMax = "";
@@ -1309,14 +1338,14 @@ namespace NumeRe
         // their values on-the-fly
         for (unsigned int i = 0; i < _vLine.size(); i++)
         {
-            if (_vLine[i] < 0 || _vLine[i] >= (int)vClusterArray.size())
+            if (_vLine[i] < 0 || _vLine[i] >= (int)size())
                 continue;
 
             if (!sMax.length())
-                sMax = vClusterArray[_vLine[i]]->getParserString();
+                sMax = getParserString(_vLine[i]);
 
-            if (sMax < vClusterArray[_vLine[i]]->getParserString())
-                sMax = vClusterArray[_vLine[i]]->getParserString();
+            if (sMax < getParserString(_vLine[i]))
+                sMax = getParserString(_vLine[i]);
         }
 
         return sMax;
@@ -1335,7 +1364,7 @@ namespace NumeRe
     /////////////////////////////////////////////////
     mu::value_type Cluster::min(const VectorIndex& _vLine)
     {
-        if (!vClusterArray.size() || isString())
+        if (!size() || isString())
             return NAN;
 
         double dMin = NAN;
@@ -1343,17 +1372,17 @@ namespace NumeRe
         // Apply the operation and ignore invalid or non-double items
         for (unsigned int i = 0; i < _vLine.size(); i++)
         {
-            if (_vLine[i] < 0 || _vLine[i] >= (int)vClusterArray.size())
+            if (_vLine[i] < 0 || _vLine[i] >= (int)size())
                 continue;
 
-            if (vClusterArray[_vLine[i]]->getType() != ClusterItem::ITEMTYPE_DOUBLE || std::isnan(vClusterArray[_vLine[i]]->getDouble().real()))
+            if (getType(_vLine[i]) != ClusterItem::ITEMTYPE_DOUBLE || std::isnan(getDouble(_vLine[i]).real()))
                 continue;
 
             if (std::isnan(dMin))
-                dMin = vClusterArray[_vLine[i]]->getDouble().real();
+                dMin = getDouble(_vLine[i]).real();
 
-            if (dMin > vClusterArray[_vLine[i]]->getDouble().real())
-                dMin = vClusterArray[_vLine[i]]->getDouble().real();
+            if (dMin > getDouble(_vLine[i]).real())
+                dMin = getDouble(_vLine[i]).real();
         }
 
         return dMin;
@@ -1372,7 +1401,7 @@ namespace NumeRe
     /////////////////////////////////////////////////
     std::string Cluster::strmin(const VectorIndex& _vLine)
     {
-        if (!vClusterArray.size() || isDouble())
+        if (!size() || isDouble())
             return "";
 
         std::string sMin = "";
@@ -1381,14 +1410,14 @@ namespace NumeRe
         // their values on-the-fly
         for (unsigned int i = 0; i < _vLine.size(); i++)
         {
-            if (_vLine[i] < 0 || _vLine[i] >= (int)vClusterArray.size())
+            if (_vLine[i] < 0 || _vLine[i] >= (int)size())
                 continue;
 
             if (!sMin.length())
-                sMin = vClusterArray[_vLine[i]]->getParserString();
+                sMin = getParserString(_vLine[i]);
 
-            if (sMin > vClusterArray[_vLine[i]]->getParserString())
-                sMin = vClusterArray[_vLine[i]]->getParserString();
+            if (sMin > getParserString(_vLine[i]))
+                sMin = getParserString(_vLine[i]);
         }
 
         return sMin;
@@ -1407,7 +1436,7 @@ namespace NumeRe
     /////////////////////////////////////////////////
     mu::value_type Cluster::prd(const VectorIndex& _vLine)
     {
-        if (!vClusterArray.size())
+        if (!size())
             return NAN;
 
         mu::value_type dPrd = 1.0;
@@ -1415,13 +1444,13 @@ namespace NumeRe
         // Apply the operation and ignore invalid or non-double items
         for (unsigned int i = 0; i < _vLine.size(); i++)
         {
-            if (_vLine[i] < 0 || _vLine[i] >= (int)vClusterArray.size())
+            if (_vLine[i] < 0 || _vLine[i] >= (int)size())
                 continue;
 
-            if (std::isnan(std::abs(vClusterArray[_vLine[i]]->getDouble())))
+            if (std::isnan(std::abs(getDouble(_vLine[i]))))
                 continue;
 
-            dPrd *= vClusterArray[_vLine[i]]->getDouble();
+            dPrd *= getDouble(_vLine[i]);
         }
 
         return dPrd;
@@ -1440,7 +1469,7 @@ namespace NumeRe
     /////////////////////////////////////////////////
     mu::value_type Cluster::sum(const VectorIndex& _vLine)
     {
-        if (!vClusterArray.size() && isString())
+        if (!size() && isString())
             return NAN;
 
         mu::value_type dSum = 0.0;
@@ -1448,13 +1477,13 @@ namespace NumeRe
         // Apply the operation and ignore invalid or non-double items
         for (unsigned int i = 0; i < _vLine.size(); i++)
         {
-            if (_vLine[i] < 0 || _vLine[i] >= (int)vClusterArray.size())
+            if (_vLine[i] < 0 || _vLine[i] >= (int)size())
                 continue;
 
-            if (vClusterArray[_vLine[i]]->getType() != ClusterItem::ITEMTYPE_DOUBLE || std::isnan(std::abs(vClusterArray[_vLine[i]]->getDouble())))
+            if (getType(_vLine[i]) != ClusterItem::ITEMTYPE_DOUBLE || std::isnan(std::abs(getDouble(_vLine[i]))))
                 continue;
 
-            dSum += vClusterArray[_vLine[i]]->getDouble();
+            dSum += getDouble(_vLine[i]);
         }
 
         return dSum;
@@ -1473,7 +1502,7 @@ namespace NumeRe
     /////////////////////////////////////////////////
     std::string Cluster::strsum(const VectorIndex& _vLine)
     {
-        if (!vClusterArray.size() || isDouble())
+        if (!size() || isDouble())
             return "";
 
         std::string sSum = "";
@@ -1482,10 +1511,10 @@ namespace NumeRe
         // their values on-the-fly
         for (unsigned int i = 0; i < _vLine.size(); i++)
         {
-            if (_vLine[i] < 0 || _vLine[i] >= (int)vClusterArray.size())
+            if (_vLine[i] < 0 || _vLine[i] >= (int)size())
                 continue;
 
-            sSum += vClusterArray[_vLine[i]]->getParserString();
+            sSum += getParserString(_vLine[i]);
         }
 
         return sSum;
@@ -1504,7 +1533,7 @@ namespace NumeRe
     /////////////////////////////////////////////////
     mu::value_type Cluster::num(const VectorIndex& _vLine)
     {
-        if (!vClusterArray.size())
+        if (!size())
             return 0;
 
         int nInvalid = 0;
@@ -1512,11 +1541,11 @@ namespace NumeRe
         // Apply the operation and ignore invalid values
         for (unsigned int i = 0; i < _vLine.size(); i++)
         {
-            if (_vLine[i] < 0 || _vLine[i] >= (int)vClusterArray.size())
+            if (_vLine[i] < 0 || _vLine[i] >= (int)size())
                 nInvalid++;
-            else if (vClusterArray[_vLine[i]]->getType() == ClusterItem::ITEMTYPE_DOUBLE && std::isnan(vClusterArray[_vLine[i]]->getDouble().real()))
+            else if (getType(_vLine[i]) == ClusterItem::ITEMTYPE_DOUBLE && std::isnan(getDouble(_vLine[i]).real()))
                 nInvalid++;
-            else if (vClusterArray[_vLine[i]]->getType() == ClusterItem::ITEMTYPE_STRING && vClusterArray[_vLine[i]]->getParserString() == "\"\"")
+            else if (getType(_vLine[i]) == ClusterItem::ITEMTYPE_STRING && getParserString(_vLine[i]) == "\"\"")
                 nInvalid++;
         }
 
@@ -1535,7 +1564,7 @@ namespace NumeRe
     /////////////////////////////////////////////////
     mu::value_type Cluster::and_func(const VectorIndex& _vLine)
     {
-        if (!vClusterArray.size())
+        if (!size())
             return 0.0;
 
         double dRetVal = NAN;
@@ -1543,13 +1572,13 @@ namespace NumeRe
         // Apply the operation and ignore invalid or non-double items
         for (unsigned int i = 0; i < _vLine.size(); i++)
         {
-            if (_vLine[i] < 0 || _vLine[i] >= (int)vClusterArray.size())
+            if (_vLine[i] < 0 || _vLine[i] >= (int)size())
                 continue;
 
             if (std::isnan(dRetVal))
                 dRetVal = 1.0;
 
-            if (vClusterArray[_vLine[i]]->getType() != ClusterItem::ITEMTYPE_DOUBLE || std::isnan(vClusterArray[_vLine[i]]->getDouble().real()) || vClusterArray[_vLine[i]]->getDouble() == 0.0)
+            if (getType(_vLine[i]) != ClusterItem::ITEMTYPE_DOUBLE || std::isnan(getDouble(_vLine[i]).real()) || getDouble(_vLine[i]) == 0.0)
                 return 0.0;
         }
 
@@ -1571,17 +1600,17 @@ namespace NumeRe
     /////////////////////////////////////////////////
     mu::value_type Cluster::or_func(const VectorIndex& _vLine)
     {
-        if (!vClusterArray.size())
+        if (!size())
             return 0.0;
 
         // Apply the operation and ignore invalid or non-double items
         for (unsigned int i = 0; i < _vLine.size(); i++)
         {
-            if (_vLine[i] < 0 || _vLine[i] >= (int)vClusterArray.size())
+            if (_vLine[i] < 0 || _vLine[i] >= (int)size())
                 continue;
 
-            if (vClusterArray[_vLine[i]]->getType() == ClusterItem::ITEMTYPE_DOUBLE
-                && (std::isnan(vClusterArray[_vLine[i]]->getDouble().real()) || vClusterArray[_vLine[i]]->getDouble() != 0.0))
+            if (getType(_vLine[i]) == ClusterItem::ITEMTYPE_DOUBLE
+                && (std::isnan(getDouble(_vLine[i]).real()) || getDouble(_vLine[i]) != 0.0))
                 return 1.0;
         }
 
@@ -1601,7 +1630,7 @@ namespace NumeRe
     /////////////////////////////////////////////////
     mu::value_type Cluster::xor_func(const VectorIndex& _vLine)
     {
-        if (!vClusterArray.size())
+        if (!size())
             return 0.0;
 
         bool isTrue = false;
@@ -1609,11 +1638,11 @@ namespace NumeRe
         // Apply the operation and ignore invalid or non-double items
         for (unsigned int i = 0; i < _vLine.size(); i++)
         {
-            if (_vLine[i] < 0 || _vLine[i] >= (int)vClusterArray.size())
+            if (_vLine[i] < 0 || _vLine[i] >= (int)size())
                 continue;
 
-            if (vClusterArray[_vLine[i]]->getType() == ClusterItem::ITEMTYPE_DOUBLE
-                && (std::isnan(vClusterArray[_vLine[i]]->getDouble().real()) || vClusterArray[_vLine[i]]->getDouble() != 0.0))
+            if (getType(_vLine[i]) == ClusterItem::ITEMTYPE_DOUBLE
+                && (std::isnan(getDouble(_vLine[i]).real()) || getDouble(_vLine[i]) != 0.0))
             {
                 if (!isTrue)
                     isTrue = true;
@@ -1641,7 +1670,7 @@ namespace NumeRe
     /////////////////////////////////////////////////
     mu::value_type Cluster::cnt(const VectorIndex& _vLine)
     {
-        if (!vClusterArray.size())
+        if (!size())
             return 0;
 
         int nInvalid = 0;
@@ -1649,7 +1678,7 @@ namespace NumeRe
         // Apply the operation and ignore invalid locations
         for (unsigned int i = 0; i < _vLine.size(); i++)
         {
-            if (_vLine[i] < 0 || _vLine[i] >= (int)vClusterArray.size())
+            if (_vLine[i] < 0 || _vLine[i] >= (int)size())
                 nInvalid++;
         }
         return _vLine.size() - (double)nInvalid;
@@ -1668,7 +1697,7 @@ namespace NumeRe
     /////////////////////////////////////////////////
     mu::value_type Cluster::norm(const VectorIndex& _vLine)
     {
-        if (!vClusterArray.size())
+        if (!size())
             return NAN;
 
         mu::value_type dNorm = 0.0;
@@ -1676,13 +1705,13 @@ namespace NumeRe
         // Apply the operation and ignore invalid or non-double items
         for (unsigned int i = 0; i < _vLine.size(); i++)
         {
-            if (_vLine[i] < 0 || _vLine[i] >= (int)vClusterArray.size())
+            if (_vLine[i] < 0 || _vLine[i] >= (int)size())
                 continue;
 
-            if (vClusterArray[_vLine[i]]->getType() != ClusterItem::ITEMTYPE_DOUBLE || std::isnan(std::abs(vClusterArray[_vLine[i]]->getDouble())))
+            if (getType(_vLine[i]) != ClusterItem::ITEMTYPE_DOUBLE || std::isnan(std::abs(getDouble(_vLine[i]))))
                 continue;
 
-            dNorm += vClusterArray[_vLine[i]]->getDouble() * conj(vClusterArray[_vLine[i]]->getDouble());
+            dNorm += getDouble(_vLine[i]) * conj(getDouble(_vLine[i]));
         }
 
         return std::sqrt(dNorm);
@@ -1704,7 +1733,7 @@ namespace NumeRe
     /////////////////////////////////////////////////
     mu::value_type Cluster::cmp(const VectorIndex& _vLine, mu::value_type dRef, int _nType)
     {
-        if (!vClusterArray.size())
+        if (!size())
             return NAN;
 
         enum
@@ -1741,50 +1770,50 @@ namespace NumeRe
         // Apply the operation and ignore invalid or non-double items
         for (long long int i = 0; i < _vLine.size(); i++)
         {
-            if (_vLine[i] < 0 || _vLine[i] >= (int)vClusterArray.size())
+            if (_vLine[i] < 0 || _vLine[i] >= (int)size())
                 continue;
 
-            if (vClusterArray[_vLine[i]]->getType() != ClusterItem::ITEMTYPE_DOUBLE || std::isnan(std::abs(vClusterArray[_vLine[i]]->getDouble())))
+            if (getType(_vLine[i]) != ClusterItem::ITEMTYPE_DOUBLE || std::isnan(std::abs(getDouble(_vLine[i]))))
                 continue;
 
-            if (vClusterArray[_vLine[i]]->getDouble() == dRef)
+            if (getDouble(_vLine[i]) == dRef)
             {
                 if (nType & RETURN_VALUE)
-                    return vClusterArray[_vLine[i]]->getDouble();
+                    return getDouble(_vLine[i]);
 
                 return _vLine[i] + 1;
             }
-            else if (nType & RETURN_GE && vClusterArray[_vLine[i]]->getDouble().real() > dRef.real())
+            else if (nType & RETURN_GE && getDouble(_vLine[i]).real() > dRef.real())
             {
                 if (nType & RETURN_FIRST)
                 {
                     if (nType & RETURN_VALUE)
-                        return vClusterArray[_vLine[i]]->getDouble().real();
+                        return getDouble(_vLine[i]).real();
 
                     return _vLine[i]+1;
                 }
 
-                if (nKeep == -1 || vClusterArray[_vLine[i]]->getDouble().real() < dKeep.real())
+                if (nKeep == -1 || getDouble(_vLine[i]).real() < dKeep.real())
                 {
-                    dKeep = vClusterArray[_vLine[i]]->getDouble().real();
+                    dKeep = getDouble(_vLine[i]).real();
                     nKeep = _vLine[i];
                 }
                 else
                     continue;
             }
-            else if (nType & RETURN_LE && vClusterArray[_vLine[i]]->getDouble().real() < dRef.real())
+            else if (nType & RETURN_LE && getDouble(_vLine[i]).real() < dRef.real())
             {
                 if (nType & RETURN_FIRST)
                 {
                     if (nType & RETURN_VALUE)
-                        return vClusterArray[_vLine[i]]->getDouble().real();
+                        return getDouble(_vLine[i]).real();
 
                     return _vLine[i]+1;
                 }
 
-                if (nKeep == -1 || vClusterArray[_vLine[i]]->getDouble().real() > dKeep.real())
+                if (nKeep == -1 || getDouble(_vLine[i]).real() > dKeep.real())
                 {
-                    dKeep = vClusterArray[_vLine[i]]->getDouble().real();
+                    dKeep = getDouble(_vLine[i]).real();
                     nKeep = _vLine[i];
                 }
                 else
@@ -1802,68 +1831,50 @@ namespace NumeRe
 
 
     /////////////////////////////////////////////////
-    /// \brief This member function calculates the
-    /// median value of the data in memory. Cluster
-    /// items, which do not have the type "value" are
-    /// ignored.
+    /// \brief Static helper function collecting the
+    /// real parts of all finite numerical items at
+    /// the selected positions.
     ///
+    /// \param cluster const Cluster&
     /// \param _vLine const VectorIndex&
-    /// \return mu::value_type
+    /// \return std::vector<double>
     ///
     /////////////////////////////////////////////////
-    mu::value_type Cluster::med(const VectorIndex& _vLine)
+    static std::vector<double> readFiniteValues(const Cluster& cluster, const VectorIndex& _vLine)
     {
-        if (!vClusterArray.size())
-            return NAN;
+        std::vector<double> vData;
+        vData.reserve(std::min(_vLine.size(), cluster.size()));
 
-        double dMed = 0.0;
-        unsigned int nInvalid = 0;
-        unsigned int nCount = 0;
-        double* dData = 0;
-
-        // Calculate the number of valid items
-        for (unsigned int i = 0; i < _vLine.size(); i++)
+        for (size_t i = 0; i < _vLine.size(); i++)
         {
-            if (_vLine[i] < 0 || _vLine[i] >= (int)vClusterArray.size())
-                nInvalid++;
-            else if (vClusterArray[_vLine[i]]->getType() != ClusterItem::ITEMTYPE_DOUBLE || std::isnan(vClusterArray[_vLine[i]]->getDouble().real()))
-                nInvalid++;
-        }
-
-        if (nInvalid >= _vLine.size())
-            return NAN;
-
-        // Create a memory buffer of the corresponding size
-        dData = new double[_vLine.size() - nInvalid];
-
-        // copy the data to the buffer
-        for (unsigned int i = 0; i < _vLine.size(); i++)
-        {
-            if (_vLine[i] < 0 || _vLine[i] >= (int)vClusterArray.size() || vClusterArray[_vLine[i]]->getType() != ClusterItem::ITEMTYPE_DOUBLE || std::isnan(vClusterArray[_vLine[i]]->getDouble().real()))
+            if (_vLine[i] < 0 || _vLine[i] >= (int)cluster.size() || cluster.getType(_vLine[i]) != ClusterItem::ITEMTYPE_DOUBLE)
                 continue;
 
-            dData[nCount] = vClusterArray[_vLine[i]]->getDouble().real();
-            nCount++;
-
-            if (nCount == _vLine.size() - nInvalid)
-                break;
+            mu::value_type val = cluster.getDouble(_vLine[i]);
+            appendFiniteValues(vData, &val, 1);
         }
 
-        // Sort the data
-        nCount = qSortDouble(dData, nCount);
-
-        if (!nCount)
-        {
-            delete[] dData;
-            return NAN;
-        }
+        return vData;
+    }
 
-        // Calculate the median value
-        dMed = gsl_stats_median_from_sorted_data(dData, 1, nCount);
 
-        delete[] dData;
+    /////////////////////////////////////////////////
+    /// \brief This member function calculates the
+    /// median value of the data in memory. Cluster
+    /// items, which do not have the type "value" are
+    /// ignored.
+    ///
+    /// \param _vLine const VectorIndex&
+    /// \return mu::value_type
+    ///
+    /////////////////////////////////////////////////
+    mu::value_type Cluster::med(const VectorIndex& _vLine)
+    {
+        if (!size())
+            return NAN;
 
-        return dMed;
+        std::vector<double> vData = readFiniteValues(*this, _vLine);
+        return selectMedian(vData);
     }
 
 
@@ -1880,59 +1891,14 @@ namespace NumeRe
     /////////////////////////////////////////////////
     mu::value_type Cluster::pct(const VectorIndex& _vLine, mu::value_type dPct)
     {
-        if (!vClusterArray.size())
+        if (!size())
             return NAN;
 
-        unsigned int nInvalid = 0;
-        unsigned int nCount = 0;
-        double* dData = 0;
-
         if (dPct.real() >= 1 || dPct.real() <= 0)
             return NAN;
 
-        // Calculate the number of valid items
-        for (unsigned int i = 0; i < _vLine.size(); i++)
-        {
-            if (_vLine[i] < 0 || _vLine[i] >= (int)vClusterArray.size())
-                nInvalid++;
-            else if (vClusterArray[_vLine[i]]->getType() != ClusterItem::ITEMTYPE_DOUBLE || std::isnan(vClusterArray[_vLine[i]]->getDouble().real()))
-                nInvalid++;
-        }
-
-        if (nInvalid >= _vLine.size())
-            return NAN;
-
-        // Create a memory buffer of the corresponding size
-        dData = new double[_vLine.size() - nInvalid];
-
-        // copy the data to the buffer
-        for (unsigned int i = 0; i < _vLine.size(); i++)
-        {
-            if (_vLine[i] < 0 || _vLine[i] >= (int)vClusterArray.size() || vClusterArray[_vLine[i]]->getType() != ClusterItem::ITEMTYPE_DOUBLE || std::isnan(vClusterArray[_vLine[i]]->getDouble().real()))
-                continue;
-
-            dData[nCount] = vClusterArray[_vLine[i]]->getDouble().real();
-            nCount++;
-
-            if (nCount == _vLine.size() - nInvalid)
-                break;
-        }
-
-        // Sort the data
-        nCount = qSortDouble(dData, nCount);
-
-        if (!nCount)
-        {
-            delete[] dData;
-            return NAN;
-        }
-
-        // Calculate the p-th percentile
-        dPct = gsl_stats_quantile_from_sorted_data(dData, 1, nCount, dPct.real());
-
-        delete[] dData;
-
-        return dPct;
+        std::vector<double> vData = readFiniteValues(*this, _vLine);
+        return selectQuantile(vData, dPct.real());
     }
 
 
@@ -29,304 +29,44 @@
 namespace NumeRe
 {
     /////////////////////////////////////////////////
-    /// \brief This is an abstract cluster item. It
-    /// is used as root class of any cluster items
-    /// and only contains the type of the item and
-    /// virtual functions as interfaces to the child
-    /// classes.
+    /// \brief This structure defines the types of
+    /// the items in a cluster.
     /////////////////////////////////////////////////
-    class ClusterItem
+    struct ClusterItem
     {
-        private:
-            unsigned short nType;
-
-        public:
-            /////////////////////////////////////////////////
-            /// \brief Defines the available types of
-            /// clusters.
-            /////////////////////////////////////////////////
-            enum ClusterItemType
-            {
-                ITEMTYPE_INVALID = -1,
-                ITEMTYPE_MIXED,
-                ITEMTYPE_DOUBLE,
-                ITEMTYPE_STRING
-            };
-
-            ClusterItem(unsigned short type) : nType(type) {}
-            virtual ~ClusterItem() {}
-
-            /////////////////////////////////////////////////
-            /// \brief Returns the ClusterItemType.
-            ///
-            /// \return unsigned short
-            ///
-            /////////////////////////////////////////////////
-            unsigned short getType() const
-            {
-                return nType;
-            }
-
-            /////////////////////////////////////////////////
-            /// \brief Base implementation. Returns always
-            /// NaN.
-            ///
-            /// \return virtual mu::value_type
-            ///
-            /////////////////////////////////////////////////
-            virtual mu::value_type getDouble()
-            {
-                return NAN;
-            }
-
-            /////////////////////////////////////////////////
-            /// \brief Base implementation. Does nothing.
-            ///
-            /// \param val const mu::value_type&
-            /// \return virtual void
-            ///
-            /////////////////////////////////////////////////
-            virtual void setDouble(const mu::value_type& val) {}
-
-            /////////////////////////////////////////////////
-            /// \brief Base implementation. Always returns an
-            /// empty string.
-            ///
-            /// \return virtual std::string
-            ///
-            /////////////////////////////////////////////////
-            virtual std::string getString()
-            {
-                return "\"\"";
-            }
-
-            /////////////////////////////////////////////////
-            /// \brief Base implementation. Returns an empty
-            /// string.
-            ///
-            /// \return virtual std::string
-            ///
-            /////////////////////////////////////////////////
-            virtual std::string getInternalString()
-            {
-                return "";
-            }
-
-            /////////////////////////////////////////////////
-            /// \brief Base implementation. Returns a string
-            /// with quotation marks.
-            ///
-            /// \return virtual std::string
-            ///
-            /////////////////////////////////////////////////
-            virtual std::string getParserString()
-            {
-                return "\"" + getInternalString() + "\"";
-            }
-
-            /////////////////////////////////////////////////
-            /// \brief Base implementation. Does nothing.
-            ///
-            /// \param strval const std::string&
-            /// \return virtual void
-            ///
-            /////////////////////////////////////////////////
-            virtual void setString(const std::string& strval) {}
-    };
-
-
-
-    /////////////////////////////////////////////////
-    /// \brief This is a cluster item, which contains
-    /// a double. It features conversions to and from
-    /// strings on-the-fly.
-    /////////////////////////////////////////////////
-    class ClusterDoubleItem : public ClusterItem
-    {
-        private:
-            mu::value_type dData;
-
-        public:
-            ClusterDoubleItem(const mu::value_type& value) : ClusterItem(ClusterItem::ITEMTYPE_DOUBLE), dData(value) {}
-            virtual ~ClusterDoubleItem() override {}
-
-            /////////////////////////////////////////////////
-            /// \brief Returns the internal value.
-            ///
-            /// \return virtual mu::value_type
-            ///
-            /////////////////////////////////////////////////
-            virtual mu::value_type getDouble() override
-            {
-                return dData;
-            }
-
-            /////////////////////////////////////////////////
-            /// \brief Overwrites the internal value.
-            ///
-            /// \param val const mu::value_type&
-            /// \return virtual void
-            ///
-            /////////////////////////////////////////////////
-            virtual void setDouble(const mu::value_type& val) override
-            {
-                dData = val;
-            }
-
-            /////////////////////////////////////////////////
-            /// \brief Returns the internal value converted
-            /// to a string.
-            ///
-            /// \return virtual std::string
-            ///
-            /////////////////////////////////////////////////
-            virtual std::string getString() override
-            {
-                if (std::isnan(std::abs(dData)))
-                    return "nan";
-
-                return toString(dData, 7);
-            }
-
-            /////////////////////////////////////////////////
-            /// \brief Returns the internal value converted
-            /// to a string.
-            ///
-            /// \return virtual std::string
-            ///
-            /////////////////////////////////////////////////
-            virtual std::string getInternalString() override
-            {
-                if (std::isnan(std::abs(dData)))
-                    return "nan";
-
-                return toString(dData, 7);
-            }
-
-            /////////////////////////////////////////////////
-            /// \brief Returns the internal value converted
-            /// to a string.
-            ///
-            /// \return virtual std::string
-            ///
-            /////////////////////////////////////////////////
-            virtual std::string getParserString() override
-            {
-                return getInternalString();
-            }
-
-            /////////////////////////////////////////////////
-            /// \brief Overwrites the internal value with the
-            /// passed string, which will converted to a
-            /// value first.
-            ///
-            /// \param strval const std::string&
-            /// \return virtual void
-            ///
-            /////////////////////////////////////////////////
-            virtual void setString(const std::string& strval) override
-            {
-                if (isConvertible(strval, CONVTYPE_VALUE))
-                    dData = StrToCmplx(toInternalString(strval));
-                else
-                    dData = NAN;
-            }
-    };
-
-
-    /////////////////////////////////////////////////
-    /// \brief This is a cluster item, which contains
-    /// a string. It features conversions to and from
-    /// doubles on-the-fly.
-    /////////////////////////////////////////////////
-    class ClusterStringItem : public ClusterItem
-    {
-        private:
-            std::string sData;
-
-        public:
-            ClusterStringItem(const std::string& strval) : ClusterItem(ClusterItem::ITEMTYPE_STRING) {setString(strval);}
-            virtual ~ClusterStringItem() override {}
-
-            /////////////////////////////////////////////////
-            /// \brief Returns the internal string converted
-            /// to a value.
-            ///
-            /// \return virtual mu::value_type
-            ///
-            /////////////////////////////////////////////////
-            virtual mu::value_type getDouble() override
-            {
-                if (isConvertible(sData, CONVTYPE_VALUE))
-                    return StrToCmplx(sData);
-
-                return NAN;
-            }
-
-            /////////////////////////////////////////////////
-            /// \brief Overwrites the internal string with
-            /// the passed value, which will be converted to
-            /// a string first.
-            ///
-            /// \param val const mu::value_type&
-            /// \return virtual void
-            ///
-            /////////////////////////////////////////////////
-            virtual void setDouble(const mu::value_type& val) override
-            {
-                sData = toString(val, 7);
-            }
-
-            /////////////////////////////////////////////////
-            /// \brief Returns the internal string.
-            ///
-            /// \return virtual std::string
-            ///
-            /////////////////////////////////////////////////
-            virtual std::string getString() override
-            {
-                return toExternalString(sData);
-            }
-
-            /////////////////////////////////////////////////
-            /// \brief Returns the internal string.
-            ///
-            /// \return virtual std::string
-            ///
-            /////////////////////////////////////////////////
-            virtual std::string getInternalString() override
-            {
-                return sData;
-            }
-
-            /////////////////////////////////////////////////
-            /// \brief Overwrites the internal string.
-            ///
-            /// \param strval const std::string&
-            /// \return virtual void
-            ///
-            /////////////////////////////////////////////////
-            virtual void setString(const std::string& strval) override
-            {
-                sData = strval;
-            }
+        /////////////////////////////////////////////////
+        /// \brief Defines the available types of
+        /// clusters.
+        /////////////////////////////////////////////////
+        enum ClusterItemType
+        {
+            ITEMTYPE_INVALID = -1,
+            ITEMTYPE_MIXED,
+            ITEMTYPE_DOUBLE,
+            ITEMTYPE_STRING
+        };
     };
 
 
     /////////////////////////////////////////////////
     /// \brief This class represents a whole cluster.
-    /// The single items are stored as pointers to
-    /// the abstract cluster item. This object can be
-    /// constructed from many different base items
-    /// and has more or less all memory-like
-    /// functions.
+    /// Clusters containing only values or only
+    /// strings store their items in a contiguous
+    /// typed array. Mixed clusters use both arrays
+    /// in parallel together with an array of type
+    /// tags. This object can be constructed from
+    /// many different base items and has more or
+    /// less all memory-like functions.
     /////////////////////////////////////////////////
     class Cluster : public Sorter
     {
         private:
-            std::vector<ClusterItem*> vClusterArray;
+            std::vector<mu::value_type> vDoubleArray;
+            std::vector<std::string> vStringArray;
+            std::vector<unsigned short> vTypeArray;
+            size_t nStringItems;
+            int nStorageType;
             bool bSortCaseInsensitive;
-            mutable int nGlobalType;
 
             void assign(const Cluster& cluster);
             void assign(const std::vector<mu::value_type>& vVals);
@@ -335,13 +75,14 @@ namespace NumeRe
             virtual int compare(int i, int j, int col) override;
             virtual bool isValue(int line, int col) override;
             void reorderElements(std::vector<int> vIndex, int i1, int i2);
-            void reduceSize(size_t z);
+            void toMixedStorage();
+            void compactStorage();
+            void expandStorage(size_t n, int nType);
+            void eraseItems(const std::vector<bool>& vDelete);
 
         public:
-            Cluster()
+            Cluster() : nStringItems(0), nStorageType(ClusterItem::ITEMTYPE_INVALID), bSortCaseInsensitive(false)
             {
-                bSortCaseInsensitive = false;
-                nGlobalType = ClusterItem::ITEMTYPE_INVALID;
             }
             Cluster(const Cluster& cluster)
             {
@@ -377,12 +118,29 @@ namespace NumeRe
                 return *this;
             }
 
-            void push_back(ClusterItem* item);
             void push_back(const mu::value_type& val);
             void push_back(const std::string& strval);
             void pop_back();
 
-            size_t size() const;
+            /////////////////////////////////////////////////
+            /// \brief This member function returns the
+            /// number of items in the cluster.
+            ///
+            /// \return size_t
+            ///
+            /////////////////////////////////////////////////
+            size_t size() const
+            {
+                if (nStorageType == ClusterItem::ITEMTYPE_DOUBLE)
+                    return vDoubleArray.size();
+                else if (nStorageType == ClusterItem::ITEMTYPE_STRING)
+                    return vStringArray.size();
+                else if (nStorageType == ClusterItem::ITEMTYPE_MIXED)
+                    return vTypeArray.size();
+
+                return 0;
+            }
+
             size_t getBytes() const;
             void clear();
 
@@ -390,9 +148,46 @@ namespace NumeRe
             bool isDouble() const;
             bool isString() const;
 
-            unsigned short getType(size_t i) const;
+            /////////////////////////////////////////////////
+            /// \brief This member function returns the type
+            /// of the i-th cluster item.
+            ///
+            /// \param i size_t
+            /// \return unsigned short
+            ///
+            /////////////////////////////////////////////////
+            unsigned short getType(size_t i) const
+            {
+                if (i >= size())
+                    return ClusterItem::ITEMTYPE_INVALID;
+
+                if (nStorageType == ClusterItem::ITEMTYPE_MIXED)
+                    return vTypeArray[i];
+
+                return nStorageType;
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief This member function returns the data
+            /// of the i-th cluster item as a value. Strings
+            /// are converted on-the-fly.
+            ///
+            /// \param i size_t
+            /// \return mu::value_type
+            ///
+            /////////////////////////////////////////////////
+            mu::value_type getDouble(size_t i) const
+            {
+                unsigned short nType = getType(i);
+
+                if (nType == ClusterItem::ITEMTYPE_DOUBLE)
+                    return vDoubleArray[i];
+                else if (nType == ClusterItem::ITEMTYPE_STRING && isConvertible(vStringArray[i], CONVTYPE_VALUE))
+                    return StrToCmplx(vStringArray[i]);
+
+                return NAN;
+            }
 
-            mu::value_type getDouble(size_t i) const;
             void setDouble(size_t i, const mu::value_type& value);
             std::vector<mu::value_type> getDoubleArray() const;
             void insertDataInArray(std::vector<mu::value_type>* vTarget, const VectorIndex& _vLine);
@@ -624,8 +624,15 @@ void replaceDataEntities(string& sLine, const string& sEntity, MemoryManager& _d
 			_parser.SetVectorVar(sEntityReplacement, vEntityContents);
 
 			// Cache the current access if needed
-			mu::CachedDataAccess _access = {sEntityName + (isCluster ? "{" + _idx.sCompiledAccessEquation + "}" : "(" + _idx.sCompiledAccessEquation + ")") , sEntityReplacement, sEntityName, isCluster ? mu::CachedDataAccess::IS_CLUSTER : mu::CachedDataAccess::NO_FLAG};
-			_parser.CacheCurrentAccess(_access);
+			if (_parser.CanCacheAccess())
+            {
+                mu::CachedDataAccess _access = {sEntityName + (isCluster ? "{" + _idx.sCompiledAccessEquation + "}" : "(" + _idx.sCompiledAccessEquation + ")") , sEntityReplacement, sEntityName, isCluster ? mu::CachedDataAccess::IS_CLUSTER : mu::CachedDataAccess::NO_FLAG};
+
+                // Compile the indices once, so that they don't
+                // have to be parsed from the text again
+                compileIndexProgram(_access.sAccessEquation, _access.program, _data);
+                _parser.CacheCurrentAccess(_access);
+            }
 
 			// Replace the occurences
 			replaceEntityOccurence(sLine, sEntityOccurence, sEntityName, sEntityReplacement, _idx, _data, _parser, _option, isCluster);
@@ -671,8 +678,19 @@ static const string handleCachedDataAccess(string& sLine, Parser& _parser, Memor
 
 		bool isCluster = _access.flags & mu::CachedDataAccess::IS_CLUSTER;
 
-		// Read the indices
-		getIndices(_access.sAccessEquation, _idx, _parser, _data, _option);
+		// Read the indices. Use the precompiled index
+		// program, if it is available
+		if (_access.program.m_compiled)
+        {
+            if (isCluster)
+                _data.updateClusterSizeVariables(_access.sCacheName);
+            else
+                _data.updateDimensionVariables(_access.sCacheName);
+
+            evalIndexProgram(_access.program, _idx, _parser, _access.sAccessEquation);
+        }
+        else
+            getIndices(_access.sAccessEquation, _idx, _parser, _data, _option);
 
 		// check the indices
 		if (!isValidIndexSet(_idx))
@@ -713,7 +731,13 @@ static const string handleCachedDataAccess(string& sLine, Parser& _parser, Memor
                 return getDataElements(sLine, _parser, _data, _option);
             }
 
-            _data.copyElementsInto(_parser.GetVectorVar(_access.sVectorName), _idx.row, _idx.col, _access.sCacheName);
+            // Bind contiguous numerical columns directly to the
+            // vector variable and copy only all other accesses
+            size_t nElems;
+            const mu::value_type* data = _data.getContiguousValues(_idx.row, _idx.col, _access.sCacheName, nElems);
+
+            if (!data || !_parser.BindVectorVar(_access.sVectorName, data, nElems))
+                _data.copyElementsInto(_parser.GetVectorVar(_access.sVectorName), _idx.row, _idx.col, _access.sCacheName);
         }
 
 		_parser.UpdateVectorVar(_access.sVectorName);
@@ -1932,6 +1956,190 @@ static std::string tableMethod_binsof(const std::string& sTableName, std::string
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Realizes the "groupby()" table method.
+/// The grouped and aggregated table is written
+/// to the target table, which defaults to
+/// "groupby()".
+///
+/// \param sTableName const std::string&
+/// \param sMethodArguments std::string
+/// \return std::string
+///
+/////////////////////////////////////////////////
+static std::string tableMethod_groupby(const std::string& sTableName, std::string sMethodArguments)
+{
+    NumeReKernel* _kernel = NumeReKernel::getInstance();
+    std::string sKeyCols = getNextArgument(sMethodArguments, true);
+    std::string sAggregations = getNextArgument(sMethodArguments, true);
+    std::string sTarget = getNextArgument(sMethodArguments, true);
+    std::vector<std::string> vAggregations;
+
+    // Might be necessary to resolve the contents of columns and conversions
+    getDataElements(sKeyCols,
+                    _kernel->getParser(),
+                    _kernel->getMemoryManager(),
+                    _kernel->getSettings());
+
+    if (_kernel->getStringParser().isStringExpression(sAggregations))
+    {
+        std::string sDummy;
+        sAggregations += " -nq";
+        NumeRe::StringParser::StringParserRetVal res = _kernel->getStringParser().evalAndFormat(sAggregations, sDummy, true);
+
+        if (res == NumeRe::StringParser::STRING_NUMERICAL)
+            return "\"\"";
+
+        vAggregations = _kernel->getAns().getInternalStringArray();
+    }
+
+    if (!vAggregations.size())
+        vAggregations.push_back("count");
+
+    if (_kernel->getStringParser().isStringExpression(sTarget))
+    {
+        std::string sDummy;
+        sTarget += " -nq";
+        NumeRe::StringParser::StringParserRetVal res = _kernel->getStringParser().evalAndFormat(sTarget, sDummy, true);
+
+        if (res == NumeRe::StringParser::STRING_NUMERICAL)
+            return "\"\"";
+
+        sTarget = _kernel->getAns().getInternalStringArray().front();
+    }
+
+    if (!sTarget.length())
+        sTarget = "groupby";
+
+    int nResults = 0;
+    _kernel->getMemoryManager().updateDimensionVariables(sTableName);
+    _kernel->getParser().SetExpr(sKeyCols);
+    mu::value_type* v = _kernel->getParser().Eval(nResults);
+
+    // Group first, because the target might be the
+    // source table itself
+    NumeRe::Table groupTable = _kernel->getMemoryManager().groupBy(sTableName, VectorIndex(v, nResults, 0), vAggregations);
+
+    if (!_kernel->getMemoryManager().isTable(sTarget))
+        _kernel->getMemoryManager().addTable(sTarget, _kernel->getSettings());
+
+    _kernel->getMemoryManager().importTable(groupTable, sTarget);
+
+    return "\"" + sTarget + "()\"";
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Realizes the "join()" table method.
+/// The joined table is written to the target
+/// table, which defaults to "join()".
+///
+/// \param sTableName const std::string&
+/// \param sMethodArguments std::string
+/// \return std::string
+///
+/////////////////////////////////////////////////
+static std::string tableMethod_join(const std::string& sTableName, std::string sMethodArguments)
+{
+    NumeReKernel* _kernel = NumeReKernel::getInstance();
+    std::string sOtherTable = getNextArgument(sMethodArguments, true);
+    std::string sKeyCols = getNextArgument(sMethodArguments, true);
+    std::string sOtherKeyCols = getNextArgument(sMethodArguments, true);
+    std::string sMode = getNextArgument(sMethodArguments, true);
+    std::string sTarget = getNextArgument(sMethodArguments, true);
+    Memory::JoinType type = Memory::JOIN_INNER;
+
+    if (_kernel->getStringParser().isStringExpression(sOtherTable))
+    {
+        std::string sDummy;
+        sOtherTable += " -nq";
+        NumeRe::StringParser::StringParserRetVal res = _kernel->getStringParser().evalAndFormat(sOtherTable, sDummy, true);
+
+        if (res == NumeRe::StringParser::STRING_NUMERICAL)
+            return "\"\"";
+
+        sOtherTable = _kernel->getAns().getInternalStringArray().front();
+    }
+
+    StripSpaces(sOtherTable);
+
+    if (sOtherTable.find('(') != std::string::npos)
+        sOtherTable.erase(sOtherTable.find('('));
+
+    if (_kernel->getStringParser().isStringExpression(sMode))
+    {
+        std::string sDummy;
+        sMode += " -nq";
+        NumeRe::StringParser::StringParserRetVal res = _kernel->getStringParser().evalAndFormat(sMode, sDummy, true);
+
+        if (res == NumeRe::StringParser::STRING_NUMERICAL)
+            return "\"\"";
+
+        sMode = _kernel->getAns().getInternalStringArray().front();
+
+        if (sMode == "left")
+            type = Memory::JOIN_LEFT;
+        else if (sMode == "outer")
+            type = Memory::JOIN_OUTER;
+        else if (sMode.length() && sMode != "inner")
+            throw SyntaxError(SyntaxError::INVALID_MODE, "join(", SyntaxError::invalid_position, sMode);
+    }
+
+    if (_kernel->getStringParser().isStringExpression(sTarget))
+    {
+        std::string sDummy;
+        sTarget += " -nq";
+        NumeRe::StringParser::StringParserRetVal res = _kernel->getStringParser().evalAndFormat(sTarget, sDummy, true);
+
+        if (res == NumeRe::StringParser::STRING_NUMERICAL)
+            return "\"\"";
+
+        sTarget = _kernel->getAns().getInternalStringArray().front();
+    }
+
+    if (!sTarget.length())
+        sTarget = "join";
+
+    // The key columns of both tables are identical,
+    // if the other key columns are omitted
+    if (!sOtherKeyCols.length())
+        sOtherKeyCols = sKeyCols;
+
+    // Might be necessary to resolve the contents of columns and conversions
+    getDataElements(sKeyCols,
+                    _kernel->getParser(),
+                    _kernel->getMemoryManager(),
+                    _kernel->getSettings());
+
+    int nResults = 0;
+    _kernel->getMemoryManager().updateDimensionVariables(sTableName);
+    _kernel->getParser().SetExpr(sKeyCols);
+    mu::value_type* v = _kernel->getParser().Eval(nResults);
+    VectorIndex vKeyCols(v, nResults, 0);
+
+    getDataElements(sOtherKeyCols,
+                    _kernel->getParser(),
+                    _kernel->getMemoryManager(),
+                    _kernel->getSettings());
+
+    _kernel->getMemoryManager().updateDimensionVariables(sOtherTable);
+    _kernel->getParser().SetExpr(sOtherKeyCols);
+    v = _kernel->getParser().Eval(nResults);
+    VectorIndex vOtherKeyCols(v, nResults, 0);
+
+    // Join first, because the target might be one of
+    // the source tables
+    NumeRe::Table joinTable = _kernel->getMemoryManager().join(sTableName, sOtherTable, vKeyCols, vOtherKeyCols, type);
+
+    if (!_kernel->getMemoryManager().isTable(sTarget))
+        _kernel->getMemoryManager().addTable(sTarget, _kernel->getSettings());
+
+    _kernel->getMemoryManager().importTable(joinTable, sTarget);
+
+    return "\"" + sTarget + "()\"";
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Realizes the "rankof()" table method.
 ///
@@ -2066,6 +2274,8 @@ static std::map<std::string, TableMethod> getInplaceTableMethods()
     mTableMethods["zscoreof"] = tableMethod_zscore;
     mTableMethods["anovaof"] = tableMethod_anova;
     mTableMethods["binsof"] = tableMethod_binsof;
+    mTableMethods["groupby"] = tableMethod_groupby;
+    mTableMethods["join"] = tableMethod_join;
 
     return mTableMethods;
 }
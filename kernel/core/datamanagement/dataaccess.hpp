@@ -77,6 +77,8 @@ Indices getIndicesForPlotAndFit(const std::string& sExpression, std::string& sDa
 
 Indices getIndices(StringView sCmd, mu::Parser& _parser, MemoryManager& _data, const Settings& _option);
 void getIndices(StringView sCmd, Indices& _idx, mu::Parser& _parser, MemoryManager& _data, const Settings& _option);
+bool compileIndexProgram(StringView sCmd, mu::IndexProgram& program, MemoryManager& _data);
+void evalIndexProgram(const mu::IndexProgram& program, Indices& _idx, mu::Parser& _parser, StringView sCmd);
 
 inline bool isValidIndexSet(const Indices& _idx)
 {
@@ -367,14 +367,11 @@ void append_data(CommandLineParser& cmdParser)
         if (!vFilelist.size())
             throw SyntaxError(SyntaxError::FILE_NOT_EXIST, cmdParser.getCommandLine(), SyntaxError::invalid_position, sFileList);
 
-        // Go through all elements in the vFilelist list
-        for (size_t i = 0; i < vFilelist.size(); i++)
-        {
-            // Load the data. The melting of multiple files
-            // is processed automatically
-            _data.setbLoadEmptyColsInNextFile(cmdParser.hasParam("keepdim") || cmdParser.hasParam("complete"));
-            _data.openFile(vFilelist[i]);
-        }
+        // Load the data. The files are read concurrently,
+        // the melting of multiple files is processed
+        // automatically in the order of the list
+        _data.setbLoadEmptyColsInNextFile(cmdParser.hasParam("keepdim") || cmdParser.hasParam("complete"));
+        _data.openFiles(vFilelist, false, false, 0, "", _option.getLoadThreads());
 
         // Inform the user and return
         if (!_data.isEmpty("data") && _option.systemPrints())
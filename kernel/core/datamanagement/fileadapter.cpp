@@ -19,8 +19,13 @@
 #include "fileadapter.hpp"
 #include "../utils/tools.hpp"
 #include "../io/logger.hpp"
+#include "../../kernel.hpp"
 #include "memory.hpp"
 
+#include <algorithm>
+#include <exception>
+#include <omp.h>
+
 using namespace std;
 
 namespace NumeRe
@@ -90,25 +95,17 @@ namespace NumeRe
 
 
     /////////////////////////////////////////////////
-    /// \brief This member function loads the
-    /// contents of the selected file to a new Memory
-    /// class instance. This instance is either
-    /// appended to the already existing instances or
-    /// melted with an existing one, if the existing
-    /// one has the same name.
+    /// \brief Resolves the passed file name to a
+    /// valid absolute path. If the file does not
+    /// exist and the user did not provide the
+    /// extension, it is detected using a wildcard.
     ///
-    /// \param _sFile std::string
-    /// \param loadToCache bool
-    /// \param overrideTarget bool
-    /// \param _nHeadline int
-    /// \param sTargetTable const std::string&
-    /// \return FileHeaderInfo
+    /// \param _sFile const std::string&
+    /// \return std::string
     ///
     /////////////////////////////////////////////////
-    FileHeaderInfo FileAdapter::openFile(std::string _sFile, bool loadToCache, bool overrideTarget, int _nHeadline, const std::string& sTargetTable)
+    std::string FileAdapter::resolveFileName(const std::string& _sFile)
     {
-        FileHeaderInfo info;
-
         // Ensure that the file name is valid
         std::string sFile = ValidFileName(_sFile);
 
@@ -118,14 +115,35 @@ namespace NumeRe
         if (!fileExists(sFile) && (_sFile.find('.') == string::npos || _sFile.find('.') < _sFile.rfind('/')))
             sFile = ValidFileName(_sFile+".*");
 
-        g_logger.info("Loading file '" + _sFile + "'.");
+        return sFile;
+    }
+
 
+    /////////////////////////////////////////////////
+    /// \brief This static member function reads the
+    /// contents of the selected file into a new
+    /// Memory instance, which is returned. It does
+    /// not access any state of the FileAdapter and
+    /// may therefore be called concurrently for
+    /// different files, if the calling threads
+    /// defer their log messages and warnings (see
+    /// openFiles()). The caller is responsible for
+    /// freeing the returned instance.
+    ///
+    /// \param sFile const std::string&
+    /// \param _nHeadline int
+    /// \param info FileHeaderInfo&
+    /// \return Memory*
+    ///
+    /////////////////////////////////////////////////
+    Memory* FileAdapter::readFile(const std::string& sFile, int _nHeadline, FileHeaderInfo& info)
+    {
         // Get an instance of the desired file type
         GenericFile* file = getFileByType(sFile);
 
         // Ensure that the instance is valid
         if (!file)
-            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, _sFile, SyntaxError::invalid_position, _sFile);
+            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFile, SyntaxError::invalid_position, sFile);
 
         // Try to read the contents of the file. This may
         // either result in a read error or the read method
@@ -147,8 +165,6 @@ namespace NumeRe
             throw;
         }
 
-        g_logger.debug("File read. Preparing memory.");
-
         // Get the header information structure
         info = file->getFileHeaderInformation();
 
@@ -161,53 +177,70 @@ namespace NumeRe
         Memory* _mem = new Memory();
         _mem->resizeMemory(info.nRows, info.nCols);
 
-        // If the dimensions were valid and the internal
-        // memory was created, copy the data to this
-        // memory
-        if (_mem->memArray.size())
+        // Ensure that the dimensions were valid and the
+        // internal memory was created
+        if (!_mem->memArray.size())
         {
-            // Copy them and delete the file instance
-            // afterwards
-            file->getData(&_mem->memArray);
             delete file;
-            g_logger.debug("Data copied.");
-            _mem->convert();
-            g_logger.debug("Data converted.");
-            _mem->shrink();
-            condenseDataSet(_mem);
-            _mem->createTableHeaders();
-            _mem->setSaveStatus(false);
-
-            NumeRe::TableMetaData meta;
-            meta.comment = info.sComment;
-            meta.source = sFile;
-
-            _mem->setMetaData(meta);
-
-            // Melt or append the new instance. The
-            // melt() member function is responsible
-            // for freeing the passed memory.
-            if (loadToCache)
+            delete _mem;
+            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFile, SyntaxError::invalid_position, sFile);
+        }
+
+        // Copy the data and delete the file instance
+        // afterwards
+        file->getData(&_mem->memArray);
+        delete file;
+        _mem->convert();
+        _mem->shrink();
+
+        return _mem;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief This private member function finalizes
+    /// a Memory instance returned from readFile() and
+    /// melts or appends it to the already existing
+    /// instances.
+    ///
+    /// \param _mem Memory*
+    /// \param info FileHeaderInfo&
+    /// \param sFile const std::string&
+    /// \param loadToCache bool
+    /// \param overrideTarget bool
+    /// \param sTargetTable const std::string&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void FileAdapter::insertMemory(Memory* _mem, FileHeaderInfo& info, const std::string& sFile, bool loadToCache, bool overrideTarget, const std::string& sTargetTable)
+    {
+        condenseDataSet(_mem);
+        _mem->createTableHeaders();
+        _mem->setSaveStatus(false);
+
+        NumeRe::TableMetaData meta;
+        meta.comment = info.sComment;
+        meta.source = sFile;
+
+        _mem->setMetaData(meta);
+
+        // Melt or append the new instance. The
+        // melt() member function is responsible
+        // for freeing the passed memory.
+        if (loadToCache)
+        {
+            if (sTargetTable.length())
             {
-                if (sTargetTable.length())
-                {
-                    melt(_mem, sTargetTable, overrideTarget);
-                    info.sTableName = sTargetTable;
-                }
-                else
-                    melt(_mem, info.sTableName, overrideTarget);
+                melt(_mem, sTargetTable, overrideTarget);
+                info.sTableName = sTargetTable;
             }
             else
-                melt(_mem, "data");
-
-            g_logger.info("File sucessfully loaded. Data file dimensions = {" + toString(info.nRows) + ", " + toString(info.nCols) + "}");
+                melt(_mem, info.sTableName, overrideTarget);
         }
         else
-        {
-            delete file;
-            delete _mem;
-            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFile, SyntaxError::invalid_position, sFile);
-        }
+            melt(_mem, "data");
+
+        g_logger.info("File sucessfully loaded. Data file dimensions = {" + toString(info.nRows) + ", " + toString(info.nCols) + "}");
 
         if (!loadToCache)
         {
@@ -216,6 +249,37 @@ namespace NumeRe
             else
                 sDataFile = sFile;
         }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief This member function loads the
+    /// contents of the selected file to a new Memory
+    /// class instance. This instance is either
+    /// appended to the already existing instances or
+    /// melted with an existing one, if the existing
+    /// one has the same name.
+    ///
+    /// \param _sFile std::string
+    /// \param loadToCache bool
+    /// \param overrideTarget bool
+    /// \param _nHeadline int
+    /// \param sTargetTable const std::string&
+    /// \return FileHeaderInfo
+    ///
+    /////////////////////////////////////////////////
+    FileHeaderInfo FileAdapter::openFile(std::string _sFile, bool loadToCache, bool overrideTarget, int _nHeadline, const std::string& sTargetTable)
+    {
+        FileHeaderInfo info;
+        std::string sFile = resolveFileName(_sFile);
+
+        g_logger.info("Loading file '" + _sFile + "'.");
+
+        Memory* _mem = readFile(sFile, _nHeadline, info);
+
+        g_logger.debug("File read and converted.");
+
+        insertMemory(_mem, info, sFile, loadToCache, overrideTarget, sTargetTable);
 
         // Return the file information header for
         // further processing
@@ -223,6 +287,99 @@ namespace NumeRe
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief This member function loads the
+    /// contents of multiple files like openFile().
+    /// The files are read and parsed concurrently
+    /// using at most nMaxThreads threads, but they
+    /// are melted in the order of the passed list.
+    /// If a file cannot be read, all preceding files
+    /// are still loaded and the error of the failing
+    /// file is rethrown afterwards. Log messages and
+    /// warnings of the readers are collected per
+    /// file and emitted in the order of the list.
+    ///
+    /// \param vFiles const std::vector<std::string>&
+    /// \param loadToCache bool
+    /// \param overrideTarget bool
+    /// \param _nHeadline int
+    /// \param sTargetTable const std::string&
+    /// \param nMaxThreads size_t
+    /// \return std::vector<FileHeaderInfo>
+    ///
+    /////////////////////////////////////////////////
+    std::vector<FileHeaderInfo> FileAdapter::openFiles(const std::vector<std::string>& vFiles, bool loadToCache, bool overrideTarget, int _nHeadline, const std::string& sTargetTable, size_t nMaxThreads)
+    {
+        std::vector<std::string> vValidFiles;
+        std::vector<Memory*> vMemory(vFiles.size(), nullptr);
+        std::vector<FileHeaderInfo> vInfo(vFiles.size());
+        std::vector<std::exception_ptr> vErrors(vFiles.size());
+        std::vector<std::vector<std::string>> vLogMessages(vFiles.size());
+        std::vector<std::vector<std::string>> vWarnings(vFiles.size());
+
+        // Resolving the file names accesses the file system
+        // settings and is therefore done serially
+        for (const std::string& sFile : vFiles)
+        {
+            vValidFiles.push_back(resolveFileName(sFile));
+        }
+
+        int nThreads = std::max(1, (int)std::min(nMaxThreads, vFiles.size()));
+        g_logger.info("Loading " + toString(vFiles.size()) + " files using " + toString(nThreads) + " threads.");
+
+        #pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+        for (int i = 0; i < (int)vValidFiles.size(); i++)
+        {
+            // Neither the logger nor the terminal may be
+            // accessed concurrently
+            g_logger.deferMessages(&vLogMessages[i]);
+            NumeReKernel::deferWarnings(&vWarnings[i]);
+
+            try
+            {
+                vMemory[i] = readFile(vValidFiles[i], _nHeadline, vInfo[i]);
+            }
+            catch (...)
+            {
+                vErrors[i] = std::current_exception();
+            }
+
+            g_logger.deferMessages(nullptr);
+            NumeReKernel::deferWarnings(nullptr);
+        }
+
+        // The request to keep empty columns applies to
+        // all files of the list
+        bool bKeepEmptyCols = bLoadEmptyColsInNextFile;
+
+        // Melt the files in the order of the list
+        for (size_t i = 0; i < vValidFiles.size(); i++)
+        {
+            for (const std::string& sMessage : vLogMessages[i])
+                g_logger.push_info(sMessage);
+
+            for (const std::string& sWarning : vWarnings[i])
+                NumeReKernel::issueWarning(sWarning);
+
+            if (vErrors[i])
+            {
+                g_logger.error("Could not load file '" + vValidFiles[i] + "'.");
+
+                for (size_t j = i+1; j < vMemory.size(); j++)
+                    delete vMemory[j];
+
+                std::rethrow_exception(vErrors[i]);
+            }
+
+            bLoadEmptyColsInNextFile = bKeepEmptyCols;
+            insertMemory(vMemory[i], vInfo[i], vValidFiles[i], loadToCache, overrideTarget, sTargetTable);
+        }
+
+        bLoadEmptyColsInNextFile = false;
+        return vInfo;
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief This member function wraps the saving
     /// functionality of the Memory class. The passed
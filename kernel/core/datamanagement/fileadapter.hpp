@@ -24,6 +24,7 @@
 #include "../settings.hpp"
 
 #include <string>
+#include <vector>
 
 class Memory;
 
@@ -47,6 +48,9 @@ namespace NumeRe
 
             std::string getDate();
             void condenseDataSet(Memory* _mem);
+            std::string resolveFileName(const std::string& _sFile);
+            static Memory* readFile(const std::string& sFile, int _nHeadline, FileHeaderInfo& info);
+            void insertMemory(Memory* _mem, FileHeaderInfo& info, const std::string& sFile, bool loadToCache, bool overrideTarget, const std::string& sTargetTable);
             virtual bool saveLayer(std::string _sFileName, const std::string& _sCache, unsigned short nPrecision) = 0;
 
         public:
@@ -54,6 +58,7 @@ namespace NumeRe
             virtual ~FileAdapter() {}
 
             FileHeaderInfo openFile(std::string _sFile, bool loadToCache = false, bool overrideTarget = false, int _nHeadline = 0, const std::string& sTargetTable = "");
+            std::vector<FileHeaderInfo> openFiles(const std::vector<std::string>& vFiles, bool loadToCache = false, bool overrideTarget = false, int _nHeadline = 0, const std::string& sTargetTable = "", size_t nMaxThreads = 1);
             bool saveFile(const std::string& sTable, std::string _sFileName, unsigned short nPrecision = 7);
             std::string getDataFileName(const std::string& sTable) const;
             std::string getDataFileNameShort() const;
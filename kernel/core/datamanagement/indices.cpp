@@ -31,6 +31,7 @@ static void handleCasualIndices(Parser& _parser, Indices& _idx, vector<StringVie
 static void handleSingleCasualIndex(VectorIndex& _vIdx, vector<StringView>& vIndex, string& sIndexExpressions, vector<int>& vIndexNumbers, int sign);
 static void expandIndexVectors(Indices& _idx, MemoryManager& _data, StringView sCmd);
 static void expandStringIndexVectors(Indices& _idx, MemoryManager& _data);
+static void mapCasualIndexResults(Indices& _idx, value_type* v, int nResults, const vector<int>& vIndexNumbers, StringView sCmd);
 
 
 /////////////////////////////////////////////////
@@ -181,6 +182,153 @@ void getIndices(StringView sCmd, Indices& _idx,  Parser& _parser, MemoryManager&
 }
 
 
+/////////////////////////////////////////////////
+/// \brief This function compiles the indices of
+/// a cached data access into an index program,
+/// which can be evaluated repeatedly by
+/// evalIndexProgram() without any string
+/// operations. Returns false, if the indices
+/// cannot be precompiled (e.g. because they
+/// contain further data accesses, strings or the
+/// headline index), in which case getIndices()
+/// has to be used.
+///
+/// \param sCmd StringView
+/// \param program mu::IndexProgram&
+/// \param _data MemoryManager&
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool compileIndexProgram(StringView sCmd, mu::IndexProgram& program, MemoryManager& _data)
+{
+    program.clear();
+    size_t nPos = sCmd.find_first_of("({");
+
+    if (nPos == string::npos)
+        return false;
+
+    size_t nClosingParens = getMatchingParenthesis(sCmd.subview(nPos));
+
+    if (nClosingParens == string::npos)
+        return false;
+
+    StringView sTableName = sCmd.subview(0, nPos);
+    sTableName.strip();
+
+    // The string object is expanded differently
+    if (sTableName == "string")
+        return false;
+
+    StringView sIndices = sCmd.subview(nPos+1, nClosingParens-1);
+    sIndices.strip();
+
+    // This is the abbreviation TABLE() == TABLE(:,:)
+    if (!sIndices.length())
+    {
+        program.m_emptyPositions = {1, 2, -1, -2};
+        program.m_compiled = true;
+        return true;
+    }
+
+    std::string sArgument = sIndices.to_string();
+
+    if (_data.containsTablesOrClusters(sArgument)
+        || NumeReKernel::getInstance()->getStringParser().isStringExpression(sArgument))
+        return false;
+
+    vector<StringView> vLines;
+    vector<StringView> vCols;
+    extractIndexList(sArgument, vLines, vCols);
+
+    // The headline index cannot be precompiled
+    for (const StringView& sIndex : vLines)
+    {
+        if (sIndex == "#")
+            return false;
+    }
+
+    for (const StringView& sIndex : vCols)
+    {
+        if (sIndex == "#")
+            return false;
+    }
+
+    // Single indices are evaluated separately,
+    // because they might be vectors. Everything
+    // else is evaluated at once. This is the same
+    // order as in handleArgumentForIndices()
+    for (int sign : {1, -1})
+    {
+        vector<StringView>& vIndex = sign > 0 ? vLines : vCols;
+
+        for (size_t n = 0; n < vIndex.size(); n++)
+        {
+            if (!vIndex[n].length())
+                program.m_emptyPositions.push_back(sign*(int)(n+1));
+            else if (vIndex.size() == 1)
+                (sign > 0 ? program.m_rowExpr : program.m_colExpr) = vIndex[n].to_string();
+            else
+            {
+                if (program.m_casualExpr.length())
+                    program.m_casualExpr += ",";
+
+                program.m_casualExpr += vIndex[n].to_string();
+                program.m_casualPositions.push_back(sign*(int)(n+1));
+            }
+        }
+    }
+
+    program.m_compiled = true;
+    return true;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This function evaluates an index
+/// program created by compileIndexProgram() and
+/// stores the result in the passed Indices
+/// object. The dimension variables have to be
+/// updated and the indices have to be validated
+/// by the caller.
+///
+/// \param program const mu::IndexProgram&
+/// \param _idx Indices&
+/// \param _parser Parser&
+/// \param sCmd StringView
+/// \return void
+///
+/////////////////////////////////////////////////
+void evalIndexProgram(const mu::IndexProgram& program, Indices& _idx, Parser& _parser, StringView sCmd)
+{
+    // Empty components are either the first or an
+    // open-ended index
+    for (int nPosition : program.m_emptyPositions)
+    {
+        size_t n = abs(nPosition) - 1;
+        (nPosition > 0 ? _idx.row : _idx.col).setIndex(n, n ? VectorIndex::OPEN_END : 0);
+    }
+
+    if (program.m_rowExpr.length())
+        handleIndexVectors(_parser, _idx.row, program.m_rowExpr);
+
+    if (program.m_colExpr.length())
+        handleIndexVectors(_parser, _idx.col, program.m_colExpr);
+
+    if (program.m_casualExpr.length())
+    {
+        _parser.SetExpr(program.m_casualExpr);
+        int nResults;
+        mu::value_type* v = _parser.Eval(nResults);
+
+        // check whether the number of the results is matching
+        if ((size_t)nResults != program.m_casualPositions.size())
+            throw SyntaxError(SyntaxError::INVALID_INDEX, sCmd.to_string(), SyntaxError::invalid_position, program.m_casualExpr);
+
+        mapCasualIndexResults(_idx, v, nResults, program.m_casualPositions, sCmd);
+    }
+}
+
+
 /*
  *   LOCAL FUNCTIONS FOR parser_getIndices()
  */
@@ -446,36 +594,56 @@ static void handleCasualIndices(Parser& _parser, Indices& _idx, vector<StringVie
         if ((size_t)nResults != vIndexNumbers.size())
             throw SyntaxError(SyntaxError::INVALID_INDEX, sCmd.to_string(), SyntaxError::invalid_position, sIndexExpressions);
 
-        // map the results to their assignments
-        for (int i = 0; i < nResults; i++)
-        {
-            if (isinf(v[i].real())) // infinity => last possible index
-                v[i] = -1; // only -1 because it will be decremented in the following lines
-            else if (isnan(v[i].real()) || intCast(v[i]) <= 0LL)
-            {
-                std::string sToken;
+        mapCasualIndexResults(_idx, v, nResults, vIndexNumbers, sCmd);
+    }
+}
 
-                if (vIndexNumbers.front() > 0 && vIndexNumbers.back() < 0)
-                    sToken = convertToString(v, vIndexNumbers);
-                else if (vIndexNumbers.front() > 0)
-                {
-                    sToken = convertToString(v, vIndexNumbers);
-                    sToken += ", " + _idx.col.to_string();
-                }
-                else
-                {
-                    sToken = _idx.row.to_string() + ", ";
-                    sToken += convertToString(v, vIndexNumbers);
-                }
 
-                throw SyntaxError(SyntaxError::INVALID_INDEX, sCmd.to_string(), SyntaxError::invalid_position, sToken);
-            }
+/////////////////////////////////////////////////
+/// \brief This static function maps the results
+/// of the evaluated casual index expressions to
+/// their assigned positions in the Indices
+/// object.
+///
+/// \param _idx Indices&
+/// \param v value_type*
+/// \param nResults int
+/// \param vIndexNumbers const vector<int>&
+/// \param sCmd StringView
+/// \return void
+///
+/////////////////////////////////////////////////
+static void mapCasualIndexResults(Indices& _idx, value_type* v, int nResults, const vector<int>& vIndexNumbers, StringView sCmd)
+{
+    // map the results to their assignments
+    for (int i = 0; i < nResults; i++)
+    {
+        if (isinf(v[i].real())) // infinity => last possible index
+            v[i] = -1; // only -1 because it will be decremented in the following lines
+        else if (isnan(v[i].real()) || intCast(v[i]) <= 0LL)
+        {
+            std::string sToken;
 
-            if (vIndexNumbers[i] > 0)
-                _idx.row.setIndex(vIndexNumbers[i] - 1, intCast(v[i]) - 1);
+            if (vIndexNumbers.front() > 0 && vIndexNumbers.back() < 0)
+                sToken = convertToString(v, vIndexNumbers);
+            else if (vIndexNumbers.front() > 0)
+            {
+                sToken = convertToString(v, vIndexNumbers);
+                sToken += ", " + _idx.col.to_string();
+            }
             else
-                _idx.col.setIndex(abs(vIndexNumbers[i]) - 1, intCast(v[i]) - 1);
+            {
+                sToken = _idx.row.to_string() + ", ";
+                sToken += convertToString(v, vIndexNumbers);
+            }
+
+            throw SyntaxError(SyntaxError::INVALID_INDEX, sCmd.to_string(), SyntaxError::invalid_position, sToken);
         }
+
+        if (vIndexNumbers[i] > 0)
+            _idx.row.setIndex(vIndexNumbers[i] - 1, intCast(v[i]) - 1);
+        else
+            _idx.col.setIndex(abs(vIndexNumbers[i]) - 1, intCast(v[i]) - 1);
     }
 }
 
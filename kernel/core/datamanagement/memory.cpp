@@ -17,6 +17,9 @@
 ******************************************************************************/
 
 #include <memory>
+#include <unordered_map>
+#include <map>
+#include <omp.h>
 #include <gsl/gsl_statistics.h>
 #include <gsl/gsl_sort.h>
 #include <gsl/gsl_cdf.h>
@@ -31,6 +34,7 @@
 #include "../version.h"
 #include "../maths/resampler.h"
 #include "../maths/statslogic.hpp"
+#include "../maths/orderstatistics.hpp"
 #include "../maths/matdatastructures.hpp"
 
 #define MAX_TABLE_SIZE 1e8
@@ -432,6 +436,40 @@ mu::value_type Memory::readMemInterpolated(double _dLine, double _dCol) const
 }
 
 
+/////////////////////////////////////////////////
+/// \brief This static helper function copies a
+/// contiguous range of lines of a numerical
+/// column directly from its storage into the
+/// target array using the passed stride. Returns
+/// false, if the fast path is not applicable and
+/// the elements have to be read one by one.
+///
+/// \param column const TableColumn*
+/// \param _vLine const VectorIndex&
+/// \param target mu::value_type*
+/// \param nStride size_t
+/// \return bool
+///
+/////////////////////////////////////////////////
+static bool copyContiguousLines(const TableColumn* column, const VectorIndex& _vLine, mu::value_type* target, size_t nStride)
+{
+    const mu::value_type* data = column->getValueArray();
+
+    if (!data || !_vLine.isContiguous())
+        return false;
+
+    VectorIndex::Span span = _vLine.getSpan(column->size());
+    const mu::value_type* source = data + span.first;
+
+    for (size_t i = 0; i < span.length; i++)
+    {
+        target[i*nStride] = source[i];
+    }
+
+    return true;
+}
+
+
 /////////////////////////////////////////////////
 /// \brief This member function returns the
 /// elements stored at the selected positions.
@@ -462,6 +500,9 @@ std::vector<mu::value_type> Memory::readMem(const VectorIndex& _vLine, const Vec
             if (!elems)
                 continue;
 
+            if (copyContiguousLines(memArray[_vCol[j]].get(), _vLine, &vReturn[j], _vCol.size()))
+                continue;
+
             for (size_t i = 0; i < _vLine.size(); i++)
             {
                 if (_vLine[i] < 0)
@@ -484,6 +525,45 @@ std::vector<mu::value_type> Memory::readMem(const VectorIndex& _vLine, const Vec
 }
 
 
+/////////////////////////////////////////////////
+/// \brief This member function returns a pointer
+/// to the storage of the selected elements, if
+/// they form a contiguous range in a single
+/// numerical column, which is completely filled.
+/// Otherwise a nullptr is returned and the
+/// elements have to be copied. The pointer is
+/// invalidated by every modification of the
+/// table.
+///
+/// \param _vLine const VectorIndex&
+/// \param _vCol const VectorIndex&
+/// \param nElems size_t&
+/// \return const mu::value_type*
+///
+/////////////////////////////////////////////////
+const mu::value_type* Memory::getContiguousValues(const VectorIndex& _vLine, const VectorIndex& _vCol, size_t& nElems) const
+{
+    nElems = 0;
+
+    if (_vCol.size() != 1 || _vCol[0] < 0 || _vCol[0] >= (int)memArray.size() || !memArray[_vCol[0]] || !_vLine.isContiguous())
+        return nullptr;
+
+    const mu::value_type* data = memArray[_vCol[0]]->getValueArray();
+
+    if (!data)
+        return nullptr;
+
+    VectorIndex::Span span = _vLine.getSpan(memArray[_vCol[0]]->size());
+
+    // Missing elements would have to be filled with NaNs
+    if (!span.length || span.length != _vLine.size())
+        return nullptr;
+
+    nElems = span.length;
+    return data + span.first;
+}
+
+
 /////////////////////////////////////////////////
 /// \brief This member function returns the
 /// elements stored at the selected positions as
@@ -808,6 +888,9 @@ void Memory::copyElementsInto(vector<mu::value_type>* vTarget, const VectorIndex
             if (!elems)
                 continue;
 
+            if (copyContiguousLines(memArray[_vCol[j]].get(), _vLine, &(*vTarget)[j], _vCol.size()))
+                continue;
+
             for (size_t i = 0; i < _vLine.size(); i++)
             {
                 if (_vLine[i] < 0)
@@ -2031,6 +2114,37 @@ void Memory::deleteBulk(const VectorIndex& _vLine, const VectorIndex& _vCol)
 }
 
 
+/////////////////////////////////////////////////
+/// \brief This static helper function passes a
+/// contiguous range of lines of a numerical
+/// column directly from its storage to the
+/// statistics operation. Returns false, if the
+/// fast path is not applicable.
+///
+/// \param column const TableColumn*
+/// \param _vLine const VectorIndex&
+/// \param operation StatsLogic&
+/// \return bool
+///
+/////////////////////////////////////////////////
+static bool accumulateContiguousLines(const TableColumn* column, const VectorIndex& _vLine, StatsLogic& operation)
+{
+    const mu::value_type* data = column->getValueArray();
+
+    if (!data || !_vLine.isContiguous())
+        return false;
+
+    VectorIndex::Span span = _vLine.getSpan(column->size());
+
+    for (const mu::value_type* val = data + span.first; val < data + span.first + span.length; ++val)
+    {
+        operation(*val);
+    }
+
+    return true;
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Driver code for simplifying the
 /// calculation of various stats using OpenMP, if
@@ -2062,6 +2176,9 @@ void Memory::calculateStats(const VectorIndex& _vLine, const VectorIndex& _vCol,
             if (!elems)
                 continue;
 
+            if (accumulateContiguousLines(memArray[_vCol[j]].get(), _vLine, operation[j]))
+                continue;
+
             for (size_t i = 0; i < _vLine.size(); i++)
             {
                 if (_vLine[i] < 0)
@@ -2091,6 +2208,9 @@ void Memory::calculateStats(const VectorIndex& _vLine, const VectorIndex& _vCol,
             if (!elems)
                 continue;
 
+            if (accumulateContiguousLines(memArray[_vCol[j]].get(), _vLine, operation[j]))
+                continue;
+
             for (size_t i = 0; i < _vLine.size(); i++)
             {
                 if (_vLine[i] < 0)
@@ -2749,30 +2869,25 @@ mu::value_type Memory::cmp(const VectorIndex& _vLine, const VectorIndex& _vCol,
 
 
 /////////////////////////////////////////////////
-/// \brief Implementation for the MED multi
-/// argument function.
+/// \brief This private member function collects
+/// the real parts of all finite values in the
+/// selected range. Contiguous ranges of numerical
+/// columns are read directly from the storage.
 ///
 /// \param _vLine const VectorIndex&
 /// \param _vCol const VectorIndex&
-/// \return mu::value_type
+/// \return std::vector<double>
 ///
 /////////////////////////////////////////////////
-mu::value_type Memory::med(const VectorIndex& _vLine, const VectorIndex& _vCol) const
+std::vector<double> Memory::readFiniteValues(const VectorIndex& _vLine, const VectorIndex& _vCol) const
 {
-    if (!memArray.size())
-        return NAN;
-
-    int lines = getLines(false);
-    int cols = getCols(false);
-
-    _vLine.setOpenEndIndex(lines-1);
-    _vCol.setOpenEndIndex(cols-1);
-
-    vector<double> vData;
+    _vLine.setOpenEndIndex(getLines(false)-1);
+    _vCol.setOpenEndIndex(getCols(false)-1);
 
+    std::vector<double> vData;
     vData.reserve(_vLine.size()*_vCol.size());
 
-    for (unsigned int j = 0; j < _vCol.size(); j++)
+    for (size_t j = 0; j < _vCol.size(); j++)
     {
         if (_vCol[j] < 0)
             continue;
@@ -2782,7 +2897,16 @@ mu::value_type Memory::med(const VectorIndex& _vLine, const VectorIndex& _vCol)
         if (!elems)
             continue;
 
-        for (unsigned int i = 0; i < _vLine.size(); i++)
+        const mu::value_type* data = memArray[_vCol[j]]->getValueArray();
+
+        if (data && _vLine.isContiguous())
+        {
+            VectorIndex::Span span = _vLine.getSpan(elems);
+            appendFiniteValues(vData, data + span.first, span.length);
+            continue;
+        }
+
+        for (size_t i = 0; i < _vLine.size(); i++)
         {
             if (_vLine[i] < 0)
                 continue;
@@ -2797,20 +2921,31 @@ mu::value_type Memory::med(const VectorIndex& _vLine, const VectorIndex& _vCol)
 
             mu::value_type val = readMem(_vLine[i], _vCol[j]);
 
-            if (!mu::isnan(val))
+            if (!mu::isnan(val) && std::isfinite(val.real()))
                 vData.push_back(val.real());
         }
     }
 
-    if (!vData.size())
-        return NAN;
+    return vData;
+}
 
-    size_t nCount = qSortDouble(&vData[0], vData.size());
 
-    if (!nCount)
+/////////////////////////////////////////////////
+/// \brief Implementation for the MED multi
+/// argument function.
+///
+/// \param _vLine const VectorIndex&
+/// \param _vCol const VectorIndex&
+/// \return mu::value_type
+///
+/////////////////////////////////////////////////
+mu::value_type Memory::med(const VectorIndex& _vLine, const VectorIndex& _vCol) const
+{
+    if (!memArray.size())
         return NAN;
 
-    return gsl_stats_median_from_sorted_data(&vData[0], 1, nCount);
+    std::vector<double> vData = readFiniteValues(_vLine, _vCol);
+    return selectMedian(vData);
 }
 
 
@@ -2829,59 +2964,11 @@ mu::value_type Memory::pct(const VectorIndex& _vLine, const VectorIndex& _vCol,
     if (!memArray.size())
         return NAN;
 
-    int lines = getLines(false);
-    int cols = getCols(false);
-
-    _vLine.setOpenEndIndex(lines-1);
-    _vCol.setOpenEndIndex(cols-1);
-
-    vector<double> vData;
-
-    vData.reserve(_vLine.size()*_vCol.size());
-
     if (dPct.real() >= 1 || dPct.real() <= 0)
         return NAN;
 
-    for (unsigned int j = 0; j < _vCol.size(); j++)
-    {
-        if (_vCol[j] < 0)
-            continue;
-
-        int elems = getElemsInColumn(_vCol[j]);
-
-        if (!elems)
-            continue;
-
-        for (unsigned int i = 0; i < _vLine.size(); i++)
-        {
-            if (_vLine[i] < 0)
-                continue;
-
-            if (_vLine[i] >= elems)
-            {
-                if (_vLine.isExpanded() && _vLine.isOrdered())
-                    break;
-
-                continue;
-            }
-
-            mu::value_type val = readMem(_vLine[i], _vCol[j]);
-
-            if (!mu::isnan(val))
-                vData.push_back(val.real());
-        }
-    }
-
-    if (!vData.size())
-        return NAN;
-
-
-    size_t nCount = qSortDouble(&vData[0], vData.size());
-
-    if (!nCount)
-        return NAN;
-
-    return gsl_stats_quantile_from_sorted_data(&vData[0], 1, nCount, dPct.real());
+    std::vector<double> vData = readFiniteValues(_vLine, _vCol);
+    return selectQuantile(vData, dPct.real());
 }
 
 
@@ -3152,6 +3239,34 @@ static bool closeEnough(const mu::value_type& v1, const mu::value_type& v2)
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Static helper function returning all
+/// rows of the passed column, whose values are
+/// close enough to the passed value. Uses the
+/// sorted lookup index of the column to find the
+/// candidates. The rows are sorted ascendingly.
+///
+/// \param column const TableColumn*
+/// \param val const mu::value_type&
+/// \return std::vector<size_t>
+///
+/////////////////////////////////////////////////
+static std::vector<size_t> findEqualRows(const TableColumn* column, const mu::value_type& val)
+{
+    // The interval contains all values, which might
+    // be close enough to the passed value
+    double dTol = 1e-16 * max(1.0, abs(val.real()));
+    std::vector<size_t> vRows = column->findRowsInRange(val.real() - dTol, val.real() + dTol);
+
+    vRows.erase(std::remove_if(vRows.begin(), vRows.end(),
+                               [&](size_t row){return !closeEnough(column->getValue(row), val);}),
+                vRows.end());
+    std::sort(vRows.begin(), vRows.end());
+
+    return vRows;
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Finds the columns IDs, whose headlines
 /// match to the passed strings. Can return
@@ -3164,14 +3279,25 @@ static bool closeEnough(const mu::value_type& v1, const mu::value_type& v2)
 std::vector<mu::value_type> Memory::findCols(const std::vector<std::string>& vColNames) const
 {
     std::vector<mu::value_type> vColIndices;
+    std::unordered_map<std::string, std::vector<size_t>> mColumns;
+
+    // Hash the headlines once instead of comparing
+    // every name to every headline
+    for (size_t i = 0; i < memArray.size(); i++)
+    {
+        if (memArray[i])
+            mColumns[memArray[i]->m_sHeadLine].push_back(i);
+    }
 
     for (const auto& sName : vColNames)
     {
-        for (size_t i = 0; i < memArray.size(); i++)
-        {
-            if (memArray[i] && memArray[i]->m_sHeadLine == sName)
-                vColIndices.push_back(i+1.0);
-        }
+        auto iter = mColumns.find(sName);
+
+        if (iter == mColumns.end())
+            continue;
+
+        for (size_t col : iter->second)
+            vColIndices.push_back(col+1.0);
     }
 
     if (!vColIndices.size())
@@ -3207,30 +3333,14 @@ std::vector<mu::value_type> Memory::countIfEqual(const VectorIndex& _vCols, cons
         {
             for (const auto& val : vValues)
             {
-                size_t count = 0;
-
-                for (size_t i = 0; i < memArray[_vCols[j]]->size(); i++)
-                {
-                    if (closeEnough(memArray[_vCols[j]]->getValue(i), val))
-                        count++;
-                }
-
-                vCounted.push_back(count);
+                vCounted.push_back(findEqualRows(memArray[_vCols[j]].get(), val).size());
             }
         }
         else
         {
             for (const auto& sVal : vStringValues)
             {
-                size_t count = 0;
-
-                for (size_t i = 0; i < memArray[_vCols[j]]->size(); i++)
-                {
-                    if (memArray[_vCols[j]]->getValueAsInternalString(i) == sVal)
-                        count++;
-                }
-
-                vCounted.push_back(count);
+                vCounted.push_back(memArray[_vCols[j]]->findRows(sVal).size());
             }
         }
     }
@@ -3269,10 +3379,9 @@ std::vector<mu::value_type> Memory::getIndex(size_t col, const std::vector<mu::v
             if (vIndex.size())
                 vIndex.push_back(NAN);
 
-            for (size_t i = 0; i < memArray[col]->size(); i++)
+            for (size_t row : findEqualRows(memArray[col].get(), val))
             {
-                if (closeEnough(memArray[col]->getValue(i), val))
-                    vIndex.push_back(i+1);
+                vIndex.push_back(row+1);
             }
         }
     }
@@ -3283,10 +3392,9 @@ std::vector<mu::value_type> Memory::getIndex(size_t col, const std::vector<mu::v
             if (vIndex.size())
                 vIndex.push_back(NAN);
 
-            for (size_t i = 0; i < memArray[col]->size(); i++)
+            for (size_t row : memArray[col]->findRows(sVal))
             {
-                if (memArray[col]->getValueAsInternalString(i) == sVal)
-                    vIndex.push_back(i+1);
+                vIndex.push_back(row+1);
             }
         }
     }
@@ -3690,6 +3798,956 @@ std::vector<mu::value_type> Memory::getBins(size_t col, size_t nBins) const
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Hash functor for using numerical
+/// values as keys in hashed containers.
+/////////////////////////////////////////////////
+struct ValueHash
+{
+    size_t operator()(const mu::value_type& val) const
+    {
+        return std::hash<double>()(val.real()) ^ (std::hash<double>()(val.imag()) << 1);
+    }
+};
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper function to encode the
+/// values of a key column as dense integer
+/// codes. Categorical columns use their internal
+/// codes directly, all other columns are
+/// encoded in the order of the first occurence
+/// of each value. Invalid values get the code
+/// -1. Returns the number of distinct codes.
+///
+/// \param column const TableColumn*
+/// \param nRows size_t
+/// \param vCodes std::vector<int>&
+/// \return size_t
+///
+/////////////////////////////////////////////////
+static size_t encodeKeyColumn(const TableColumn* column, size_t nRows, std::vector<int>& vCodes)
+{
+    vCodes.assign(nRows, -1);
+    size_t nElems = std::min(nRows, column->size());
+
+    if (column->m_type == TableColumn::TYPE_CATEGORICAL)
+    {
+        const CategoricalColumn* catCol = static_cast<const CategoricalColumn*>(column);
+
+        #pragma omp parallel for
+        for (size_t i = 0; i < nElems; i++)
+        {
+            vCodes[i] = catCol->getCode(i);
+        }
+
+        return catCol->getCategories().size();
+    }
+
+    if (column->m_type == TableColumn::TYPE_STRING)
+    {
+        std::unordered_map<std::string, int> mDictionary;
+
+        for (size_t i = 0; i < nElems; i++)
+        {
+            std::string sValue = column->getValueAsInternalString(i);
+
+            if (!sValue.length())
+                continue;
+
+            vCodes[i] = mDictionary.emplace(sValue, mDictionary.size()).first->second;
+        }
+
+        return mDictionary.size();
+    }
+
+    std::unordered_map<mu::value_type, int, ValueHash> mDictionary;
+
+    for (size_t i = 0; i < nElems; i++)
+    {
+        mu::value_type val = column->getValue(i);
+
+        if (mu::isnan(val))
+            continue;
+
+        // Avoid different keys for signed zeros
+        val = mu::value_type(val.real() + 0.0, val.imag() + 0.0);
+        vCodes[i] = mDictionary.emplace(val, mDictionary.size()).first->second;
+    }
+
+    return mDictionary.size();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Partial aggregation of a single group.
+/////////////////////////////////////////////////
+struct GroupAggregate
+{
+    size_t nCount;
+    mu::value_type dSum;
+    double dMin;
+    double dMax;
+    double dSqDev;
+
+    GroupAggregate() : nCount(0), dSum(0.0), dMin(NAN), dMax(NAN), dSqDev(0.0) {}
+};
+
+
+/////////////////////////////////////////////////
+/// \brief Groups the rows of the table by the
+/// values in the key columns and aggregates the
+/// numerical columns per group. The rows are
+/// assigned to their groups in a single pass
+/// using dense key codes, which are addressed
+/// directly, if their number of combinations is
+/// small, and hashed otherwise. The aggregation
+/// itself runs in parallel on thread-private
+/// partial results, if there are enough rows per
+/// group to justify them. Rows with an invalid key
+/// are ignored. The groups appear in the order
+/// of their first occurence.
+///
+/// \param _vKeyCols const VectorIndex&
+/// \param vAggregations const std::vector<std::string>&
+/// \return NumeRe::Table
+///
+/////////////////////////////////////////////////
+NumeRe::Table Memory::groupBy(const VectorIndex& _vKeyCols, const std::vector<std::string>& vAggregations) const
+{
+    static const std::vector<std::string> vKnownAggregations({"count", "sum", "avg", "min", "max", "std", "med"});
+    const size_t NO_GROUP = std::numeric_limits<size_t>::max();
+
+    for (const std::string& sAgg : vAggregations)
+    {
+        if (std::find(vKnownAggregations.begin(), vKnownAggregations.end(), sAgg) == vKnownAggregations.end())
+            throw SyntaxError(SyntaxError::INVALID_MODE, "groupby(", SyntaxError::invalid_position, sAgg);
+    }
+
+    std::vector<size_t> vKeyCols;
+
+    for (size_t k = 0; k < _vKeyCols.size(); k++)
+    {
+        if (_vKeyCols[k] < 0 || _vKeyCols[k] >= (int)memArray.size() || !memArray[_vKeyCols[k]])
+            throw SyntaxError(SyntaxError::INVALID_INDEX, "groupby(", SyntaxError::invalid_position, toString(_vKeyCols[k]+1));
+
+        vKeyCols.push_back(_vKeyCols[k]);
+    }
+
+    if (!vKeyCols.size())
+        throw SyntaxError(SyntaxError::TOO_FEW_COLS, "groupby(", SyntaxError::invalid_position);
+
+    size_t nRows = getLines();
+
+    // Encode the keys and determine the number of
+    // possible key combinations
+    std::vector<std::vector<int>> vCodes(vKeyCols.size());
+    std::vector<size_t> vCardinality(vKeyCols.size());
+    uint64_t nCombinations = 1;
+    bool bCombinationsFit = true;
+
+    for (size_t k = 0; k < vKeyCols.size(); k++)
+    {
+        vCardinality[k] = std::max(encodeKeyColumn(memArray[vKeyCols[k]].get(), nRows, vCodes[k]), (size_t)1);
+
+        if (nCombinations > std::numeric_limits<uint64_t>::max() / vCardinality[k])
+            bCombinationsFit = false;
+        else
+            nCombinations *= vCardinality[k];
+    }
+
+    // Assign the rows to their groups
+    std::vector<size_t> vGroups(nRows, NO_GROUP);
+    std::vector<int> vFirstRows;
+    std::vector<size_t> vDirectTable;
+    std::unordered_map<uint64_t, size_t> mHashTable;
+    std::map<std::vector<int>, size_t> mTupleTable;
+    bool bDirect = bCombinationsFit && nCombinations <= std::max((uint64_t)nRows, (uint64_t)65536);
+
+    if (bDirect)
+        vDirectTable.assign(nCombinations, NO_GROUP);
+
+    for (size_t i = 0; i < nRows; i++)
+    {
+        uint64_t nCode = 0;
+        bool bValid = true;
+
+        for (size_t k = 0; k < vKeyCols.size(); k++)
+        {
+            if (vCodes[k][i] < 0)
+            {
+                bValid = false;
+                break;
+            }
+
+            if (bCombinationsFit)
+                nCode = nCode * vCardinality[k] + vCodes[k][i];
+        }
+
+        if (!bValid)
+            continue;
+
+        size_t* group;
+
+        if (bDirect)
+            group = &vDirectTable[nCode];
+        else if (bCombinationsFit)
+            group = &mHashTable.emplace(nCode, NO_GROUP).first->second;
+        else
+        {
+            std::vector<int> vTuple(vKeyCols.size());
+
+            for (size_t k = 0; k < vKeyCols.size(); k++)
+                vTuple[k] = vCodes[k][i];
+
+            group = &mTupleTable.emplace(vTuple, NO_GROUP).first->second;
+        }
+
+        if (*group == NO_GROUP)
+        {
+            *group = vFirstRows.size();
+            vFirstRows.push_back(i);
+        }
+
+        vGroups[i] = *group;
+    }
+
+    size_t nGroups = vFirstRows.size();
+    NumeRe::Table groupTable;
+    size_t nCol = 0;
+
+    // The key columns keep their types
+    for (size_t k = 0; k < vKeyCols.size(); k++)
+    {
+        groupTable.setColumn(nCol++, nGroups ? memArray[vKeyCols[k]]->copy(VectorIndex(vFirstRows)) : new ValueColumn);
+    }
+
+    if (std::find(vAggregations.begin(), vAggregations.end(), "count") != vAggregations.end())
+    {
+        ValueColumn* countCol = new ValueColumn(nGroups);
+        countCol->m_sHeadLine = "count";
+        std::vector<size_t> vGroupSizes(nGroups, 0);
+
+        for (size_t i = 0; i < nRows; i++)
+        {
+            if (vGroups[i] != NO_GROUP)
+                vGroupSizes[vGroups[i]]++;
+        }
+
+        for (size_t g = 0; g < nGroups; g++)
+            countCol->setValue(g, vGroupSizes[g]);
+
+        groupTable.setColumn(nCol++, countCol);
+    }
+
+    bool bNeedsStd = std::find(vAggregations.begin(), vAggregations.end(), "std") != vAggregations.end();
+    bool bNeedsMed = std::find(vAggregations.begin(), vAggregations.end(), "med") != vAggregations.end();
+
+    // Every thread needs its own partial aggregate for
+    // every group. Limit the number of threads so that
+    // the partials never outnumber the rows, i.e. keys
+    // with a high cardinality are aggregated serially
+    int nThreads = std::max(1, (int)std::min((size_t)omp_get_max_threads(), nRows / std::max(nGroups, (size_t)1)));
+
+    // Aggregate all numerical columns, which are not
+    // part of the key
+    for (size_t j = 0; j < memArray.size(); j++)
+    {
+        if (!memArray[j]
+            || std::find(vKeyCols.begin(), vKeyCols.end(), j) != vKeyCols.end()
+            || (memArray[j]->m_type != TableColumn::TYPE_VALUE
+                && memArray[j]->m_type != TableColumn::TYPE_DATETIME
+                && memArray[j]->m_type != TableColumn::TYPE_LOGICAL))
+            continue;
+
+        const TableColumn* column = memArray[j].get();
+        size_t nElems = std::min(nRows, column->size());
+        const mu::value_type* values = column->getValueArray();
+        std::vector<mu::value_type> vValues;
+
+        if (!values)
+        {
+            vValues.resize(nElems);
+
+            #pragma omp parallel for
+            for (size_t i = 0; i < nElems; i++)
+            {
+                vValues[i] = column->getValue(i);
+            }
+
+            values = vValues.data();
+        }
+
+        // Every thread aggregates into its own partial
+        // results, which are merged afterwards
+        std::vector<std::vector<GroupAggregate>> vPartials(nThreads, std::vector<GroupAggregate>(nGroups));
+
+        #pragma omp parallel num_threads(nThreads)
+        {
+            std::vector<GroupAggregate>& vPartial = vPartials[omp_get_thread_num()];
+
+            #pragma omp for schedule(static)
+            for (size_t i = 0; i < nElems; i++)
+            {
+                if (vGroups[i] == NO_GROUP || mu::isnan(values[i]))
+                    continue;
+
+                GroupAggregate& agg = vPartial[vGroups[i]];
+
+                if (!agg.nCount || values[i].real() < agg.dMin)
+                    agg.dMin = values[i].real();
+
+                if (!agg.nCount || values[i].real() > agg.dMax)
+                    agg.dMax = values[i].real();
+
+                agg.nCount++;
+                agg.dSum += values[i];
+            }
+        }
+
+        std::vector<GroupAggregate>& vResult = vPartials.front();
+
+        for (int t = 1; t < nThreads; t++)
+        {
+            for (size_t g = 0; g < nGroups; g++)
+            {
+                const GroupAggregate& agg = vPartials[t][g];
+
+                if (!agg.nCount)
+                    continue;
+
+                if (!vResult[g].nCount || agg.dMin < vResult[g].dMin)
+                    vResult[g].dMin = agg.dMin;
+
+                if (!vResult[g].nCount || agg.dMax > vResult[g].dMax)
+                    vResult[g].dMax = agg.dMax;
+
+                vResult[g].nCount += agg.nCount;
+                vResult[g].dSum += agg.dSum;
+            }
+        }
+
+        // The standard deviation needs a second pass
+        // using the averages of the groups
+        if (bNeedsStd)
+        {
+            for (int t = 1; t < nThreads; t++)
+            {
+                for (size_t g = 0; g < nGroups; g++)
+                    vPartials[t][g].dSqDev = 0.0;
+            }
+
+            #pragma omp parallel num_threads(nThreads)
+            {
+                std::vector<GroupAggregate>& vPartial = vPartials[omp_get_thread_num()];
+
+                #pragma omp for schedule(static)
+                for (size_t i = 0; i < nElems; i++)
+                {
+                    if (vGroups[i] == NO_GROUP || mu::isnan(values[i]))
+                        continue;
+
+                    mu::value_type dDev = values[i] - vResult[vGroups[i]].dSum / (double)vResult[vGroups[i]].nCount;
+                    vPartial[vGroups[i]].dSqDev += std::norm(dDev);
+                }
+            }
+
+            for (int t = 1; t < nThreads; t++)
+            {
+                for (size_t g = 0; g < nGroups; g++)
+                    vResult[g].dSqDev += vPartials[t][g].dSqDev;
+            }
+        }
+
+        // The median needs all values of a group. Sort
+        // them into contiguous buckets first
+        std::vector<double> vMedians;
+
+        if (bNeedsMed)
+        {
+            std::vector<size_t> vOffsets(nGroups+1, 0);
+
+            for (size_t g = 0; g < nGroups; g++)
+                vOffsets[g+1] = vOffsets[g] + vResult[g].nCount;
+
+            std::vector<double> vBuckets(vOffsets.back());
+            std::vector<size_t> vFill(vOffsets.begin(), vOffsets.end()-1);
+
+            for (size_t i = 0; i < nElems; i++)
+            {
+                if (vGroups[i] != NO_GROUP && !mu::isnan(values[i]))
+                    vBuckets[vFill[vGroups[i]]++] = values[i].real();
+            }
+
+            vMedians.resize(nGroups, NAN);
+
+            #pragma omp parallel for schedule(dynamic, 64)
+            for (size_t g = 0; g < nGroups; g++)
+            {
+                size_t nCount = vResult[g].nCount;
+
+                if (!nCount)
+                    continue;
+
+                double* first = &vBuckets[vOffsets[g]];
+                std::nth_element(first, first + nCount / 2, first + nCount);
+                vMedians[g] = first[nCount / 2];
+
+                // Even number of elements: average with the
+                // largest element of the lower half
+                if (!(nCount % 2))
+                    vMedians[g] = 0.5 * (vMedians[g] + *std::max_element(first, first + nCount / 2));
+            }
+        }
+
+        // Write the aggregated columns
+        for (const std::string& sAgg : vAggregations)
+        {
+            if (sAgg == "count")
+                continue;
+
+            ValueColumn* aggCol = new ValueColumn(nGroups);
+            aggCol->m_sHeadLine = sAgg + "(" + column->m_sHeadLine + ")";
+
+            for (size_t g = 0; g < nGroups; g++)
+            {
+                const GroupAggregate& agg = vResult[g];
+
+                if (!agg.nCount)
+                    continue;
+
+                if (sAgg == "sum")
+                    aggCol->setValue(g, agg.dSum);
+                else if (sAgg == "avg")
+                    aggCol->setValue(g, agg.dSum / (double)agg.nCount);
+                else if (sAgg == "min")
+                    aggCol->setValue(g, agg.dMin);
+                else if (sAgg == "max")
+                    aggCol->setValue(g, agg.dMax);
+                else if (sAgg == "std" && agg.nCount > 1)
+                    aggCol->setValue(g, std::sqrt(agg.dSqDev / (agg.nCount - 1.0)));
+                else if (sAgg == "med")
+                    aggCol->setValue(g, vMedians[g]);
+            }
+
+            groupTable.setColumn(nCol++, aggCol);
+        }
+    }
+
+    return groupTable;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Dictionary for encoding the keys of a
+/// join as dense integer codes. Both key columns
+/// of a pair share the same dictionary. String-
+/// like keys are compared by their strings, all
+/// other keys by their values.
+/////////////////////////////////////////////////
+struct JoinKeyDictionary
+{
+    bool m_isString;
+    std::unordered_map<std::string, int> m_strings;
+    std::unordered_map<mu::value_type, int, ValueHash> m_values;
+
+    JoinKeyDictionary(bool isString) : m_isString(isString) {}
+
+    /////////////////////////////////////////////////
+    /// \brief Inserts the keys of the build side
+    /// into the dictionary and writes their codes.
+    /// Invalid keys get the code -1.
+    ///
+    /// \param column const TableColumn*
+    /// \param nRows size_t
+    /// \param vCodes std::vector<int>&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void insert(const TableColumn* column, size_t nRows, std::vector<int>& vCodes)
+    {
+        vCodes.assign(nRows, -1);
+        size_t nElems = std::min(nRows, column->size());
+
+        for (size_t i = 0; i < nElems; i++)
+        {
+            if (m_isString)
+            {
+                std::string sKey = column->getValueAsInternalString(i);
+
+                if (sKey.length())
+                    vCodes[i] = m_strings.emplace(sKey, m_strings.size()).first->second;
+            }
+            else
+            {
+                mu::value_type key = column->getValue(i);
+
+                // Avoid different keys for signed zeros
+                if (!mu::isnan(key))
+                    vCodes[i] = m_values.emplace(mu::value_type(key.real() + 0.0, key.imag() + 0.0), m_values.size()).first->second;
+            }
+        }
+    }
+
+    /////////////////////////////////////////////////
+    /// \brief Looks up the keys of the probe side in
+    /// parallel without modifying the dictionary.
+    /// Invalid and unknown keys get the code -1.
+    ///
+    /// \param column const TableColumn*
+    /// \param nRows size_t
+    /// \param vCodes std::vector<int>&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void find(const TableColumn* column, size_t nRows, std::vector<int>& vCodes) const
+    {
+        vCodes.assign(nRows, -1);
+        size_t nElems = std::min(nRows, column->size());
+
+        // Categorical columns only need a single lookup
+        // per category
+        if (m_isString && column->m_type == TableColumn::TYPE_CATEGORICAL)
+        {
+            const CategoricalColumn* catCol = static_cast<const CategoricalColumn*>(column);
+            const std::vector<std::string>& vCategories = catCol->getCategories();
+            std::vector<int> vCategoryCodes(vCategories.size(), -1);
+
+            for (size_t c = 0; c < vCategories.size(); c++)
+            {
+                auto iter = m_strings.find(vCategories[c]);
+
+                if (iter != m_strings.end())
+                    vCategoryCodes[c] = iter->second;
+            }
+
+            #pragma omp parallel for
+            for (size_t i = 0; i < nElems; i++)
+            {
+                int nCode = catCol->getCode(i);
+
+                if (nCode >= 0 && nCode < (int)vCategoryCodes.size())
+                    vCodes[i] = vCategoryCodes[nCode];
+            }
+
+            return;
+        }
+
+        #pragma omp parallel for
+        for (size_t i = 0; i < nElems; i++)
+        {
+            if (m_isString)
+            {
+                auto iter = m_strings.find(column->getValueAsInternalString(i));
+
+                if (iter != m_strings.end())
+                    vCodes[i] = iter->second;
+            }
+            else
+            {
+                mu::value_type key = column->getValue(i);
+
+                if (mu::isnan(key))
+                    continue;
+
+                auto iter = m_values.find(mu::value_type(key.real() + 0.0, key.imag() + 0.0));
+
+                if (iter != m_values.end())
+                    vCodes[i] = iter->second;
+            }
+        }
+    }
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the number of distinct keys.
+    ///
+    /// \return size_t
+    ///
+    /////////////////////////////////////////////////
+    size_t size() const
+    {
+        return m_isString ? m_strings.size() : m_values.size();
+    }
+};
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper function to combine the
+/// codes of a further key column with the
+/// already combined codes. The combined codes
+/// are dense again, wherefore the product of the
+/// cardinalities always fits into 64 bits. Only
+/// the build side inserts new combinations.
+///
+/// \param vCodes std::vector<int>&
+/// \param vNextCodes const std::vector<int>&
+/// \param nNextCardinality size_t
+/// \param mCombinations std::unordered_map<uint64_t,int>&
+/// \param isBuildSide bool
+/// \return void
+///
+/////////////////////////////////////////////////
+static void combineJoinKeys(std::vector<int>& vCodes, const std::vector<int>& vNextCodes, size_t nNextCardinality,
+                            std::unordered_map<uint64_t,int>& mCombinations, bool isBuildSide)
+{
+    if (isBuildSide)
+    {
+        for (size_t i = 0; i < vCodes.size(); i++)
+        {
+            if (vCodes[i] < 0 || vNextCodes[i] < 0)
+                vCodes[i] = -1;
+            else
+                vCodes[i] = mCombinations.emplace((uint64_t)vCodes[i] * nNextCardinality + vNextCodes[i],
+                                                  mCombinations.size()).first->second;
+        }
+
+        return;
+    }
+
+    #pragma omp parallel for
+    for (size_t i = 0; i < vCodes.size(); i++)
+    {
+        if (vCodes[i] < 0 || vNextCodes[i] < 0)
+        {
+            vCodes[i] = -1;
+            continue;
+        }
+
+        auto iter = mCombinations.find((uint64_t)vCodes[i] * nNextCardinality + vNextCodes[i]);
+        vCodes[i] = iter != mCombinations.end() ? iter->second : -1;
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper function to determine,
+/// whether a key column can be compared by its
+/// numerical values.
+///
+/// \param column const TableColumn*
+/// \return bool
+///
+/////////////////////////////////////////////////
+static bool isValueLikeKey(const TableColumn* column)
+{
+    return column->m_type == TableColumn::TYPE_VALUE
+        || column->m_type == TableColumn::TYPE_DATETIME
+        || column->m_type == TableColumn::TYPE_LOGICAL;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper function to gather the
+/// rows of a join result from a source column.
+/// Rows without a match in the source table are
+/// marked as VectorIndex::INVALID and are left
+/// empty.
+///
+/// \param source const TableColumn*
+/// \param vRows const std::vector<int>&
+/// \return TableColumn*
+///
+/////////////////////////////////////////////////
+static TableColumn* gatherJoinRows(const TableColumn* source, const std::vector<int>& vRows)
+{
+    bool hasUnmatched = std::find(vRows.begin(), vRows.end(), VectorIndex::INVALID) != vRows.end();
+
+    if (vRows.size() && !hasUnmatched)
+        return source->copy(VectorIndex(vRows));
+
+    // Create an empty column of the same type and
+    // fill in the matched rows one by one
+    TableColumn* col = source->copy(VectorIndex(0));
+    col->resize(0);
+    col->resize(vRows.size());
+
+    bool isValueLike = isValueLikeKey(col);
+
+    for (size_t i = 0; i < vRows.size(); i++)
+    {
+        if (vRows[i] == VectorIndex::INVALID)
+            continue;
+
+        if (isValueLike)
+            col->setValue(i, source->getValue(vRows[i]));
+        else
+            col->setValue(i, source->getValueAsInternalString(vRows[i]));
+    }
+
+    return col;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Joins this table with another table
+/// using the selected key columns. The keys of
+/// the smaller table are hashed, the larger
+/// table is probed in parallel. The result
+/// contains the key columns followed by the
+/// remaining columns of this and the other
+/// table. All columns keep their types. Rows
+/// with invalid keys never match.
+///
+/// \param other const Memory&
+/// \param _vKeyCols const VectorIndex&
+/// \param _vOtherKeyCols const VectorIndex&
+/// \param type JoinType
+/// \return NumeRe::Table
+///
+/////////////////////////////////////////////////
+NumeRe::Table Memory::join(const Memory& other, const VectorIndex& _vKeyCols, const VectorIndex& _vOtherKeyCols, JoinType type) const
+{
+    if (!_vKeyCols.size() || _vKeyCols.size() != _vOtherKeyCols.size())
+        throw SyntaxError(SyntaxError::INVALID_INDEX, "join(", SyntaxError::invalid_position);
+
+    std::vector<size_t> vKeyCols;
+    std::vector<size_t> vOtherKeyCols;
+
+    for (size_t k = 0; k < _vKeyCols.size(); k++)
+    {
+        if (_vKeyCols[k] < 0 || _vKeyCols[k] >= (int)memArray.size() || !memArray[_vKeyCols[k]])
+            throw SyntaxError(SyntaxError::INVALID_INDEX, "join(", SyntaxError::invalid_position, toString(_vKeyCols[k]+1));
+
+        if (_vOtherKeyCols[k] < 0 || _vOtherKeyCols[k] >= (int)other.memArray.size() || !other.memArray[_vOtherKeyCols[k]])
+            throw SyntaxError(SyntaxError::INVALID_INDEX, "join(", SyntaxError::invalid_position, toString(_vOtherKeyCols[k]+1));
+
+        vKeyCols.push_back(_vKeyCols[k]);
+        vOtherKeyCols.push_back(_vOtherKeyCols[k]);
+    }
+
+    size_t nRows = getLines();
+    size_t nOtherRows = other.getLines();
+
+    // Hash the keys of the smaller table
+    bool buildIsThis = nRows < nOtherRows;
+    const Memory& build = buildIsThis ? *this : other;
+    const Memory& probe = buildIsThis ? other : *this;
+    const std::vector<size_t>& vBuildKeys = buildIsThis ? vKeyCols : vOtherKeyCols;
+    const std::vector<size_t>& vProbeKeys = buildIsThis ? vOtherKeyCols : vKeyCols;
+    size_t nBuildRows = buildIsThis ? nRows : nOtherRows;
+    size_t nProbeRows = buildIsThis ? nOtherRows : nRows;
+
+    std::vector<int> vBuildCodes;
+    std::vector<int> vProbeCodes;
+
+    for (size_t k = 0; k < vBuildKeys.size(); k++)
+    {
+        const TableColumn* buildCol = build.memArray[vBuildKeys[k]].get();
+        const TableColumn* probeCol = probe.memArray[vProbeKeys[k]].get();
+
+        // Categorical codes differ between tables,
+        // wherefore categories are compared as strings
+        JoinKeyDictionary dict(!isValueLikeKey(buildCol) || !isValueLikeKey(probeCol));
+
+        std::vector<int> vBuildKeyCodes;
+        std::vector<int> vProbeKeyCodes;
+        dict.insert(buildCol, nBuildRows, vBuildKeyCodes);
+        dict.find(probeCol, nProbeRows, vProbeKeyCodes);
+
+        if (!k)
+        {
+            vBuildCodes.swap(vBuildKeyCodes);
+            vProbeCodes.swap(vProbeKeyCodes);
+        }
+        else
+        {
+            std::unordered_map<uint64_t,int> mCombinations;
+            combineJoinKeys(vBuildCodes, vBuildKeyCodes, dict.size(), mCombinations, true);
+            combineJoinKeys(vProbeCodes, vProbeKeyCodes, dict.size(), mCombinations, false);
+        }
+    }
+
+    // Sort the build rows into contiguous buckets
+    // per key
+    int nKeys = 0;
+
+    for (int code : vBuildCodes)
+        nKeys = std::max(nKeys, code+1);
+
+    std::vector<size_t> vOffsets(nKeys+1, 0);
+
+    for (int code : vBuildCodes)
+    {
+        if (code >= 0)
+            vOffsets[code+1]++;
+    }
+
+    for (int c = 0; c < nKeys; c++)
+        vOffsets[c+1] += vOffsets[c];
+
+    std::vector<int> vBucketRows(vOffsets.back());
+    std::vector<size_t> vFill(vOffsets.begin(), vOffsets.end()-1);
+
+    for (size_t i = 0; i < nBuildRows; i++)
+    {
+        if (vBuildCodes[i] >= 0)
+            vBucketRows[vFill[vBuildCodes[i]]++] = i;
+    }
+
+    bool keepProbe = type == JOIN_OUTER || (type == JOIN_LEFT && !buildIsThis);
+    bool keepBuild = type == JOIN_OUTER || (type == JOIN_LEFT && buildIsThis);
+
+    // Count the matches of every probe row in parallel
+    // to determine the positions in the result
+    std::vector<size_t> vProbeOffsets(nProbeRows+1, 0);
+
+    #pragma omp parallel for
+    for (size_t i = 0; i < nProbeRows; i++)
+    {
+        size_t nMatches = vProbeCodes[i] >= 0 ? vOffsets[vProbeCodes[i]+1] - vOffsets[vProbeCodes[i]] : 0;
+        vProbeOffsets[i+1] = !nMatches && keepProbe ? 1 : nMatches;
+    }
+
+    for (size_t i = 0; i < nProbeRows; i++)
+        vProbeOffsets[i+1] += vProbeOffsets[i];
+
+    std::vector<int> vBuildRows(vProbeOffsets.back(), VectorIndex::INVALID);
+    std::vector<int> vProbeRows(vProbeOffsets.back(), VectorIndex::INVALID);
+
+    #pragma omp parallel for
+    for (size_t i = 0; i < nProbeRows; i++)
+    {
+        size_t pos = vProbeOffsets[i];
+
+        if (pos == vProbeOffsets[i+1])
+            continue;
+
+        if (vProbeCodes[i] < 0 || vOffsets[vProbeCodes[i]] == vOffsets[vProbeCodes[i]+1])
+        {
+            vProbeRows[pos] = i;
+            continue;
+        }
+
+        for (size_t n = vOffsets[vProbeCodes[i]]; n < vOffsets[vProbeCodes[i]+1]; n++, pos++)
+        {
+            vBuildRows[pos] = vBucketRows[n];
+            vProbeRows[pos] = i;
+        }
+    }
+
+    // Append the build rows without any match
+    if (keepBuild)
+    {
+        std::vector<bool> vMatched(nKeys, false);
+
+        for (int code : vProbeCodes)
+        {
+            if (code >= 0)
+                vMatched[code] = true;
+        }
+
+        for (size_t i = 0; i < nBuildRows; i++)
+        {
+            if (vBuildCodes[i] < 0 || !vMatched[vBuildCodes[i]])
+            {
+                vBuildRows.push_back(i);
+                vProbeRows.push_back(VectorIndex::INVALID);
+            }
+        }
+    }
+
+    std::vector<int>& vRows = buildIsThis ? vBuildRows : vProbeRows;
+    std::vector<int>& vOtherRows = buildIsThis ? vProbeRows : vBuildRows;
+
+    // Restore the order of this table, if it has been
+    // the build side. Rows only present in the other
+    // table are moved to the end
+    if (buildIsThis)
+    {
+        std::vector<size_t> vOrder(vRows.size());
+
+        for (size_t i = 0; i < vOrder.size(); i++)
+            vOrder[i] = i;
+
+        std::stable_sort(vOrder.begin(), vOrder.end(),
+                         [&vRows](size_t i, size_t j){return (unsigned int)vRows[i] < (unsigned int)vRows[j];});
+
+        std::vector<int> vSortedRows(vOrder.size());
+        std::vector<int> vSortedOtherRows(vOrder.size());
+
+        for (size_t i = 0; i < vOrder.size(); i++)
+        {
+            vSortedRows[i] = vRows[vOrder[i]];
+            vSortedOtherRows[i] = vOtherRows[vOrder[i]];
+        }
+
+        vRows.swap(vSortedRows);
+        vOtherRows.swap(vSortedOtherRows);
+    }
+
+    // Materialize the result columns. The copies are
+    // independent from each other
+    std::vector<const TableColumn*> vSources;
+    std::vector<bool> vFromOther;
+
+    for (size_t k = 0; k < vKeyCols.size(); k++)
+    {
+        vSources.push_back(memArray[vKeyCols[k]].get());
+        vFromOther.push_back(false);
+    }
+
+    for (size_t j = 0; j < memArray.size(); j++)
+    {
+        if (memArray[j] && std::find(vKeyCols.begin(), vKeyCols.end(), j) == vKeyCols.end())
+        {
+            vSources.push_back(memArray[j].get());
+            vFromOther.push_back(false);
+        }
+    }
+
+    for (size_t j = 0; j < other.memArray.size(); j++)
+    {
+        if (other.memArray[j] && std::find(vOtherKeyCols.begin(), vOtherKeyCols.end(), j) == vOtherKeyCols.end())
+        {
+            vSources.push_back(other.memArray[j].get());
+            vFromOther.push_back(true);
+        }
+    }
+
+    size_t nResultRows = vRows.size();
+    std::vector<TableColumn*> vColumns(vSources.size(), nullptr);
+
+    // Unmatched rows are marked as invalid and must
+    // not be passed as a VectorIndex, because its size
+    // would collapse, if the last row is invalid
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t j = 0; j < vSources.size(); j++)
+    {
+        vColumns[j] = gatherJoinRows(vSources[j], vFromOther[j] ? vOtherRows : vRows);
+    }
+
+    // Rows only present in the other table take their
+    // keys from the other table
+    if (type == JOIN_OUTER)
+    {
+        for (size_t k = 0; k < vKeyCols.size(); k++)
+        {
+            const TableColumn* otherKey = other.memArray[vOtherKeyCols[k]].get();
+
+            for (size_t i = 0; i < nResultRows; i++)
+            {
+                if (vRows[i] != VectorIndex::INVALID || vOtherRows[i] == VectorIndex::INVALID)
+                    continue;
+
+                if (vColumns[k]->m_type >= TableColumn::STRINGLIKE || vColumns[k]->m_type == TableColumn::TYPE_CATEGORICAL)
+                    vColumns[k]->setValue(i, otherKey->getValueAsInternalString(vOtherRows[i]));
+                else
+                    vColumns[k]->setValue(i, otherKey->getValue(vOtherRows[i]));
+            }
+        }
+    }
+
+    NumeRe::Table joinTable;
+
+    for (size_t j = 0; j < vColumns.size(); j++)
+    {
+        joinTable.setColumn(j, vColumns[j]);
+    }
+
+    return joinTable;
+}
+
+
 /////////////////////////////////////////////////
 /// \brief This method is the retouching main
 /// method. It will redirect the control into the
@@ -82,6 +82,13 @@ class Memory : public Sorter
             RANK_FRACTIONAL
         };
 
+        enum JoinType
+        {
+            JOIN_INNER,
+            JOIN_LEFT,
+            JOIN_OUTER
+        };
+
 	private:
 	    friend class MemoryManager;
 	    friend class NumeRe::FileAdapter;
@@ -108,6 +115,7 @@ class Memory : public Sorter
 		void smoothingWindow1D(const VectorIndex& _vLine, const VectorIndex& _vCol, size_t i, size_t j, NumeRe::Filter* _filter, bool smoothLines);
 		void smoothingWindow2D(const VectorIndex& _vLine, const VectorIndex& _vCol, size_t i, size_t j, NumeRe::Filter* _filter);
 		void calculateStats(const VectorIndex& _vLine, const VectorIndex& _vCol, std::vector<StatsLogic>& operation) const;
+		std::vector<double> readFiniteValues(const VectorIndex& _vLine, const VectorIndex& _vCol) const;
 
     public:
 		Memory();
@@ -142,6 +150,7 @@ class Memory : public Sorter
 		ValueVector getCategoryList(const VectorIndex& _vCol) const;
 		Memory* extractRange(const VectorIndex& _vLine, const VectorIndex& _vCol) const;
 		void copyElementsInto(std::vector<mu::value_type>* vTarget, const VectorIndex& _vLine, const VectorIndex& _vCol) const;
+		const mu::value_type* getContiguousValues(const VectorIndex& _vLine, const VectorIndex& _vCol, size_t& nElems) const;
 		std::string getHeadLineElement(size_t _i) const;
 		std::vector<std::string> getHeadLineElement(const VectorIndex& _vCol) const;
 		size_t getAppendedZeroes(size_t _i) const;
@@ -202,6 +211,8 @@ class Memory : public Sorter
         std::vector<mu::value_type> getRank(size_t col, const VectorIndex& _vIndex, RankingStrategy _strat) const;
         std::vector<mu::value_type> getZScore(size_t col, const VectorIndex& _vIndex) const;
         std::vector<mu::value_type> getBins(size_t col, size_t nBins) const;
+        NumeRe::Table groupBy(const VectorIndex& _vKeyCols, const std::vector<std::string>& vAggregations) const;
+        NumeRe::Table join(const Memory& other, const VectorIndex& _vKeyCols, const VectorIndex& _vOtherKeyCols, JoinType type) const;
 
         bool smooth(VectorIndex _vLine, VectorIndex _vCol, NumeRe::FilterSettings _settings, AppDir Direction = ALL);
         bool retouch(VectorIndex _vLine, VectorIndex _vCol, AppDir Direction = ALL);
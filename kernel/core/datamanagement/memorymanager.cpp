@@ -43,6 +43,7 @@ using namespace std;
 MemoryManager::MemoryManager() : NumeRe::FileAdapter(), StringMemory(), NumeRe::ClusterManager()
 {
 	bSaveMutex = false;
+	bHasPendingTables = false;
 	sCache_file = "<>/numere.cache";
 	sPredefinedFuncs = "";
 	sUserdefinedFuncs = "";
@@ -92,6 +93,7 @@ void MemoryManager::removeTablesFromMemory()
             delete vMemory[i];
 
 		vMemory.clear();
+		clearPendingTables();
 		bSaveMutex = false;
 		mCachesMap.clear();
 		mCachesMap["table"] = std::make_pair(0u, 0u);
@@ -117,6 +119,11 @@ bool MemoryManager::isValid() const
     {
         if (vMemory[i]->getCols(false))
             return true;
+
+        PendingTable pending;
+
+        if (getPendingTable(i, pending) && pending.nCols)
+            return true;
     }
 
 	return false;
@@ -303,6 +310,12 @@ bool MemoryManager::saveToCacheFile()
 
     bSaveMutex = true;
 
+    // The cache file will be overwritten, so we
+    // need the remaining tables from the last
+    // session in memory first. Unreadable tables
+    // are dropped with a warning
+    loadPendingTables();
+
     sCache_file = ValidFileName(sCache_file, ".cache");
 
     NumeRe::CacheFile cacheFile(sCache_file);
@@ -336,6 +349,146 @@ bool MemoryManager::saveToCacheFile()
 }
 
 
+/////////////////////////////////////////////////
+/// \brief This member function loads the passed
+/// table from the cache file of the last
+/// session, if it has not been loaded yet.
+/// Loading a table does not change its save
+/// status. A table, which cannot be read, is
+/// dropped with a warning and stays empty, so
+/// that the remaining tables can still be saved.
+///
+/// \param _mem Memory*
+/// \return void
+///
+/////////////////////////////////////////////////
+void MemoryManager::loadPendingTable(Memory* _mem) const
+{
+    if (!bHasPendingTables)
+        return;
+
+    bool bFailed = false;
+
+    // Other threads accessing the same table have to
+    // wait until it has been loaded completely
+    #pragma omp critical (MemoryManagerPendingTables)
+    {
+        auto iter = mPendingTables.find(_mem);
+
+        if (iter != mPendingTables.end())
+        {
+            bool bIsSaved = _mem->getSaveStatus();
+
+            try
+            {
+                NumeRe::CacheFile cacheFile(sPendingCacheFile);
+
+                // Reading the table verifies its checksum
+                cacheFile.readCacheHeader();
+                cacheFile.readTable(iter->second.nthTable);
+
+                // Ensure that the table still corresponds to its header
+                if (cacheFile.getRows() != iter->second.nRows || cacheFile.getCols() != iter->second.nCols)
+                    throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sPendingCacheFile, SyntaxError::invalid_position, sPendingCacheFile);
+
+                _mem->resizeMemory(cacheFile.getRows(), cacheFile.getCols());
+                cacheFile.getData(&_mem->memArray);
+                _mem->shrink();
+            }
+            catch (...)
+            {
+                _mem->clear();
+                bFailed = true;
+            }
+
+            _mem->setSaveStatus(bIsSaved);
+            mPendingTables.erase(iter);
+            bHasPendingTables = !mPendingTables.empty();
+        }
+    }
+
+    if (bFailed)
+    {
+        std::string sTable;
+
+        for (const auto& iter : mCachesMap)
+        {
+            if (vMemory[iter.second.first] == _mem)
+                sTable = iter.first;
+        }
+
+        NumeReKernel::issueWarning("The table \"" + sTable + "()\" could not be restored from \"" + sPendingCacheFile
+                                   + "\" and has been emptied.");
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This member function loads all tables
+/// from the cache file of the last session,
+/// which have not been loaded yet.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void MemoryManager::loadPendingTables() const
+{
+    while (bHasPendingTables)
+    {
+        Memory* _mem = nullptr;
+
+        #pragma omp critical (MemoryManagerPendingTables)
+        {
+            if (mPendingTables.size())
+                _mem = mPendingTables.begin()->first;
+        }
+
+        if (!_mem)
+            break;
+
+        loadPendingTable(_mem);
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Removes the passed table from the
+/// pending tables, because it is deleted or
+/// replaced.
+///
+/// \param _mem Memory*
+/// \return void
+///
+/////////////////////////////////////////////////
+void MemoryManager::dropPendingTable(Memory* _mem)
+{
+    if (!bHasPendingTables)
+        return;
+
+    #pragma omp critical (MemoryManagerPendingTables)
+    {
+        mPendingTables.erase(_mem);
+        bHasPendingTables = !mPendingTables.empty();
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Removes all pending tables.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void MemoryManager::clearPendingTables()
+{
+    #pragma omp critical (MemoryManagerPendingTables)
+    {
+        mPendingTables.clear();
+        bHasPendingTables = false;
+    }
+}
+
+
 /////////////////////////////////////////////////
 /// \brief This member function wraps the loading
 /// of the tables from the cache file. It will
@@ -364,7 +517,9 @@ bool MemoryManager::loadFromCacheFile()
 /// \brief This member function tries to load the
 /// contents of the cache file in the new cache
 /// file format. If it does not succeed, false is
-/// returned.
+/// returned. Only the table headers are read
+/// here. The tables themselves are loaded on
+/// their first access (see loadPendingTable()).
 ///
 /// \return bool
 ///
@@ -382,24 +537,30 @@ bool MemoryManager::loadFromNewCacheFile()
             delete vMemory[i];
 
         vMemory.clear();
+        clearPendingTables();
         mCachesMap.clear();
 
+        std::map<Memory*, PendingTable> mTables;
+
         for (size_t i = 0; i < nCaches; i++)
         {
-            cacheFile.read();
+            cacheFile.readTableInformation(i);
 
             mCachesMap[cacheFile.getTableName()] = std::make_pair(vMemory.size(), vMemory.size());
             vMemory.push_back(new Memory());
-
-            vMemory.back()->resizeMemory(cacheFile.getRows(), cacheFile.getCols());
-            cacheFile.getData(&vMemory.back()->memArray);
-
-            vMemory.back()->shrink();
+            mTables[vMemory.back()] = {i, cacheFile.getRows(), cacheFile.getCols()};
 
             if (cacheFile.getComment() != "NO COMMENT")
                 vMemory.back()->m_meta.comment = cacheFile.getComment();
         }
 
+        #pragma omp critical (MemoryManagerPendingTables)
+        {
+            mPendingTables.swap(mTables);
+            bHasPendingTables = !mPendingTables.empty();
+        }
+
+        sPendingCacheFile = sCache_file;
         bSaveMutex = false;
         return true;
 
@@ -473,6 +634,7 @@ bool MemoryManager::loadFromLegacyCacheFile()
                 delete vMemory[i];
 
             vMemory.clear();
+            clearPendingTables();
             mCachesMap.clear();
 
             for (size_t i = 0; i < cachemapssize; i++)
@@ -885,6 +1047,7 @@ void MemoryManager::melt(Memory* _mem, const string& sTable, bool overrideTarget
     else if (overrideTarget)
     {
         // Shall the original table be overwritten?
+        dropPendingTable(vMemory[mCachesMap[sTable].first]);
         delete vMemory[mCachesMap[sTable].first];
         vMemory[mCachesMap[sTable].first] = _mem;
     }
@@ -892,6 +1055,7 @@ void MemoryManager::melt(Memory* _mem, const string& sTable, bool overrideTarget
     {
         // Combine both tables
         Memory* _existingMem = vMemory[mCachesMap[sTable].first];
+        loadPendingTable(_existingMem);
 
         size_t nCols = _existingMem->memArray.size();
 
@@ -1105,6 +1269,7 @@ bool MemoryManager::deleteTable(const string& sCache)
         {
             if (vMemory.size() > iter->second.first)
             {
+                dropPendingTable(vMemory[iter->second.first]);
                 delete vMemory[iter->second.first];
                 vMemory.erase(vMemory.begin() + iter->second.first);
             }
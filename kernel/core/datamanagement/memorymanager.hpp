@@ -20,6 +20,7 @@
 #include <fstream>
 #include <string>
 #include <vector>
+#include <atomic>
 
 #include "../ui/error.hpp"
 #include "../settings.hpp"
@@ -54,6 +55,65 @@ class MemoryManager : public NumeRe::FileAdapter, public StringMemory, public Nu
 		std::string sPredefinedCommands;
 		std::string sPluginCommands;
 
+		/////////////////////////////////////////////////
+		/// \brief Describes a table from the cache file,
+		/// which has not been loaded yet.
+		/////////////////////////////////////////////////
+		struct PendingTable
+		{
+		    size_t nthTable;
+		    long long int nRows;
+		    long long int nCols;
+		};
+
+		// Pending tables are loaded from const accessors,
+		// which may be called concurrently (e.g. from a
+		// parallel loop or the GUI thread). Every access
+		// to mPendingTables is therefore guarded by the
+		// critical section "MemoryManagerPendingTables".
+		// The flag allows to skip it, if no table is
+		// pending at all
+		mutable std::map<Memory*, PendingTable> mPendingTables;
+		mutable std::atomic<bool> bHasPendingTables;
+		std::string sPendingCacheFile;
+
+		void loadPendingTable(Memory* _mem) const;
+		void loadPendingTables() const;
+		void dropPendingTable(Memory* _mem);
+		void clearPendingTables();
+
+		/////////////////////////////////////////////////
+		/// \brief Copies the pending cache file
+		/// information of the selected table and
+		/// returns true. Returns false, if the table is
+		/// already loaded.
+		///
+		/// \param idx size_t
+		/// \param pending PendingTable&
+		/// \return bool
+		///
+		/////////////////////////////////////////////////
+		bool getPendingTable(size_t idx, PendingTable& pending) const
+		{
+		    if (!bHasPendingTables)
+                return false;
+
+            bool isPending = false;
+
+            #pragma omp critical (MemoryManagerPendingTables)
+            {
+                auto iter = mPendingTables.find(vMemory[idx]);
+
+                if (iter != mPendingTables.end())
+                {
+                    pending = iter->second;
+                    isPending = true;
+                }
+            }
+
+            return isPending;
+		}
+
 		void reorderColumn(size_t _nLayer, const std::vector<int>& vIndex, long long int i1, long long int i2, long long int j1 = 0);
 		bool loadFromNewCacheFile();
 		bool loadFromLegacyCacheFile();
@@ -95,10 +155,17 @@ class MemoryManager : public NumeRe::FileAdapter, public StringMemory, public Nu
 		    if (iter == mCachesMap.end())
                 throw SyntaxError(SyntaxError::TABLE_DOESNT_EXIST, sTable, sTable);
 
+            size_t idx = iter->second.first;
+
             if (iter->second.first != iter->second.second)
-                return iter->second.second;
+                idx = iter->second.second;
+
+            // Tables from the last session are loaded
+            // on their first access
+            if (bHasPendingTables)
+                loadPendingTable(vMemory[idx]);
 
-            return iter->second.first;
+            return idx;
 		}
 
 	public:
@@ -148,6 +215,26 @@ class MemoryManager : public NumeRe::FileAdapter, public StringMemory, public Nu
             return true;
         }
 
+        /////////////////////////////////////////////////
+        /// \brief Returns false, if the selected table
+        /// still waits for being loaded from the cache
+        /// file of the last session.
+        ///
+        /// \param sTable const std::string&
+        /// \return bool
+        ///
+        /////////////////////////////////////////////////
+        bool isLoaded(const std::string& sTable) const
+        {
+            auto iter = mCachesMap.find(sTable);
+
+            if (iter == mCachesMap.end())
+                return true;
+
+            PendingTable pending;
+            return !getPendingTable(iter->second.first != iter->second.second ? iter->second.second : iter->second.first, pending);
+        }
+
 		bool isValidElement(long long int _nLine, long long int _nCol, const std::string& _sTable) const
 		{
 		    if (exists(_sTable))
@@ -312,6 +399,7 @@ class MemoryManager : public NumeRe::FileAdapter, public StringMemory, public Nu
 
 		inline NumeRe::Table extractTable(int _nLayer, const std::string& _sTable = "", const VectorIndex& lines = VectorIndex(0, VectorIndex::OPEN_END), const VectorIndex& cols = VectorIndex(0, VectorIndex::OPEN_END))
 		{
+		    loadPendingTable(vMemory[_nLayer]);
 			return vMemory[_nLayer]->extractTable(_sTable, lines, cols);
 		}
 
@@ -322,6 +410,7 @@ class MemoryManager : public NumeRe::FileAdapter, public StringMemory, public Nu
 
 		inline void importTable(NumeRe::Table _table, int _nLayer, const VectorIndex& lines = VectorIndex(0, VectorIndex::OPEN_END), const VectorIndex& cols = VectorIndex(0, VectorIndex::OPEN_END))
 		{
+		    loadPendingTable(vMemory[_nLayer]);
 			return vMemory[_nLayer]->importTable(_table, lines, cols);
 		}
 
@@ -416,6 +505,18 @@ class MemoryManager : public NumeRe::FileAdapter, public StringMemory, public Nu
             return vMemory[findTable(sTable)]->getBins(col, nBins);
         }
 
+        NumeRe::Table groupBy(const std::string& sTable,
+                              const VectorIndex& _vKeyCols, const std::vector<std::string>& vAggregations) const
+        {
+            return vMemory[findTable(sTable)]->groupBy(_vKeyCols, vAggregations);
+        }
+
+        NumeRe::Table join(const std::string& sTable, const std::string& sOtherTable,
+                           const VectorIndex& _vKeyCols, const VectorIndex& _vOtherKeyCols, Memory::JoinType type) const
+        {
+            return vMemory[findTable(sTable)]->join(*vMemory[findTable(sOtherTable)], _vKeyCols, _vOtherKeyCols, type);
+        }
+
 
 
 		// DIMENSION ACCESS METHODS
@@ -424,17 +525,24 @@ class MemoryManager : public NumeRe::FileAdapter, public StringMemory, public Nu
 		    size_t idx = mapStringViewFind(sTable);
 
 		    if (idx != (size_t)-1)
+            {
+                // Do not load pending tables only for
+                // their dimensions
+                PendingTable pending;
+
+                if (getPendingTable(idx, pending))
+                    return pending.nRows;
+
                 return vMemory[idx]->getLines(_bFull);
+            }
 
             return 0;
 		}
 
 		inline int getLines(const std::string& sTable, bool _bFull = false) const
 		{
-		    auto iter = mCachesMap.find(sTable);
-
-		    if (iter != mCachesMap.end())
-                return vMemory[findTable(sTable)]->getLines(_bFull);
+		    if (exists(sTable))
+                return getLines(StringView(sTable), _bFull);
 
             return 0;
 		}
@@ -444,17 +552,22 @@ class MemoryManager : public NumeRe::FileAdapter, public StringMemory, public Nu
 		    size_t idx = mapStringViewFind(sTable);
 
 		    if (idx != (size_t)-1)
+            {
+                PendingTable pending;
+
+                if (getPendingTable(idx, pending))
+                    return pending.nCols;
+
                 return vMemory[idx]->getCols(_bFull);
+            }
 
             return 0;
 		}
 
 		inline int getCols(const std::string& sTable, bool _bFull = false) const
 		{
-		    auto iter = mCachesMap.find(sTable);
-
-		    if (iter != mCachesMap.end())
-                return vMemory[findTable(sTable)]->getCols(_bFull);
+		    if (exists(sTable))
+                return getCols(StringView(sTable), _bFull);
 
             return 0;
 		}
@@ -467,7 +580,10 @@ class MemoryManager : public NumeRe::FileAdapter, public StringMemory, public Nu
 		inline int getSize(int _nLayer) const
 		{
 			if (vMemory.size() && _nLayer < (int)vMemory.size())
+            {
+                loadPendingTable(vMemory[_nLayer]);
 				return vMemory[_nLayer]->getSize();
+            }
 
 			return 0;
 		}
@@ -536,6 +652,11 @@ class MemoryManager : public NumeRe::FileAdapter, public StringMemory, public Nu
 			vMemory[findTable(_sTable)]->copyElementsInto(vTarget, _vLine, _vCol);
 		}
 
+		const mu::value_type* getContiguousValues(const VectorIndex& _vLine, const VectorIndex& _vCol, const std::string& _sTable, size_t& nElems) const
+		{
+			return vMemory[findTable(_sTable)]->getContiguousValues(_vLine, _vCol, nElems);
+		}
+
 		int getHeadlineCount(const std::string& _sTable) const
 		{
 		    if (exists(_sTable))
@@ -19,6 +19,7 @@
 #include "tablecolumn.hpp"
 #include "../ui/language.hpp"
 #include "../utils/tools.hpp"
+#include <algorithm>
 
 extern Language _lang;
 
@@ -78,11 +79,23 @@ std::vector<std::string> TableColumn::getValueAsInternalString(const VectorIndex
 std::vector<mu::value_type> TableColumn::getValue(const VectorIndex& idx) const
 {
     idx.setOpenEndIndex(size()-1);
-    std::vector<mu::value_type> vVect(idx.size());
+    std::vector<mu::value_type> vVect(idx.size(), NAN);
+    const mu::value_type* data = getValueArray();
 
-    for (size_t i = 0; i < idx.size(); i++)
+    // Copy contiguous ranges of numerical columns
+    // directly from the storage
+    if (data && idx.isContiguous())
+    {
+        VectorIndex::Span span = idx.getSpan(size());
+        std::copy(data+span.first, data+span.first+span.length, vVect.begin());
+        return vVect;
+    }
+
+    size_t i = 0;
+
+    for (int nIndex : idx)
     {
-        vVect[i] = getValue(idx[i]);
+        vVect[i++] = getValue(nIndex);
     }
 
     return vVect;
@@ -210,6 +223,99 @@ size_t TableColumn::getNumFilledElements() const
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Returns the rows, whose internal string
+/// representation equals the passed string. The
+/// rows are sorted ascendingly. The hashed index
+/// is created on the first call and kept until
+/// the column is modified.
+///
+/// \param sValue const std::string&
+/// \return const std::vector<size_t>&
+///
+/////////////////////////////////////////////////
+const std::vector<size_t>& TableColumn::findRows(const std::string& sValue) const
+{
+    static const std::vector<size_t> vNoRows;
+
+    if (!m_index)
+        m_index.reset(new ColumnIndex);
+
+    if (!m_index->m_hasStringIndex)
+    {
+        for (size_t i = 0; i < size(); i++)
+        {
+            m_index->m_rowsByString[getValueAsInternalString(i)].push_back(i);
+        }
+
+        m_index->m_hasStringIndex = true;
+    }
+
+    auto iter = m_index->m_rowsByString.find(sValue);
+
+    if (iter == m_index->m_rowsByString.end())
+        return vNoRows;
+
+    return iter->second;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the rows, whose real part lies
+/// within the closed interval [dMin,dMax]. The
+/// rows are sorted by their values. Rows with a
+/// NaN real part are never returned. The sorted
+/// index is created on the first call and kept
+/// until the column is modified.
+///
+/// \param dMin double
+/// \param dMax double
+/// \return std::vector<size_t>
+///
+/////////////////////////////////////////////////
+std::vector<size_t> TableColumn::findRowsInRange(double dMin, double dMax) const
+{
+    if (std::isnan(dMin) || std::isnan(dMax))
+        return std::vector<size_t>();
+
+    if (!m_index)
+        m_index.reset(new ColumnIndex);
+
+    if (!m_index->m_hasSortedIndex)
+    {
+        std::vector<std::pair<double, size_t>> vSorted;
+        vSorted.reserve(size());
+
+        for (size_t i = 0; i < size(); i++)
+        {
+            double dVal = getValue(i).real();
+
+            if (!std::isnan(dVal))
+                vSorted.push_back(std::make_pair(dVal, i));
+        }
+
+        std::sort(vSorted.begin(), vSorted.end());
+
+        m_index->m_sortedValues.resize(vSorted.size());
+        m_index->m_sortedRows.resize(vSorted.size());
+
+        for (size_t i = 0; i < vSorted.size(); i++)
+        {
+            m_index->m_sortedValues[i] = vSorted[i].first;
+            m_index->m_sortedRows[i] = vSorted[i].second;
+        }
+
+        m_index->m_hasSortedIndex = true;
+    }
+
+    const std::vector<double>& vValues = m_index->m_sortedValues;
+    size_t nFirst = std::lower_bound(vValues.begin(), vValues.end(), dMin) - vValues.begin();
+    size_t nLast = std::upper_bound(vValues.begin()+nFirst, vValues.end(), dMax) - vValues.begin();
+
+    return std::vector<size_t>(m_index->m_sortedRows.begin()+nFirst, m_index->m_sortedRows.begin()+nLast);
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Creates a default column headline for
 /// a column, which can be used without an
@@ -22,9 +22,30 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <unordered_map>
 #include "../ParserLib/muParserDef.h"
 #include "../structures.hpp"
 
+/////////////////////////////////////////////////
+/// \brief Lookup index of a single table column.
+/// It maps the internal string representation of
+/// the cells to their rows and contains the rows
+/// sorted by the real part of their values. Both
+/// parts are created independently on their
+/// first use.
+/////////////////////////////////////////////////
+struct ColumnIndex
+{
+    std::unordered_map<std::string, std::vector<size_t>> m_rowsByString;
+    std::vector<double> m_sortedValues;
+    std::vector<size_t> m_sortedRows;
+    bool m_hasStringIndex;
+    bool m_hasSortedIndex;
+
+    ColumnIndex() : m_hasStringIndex(false), m_hasSortedIndex(false) {}
+};
+
+
 /////////////////////////////////////////////////
 /// \brief Abstract table column, which allows
 /// using it to compose the data table in each
@@ -61,6 +82,22 @@ struct TableColumn
     virtual std::string getValueAsStringLiteral(size_t elem) const = 0;
     virtual mu::value_type getValue(size_t elem) const = 0;
 
+    /////////////////////////////////////////////////
+    /// \brief Returns a pointer to the contiguous
+    /// numerical storage of this column or a
+    /// nullptr, if the column does not store its
+    /// values as mu::value_type. The pointer is
+    /// valid for size() elements and invalidated by
+    /// every modification of the column.
+    ///
+    /// \return const mu::value_type*
+    ///
+    /////////////////////////////////////////////////
+    virtual const mu::value_type* getValueArray() const
+    {
+        return nullptr;
+    }
+
     void setValue(const VectorIndex& idx, const std::vector<std::string>& vValue);
     void setValue(const VectorIndex& idx, const std::vector<mu::value_type>& vValue);
     void setValue(const VectorIndex& idx, mu::value_type* _dData, unsigned int _nNum);
@@ -91,10 +128,28 @@ struct TableColumn
 
     virtual TableColumn* convert(ColumnType type = TableColumn::TYPE_NONE) = 0;
 
+    const std::vector<size_t>& findRows(const std::string& sValue) const;
+    std::vector<size_t> findRowsInRange(double dMin, double dMax) const;
+
     static std::string getDefaultColumnHead(size_t colNo);
     static std::string typeToString(ColumnType type);
     static ColumnType stringToType(const std::string& sType);
     static std::vector<std::string> getTypesAsString();
+
+    protected:
+        mutable std::unique_ptr<ColumnIndex> m_index;
+
+        /////////////////////////////////////////////////
+        /// \brief Drops the lookup index. Has to be
+        /// called by every modification of the column.
+        ///
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void invalidateIndex()
+        {
+            m_index.reset();
+        }
 };
 
 
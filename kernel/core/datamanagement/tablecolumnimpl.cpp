@@ -109,6 +109,8 @@ mu::value_type ValueColumn::getValue(size_t elem) const
 /////////////////////////////////////////////////
 void ValueColumn::setValue(size_t elem, const std::string& sValue)
 {
+    invalidateIndex();
+
     if (isConvertible(sValue, CONVTYPE_VALUE))
         setValue(elem, StrToCmplx(toInternalString(sValue)));
     else
@@ -126,6 +128,8 @@ void ValueColumn::setValue(size_t elem, const std::string& sValue)
 /////////////////////////////////////////////////
 void ValueColumn::setValue(size_t elem, const mu::value_type& vValue)
 {
+    invalidateIndex();
+
     if (elem >= m_data.size() && mu::isnan(vValue))
         return;
 
@@ -171,6 +175,8 @@ ValueColumn* ValueColumn::copy(const VectorIndex& idx) const
 /////////////////////////////////////////////////
 void ValueColumn::assign(const TableColumn* column)
 {
+    invalidateIndex();
+
     if (column->m_type == TableColumn::TYPE_VALUE)
     {
         m_sHeadLine = column->m_sHeadLine;
@@ -192,6 +198,8 @@ void ValueColumn::assign(const TableColumn* column)
 /////////////////////////////////////////////////
 void ValueColumn::insert(const VectorIndex& idx, const TableColumn* column)
 {
+    invalidateIndex();
+
     if (column->m_type == TableColumn::TYPE_VALUE)
         TableColumn::setValue(idx, static_cast<const ValueColumn*>(column)->m_data);
     else
@@ -210,6 +218,8 @@ void ValueColumn::insert(const VectorIndex& idx, const TableColumn* column)
 /////////////////////////////////////////////////
 void ValueColumn::deleteElements(const VectorIndex& idx)
 {
+    invalidateIndex();
+
     idx.setOpenEndIndex(size()-1);
 
     // Shortcut, if everything shall be deleted
@@ -242,6 +252,8 @@ void ValueColumn::deleteElements(const VectorIndex& idx)
 /////////////////////////////////////////////////
 void ValueColumn::insertElements(size_t pos, size_t elem)
 {
+    invalidateIndex();
+
     if (pos < m_data.size())
         m_data.insert(m_data.begin()+pos, elem, NAN);
 }
@@ -256,6 +268,8 @@ void ValueColumn::insertElements(size_t pos, size_t elem)
 /////////////////////////////////////////////////
 void ValueColumn::appendElements(size_t elem)
 {
+    invalidateIndex();
+
     m_data.insert(m_data.end(), elem, NAN);
 }
 
@@ -272,6 +286,8 @@ void ValueColumn::appendElements(size_t elem)
 /////////////////////////////////////////////////
 void ValueColumn::removeElements(size_t pos, size_t elem)
 {
+    invalidateIndex();
+
     if (pos < m_data.size())
         m_data.erase(m_data.begin()+pos, m_data.begin()+pos+elem);
 }
@@ -286,6 +302,8 @@ void ValueColumn::removeElements(size_t pos, size_t elem)
 /////////////////////////////////////////////////
 void ValueColumn::resize(size_t elem)
 {
+    invalidateIndex();
+
     if (!elem)
         m_data.clear();
     else
@@ -521,6 +539,8 @@ mu::value_type DateTimeColumn::getValue(size_t elem) const
 /////////////////////////////////////////////////
 void DateTimeColumn::setValue(size_t elem, const std::string& sValue)
 {
+    invalidateIndex();
+
     if (isConvertible(sValue, CONVTYPE_DATE_TIME))
         setValue(elem, to_double(StrToTime(toInternalString(sValue))));
     else
@@ -538,6 +558,8 @@ void DateTimeColumn::setValue(size_t elem, const std::string& sValue)
 /////////////////////////////////////////////////
 void DateTimeColumn::setValue(size_t elem, const mu::value_type& vValue)
 {
+    invalidateIndex();
+
     if (elem >= m_data.size() && mu::isnan(vValue))
         return;
 
@@ -583,6 +605,8 @@ DateTimeColumn* DateTimeColumn::copy(const VectorIndex& idx) const
 /////////////////////////////////////////////////
 void DateTimeColumn::assign(const TableColumn* column)
 {
+    invalidateIndex();
+
     if (column->m_type == TableColumn::TYPE_DATETIME || column->m_type == TableColumn::TYPE_VALUE)
     {
         m_sHeadLine = column->m_sHeadLine;
@@ -607,6 +631,8 @@ void DateTimeColumn::assign(const TableColumn* column)
 /////////////////////////////////////////////////
 void DateTimeColumn::insert(const VectorIndex& idx, const TableColumn* column)
 {
+    invalidateIndex();
+
     if (column->m_type == TableColumn::TYPE_DATETIME || column->m_type == TableColumn::TYPE_VALUE)
         TableColumn::setValue(idx, column->getValue(VectorIndex(0, VectorIndex::OPEN_END)));
     else
@@ -625,6 +651,8 @@ void DateTimeColumn::insert(const VectorIndex& idx, const TableColumn* column)
 /////////////////////////////////////////////////
 void DateTimeColumn::deleteElements(const VectorIndex& idx)
 {
+    invalidateIndex();
+
     idx.setOpenEndIndex(size()-1);
 
     // Shortcut, if everything shall be deleted
@@ -657,6 +685,8 @@ void DateTimeColumn::deleteElements(const VectorIndex& idx)
 /////////////////////////////////////////////////
 void DateTimeColumn::insertElements(size_t pos, size_t elem)
 {
+    invalidateIndex();
+
     if (pos < m_data.size())
         m_data.insert(m_data.begin()+pos, elem, NAN);
 }
@@ -671,6 +701,8 @@ void DateTimeColumn::insertElements(size_t pos, size_t elem)
 /////////////////////////////////////////////////
 void DateTimeColumn::appendElements(size_t elem)
 {
+    invalidateIndex();
+
     m_data.insert(m_data.end(), elem, NAN);
 }
 
@@ -687,6 +719,8 @@ void DateTimeColumn::appendElements(size_t elem)
 /////////////////////////////////////////////////
 void DateTimeColumn::removeElements(size_t pos, size_t elem)
 {
+    invalidateIndex();
+
     if (pos < m_data.size())
         m_data.erase(m_data.begin()+pos, m_data.begin()+pos+elem);
 }
@@ -701,6 +735,8 @@ void DateTimeColumn::removeElements(size_t pos, size_t elem)
 /////////////////////////////////////////////////
 void DateTimeColumn::resize(size_t elem)
 {
+    invalidateIndex();
+
     if (!elem)
         m_data.clear();
     else
@@ -927,6 +963,8 @@ mu::value_type LogicalColumn::getValue(size_t elem) const
 /////////////////////////////////////////////////
 void LogicalColumn::setValue(size_t elem, const std::string& sValue)
 {
+    invalidateIndex();
+
     if (isConvertible(sValue, CONVTYPE_LOGICAL))
         setValue(elem, StrToLogical(toInternalString(sValue)));
     else
@@ -944,6 +982,8 @@ void LogicalColumn::setValue(size_t elem, const std::string& sValue)
 /////////////////////////////////////////////////
 void LogicalColumn::setValue(size_t elem, const mu::value_type& vValue)
 {
+    invalidateIndex();
+
     if (elem >= m_data.size() && mu::isnan(vValue))
         return;
 
@@ -990,6 +1030,8 @@ LogicalColumn* LogicalColumn::copy(const VectorIndex& idx) const
 /////////////////////////////////////////////////
 void LogicalColumn::assign(const TableColumn* column)
 {
+    invalidateIndex();
+
     if (column->m_type == TableColumn::TYPE_LOGICAL)
     {
         m_sHeadLine = column->m_sHeadLine;
@@ -1011,6 +1053,8 @@ void LogicalColumn::assign(const TableColumn* column)
 /////////////////////////////////////////////////
 void LogicalColumn::insert(const VectorIndex& idx, const TableColumn* column)
 {
+    invalidateIndex();
+
     if (column->m_type == TableColumn::TYPE_LOGICAL)
         TableColumn::setValue(idx, column->getValue(VectorIndex(0, VectorIndex::OPEN_END)));
     else
@@ -1029,6 +1073,8 @@ void LogicalColumn::insert(const VectorIndex& idx, const TableColumn* column)
 /////////////////////////////////////////////////
 void LogicalColumn::deleteElements(const VectorIndex& idx)
 {
+    invalidateIndex();
+
     idx.setOpenEndIndex(size()-1);
 
     // Shortcut, if everything shall be deleted
@@ -1061,6 +1107,8 @@ void LogicalColumn::deleteElements(const VectorIndex& idx)
 /////////////////////////////////////////////////
 void LogicalColumn::insertElements(size_t pos, size_t elem)
 {
+    invalidateIndex();
+
     if (pos < m_data.size())
         m_data.insert(m_data.begin()+pos, elem, LOGICAL_NAN);
 }
@@ -1075,6 +1123,8 @@ void LogicalColumn::insertElements(size_t pos, size_t elem)
 /////////////////////////////////////////////////
 void LogicalColumn::appendElements(size_t elem)
 {
+    invalidateIndex();
+
     m_data.insert(m_data.end(), elem, LOGICAL_NAN);
 }
 
@@ -1091,6 +1141,8 @@ void LogicalColumn::appendElements(size_t elem)
 /////////////////////////////////////////////////
 void LogicalColumn::removeElements(size_t pos, size_t elem)
 {
+    invalidateIndex();
+
     if (pos < m_data.size())
         m_data.erase(m_data.begin()+pos, m_data.begin()+pos+elem);
 }
@@ -1105,6 +1157,8 @@ void LogicalColumn::removeElements(size_t pos, size_t elem)
 /////////////////////////////////////////////////
 void LogicalColumn::resize(size_t elem)
 {
+    invalidateIndex();
+
     if (!elem)
         m_data.clear();
     else
@@ -1321,6 +1375,8 @@ mu::value_type StringColumn::getValue(size_t elem) const
 /////////////////////////////////////////////////
 void StringColumn::setValue(size_t elem, const std::string& sValue)
 {
+    invalidateIndex();
+
     if (elem >= m_data.size() && !sValue.length())
         return;
 
@@ -1341,6 +1397,8 @@ void StringColumn::setValue(size_t elem, const std::string& sValue)
 /////////////////////////////////////////////////
 void StringColumn::setValue(size_t elem, const mu::value_type& vValue)
 {
+    invalidateIndex();
+
     if (elem >= m_data.size() && mu::isnan(vValue))
         return;
 
@@ -1387,6 +1445,8 @@ StringColumn* StringColumn::copy(const VectorIndex& idx) const
 /////////////////////////////////////////////////
 void StringColumn::assign(const TableColumn* column)
 {
+    invalidateIndex();
+
     if (column->m_type == TableColumn::TYPE_STRING)
     {
         m_sHeadLine = column->m_sHeadLine;
@@ -1408,6 +1468,8 @@ void StringColumn::assign(const TableColumn* column)
 /////////////////////////////////////////////////
 void StringColumn::insert(const VectorIndex& idx, const TableColumn* column)
 {
+    invalidateIndex();
+
     if (column->m_type == TableColumn::TYPE_STRING)
         TableColumn::setValue(idx, static_cast<const StringColumn*>(column)->m_data);
     else
@@ -1426,6 +1488,8 @@ void StringColumn::insert(const VectorIndex& idx, const TableColumn* column)
 /////////////////////////////////////////////////
 void StringColumn::deleteElements(const VectorIndex& idx)
 {
+    invalidateIndex();
+
     idx.setOpenEndIndex(size()-1);
 
     // Shortcut, if everything shall be deleted
@@ -1458,6 +1522,8 @@ void StringColumn::deleteElements(const VectorIndex& idx)
 /////////////////////////////////////////////////
 void StringColumn::insertElements(size_t pos, size_t elem)
 {
+    invalidateIndex();
+
     if (pos < m_data.size())
         m_data.insert(m_data.begin()+pos, elem, "");
 }
@@ -1472,6 +1538,8 @@ void StringColumn::insertElements(size_t pos, size_t elem)
 /////////////////////////////////////////////////
 void StringColumn::appendElements(size_t elem)
 {
+    invalidateIndex();
+
     m_data.insert(m_data.end(), elem, "");
 }
 
@@ -1488,6 +1556,8 @@ void StringColumn::appendElements(size_t elem)
 /////////////////////////////////////////////////
 void StringColumn::removeElements(size_t pos, size_t elem)
 {
+    invalidateIndex();
+
     if (pos < m_data.size())
         m_data.erase(m_data.begin()+pos, m_data.begin()+pos+elem);
 }
@@ -1502,6 +1572,8 @@ void StringColumn::removeElements(size_t pos, size_t elem)
 /////////////////////////////////////////////////
 void StringColumn::resize(size_t elem)
 {
+    invalidateIndex();
+
     if (!elem)
         m_data.clear();
     else
@@ -1812,6 +1884,8 @@ mu::value_type CategoricalColumn::getValue(size_t elem) const
 /////////////////////////////////////////////////
 void CategoricalColumn::setValue(size_t elem, const std::string& sValue)
 {
+    invalidateIndex();
+
     if (elem >= m_data.size() && !sValue.length())
         return;
 
@@ -1846,6 +1920,8 @@ void CategoricalColumn::setValue(size_t elem, const std::string& sValue)
 /////////////////////////////////////////////////
 void CategoricalColumn::setValue(size_t elem, const mu::value_type& vValue)
 {
+    invalidateIndex();
+
     if (elem >= m_data.size() && mu::isnan(vValue))
         return;
 
@@ -1876,13 +1952,12 @@ CategoricalColumn* CategoricalColumn::copy(const VectorIndex& idx) const
 
     CategoricalColumn* col = new CategoricalColumn(idx.size());
     col->m_sHeadLine = m_sHeadLine;
+    col->m_categories = m_categories;
 
     for (size_t i = 0; i < idx.size(); i++)
     {
         if (idx[i] >= 0 && idx[i] < (int)m_data.size())
             col->m_data[i] = m_data[idx[i]];
-
-        col->m_categories = m_categories;
     }
 
     return col;
@@ -1899,6 +1974,8 @@ CategoricalColumn* CategoricalColumn::copy(const VectorIndex& idx) const
 /////////////////////////////////////////////////
 void CategoricalColumn::assign(const TableColumn* column)
 {
+    invalidateIndex();
+
     if (column->m_type == TableColumn::TYPE_CATEGORICAL)
     {
         m_sHeadLine = column->m_sHeadLine;
@@ -1921,6 +1998,8 @@ void CategoricalColumn::assign(const TableColumn* column)
 /////////////////////////////////////////////////
 void CategoricalColumn::insert(const VectorIndex& idx, const TableColumn* column)
 {
+    invalidateIndex();
+
     if (column->m_type == TableColumn::TYPE_CATEGORICAL)
         TableColumn::setValue(idx, column->getValueAsInternalString(VectorIndex(0, VectorIndex::OPEN_END)));
     else
@@ -1939,6 +2018,8 @@ void CategoricalColumn::insert(const VectorIndex& idx, const TableColumn* column
 /////////////////////////////////////////////////
 void CategoricalColumn::deleteElements(const VectorIndex& idx)
 {
+    invalidateIndex();
+
     idx.setOpenEndIndex(size()-1);
 
     // Shortcut, if everything shall be deleted
@@ -1974,6 +2055,8 @@ void CategoricalColumn::deleteElements(const VectorIndex& idx)
 /////////////////////////////////////////////////
 void CategoricalColumn::insertElements(size_t pos, size_t elem)
 {
+    invalidateIndex();
+
     if (pos < m_data.size())
         m_data.insert(m_data.begin()+pos, elem, CATEGORICAL_NAN);
 }
@@ -1988,6 +2071,8 @@ void CategoricalColumn::insertElements(size_t pos, size_t elem)
 /////////////////////////////////////////////////
 void CategoricalColumn::appendElements(size_t elem)
 {
+    invalidateIndex();
+
     m_data.insert(m_data.end(), elem, CATEGORICAL_NAN);
 }
 
@@ -2004,6 +2089,8 @@ void CategoricalColumn::appendElements(size_t elem)
 /////////////////////////////////////////////////
 void CategoricalColumn::removeElements(size_t pos, size_t elem)
 {
+    invalidateIndex();
+
     if (pos < m_data.size())
         m_data.erase(m_data.begin()+pos, m_data.begin()+pos+elem);
 }
@@ -2018,6 +2105,8 @@ void CategoricalColumn::removeElements(size_t pos, size_t elem)
 /////////////////////////////////////////////////
 void CategoricalColumn::resize(size_t elem)
 {
+    invalidateIndex();
+
     if (!elem)
         m_data.clear();
     else
@@ -2246,6 +2335,8 @@ TableColumn* CategoricalColumn::convert(ColumnType type)
 /////////////////////////////////////////////////
 void CategoricalColumn::setCategories(const std::vector<std::string>& vCategories)
 {
+    invalidateIndex();
+
     // If the number of new categories is higher
     // than the previous one: extend the necessary space
     if (vCategories.size() > m_categories.size())
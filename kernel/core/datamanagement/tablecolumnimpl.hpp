@@ -63,6 +63,18 @@ class ValueColumn : public TableColumn
         virtual std::string getValueAsStringLiteral(size_t elem) const override;
         virtual mu::value_type getValue(size_t elem) const override;
 
+        /////////////////////////////////////////////////
+        /// \brief Returns a pointer to the internal
+        /// value array.
+        ///
+        /// \return const mu::value_type*
+        ///
+        /////////////////////////////////////////////////
+        virtual const mu::value_type* getValueArray() const override
+        {
+            return m_data.data();
+        }
+
         virtual void setValue(size_t elem, const std::string& sValue) override;
         virtual void setValue(size_t elem, const mu::value_type& vValue) override;
 
@@ -445,6 +457,20 @@ class CategoricalColumn : public TableColumn
             return m_categories;
         }
 
+        /////////////////////////////////////////////////
+        /// \brief Returns the internal category code of
+        /// the selected element. Missing elements are
+        /// encoded as CATEGORICAL_NAN.
+        ///
+        /// \param elem size_t
+        /// \return int
+        ///
+        /////////////////////////////////////////////////
+        int getCode(size_t elem) const
+        {
+            return elem < m_data.size() ? m_data[elem] : CATEGORICAL_NAN;
+        }
+
         void setCategories(const std::vector<std::string>& vCategories);
 };
 
@@ -0,0 +1,374 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2023  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "profiler.hpp"
+#include "../utils/tools.hpp"
+#include <fstream>
+#include <algorithm>
+
+// Name of the pseudo procedure collecting all lines
+// executed outside of any procedure (i.e. in scripts
+// or in the console)
+#define PROFILER_GLOBAL_SCOPE "<global>"
+
+
+/////////////////////////////////////////////////
+/// \brief Starts the profiler for the whole
+/// session.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void NumeReProfiler::start()
+{
+    m_isActive = true;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Stops the session-wide profiling. The
+/// collected data is kept until reset() is
+/// called. Running frames are still closed
+/// correctly.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void NumeReProfiler::stop()
+{
+    m_isActive = false;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Removes all collected data. If there
+/// are still running frames (i.e. this function
+/// is called from within a profiled procedure),
+/// the records are only set to zero, because the
+/// frames still refer to them.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void NumeReProfiler::reset()
+{
+    m_stacks.clear();
+
+    if (m_frames.empty())
+    {
+        m_procedures.clear();
+        m_lines.clear();
+        return;
+    }
+
+    for (auto& iter : m_procedures)
+    {
+        iter.second = Record();
+    }
+
+    for (auto& iter : m_lines)
+    {
+        iter.second = Record();
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Private helper to push a new frame on
+/// the profiler's stack.
+///
+/// \param record Record*
+/// \param sProcedure const std::string&
+/// \param sFrameName const std::string&
+/// \return void
+///
+/////////////////////////////////////////////////
+void NumeReProfiler::push(Record* record, const std::string& sProcedure, const std::string& sFrameName)
+{
+    Frame frame;
+    frame.record = record;
+    frame.sProcedure = sProcedure;
+    frame.sStack = m_frames.size() ? m_frames.back().sStack + ";" + sFrameName : sFrameName;
+    frame.nChildTime = 0;
+
+    m_frames.push_back(std::move(frame));
+    record->nCalls++;
+
+    // Start the clock as late as possible
+    m_frames.back().start = Clock::now();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Starts measuring a procedure call.
+/// Returns true, if a frame was pushed, which
+/// has to be closed by leave().
+///
+/// \param sProcedure const std::string&
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool NumeReProfiler::enterProcedure(const std::string& sProcedure)
+{
+    if (!isActive())
+        return false;
+
+    push(&m_procedures[sProcedure], sProcedure, sProcedure);
+    return true;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Starts measuring a command line of the
+/// current procedure. Returns true, if a frame
+/// was pushed, which has to be closed by
+/// leave() or discard().
+///
+/// \param nLine size_t
+/// \param bByteCodeMiss bool
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool NumeReProfiler::enterLine(size_t nLine, bool bByteCodeMiss)
+{
+    if (!isActive())
+        return false;
+
+    std::string sProcedure = m_frames.size() ? m_frames.back().sProcedure : PROFILER_GLOBAL_SCOPE;
+    Record& record = m_lines[std::make_pair(sProcedure, nLine)];
+
+    if (bByteCodeMiss)
+        record.nByteCodeMisses++;
+
+    push(&record, sProcedure, sProcedure + ":" + toString(nLine+1));
+    return true;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Closes the topmost frame and adds its
+/// timings to its record, to its parent and to
+/// the collapsed stacks.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void NumeReProfiler::leave()
+{
+    if (m_frames.empty())
+        return;
+
+    Frame& frame = m_frames.back();
+    int64_t nElapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - frame.start).count();
+    int64_t nSelfTime = std::max(nElapsed - frame.nChildTime, (int64_t)0);
+
+    frame.record->nInclusiveTime += nElapsed;
+    frame.record->nExclusiveTime += nSelfTime;
+    m_stacks[frame.sStack] += nSelfTime;
+
+    m_frames.pop_back();
+
+    if (m_frames.size())
+        m_frames.back().nChildTime += nElapsed;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Removes the topmost frame without
+/// recording it. Its time is therefore added to
+/// the exclusive time of its parent. This is
+/// used for lines, which are only collected and
+/// executed later by the flow control logic.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void NumeReProfiler::discard()
+{
+    if (m_frames.empty())
+        return;
+
+    m_frames.back().record->nCalls--;
+    m_frames.pop_back();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Creates a table containing the
+/// collected data. Procedures come first, then
+/// the lines, both sorted by their exclusive
+/// time.
+///
+/// \return NumeRe::Table
+///
+/////////////////////////////////////////////////
+NumeRe::Table NumeReProfiler::createReport() const
+{
+    // Line numbers are stored one-based in the rows.
+    // Procedures use zero, because they don't have
+    // a line number
+    struct Row
+    {
+        const std::string* sProcedure;
+        size_t nLine;
+        const Record* record;
+    };
+
+    std::vector<Row> vRows;
+
+    for (const auto& iter : m_procedures)
+    {
+        if (iter.second.nCalls)
+            vRows.push_back({&iter.first, 0, &iter.second});
+    }
+
+    size_t nProcedures = vRows.size();
+
+    for (const auto& iter : m_lines)
+    {
+        if (iter.second.nCalls)
+            vRows.push_back({&iter.first.first, iter.first.second+1, &iter.second});
+    }
+
+    // Sort procedures and lines separately by their
+    // exclusive time
+    auto sorter = [](const Row& a, const Row& b){return a.record->nExclusiveTime > b.record->nExclusiveTime;};
+    std::stable_sort(vRows.begin(), vRows.begin()+nProcedures, sorter);
+    std::stable_sort(vRows.begin()+nProcedures, vRows.end(), sorter);
+
+    NumeRe::Table report(vRows.size(), 6);
+    report.setHead(0, "Procedure");
+    report.setHead(1, "Line");
+    report.setHead(2, "Calls");
+    report.setHead(3, "Bytecode misses");
+    report.setHead(4, "Inclusive [ms]");
+    report.setHead(5, "Exclusive [ms]");
+
+    for (size_t i = 0; i < vRows.size(); i++)
+    {
+        report.setValueAsString(i, 0, *vRows[i].sProcedure);
+
+        if (vRows[i].nLine)
+        {
+            report.setValue(i, 1, vRows[i].nLine);
+            report.setValue(i, 3, vRows[i].record->nByteCodeMisses);
+        }
+
+        report.setValue(i, 2, vRows[i].record->nCalls);
+        report.setValue(i, 4, vRows[i].record->nInclusiveTime * 1e-6);
+        report.setValue(i, 5, vRows[i].record->nExclusiveTime * 1e-6);
+    }
+
+    return report;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Writes the collapsed stacks to the
+/// passed file. Each line contains the semicolon
+/// separated stack and its exclusive time in
+/// microseconds, which is the input format of
+/// the common flamegraph tools.
+///
+/// \param sFileName const std::string&
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool NumeReProfiler::exportCollapsedStacks(const std::string& sFileName) const
+{
+    std::ofstream file(sFileName.c_str(), std::ios_base::out | std::ios_base::trunc);
+
+    if (!file.good())
+        return false;
+
+    for (const auto& iter : m_stacks)
+    {
+        int64_t nMicroSeconds = iter.second / 1000;
+
+        if (nMicroSeconds > 0)
+        {
+            // Spaces would break the format
+            std::string sStack = iter.first;
+            std::replace(sStack.begin(), sStack.end(), ' ', '_');
+            file << sStack << " " << nMicroSeconds << "\n";
+        }
+    }
+
+    return file.good();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Constructor. Starts measuring the
+/// passed procedure and activates the profiler
+/// for this call, if requested.
+///
+/// \param profiler NumeReProfiler&
+/// \param sProcedure const std::string&
+/// \param bActivateForCall bool
+///
+/////////////////////////////////////////////////
+NumeReProfiler::ProcedureScope::ProcedureScope(NumeReProfiler& profiler, const std::string& sProcedure, bool bActivateForCall) : m_profiler(profiler), m_entered(false), m_activated(bActivateForCall)
+{
+    if (m_activated)
+        m_profiler.m_callActivations++;
+
+    m_entered = m_profiler.enterProcedure(sProcedure);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Destructor. Closes the procedure frame
+/// and releases the activation of this call.
+/////////////////////////////////////////////////
+NumeReProfiler::ProcedureScope::~ProcedureScope()
+{
+    if (m_entered)
+        m_profiler.leave();
+
+    if (m_activated)
+        m_profiler.m_callActivations--;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Destructor. Closes the line frame, if
+/// it has been started and not been dropped.
+/////////////////////////////////////////////////
+NumeReProfiler::LineScope::~LineScope()
+{
+    if (m_entered)
+        m_profiler.leave();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Removes the line frame without
+/// recording it.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void NumeReProfiler::LineScope::drop()
+{
+    if (m_entered)
+        m_profiler.discard();
+
+    m_entered = false;
+}
+
@@ -0,0 +1,188 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2023  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <chrono>
+#include <cstdint>
+
+#include "../datamanagement/table.hpp"
+
+/////////////////////////////////////////////////
+/// \brief This class implements the line-level
+/// execution profiler. It measures call counts
+/// and inclusive and exclusive wall times for
+/// every executed procedure and command line
+/// together with the number of bytecode misses,
+/// i.e. the lines, which had to be parsed from
+/// scratch. The hooks in the procedure and flow
+/// control logic use the RAII helpers
+/// ProcedureScope and LineScope and return
+/// immediately, if the profiler is not active.
+/////////////////////////////////////////////////
+class NumeReProfiler
+{
+    public:
+        typedef std::chrono::steady_clock Clock;
+
+        /////////////////////////////////////////////////
+        /// \brief The collected statistics of a single
+        /// procedure or line. Times are stored in
+        /// nanoseconds.
+        /////////////////////////////////////////////////
+        struct Record
+        {
+            size_t nCalls;
+            size_t nByteCodeMisses;
+            int64_t nInclusiveTime;
+            int64_t nExclusiveTime;
+
+            Record() : nCalls(0), nByteCodeMisses(0), nInclusiveTime(0), nExclusiveTime(0) {}
+        };
+
+    private:
+        /////////////////////////////////////////////////
+        /// \brief A currently running procedure or line
+        /// on the profiler's stack.
+        /////////////////////////////////////////////////
+        struct Frame
+        {
+            Record* record;
+            std::string sStack;
+            std::string sProcedure;
+            Clock::time_point start;
+            int64_t nChildTime;
+        };
+
+        std::map<std::string, Record> m_procedures;
+        std::map<std::pair<std::string, size_t>, Record> m_lines;
+        std::map<std::string, int64_t> m_stacks;
+        std::vector<Frame> m_frames;
+        bool m_isActive;
+        size_t m_callActivations;
+
+        void push(Record* record, const std::string& sProcedure, const std::string& sFrameName);
+
+    public:
+        NumeReProfiler() : m_isActive(false), m_callActivations(0) {}
+
+        /////////////////////////////////////////////////
+        /// \brief Returns true, if the profiler is
+        /// currently collecting data, either because
+        /// it was started for the whole session or
+        /// for a single procedure call.
+        ///
+        /// \return bool
+        ///
+        /////////////////////////////////////////////////
+        bool isActive() const
+        {
+            return m_isActive || m_callActivations;
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Returns true, if no data has been
+        /// collected yet.
+        ///
+        /// \return bool
+        ///
+        /////////////////////////////////////////////////
+        bool isEmpty() const
+        {
+            return m_procedures.empty() && m_lines.empty();
+        }
+
+        void start();
+        void stop();
+        void reset();
+
+        bool enterProcedure(const std::string& sProcedure);
+        bool enterLine(size_t nLine, bool bByteCodeMiss);
+        void leave();
+        void discard();
+
+        NumeRe::Table createReport() const;
+        bool exportCollapsedStacks(const std::string& sFileName) const;
+
+        /////////////////////////////////////////////////
+        /// \brief RAII helper, which profiles a single
+        /// procedure call. The profiler may be activated
+        /// for the duration of this call only.
+        /////////////////////////////////////////////////
+        class ProcedureScope
+        {
+            private:
+                NumeReProfiler& m_profiler;
+                bool m_entered;
+                bool m_activated;
+
+            public:
+                ProcedureScope(NumeReProfiler& profiler, const std::string& sProcedure, bool bActivateForCall = false);
+                ~ProcedureScope();
+        };
+
+        /////////////////////////////////////////////////
+        /// \brief RAII helper, which profiles a single
+        /// command line. The measurement starts with the
+        /// first call to begin() and ends with the
+        /// destruction of the scope, unless it is
+        /// dropped beforehand.
+        /////////////////////////////////////////////////
+        class LineScope
+        {
+            private:
+                NumeReProfiler& m_profiler;
+                bool m_entered;
+
+            public:
+                LineScope(NumeReProfiler& profiler) : m_profiler(profiler), m_entered(false) {}
+                LineScope(NumeReProfiler& profiler, size_t nLine, bool bByteCodeMiss) : m_profiler(profiler), m_entered(false)
+                {
+                    begin(nLine, bByteCodeMiss);
+                }
+
+                ~LineScope();
+
+                /////////////////////////////////////////////////
+                /// \brief Starts measuring the passed line. Does
+                /// nothing, if the measurement has already been
+                /// started.
+                ///
+                /// \param nLine size_t
+                /// \param bByteCodeMiss bool
+                /// \return void
+                ///
+                /////////////////////////////////////////////////
+                void begin(size_t nLine, bool bByteCodeMiss)
+                {
+                    if (!m_entered && m_profiler.isActive())
+                        m_entered = m_profiler.enterLine(nLine, bByteCodeMiss);
+                }
+
+                void drop();
+        };
+};
+
+
+#endif // PROFILER_HPP
+
@@ -222,7 +222,7 @@ static std::vector<std::string> loadDocumentationArticle(const std::string& sFil
 /////////////////////////////////////////////////
 /// \brief The default constructor
 /////////////////////////////////////////////////
-Documentation::Documentation() : FileSystem()
+Documentation::Documentation() : FileSystem(), bIndexPending(false), bLoadUserDocs(true)
 {
     vDocIndexTable.reserve(128);
 }
@@ -455,6 +455,7 @@ std::string Documentation::getArgAtPos(const std::string& sCmd, unsigned int nPo
 /////////////////////////////////////////////////
 void Documentation::createDocumentationIndex(bool bLoadUserLangFiles)
 {
+    bIndexPending = false;
     Settings& _option = NumeReKernel::getInstance()->getSettings();
 
     // Add standard documentation files
@@ -486,6 +487,37 @@ void Documentation::createDocumentationIndex(bool bLoadUserLangFiles)
 }
 
 
+/////////////////////////////////////////////////
+/// \brief This member function defers the
+/// creation of the documentation index until it
+/// is needed for the first time.
+///
+/// \param bLoadUserLangFiles bool
+/// \return void
+///
+/////////////////////////////////////////////////
+void Documentation::deferDocumentationIndex(bool bLoadUserLangFiles)
+{
+    bIndexPending = true;
+    bLoadUserDocs = bLoadUserLangFiles;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Private member function to create the
+/// documentation index, if its creation has been
+/// deferred.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void Documentation::loadPendingIndex()
+{
+    if (bIndexPending)
+        createDocumentationIndex(bLoadUserDocs);
+}
+
+
 /////////////////////////////////////////////////
 /// \brief This member function is used to add
 /// documentation index entries to the index
@@ -500,6 +532,9 @@ void Documentation::addFileToDocumentationIndex(const std::string& sFileName)
     if (!sFileName.length())
         return;
 
+    // Keep the order of the index entries
+    loadPendingIndex();
+
     try
     {
         DocumentationFile docFile(sFileName);
@@ -530,6 +565,8 @@ void Documentation::addFileToDocumentationIndex(const std::string& sFileName)
 /////////////////////////////////////////////////
 void Documentation::removeFromDocIndex(const string& _sID)
 {
+    loadPendingIndex();
+
     if (!vDocIndexTable.size())
         throw SyntaxError(SyntaxError::INVALID_HLPIDX, "", SyntaxError::invalid_position);
 
@@ -581,6 +618,7 @@ void Documentation::removeFromDocIndex(const string& _sID)
 std::vector<std::string> Documentation::getHelpArticle(const std::string& sTopic)
 {
     std::vector<std::string> vReturn;
+    loadPendingIndex();
 
     if (!vDocIndexTable.size())
         throw SyntaxError(SyntaxError::INVALID_HLPIDX, "", SyntaxError::invalid_position);
@@ -643,9 +681,10 @@ std::vector<std::string> Documentation::getHelpArticle(const std::string& sTopic
 /// \return std::vector<std::string>
 ///
 /////////////////////////////////////////////////
-std::vector<std::string> Documentation::getDocIndex() const
+std::vector<std::string> Documentation::getDocIndex()
 {
     std::vector<std::string> vReturn;
+    loadPendingIndex();
 
     // Go through the index table and extract the
     // key list
@@ -686,6 +725,8 @@ std::vector<std::string> Documentation::getDocIndex() const
 /////////////////////////////////////////////////
 std::string Documentation::getHelpIdxKey(const std::string& sTopic)
 {
+    loadPendingIndex();
+
     int nIndex = findPositionInDocumentationIndex(sTopic);
     std::string sReturn = "";
 
@@ -711,6 +752,8 @@ std::string Documentation::getHelpIdxKey(const std::string& sTopic)
 /////////////////////////////////////////////////
 std::string Documentation::getHelpArticleID(const std::string& sTopic)
 {
+    loadPendingIndex();
+
     int nIndex = findPositionInDocumentationIndex(sTopic);
 
     if (nIndex != -1)
@@ -731,6 +774,8 @@ std::string Documentation::getHelpArticleID(const std::string& sTopic)
 /////////////////////////////////////////////////
 std::string Documentation::getHelpArticleTitle(const std::string& _sIdxKey)
 {
+    loadPendingIndex();
+
     int nIndex = findPositionInDocumentationIndex(_sIdxKey);
 
     if (nIndex == -1)
@@ -40,7 +40,10 @@ class Documentation : public FileSystem
     private:
         std::map<std::string,int> mDocumentationIndex;
         std::vector<DocumentationEntry> vDocIndexTable;
+        bool bIndexPending;
+        bool bLoadUserDocs;
 
+        void loadPendingIndex();
         void addEntry(const DocumentationEntry& entry, const std::vector<std::string>& keyWords);
         int findPositionInDocumentationIndex(const std::string& sTopic) const;
         int findPositionUsingIdxKeys(const std::string& sIdxKeys) const;
@@ -50,10 +53,11 @@ class Documentation : public FileSystem
         ~Documentation();
 
         void createDocumentationIndex(bool bLoadUserLangFiles = true);
+        void deferDocumentationIndex(bool bLoadUserLangFiles = true);
         void addFileToDocumentationIndex(const std::string& sFileName);
         void removeFromDocIndex(const std::string& _sID);
         std::vector<std::string> getHelpArticle(const std::string& sTopic);
-        std::vector<std::string> getDocIndex() const;
+        std::vector<std::string> getDocIndex();
         std::string getHelpIdxKey(const std::string& sTopic);
         std::string getHelpArticleID(const std::string& sTopic);
         std::string getHelpArticleTitle(const std::string& _sIdxKey);
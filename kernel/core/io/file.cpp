@@ -24,13 +24,16 @@
 #include "../IgorLib/ReadWave.h"
 #include "../utils/tools.hpp"
 #include "../utils/BasicExcel.hpp"
-#include "../utils/tinyxml2.h"
 #include "../ui/language.hpp"
 #include "../version.h"
 #include "../../kernel.hpp"
 
 #define DEFAULT_PRECISION 14
 
+// Number of rows, which are formatted at once
+// before being written to a text file
+#define FORMATTING_CHUNKSIZE 4096LL
+
 extern Language _lang;
 
 namespace NumeRe
@@ -325,28 +328,33 @@ namespace NumeRe
     /////////////////////////////////////////////////
     void TextDataFile::writeTableContents(const vector<size_t>& vColumnWidth)
     {
-        for (long long int i = 0; i < nRows; i++)
+        vector<string> vLines(min(nRows, FORMATTING_CHUNKSIZE));
+        bool bParallel = canFormatInParallel();
+
+        // Format the rows chunk-wise into the line
+        // buffers and write them afterwards
+        for (long long int nChunk = 0; nChunk < nRows; nChunk += FORMATTING_CHUNKSIZE)
         {
-            for (long long int j = 0; j < nCols; j++)
+            long long int nChunkRows = min(nRows - nChunk, FORMATTING_CHUNKSIZE);
+
+            #pragma omp parallel for if(bParallel)
+            for (long long int i = 0; i < nChunkRows; i++)
             {
-                fFileStream.width(vColumnWidth[j]+2);
-                fFileStream.fill(' ');
-                fFileStream.precision(nPrecFields);
+                vLines[i].clear();
 
-                // Handle NaNs correctly
-                if (!fileData->at(j)->isValid(i))
-                    fFileStream << "---";
-                else
+                // NaNs are written as "---"
+                for (long long int j = 0; j < nCols; j++)
                 {
-                    if (fileData->at(j)->m_type == TableColumn::TYPE_VALUE)
-                        fFileStream << toString(fileData->at(j)->getValue(i), nPrecFields);
-                    else
-                        fFileStream << fileData->at(j)->getValueAsInternalString(i);
+                    appendCell(vLines[i], nChunk+i, j, nPrecFields, vColumnWidth[j]+2, "---");
                 }
+
+                vLines[i] += "\n";
             }
 
-            fFileStream.width(0);
-            fFileStream << "\n";
+            for (long long int i = 0; i < nChunkRows; i++)
+            {
+                fFileStream.write(vLines[i].data(), vLines[i].length());
+            }
         }
     }
 
@@ -1053,11 +1061,14 @@ namespace NumeRe
     /// automatically detect, whether the file is in
     /// legacy format or not. If the file format is
     /// newer than expected, it will throw an error.
+    /// The checksum verification may be skipped, if
+    /// only the header information is of interest.
     ///
+    /// \param bVerifyChecksum bool
     /// \return void
     ///
     /////////////////////////////////////////////////
-    void NumeReDataFile::readHeader()
+    void NumeReDataFile::readHeader(bool bVerifyChecksum)
     {
         // Read the basic information
         versionMajor = readNumField<long int>();
@@ -1102,13 +1113,16 @@ namespace NumeRe
 
             size_t checkStart = tellg();
 
-            std::string sha = "SHA-256:" + sha256(fFileStream, checkStart, fileEnd-checkStart);
+            if (bVerifyChecksum)
+            {
+                std::string sha = "SHA-256:" + sha256(fFileStream, checkStart, fileEnd-checkStart);
 
-            // Is it corrupted?
-            if (sha_check != sha)
-                NumeReKernel::issueWarning(_lang.get("COMMON_DATAFILE_CORRUPTED", sFileName));
+                // Is it corrupted?
+                if (sha_check != sha)
+                    NumeReKernel::issueWarning(_lang.get("COMMON_DATAFILE_CORRUPTED", sFileName));
 
-            seekg(checkStart);
+                seekg(checkStart);
+            }
         }
 
         // Read the table name and the comment
@@ -1774,6 +1788,49 @@ namespace NumeRe
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief This member function reads only the
+    /// header of the selected table, i.e. its name,
+    /// its comment and its dimensions. The checksum
+    /// is not verified, because this would need to
+    /// read the whole table.
+    ///
+    /// \param nthTable size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void CacheFile::readTableInformation(size_t nthTable)
+    {
+        if (nthTable >= vFileIndex.size())
+            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+        reset();
+        seekg(vFileIndex[nthTable]);
+        readHeader(false);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief This member function reads the
+    /// selected table to the internal storage
+    /// independent on the current position in the
+    /// file.
+    ///
+    /// \param nthTable size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void CacheFile::readTable(size_t nthTable)
+    {
+        if (nthTable >= vFileIndex.size())
+            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+        reset();
+        seekg(vFileIndex[nthTable]);
+        readFile();
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief This member function will write the
     /// standard cache file header to the cache file.
@@ -2160,25 +2217,34 @@ namespace NumeRe
         }
 
         fFileStream << "\n";
-        fFileStream.precision(nPrecFields);
 
-        // Write the data to the file
-        for (long long int i = 0; i < nRows; i++)
+        vector<string> vLines(min(nRows, FORMATTING_CHUNKSIZE));
+        bool bParallel = canFormatInParallel();
+
+        // Write the data to the file. The rows are
+        // formatted chunk-wise into the line buffers
+        for (long long int nChunk = 0; nChunk < nRows; nChunk += FORMATTING_CHUNKSIZE)
         {
-            for (long long int j = 0; j < nCols; j++)
+            long long int nChunkRows = min(nRows - nChunk, FORMATTING_CHUNKSIZE);
+
+            #pragma omp parallel for if(bParallel)
+            for (long long int i = 0; i < nChunkRows; i++)
             {
-                if (fileData->at(j) && fileData->at(j)->isValid(i))
+                vLines[i].clear();
+
+                for (long long int j = 0; j < nCols; j++)
                 {
-                    if (fileData->at(j)->m_type == TableColumn::TYPE_VALUE)
-                        fFileStream << toString(fileData->at(j)->getValue(i), DEFAULT_PRECISION);
-                    else
-                        fFileStream << fileData->at(j)->getValueAsInternalString(i);
+                    appendCell(vLines[i], nChunk+i, j, DEFAULT_PRECISION, 0, "");
+                    vLines[i] += ",";
                 }
 
-                fFileStream << ",";
+                vLines[i] += "\n";
             }
 
-            fFileStream << "\n";
+            for (long long int i = 0; i < nChunkRows; i++)
+            {
+                fFileStream.write(vLines[i].data(), vLines[i].length());
+            }
         }
 
         fFileStream.flush();
@@ -3322,196 +3388,448 @@ namespace NumeRe
     }
 
 
-    //////////////////////////////////////////////
-    // class OpenDocumentSpreadSheet
-    //////////////////////////////////////////////
-    //
-    OpenDocumentSpreadSheet::OpenDocumentSpreadSheet(const string& filename) : GenericFile(filename)
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to write a
+    /// single cell into a column while streaming a
+    /// spreadsheet. Empty columns are created with
+    /// the type of the cell. As long as a column is
+    /// not a string column, the raw texts of its
+    /// cells are kept as well. If the column turns
+    /// out to contain mixed types, it is rebuilt as
+    /// a string column from these texts, so that
+    /// all of its cells keep their original format.
+    ///
+    /// \param col TblColPtr&
+    /// \param vRawCells std::vector<std::string>&
+    /// \param nRow size_t
+    /// \param type TableColumn::ColumnType
+    /// \param val const mu::value_type&
+    /// \param sRaw const std::string&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void writeTypedCell(TblColPtr& col, std::vector<std::string>& vRawCells, size_t nRow,
+                               TableColumn::ColumnType type, const mu::value_type& val, const std::string& sRaw)
     {
-        // Empty constructor
+        if (!col)
+            col.reset(new StringColumn);
+
+        // Replaces empty columns but keeps their
+        // headlines
+        convert_if_empty(col, 0, type);
+
+        if (col->m_type != TableColumn::TYPE_STRING)
+        {
+            if (vRawCells.size() <= nRow)
+                vRawCells.resize(nRow+1);
+
+            vRawCells[nRow] = sRaw;
+        }
+
+        if (col->m_type == type)
+        {
+            if (type == TableColumn::TYPE_STRING)
+                col->setValue(nRow, sRaw);
+            else
+                col->setValue(nRow, val);
+
+            return;
+        }
+
+        // Mixed columns fall back to strings. The raw
+        // texts already contain the current cell
+        if (col->m_type != TableColumn::TYPE_STRING)
+        {
+            StringColumn* strCol = new StringColumn(vRawCells.size());
+            strCol->m_sHeadLine = col->m_sHeadLine;
+
+            for (size_t i = 0; i < vRawCells.size(); i++)
+            {
+                if (vRawCells[i].length())
+                    strCol->setValue(i, vRawCells[i]);
+            }
+
+            col.reset(strCol);
+            std::vector<std::string>().swap(vRawCells);
+            return;
+        }
+
+        col->setValue(nRow, sRaw);
     }
 
 
-    OpenDocumentSpreadSheet::~OpenDocumentSpreadSheet()
+    /////////////////////////////////////////////////
+    /// \brief This structure holds a single cell of
+    /// an ODS table row, until the row is complete.
+    /////////////////////////////////////////////////
+    struct OdsCell
     {
-        // Empty destructor
+        std::string sValueType;
+        std::string sValue;
+        std::string sText;
+        int nRepeated;
+        bool isRepeated;
+        bool hasChildren;
+        bool hasText;
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief This structure contains the columns
+    /// read from a single table in an ODS file.
+    /////////////////////////////////////////////////
+    struct OdsTable
+    {
+        TableColumnArray vColumns;
+        std::vector<std::vector<std::string>> vRawCells;
+        size_t nWidth;
+        size_t nRowCount;
+        bool isHeadLine;
+
+        OdsTable() : nWidth(0), nRowCount(0), isHeadLine(true) {}
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief Event handler for streaming the
+    /// content.xml of an ODS file. Each completed
+    /// table row is written directly into the
+    /// columns of the current table.
+    /////////////////////////////////////////////////
+    class OdsContentReader : public XmlEventHandler
+    {
+        private:
+            std::vector<OdsCell> m_cells;
+            size_t m_nCells;
+            int m_nCellDepth;
+            int m_nTextDepth;
+            bool m_inRow;
+
+            void finishRow();
+            void writeCell(OdsTable& table, size_t nCol, const OdsCell& cell);
+
+        public:
+            std::vector<OdsTable> m_tables;
+
+            OdsContentReader() : m_nCells(0), m_nCellDepth(0), m_nTextDepth(0), m_inRow(false) {}
+
+            virtual void startElement(const std::string& sName, const XmlAttributes& attributes) override;
+            virtual void endElement(const std::string& sName) override;
+            virtual void characters(const std::string& sText) override;
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief Handles opening XML tags.
+    ///
+    /// \param sName const std::string&
+    /// \param attributes const XmlAttributes&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void OdsContentReader::startElement(const std::string& sName, const XmlAttributes& attributes)
+    {
+        if (m_nCellDepth)
+        {
+            OdsCell& cell = m_cells[m_nCells-1];
+            cell.hasChildren = true;
+            m_nCellDepth++;
+
+            if (m_nTextDepth)
+            {
+                m_nTextDepth++;
+
+                // Encoded sequence of spaces
+                if (sName == "text:s")
+                    cell.sText.append(attributes.getInt("text:c", 1), ' ');
+            }
+            else if (sName == "text:p" && !cell.hasText)
+            {
+                cell.hasText = true;
+                m_nTextDepth = 1;
+            }
+
+            return;
+        }
+
+        if (sName == "table:table")
+            m_tables.emplace_back();
+        else if (sName == "table:table-row" && m_tables.size())
+        {
+            m_inRow = true;
+            m_nCells = 0;
+        }
+        else if (m_inRow && (sName == "table:table-cell" || sName == "table:covered-table-cell"))
+        {
+            if (m_nCells >= m_cells.size())
+                m_cells.emplace_back();
+
+            OdsCell& cell = m_cells[m_nCells++];
+            const std::string* attr;
+
+            cell.sValueType = (attr = attributes.get("office:value-type")) ? *attr : "";
+            cell.sValue.clear();
+            cell.sText.clear();
+            cell.isRepeated = attributes.get("table:number-columns-repeated") != nullptr;
+            cell.nRepeated = std::max(1, attributes.getInt("table:number-columns-repeated", 1));
+            cell.hasChildren = false;
+            cell.hasText = false;
+
+            if (cell.sValueType == "boolean")
+                cell.sValue = (attr = attributes.get("office:boolean-value")) ? *attr : "";
+            else if (cell.sValueType == "date")
+                cell.sValue = (attr = attributes.get("office:date-value")) ? *attr : "";
+            else if ((attr = attributes.get("office:value")))
+                cell.sValue = *attr;
+
+            m_nCellDepth = 1;
+        }
     }
 
 
     /////////////////////////////////////////////////
-    /// \brief This member function is used to read
-    /// the targed file into the internal storage.
-    /// ODS is a ZIP file containing the data
-    /// formatted as XML.
+    /// \brief Handles closing XML tags.
     ///
+    /// \param sName const std::string&
     /// \return void
     ///
     /////////////////////////////////////////////////
-    void OpenDocumentSpreadSheet::readFile()
+    void OdsContentReader::endElement(const std::string& sName)
     {
-        std::string sODS;
+        if (m_nCellDepth)
+        {
+            m_nCellDepth--;
 
-        // Get the contents of the embedded
-        // XML file
-        sODS = getZipFileItem("content.xml");
+            if (m_nTextDepth)
+                m_nTextDepth--;
 
-        // Ensure that the embedded file is
-        // not empty
-        if (!sODS.length())
-            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+            return;
+        }
+
+        if (sName == "table:table-row" && m_inRow)
+        {
+            finishRow();
+            m_inRow = false;
+        }
+    }
 
-        // Parse the XML file
-        tinyxml2::XMLDocument odsDocument;
-        odsDocument.Parse(sODS.c_str());
 
-        // Ensure again that the file is not empty and that
-        // the necessary elements are present
-        if (!odsDocument.FirstChildElement()
-            || !odsDocument.FirstChildElement()->FirstChildElement("office:body")
-            || !odsDocument.FirstChildElement()->FirstChildElement("office:body")->FirstChildElement()
-            || !odsDocument.FirstChildElement()->FirstChildElement("office:body")->FirstChildElement()->FirstChildElement("table:table"))
-            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+    /////////////////////////////////////////////////
+    /// \brief Collects the text content of the first
+    /// paragraph in the current cell.
+    ///
+    /// \param sText const std::string&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void OdsContentReader::characters(const std::string& sText)
+    {
+        if (m_nTextDepth)
+            m_cells[m_nCells-1].sText += sText;
+    }
 
-        std::vector<size_t> vTableSizes;
-        std::vector<size_t> vCommentRows;
 
-        // Get the contained table section
-        tinyxml2::XMLElement* table = odsDocument.FirstChildElement()->FirstChildElement("office:body")
-                                                                     ->FirstChildElement()
-                                                                     ->FirstChildElement("table:table");
+    /////////////////////////////////////////////////
+    /// \brief Writes the contents of the completed
+    /// row either to the column headlines (as long
+    /// as the leading rows of the table consist of
+    /// strings only) or to the columns themselves.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void OdsContentReader::finishRow()
+    {
+        OdsTable& table = m_tables.back();
+        size_t nCellCount = 0;
 
-        // Find the column count of every table as well as the needed number of
-        // table head lines
-        do
+        for (size_t i = 0; i < m_nCells; i++)
         {
-            tinyxml2::XMLElement* row = table->FirstChildElement("table:table-row");
-            vTableSizes.push_back(0);
-            vCommentRows.push_back(0);
-            bool isString = true;
+            const OdsCell& cell = m_cells[i];
 
-            // Read every row
-            while (row)
-            {
-                tinyxml2::XMLElement* cell = row->FirstChildElement();
-                size_t cellcount = 0;
+            // Interpret the repeating statement only if this is
+            // not the last cell in this row
+            nCellCount += i+1 < m_nCells ? cell.nRepeated : 1;
+
+            if (!(cell.sValueType == "string" || cell.isRepeated || !cell.hasChildren))
+                table.isHeadLine = false;
+        }
 
-                // Examine each cell
-                while (cell)
+        table.nWidth = std::max(table.nWidth, nCellCount);
+
+        if (table.vColumns.size() < nCellCount)
+        {
+            table.vColumns.resize(nCellCount);
+            table.vRawCells.resize(nCellCount);
+        }
+
+        size_t nCol = 0;
+
+        for (size_t i = 0; i < m_nCells && nCol < nCellCount; i++)
+        {
+            const OdsCell& cell = m_cells[i];
+
+            if (table.isHeadLine)
+            {
+                // Write the text element to the
+                // current column's headline
+                if (cell.hasText)
                 {
-                    // Interpret the repeating statement only if this is not the last cell
-                    // in this row
-                    if (cell->NextSiblingElement())
-                        cellcount += cell->IntAttribute("table:number-columns-repeated", 1);
-                    else
-                        cellcount++;
+                    if (!table.vColumns[nCol])
+                        table.vColumns[nCol].reset(new StringColumn);
 
-                    if (!(cell->Attribute("office:value-type", "string")
-                        || cell->Attribute("table:number-columns-repeated")
-                        || !cell->FirstChildElement()))
-                        isString = false;
+                    if (table.vColumns[nCol]->m_sHeadLine.length())
+                        table.vColumns[nCol]->m_sHeadLine += "\n";
 
-                    cell = cell->NextSiblingElement();
+                    table.vColumns[nCol]->m_sHeadLine += utf8parser(cell.sText);
+                }
+            }
+            else
+            {
+                // Repeated cells share the same value
+                for (int n = 0; n < cell.nRepeated && nCol+n < nCellCount; n++)
+                {
+                    writeCell(table, nCol+n, cell);
                 }
+            }
+
+            nCol += cell.nRepeated;
+        }
 
-                // Count comment rows
-                if (isString)
-                    vCommentRows.back()++;
+        if (!table.isHeadLine)
+            table.nRowCount++;
+    }
 
-                // Use the maximal number of cells
-                if (cellcount > vTableSizes.back())
-                    vTableSizes.back() = cellcount;
 
-                row = row->NextSiblingElement("table:table-row");
-            }
-        } while ((table = table->NextSiblingElement("table:table")));
+    /////////////////////////////////////////////////
+    /// \brief Writes a single cell with its native
+    /// type to the selected column.
+    ///
+    /// \param table OdsTable&
+    /// \param nCol size_t
+    /// \param cell const OdsCell&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void OdsContentReader::writeCell(OdsTable& table, size_t nCol, const OdsCell& cell)
+    {
+        TblColPtr& col = table.vColumns[nCol];
+        std::vector<std::string>& vRawCells = table.vRawCells[nCol];
+        size_t nRow = table.nRowCount;
+
+        if (cell.sValueType == "string")
+        {
+            if (cell.hasText)
+                writeTypedCell(col, vRawCells, nRow, TableColumn::TYPE_STRING, mu::value_type(), utf8parser(cell.sText));
+        }
+        else if (cell.sValueType == "boolean")
+            writeTypedCell(col, vRawCells, nRow, TableColumn::TYPE_LOGICAL, mu::value_type(cell.sValue == "true"), cell.sValue);
+        else if (cell.sValue.length()
+                 && (cell.sValueType == "float" || cell.sValueType == "percentage" || cell.sValueType == "currency"))
+            writeTypedCell(col, vRawCells, nRow, TableColumn::TYPE_VALUE, mu::value_type(StrToDb(cell.sValue)),
+                           cell.hasText ? cell.sText : cell.sValue);
+        else if (cell.sValue.length() && cell.sValueType == "date")
+            writeTypedCell(col, vRawCells, nRow, TableColumn::TYPE_DATETIME, mu::value_type(to_double(StrToTime(cell.sValue))),
+                           cell.hasText ? cell.sText : cell.sValue);
+        else if (cell.hasText)
+            writeTypedCell(col, vRawCells, nRow, TableColumn::TYPE_STRING, mu::value_type(), cell.sText);
+    }
+
+
+    //////////////////////////////////////////////
+    // class OpenDocumentSpreadSheet
+    //////////////////////////////////////////////
+    //
+    OpenDocumentSpreadSheet::OpenDocumentSpreadSheet(const string& filename) : GenericFile(filename)
+    {
+        // Empty constructor
+    }
+
+
+    OpenDocumentSpreadSheet::~OpenDocumentSpreadSheet()
+    {
+        // Empty destructor
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief This member function is used to read
+    /// the targed file into the internal storage.
+    /// ODS is a ZIP file containing the data
+    /// formatted as XML. The XML is inflated and
+    /// parsed chunk-wise and the cells are written
+    /// with their native types directly into the
+    /// columns. As all tables are part of the same
+    /// XML file, they are read sequentially.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void OpenDocumentSpreadSheet::readFile()
+    {
+        OdsContentReader content;
+
+        // Stream the contents of the embedded
+        // XML file
+        if (!streamZipFileItem("content.xml", content) || !content.m_tables.size())
+            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
 
         // Find the total amount of needed columns
-        nCols = std::accumulate(vTableSizes.begin(), vTableSizes.end(), 0);
+        nCols = 0;
+
+        for (const OdsTable& table : content.m_tables)
+        {
+            nCols += table.nWidth;
+        }
 
         // Ensure that we found at least a single
         // column
         if (!nCols)
             throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
 
-        // Prepare the table column array and create string columns
+        // Prepare the table column array and move
+        // the columns of every table next to each
+        // other
         createStorage();
-
-        for (long long int i = 0; i < nCols; i++)
-            fileData->at(i).reset(new StringColumn);
-
-        // Return to the first table
-        table = odsDocument.FirstChildElement()->FirstChildElement("office:body")
-                                               ->FirstChildElement()
-                                               ->FirstChildElement("table:table");
-
-        size_t nTableId = 0;
         size_t nOffSet = 0;
 
-        // Read and parse every table in the file
-        do
+        for (OdsTable& table : content.m_tables)
         {
-            tinyxml2::XMLElement* row = table->FirstChildElement("table:table-row");
-            size_t rowCount = 0;
-
-            // Read every row
-            while (row)
+            for (size_t j = 0; j < table.nWidth; j++)
             {
-                tinyxml2::XMLElement* cell = row->FirstChildElement();
-                int colCount = 0;
-
-                // Examine each cell
-                while (cell)
-                {
-                    // Does this row still belong to the previously identified
-                    // table headlines?
-                    if (vCommentRows[nTableId])
-                    {
-                        // Ensure that it contains the text element and write
-                        // that to the current columns headline
-                        if (cell->FirstChildElement("text:p"))
-                        {
-                            if (fileData->at(colCount + nOffSet)->m_sHeadLine.length())
-                                fileData->at(colCount + nOffSet)->m_sHeadLine += "\n";
-
-                            fileData->at(colCount + nOffSet)->m_sHeadLine += utf8parser(cell->FirstChildElement("text:p")->GetText());
-                        }
-                    }
-                    else
-                    {
-                        // Some data types need some special pre-processing
-                        if (cell->Attribute("office:value-type", "string"))
-                            fileData->at(colCount + nOffSet)->setValue(rowCount, utf8parser(cell->FirstChildElement()->GetText()));
-                        else if (cell->Attribute("office:value-type", "boolean"))
-                            fileData->at(colCount + nOffSet)->setValue(rowCount, cell->Attribute("office:boolean-value"));
-                        else if (cell->FirstChildElement("text:p"))
-                            fileData->at(colCount + nOffSet)->setValue(rowCount, cell->FirstChildElement("text:p")->GetText());
-                    }
-
-                    colCount += cell->IntAttribute("table:number-columns-repeated", 1);
-                    cell = cell->NextSiblingElement();
-                }
-
-                if (vCommentRows[nTableId])
-                    vCommentRows[nTableId]--;
+                if (table.vColumns[j])
+                    fileData->at(nOffSet+j) = std::move(table.vColumns[j]);
                 else
-                    rowCount++;
-
-                row = row->NextSiblingElement("table:table-row");
+                    fileData->at(nOffSet+j).reset(new StringColumn);
             }
 
-            nOffSet += vTableSizes[nTableId];
-            nTableId++;
-        } while ((table = table->NextSiblingElement("table:table")));
+            nOffSet += table.nWidth;
+        }
 
         // Now calculate the total number of rows in this data set
         for (TblColPtr& col : *fileData)
         {
-            nRows = col->size() > nRows ? col->size() : nRows;
+            nRows = (long long int)col->size() > nRows ? col->size() : nRows;
         }
     }
 
 
 
+    /////////////////////////////////////////////////
+    /// \brief Static helper function returning the
+    /// offset between the MS-Excel epoch and the
+    /// UNIX epoch in seconds.
+    ///
+    /// \return double
+    ///
+    /////////////////////////////////////////////////
+    static double getExcelEpochOffset()
+    {
+        static const double epochOffset = to_double(StrToTime("1899-12-30"));
+        return epochOffset;
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief Static helper function to convert
     /// MS-Excel time values to the acutal UNIX epoch.
@@ -3523,8 +3841,7 @@ namespace NumeRe
     /////////////////////////////////////////////////
     static std::string convertExcelTimeToEpoch(std::string sXlsTime, bool isTimeVal)
     {
-        static const double epochOffset = to_double(StrToTime("1899-12-30"));
-        return toString(to_timePoint(StrToDb(sXlsTime)*24*3600 + (!isTimeVal)*epochOffset),
+        return toString(to_timePoint(StrToDb(sXlsTime)*24*3600 + (!isTimeVal)*getExcelEpochOffset()),
                         GET_MILLISECONDS | GET_FULL_PRECISION | GET_UNBIASED_TIME | (isTimeVal)*GET_ONLY_TIME);
     }
 
@@ -3813,404 +4130,636 @@ namespace NumeRe
     }
 
 
-    //////////////////////////////////////////////
-    // class XLSXSpreadSheet
-    //////////////////////////////////////////////
-    //
-    XLSXSpreadSheet::XLSXSpreadSheet(const string& filename) : GenericFile(filename)
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to decode an
+    /// Excel cell reference (e.g. "AB12") into
+    /// zero-based numerical indices.
+    ///
+    /// \param sRef const std::string&
+    /// \param nLine int&
+    /// \param nCol int&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void decodeExcelCellRef(const std::string& sRef, int& nLine, int& nCol)
     {
-        // Empty constructor
+        int col = 0;
+        size_t i = 0;
+
+        for (; i < sRef.length() && isalpha(sRef[i]); i++)
+        {
+            col = col*26 + (toupper(sRef[i]) - 'A' + 1);
+        }
+
+        if (i < sRef.length() && isdigit(sRef[i]))
+        {
+            nLine = std::strtol(sRef.c_str()+i, nullptr, 10) - 1;
+            nCol = col - 1;
+        }
     }
 
 
-    XLSXSpreadSheet::~XLSXSpreadSheet()
+    /////////////////////////////////////////////////
+    /// \brief Event handler to determine the number
+    /// of sheets within a XLSX workbook.
+    /////////////////////////////////////////////////
+    class XlsxWorkbookReader : public XmlEventHandler
     {
-        // Empty destructor
-    }
+        private:
+            bool m_inSheets;
+
+        public:
+            size_t m_nSheets;
+
+            XlsxWorkbookReader() : m_inSheets(false), m_nSheets(0) {}
+
+            virtual void startElement(const std::string& sName, const XmlAttributes& attributes) override
+            {
+                if (sName == "sheets")
+                    m_inSheets = true;
+                else if (m_inSheets && sName == "sheet")
+                    m_nSheets++;
+            }
+
+            virtual void endElement(const std::string& sName) override
+            {
+                if (sName == "sheets")
+                    m_inSheets = false;
+            }
+    };
 
 
     /////////////////////////////////////////////////
-    /// \brief This member function is used to read
-    /// the data from the XLSX spreadsheet into the
-    /// internal storage. XLSX is a ZIP file
-    /// containing the data formatted as XML.
-    ///
-    /// \return void
-    ///
+    /// \brief Event handler to extract the shared
+    /// strings table of a XLSX workbook into an
+    /// indexable array.
     /////////////////////////////////////////////////
-    void XLSXSpreadSheet::readFile()
+    class XlsxSharedStringsReader : public XmlEventHandler
     {
-        unsigned int nSheets = 0;
-        long long int nExcelLines = 0;
-        long long int nExcelCols = 0;
-        long long int nOffset = 0;
-        int nRow = 0, nCol = 0;
-        int nRowmin = 0, nRowmax = 0;
-        int nColmin = 0, nColmax = 0;
-        bool bBreakSignal = false;
+        private:
+            bool m_inText;
+            bool m_inPhonetic;
 
-        vector<long long int> vCommentLines;
-        string sEntry;
-        string sSheetContent;
-        string sStringsContent;
-        string sCellLocation;
-
-        // We use TinyXML-2 as XML libary in this case
-        tinyxml2::XMLDocument _workbook;
-        tinyxml2::XMLDocument _sheet;
-        tinyxml2::XMLDocument _strings;
-        tinyxml2::XMLDocument _styles;
-        tinyxml2::XMLNode* _node;
-        tinyxml2::XMLElement* _element;
-        tinyxml2::XMLElement* _stringelement;
-
-        // Get the content of the workbool XML file
-        sEntry = getZipFileItem("xl/workbook.xml");
-
-        // Ensure that a workbook XML is available
-        if (!sEntry.length())
-            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+        public:
+            std::vector<std::string> m_strings;
 
-        // Parse the file to obtain the number of
-        // sheets, which are associated with this
-        // workbook
-        _workbook.Parse(sEntry.c_str());
+            XlsxSharedStringsReader() : m_inText(false), m_inPhonetic(false) {}
 
-        // Ensure that we could parse the file correctly
-        if (_workbook.ErrorID())
-            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+            virtual void startElement(const std::string& sName, const XmlAttributes& attributes) override
+            {
+                if (sName == "si")
+                    m_strings.emplace_back();
+                else if (sName == "rPh")
+                    m_inPhonetic = true;
+                else if (sName == "t" && !m_inPhonetic && m_strings.size())
+                    m_inText = true;
+            }
 
-        // Search the first child of the "sheets" node
-        // in the current workbook and count all siblings
-        _node = _workbook.FirstChildElement()->FirstChildElement("sheets")->FirstChild();
+            virtual void endElement(const std::string& sName) override
+            {
+                if (sName == "t")
+                    m_inText = false;
+                else if (sName == "rPh")
+                    m_inPhonetic = false;
+                else if (sName == "si")
+                    m_strings.back() = utf8parser(m_strings.back());
+            }
 
-        if (_node)
-            nSheets++;
+            virtual void characters(const std::string& sText) override
+            {
+                // Rich text strings consist of multiple runs
+                if (m_inText)
+                    m_strings.back() += sText;
+            }
+    };
 
-        while ((_node = _node->NextSibling()))
-            nSheets++;
 
-        // Ensure that we have at least one sheet in
-        // the workbook
-        if (!nSheets)
-            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+    /////////////////////////////////////////////////
+    /// \brief Event handler to extract the number
+    /// format IDs of the cell styles of a XLSX
+    /// workbook.
+    /////////////////////////////////////////////////
+    class XlsxStylesReader : public XmlEventHandler
+    {
+        private:
+            bool m_inCellXfs;
 
-        // Walk through the sheets and extract the
-        // dimension info
-        for (unsigned int i = 0; i < nSheets; i++)
-        {
-            // Get the file contents of the current
-            // sheet
-            sSheetContent = getZipFileItem("xl/worksheets/sheet"+toString(i+1)+".xml");
+        public:
+            std::vector<int> m_numFmts;
 
-            // Ensure that the sheet is not empty
-            if (!sSheetContent.length())
-                throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+            XlsxStylesReader() : m_inCellXfs(false) {}
 
-            // Parse the sheet and catch parsing
-            // errors
-            _sheet.Parse(sSheetContent.c_str());
+            virtual void startElement(const std::string& sName, const XmlAttributes& attributes) override
+            {
+                if (sName == "cellXfs")
+                    m_inCellXfs = true;
+                else if (m_inCellXfs && sName == "xf")
+                    m_numFmts.push_back(attributes.getInt("numFmtId", -1));
+            }
 
-            if (_sheet.ErrorID())
-                throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+            virtual void endElement(const std::string& sName) override
+            {
+                if (sName == "cellXfs")
+                    m_inCellXfs = false;
+            }
+    };
 
-            // Get the dimensions of the current sheet
-            _element = _sheet.FirstChildElement()->FirstChildElement("dimension");
-            sCellLocation = _element->Attribute("ref");
 
-            // Determine the dimensions of this sheet
-            evalIndices(sCellLocation.substr(0, sCellLocation.find(':')), nRowmin, nColmin);
-            evalIndices(sCellLocation.substr(sCellLocation.find(':') + 1), nRowmax, nColmax);
-            tinyxml2::XMLElement* cols = _sheet.FirstChildElement()->FirstChildElement("cols");
+    /////////////////////////////////////////////////
+    /// \brief This structure holds a single cell of
+    /// a XLSX sheet until it can be stored.
+    /////////////////////////////////////////////////
+    struct XlsxCell
+    {
+        int nRow;
+        int nCol;
+        std::string sType;
+        std::string sValue;
+        int nStyle;
+        bool hasValue;
+        bool hasChildren;
+    };
 
-            // We use the columns identifiers to check and probably
-            // update the necessary columns
-            if (cols && cols->FirstChildElement())
+
+    /////////////////////////////////////////////////
+    /// \brief Event handler for streaming a single
+    /// sheet of a XLSX workbook. The cells are
+    /// written with their native types into the
+    /// columns of this sheet. Only the leading
+    /// candidates for headline rows are buffered
+    /// until the number of headlines is known.
+    /////////////////////////////////////////////////
+    class XlsxSheetReader : public XmlEventHandler
+    {
+        private:
+            const std::vector<std::string>& m_sharedStrings;
+            const std::vector<int>& m_numFmts;
+            std::vector<XlsxCell> m_rowCells;
+            std::vector<XlsxCell> m_pendingCells;
+            std::vector<std::vector<std::string>> m_rawCells;
+            size_t m_nCells;
+            int m_currentRow;
+            int m_lastCol;
+            bool m_inSheetData;
+            bool m_inCell;
+            bool m_inValue;
+            bool m_detectHeadLines;
+
+            void finishRow();
+            void storeCell(const XlsxCell& cell);
+
+        public:
+            TableColumnArray m_columns;
+            int m_rowMin, m_colMin;
+            int m_rowMax, m_colMax;
+            long long int m_commentLines;
+            bool m_hasRows;
+
+            XlsxSheetReader(const std::vector<std::string>& vSharedStrings, const std::vector<int>& vNumFmts)
+                : m_sharedStrings(vSharedStrings), m_numFmts(vNumFmts), m_nCells(0), m_currentRow(0), m_lastCol(-1),
+                  m_inSheetData(false), m_inCell(false), m_inValue(false), m_detectHeadLines(true),
+                  m_rowMin(0), m_colMin(0), m_rowMax(0), m_colMax(0), m_commentLines(0), m_hasRows(false) {}
+
+            /////////////////////////////////////////////////
+            /// \brief Returns the number of columns needed
+            /// for this sheet.
+            ///
+            /// \return int
+            ///
+            /////////////////////////////////////////////////
+            int width() const
             {
-                cols = cols->FirstChildElement();
+                return m_colMax - m_colMin + 1;
+            }
+
+            virtual void startElement(const std::string& sName, const XmlAttributes& attributes) override;
+            virtual void endElement(const std::string& sName) override;
+            virtual void characters(const std::string& sText) override;
+    };
 
-                do
-                {
-                    if (cols->IntAttribute("max") > nColmax+1)
-                        nColmax = cols->IntAttribute("max")-1;
 
-                } while ((cols = cols->NextSiblingElement()));
+    /////////////////////////////////////////////////
+    /// \brief Handles opening XML tags.
+    ///
+    /// \param sName const std::string&
+    /// \param attributes const XmlAttributes&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void XlsxSheetReader::startElement(const std::string& sName, const XmlAttributes& attributes)
+    {
+        if (m_inCell)
+        {
+            XlsxCell& cell = m_rowCells[m_nCells-1];
+            cell.hasChildren = true;
+
+            // Values and inline strings
+            if (sName == "v" || sName == "t")
+            {
+                m_inValue = true;
+                cell.hasValue = true;
             }
 
-            vCommentLines.push_back(0);
+            return;
+        }
 
-            // Search the data section of the sheet
-            _node = _sheet.FirstChildElement()->FirstChildElement("sheetData")->FirstChild();
+        if (m_inSheetData)
+        {
+            if (sName == "row")
+            {
+                m_currentRow = attributes.getInt("r");
+                m_lastCol = -1;
+                m_nCells = 0;
+                m_hasRows = true;
+            }
+            else if (sName == "c")
+            {
+                if (m_nCells >= m_rowCells.size())
+                    m_rowCells.emplace_back();
+
+                XlsxCell& cell = m_rowCells[m_nCells++];
+                const std::string* attr;
+
+                // Cells without reference follow their
+                // predecessor
+                cell.nRow = m_currentRow-1;
+                cell.nCol = m_lastCol+1;
+
+                if ((attr = attributes.get("r")))
+                    decodeExcelCellRef(*attr, cell.nRow, cell.nCol);
+
+                m_lastCol = cell.nCol;
+                cell.sType = (attr = attributes.get("t")) ? *attr : "";
+                cell.nStyle = attributes.getInt("s", -1);
+                cell.sValue.clear();
+                cell.hasValue = false;
+                cell.hasChildren = false;
+                m_inCell = true;
+            }
 
-            if (!_node)
-                continue;
+            return;
+        }
+
+        if (sName == "dimension")
+        {
+            const std::string* ref = attributes.get("ref");
 
-            // Find pure textual lines in the current
-            // sheet, which will be used as table column
-            // heads
-            do
+            if (ref)
             {
-                // Find the next cell
-                int currentRow = _node->ToElement()->IntAttribute("r");
-                _element = _node->ToElement()->FirstChildElement("c");
+                decodeExcelCellRef(ref->substr(0, ref->find(':')), m_rowMin, m_colMin);
+                decodeExcelCellRef(ref->substr(ref->find(':')+1), m_rowMax, m_colMax);
+            }
+        }
+        else if (sName == "col")
+        {
+            // We use the columns identifiers to check and probably
+            // update the necessary columns
+            if (attributes.getInt("max") > m_colMax+1)
+                m_colMax = attributes.getInt("max")-1;
+        }
+        else if (sName == "sheetData")
+        {
+            m_inSheetData = true;
 
-                // Row does not contain any cells
-                if (!_element)
-                {
-                    vCommentLines[i] = currentRow;
-                    continue;
-                }
+            if (width() > 0)
+            {
+                m_columns.resize(width());
+                m_rawCells.resize(width());
+            }
+        }
+    }
 
-                size_t cellCount = 0;
 
-                do
-                {
-                    cellCount++;
+    /////////////////////////////////////////////////
+    /// \brief Handles closing XML tags.
+    ///
+    /// \param sName const std::string&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void XlsxSheetReader::endElement(const std::string& sName)
+    {
+        if (m_inCell)
+        {
+            if (sName == "v" || sName == "t")
+                m_inValue = false;
+            else if (sName == "c")
+                m_inCell = false;
 
-                    if (_element->Attribute("t"))
-                    {
-                        // If the attribute signalizes a
-                        // non-string element, we abort here
-                        if (_element->Attribute("t") != string("s"))
-                        {
-                            bBreakSignal = true;
-                            break;
-                        }
-                    }
-                    else if (_element->FirstChildElement()) // Ensure that the cell is not empty
-                    {
-                        bBreakSignal = true;
-                        break;
-                    }
-                }
-                while ((_element = _element->NextSiblingElement()));
+            return;
+        }
 
-                // Only use the first row as headline candidates
-                if (!bBreakSignal)
-                    vCommentLines[i] = currentRow;
+        if (sName == "row" && m_inSheetData)
+            finishRow();
+        else if (sName == "sheetData")
+        {
+            m_inSheetData = false;
 
-                // Search for the first nearly complete line of strings
-                if (bBreakSignal || 4/3.0 * cellCount >= nColmax-nColmin+1)
-                    break;
+            // Sheet consists of headlines only
+            for (const XlsxCell& cell : m_pendingCells)
+            {
+                storeCell(cell);
             }
-            while ((_node = _node->NextSibling()));
 
-            bBreakSignal = false;
+            m_pendingCells.clear();
+            m_detectHeadLines = false;
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Collects the text within value and
+    /// inline string elements.
+    ///
+    /// \param sText const std::string&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void XlsxSheetReader::characters(const std::string& sText)
+    {
+        if (m_inValue)
+            m_rowCells[m_nCells-1].sValue += sText;
+    }
 
-            // Calculate the maximal number of needed
-            // rows to store all sheets next to each
-            // other
-            if (nExcelLines < nRowmax-nRowmin+1-vCommentLines[i])
-                nExcelLines = nRowmax-nRowmin+1-vCommentLines[i];
 
-            // Add the number of columns to the total
-            // number of columns
-            nExcelCols += nColmax-nColmin+1;
+    /////////////////////////////////////////////////
+    /// \brief Stores the cells of the completed row.
+    /// As long as the leading rows are examined for
+    /// pure textual lines (which will be used as
+    /// column heads), the cells are buffered.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void XlsxSheetReader::finishRow()
+    {
+        if (!m_detectHeadLines)
+        {
+            for (size_t i = 0; i < m_nCells; i++)
+            {
+                storeCell(m_rowCells[i]);
+            }
 
-            g_logger.info("headlines=" + toString(vCommentLines[i]));
+            return;
         }
 
-        // Set the dimensions of the final table
-        nRows = nExcelLines;
-        nCols = nExcelCols;
+        // Row does not contain any cells
+        if (!m_nCells)
+        {
+            m_commentLines = m_currentRow;
+            return;
+        }
 
-        // Allocate the memory
-        createStorage();
+        bool bBreakSignal = false;
 
-        // We create a text-only table first
-        for (long long int j = 0; j < nCols; j++)
+        for (size_t i = 0; i < m_nCells; i++)
         {
-            fileData->at(j).reset(new StringColumn);
+            const XlsxCell& cell = m_rowCells[i];
+
+            // Non-string elements and non-empty cells
+            // without type abort the search
+            if ((cell.sType.length() && cell.sType != "s")
+                || (!cell.sType.length() && cell.hasChildren))
+            {
+                bBreakSignal = true;
+                break;
+            }
         }
 
-        // Walk through the sheets and extract the
-        // contents to memory
-        //
-        // Get the contents of the shared strings
-        // XML file and parse it
-        sStringsContent = getZipFileItem("xl/sharedStrings.xml");
-        _strings.Parse(sStringsContent.c_str());
-        std::string sStylesContent = getZipFileItem("xl/styles.xml");
-        _styles.Parse(sStylesContent.c_str());
-        tinyxml2::XMLElement* cellXfs = _styles.FirstChildElement()->FirstChildElement("cellXfs");
-
-        // Go through all sheets
-        for (unsigned int i = 0; i < nSheets; i++)
-        {
-            // Get the file contents of the current
-            // sheet and parse it
-            sSheetContent = getZipFileItem("xl/worksheets/sheet"+toString(i+1)+".xml");
-            _sheet.Parse(sSheetContent.c_str());
-
-            // Search the data section and the dimensions
-            // of the current sheet
-            _node = _sheet.FirstChildElement()->FirstChildElement("sheetData")->FirstChild();
-            _element = _sheet.FirstChildElement()->FirstChildElement("dimension");
-
-            // Ensure that data is available
-            if (!_node)
-                continue;
+        m_pendingCells.insert(m_pendingCells.end(), m_rowCells.begin(), m_rowCells.begin()+m_nCells);
 
-            // Extract the target indices
-            sCellLocation = _element->Attribute("ref");
-            evalIndices(sCellLocation.substr(0, sCellLocation.find(':')), nRowmin, nColmin);
-            evalIndices(sCellLocation.substr(sCellLocation.find(':')+1), nRowmax, nColmax);
+        // Only use the first row as headline candidates
+        if (!bBreakSignal)
+            m_commentLines = m_currentRow;
 
-            tinyxml2::XMLElement* cols = _sheet.FirstChildElement()->FirstChildElement("cols");
+        // Search for the first nearly complete line of strings
+        if (bBreakSignal || 4/3.0 * m_nCells >= width())
+        {
+            m_detectHeadLines = false;
 
-            if (cols && cols->FirstChildElement())
+            for (const XlsxCell& cell : m_pendingCells)
             {
-                cols = cols->FirstChildElement();
+                storeCell(cell);
+            }
+
+            m_pendingCells.clear();
+        }
+    }
 
-                do
-                {
-                    if (cols->IntAttribute("max") > nColmax+1)
-                        nColmax = cols->IntAttribute("max")-1;
 
-                } while ((cols = cols->NextSiblingElement()));
+    /////////////////////////////////////////////////
+    /// \brief Writes a single cell with its native
+    /// type into the corresponding column or its
+    /// column head.
+    ///
+    /// \param cell const XlsxCell&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void XlsxSheetReader::storeCell(const XlsxCell& cell)
+    {
+        int nRow = cell.nRow - m_rowMin;
+        int nCol = cell.nCol - m_colMin;
+
+        if (nCol < 0 || nCol >= (int)m_columns.size())
+            return;
+
+        TblColPtr& col = m_columns[nCol];
+        std::vector<std::string>& vRawCells = m_rawCells[nCol];
+        long long int nTargetRow = nRow - m_commentLines;
+
+        // catch textual cells and store them
+        // in the corresponding table column
+        // head
+        if (cell.sType == "s" || cell.sType == "inlineStr")
+        {
+            std::string sEntry;
+
+            if (cell.sType == "inlineStr")
+                sEntry = utf8parser(cell.sValue);
+            else
+            {
+                long int nPos = std::strtol(cell.sValue.c_str(), nullptr, 10);
+
+                if (nPos >= 0 && nPos < (long int)m_sharedStrings.size())
+                    sEntry = m_sharedStrings[nPos];
             }
 
-            // Go through each cell and store its
-            // value at the correct position in the
-            // final table. If we hit a textual cell,
-            // then we store its contents as a table
+            // If the string is not empty, then
+            // we'll add it to the correct table
             // column head
-            do
+            if (!sEntry.length())
+                return;
+
+            if (nTargetRow < 0)
             {
-                _element = _node->ToElement()->FirstChildElement("c");
+                if (!col)
+                    col.reset(new StringColumn);
 
-                // Does not contain any cells
-                if (!_element)
-                    continue;
+                if (!col->m_sHeadLine.length())
+                    col->m_sHeadLine = sEntry;
+                else if (col->m_sHeadLine != sEntry)
+                    col->m_sHeadLine += "\n" + sEntry;
+            }
+            else
+                writeTypedCell(col, vRawCells, nTargetRow, TableColumn::TYPE_STRING, mu::value_type(), sEntry);
 
-                // Go through the cells of the current
-                // row
-                do
-                {
-                    sCellLocation = _element->Attribute("r");
-                    evalIndices(sCellLocation, nRow, nCol);
-                    nCol -= nColmin;
-                    nRow -= nRowmin;
+            return;
+        }
 
-                    if (nCol+nOffset >= nCols)
-                        continue;
+        if (!cell.hasValue || nTargetRow < 0)
+            return;
 
-                    // catch textual cells and store them
-                    // in the corresponding table column
-                    // head
-                    if (_element->Attribute("t") && _element->Attribute("t") == string("s"))
-                    {
-                        //Handle text
-                        int nPos = 0;
-                        _element->FirstChildElement("v")->QueryIntText(&nPos);
-                        _stringelement = _strings.FirstChildElement()->FirstChildElement("si");
+        if (cell.sType == "b")
+        {
+            writeTypedCell(col, vRawCells, nTargetRow, TableColumn::TYPE_LOGICAL, mu::value_type(cell.sValue != "0"),
+                           cell.sValue == "0" ? "false" : "true");
+            return;
+        }
 
-                        for (int k = 1; k <= nPos; k++)
-                        {
-                            _stringelement = _stringelement->NextSiblingElement();
-                        }
+        if (cell.sType == "str" || cell.sType == "e")
+        {
+            writeTypedCell(col, vRawCells, nTargetRow, TableColumn::TYPE_STRING, mu::value_type(), utf8parser(cell.sValue));
+            return;
+        }
 
-                        if (_stringelement->FirstChildElement()->FirstChild())
-                            sEntry = utf8parser(_stringelement->FirstChildElement()->FirstChild()->ToText()->Value());
-                        else
-                            sEntry.clear();
+        // Decode styles
+        int numFmtId = cell.nStyle >= 0 && cell.nStyle < (int)m_numFmts.size() ? m_numFmts[cell.nStyle] : -1;
 
-                        // If the string is not empty, then
-                        // we'll add it to the correct table
-                        // column head
-                        if (sEntry.length())
-                        {
-                            if (nRow - vCommentLines[i] < 0)
-                            {
-                                if (!fileData->at(nCol+nOffset)->m_sHeadLine.length())
-                                    fileData->at(nCol+nOffset)->m_sHeadLine = sEntry;
-                                else if (fileData->at(nCol+nOffset)->m_sHeadLine != sEntry)
-                                    fileData->at(nCol+nOffset)->m_sHeadLine += "\n" + sEntry;
-                            }
-                            else
-                                fileData->at(nCol+nOffset)->setValue(nRow-vCommentLines[i], sEntry);
-                        }
-
-                        continue;
-                    }
-                    else if (_element->FirstChildElement("v"))
-                    {
-                        std::string sValue = utf8parser(_element->FirstChildElement("v")->GetText());
+        // Those are time formats: 14-22, 45-47
+        if ((numFmtId >= 14 && numFmtId <= 22) || (numFmtId >= 45 && numFmtId <= 47))
+        {
+            bool isTimeVal = (numFmtId >= 18 && numFmtId <= 21) || numFmtId >= 45;
 
-                        // Decode styles
-                        if (_element->Attribute("t") && _element->Attribute("t") == string("b"))
-                            sValue = sValue == "0" ? "false" : "true";
-                        else if (_element->Attribute("s") && cellXfs && cellXfs->FirstChildElement())
-                        {
-                            // Style ID
-                            int styleId = _element->IntAttribute("s");
-                            tinyxml2::XMLElement* style = cellXfs->FirstChildElement();
+            writeTypedCell(col, vRawCells, nTargetRow, TableColumn::TYPE_DATETIME,
+                           mu::value_type(StrToDb(cell.sValue)*24*3600 + (!isTimeVal)*getExcelEpochOffset()),
+                           convertExcelTimeToEpoch(cell.sValue, isTimeVal));
+            return;
+        }
 
-                            // Find the correct style ID
-                            while (styleId && style)
-                            {
-                                style = style->NextSiblingElement();
-                                styleId--;
-                            }
+        writeTypedCell(col, vRawCells, nTargetRow, TableColumn::TYPE_VALUE, mu::value_type(StrToDb(cell.sValue)), cell.sValue);
+    }
 
-                            if (!styleId && style && style->Attribute("numFmtId"))
-                            {
-                                styleId = style->IntAttribute("numFmtId");
 
-                                // Those are time formats: 14-22, 45-47
-                                if ((styleId >= 14 && styleId <= 22) || (styleId >= 45 && styleId <= 47))
-                                    sValue = convertExcelTimeToEpoch(sValue, (styleId >= 18 && styleId <= 21)
-                                                                              || (styleId >= 45 && styleId >= 47));
-                            }
-                        }
+    //////////////////////////////////////////////
+    // class XLSXSpreadSheet
+    //////////////////////////////////////////////
+    //
+    XLSXSpreadSheet::XLSXSpreadSheet(const string& filename) : GenericFile(filename)
+    {
+        // Empty constructor
+    }
 
-                        // Write the decoded string to the table column array
-                        fileData->at(nCol+nOffset)->setValue(nRow-vCommentLines[i], sValue);
-                    }
-                }
-                while ((_element = _element->NextSiblingElement()));
-            }
-            while ((_node = _node->NextSibling()));
 
-            nOffset += nColmax-nColmin+1;
-        }
+    XLSXSpreadSheet::~XLSXSpreadSheet()
+    {
+        // Empty destructor
     }
 
 
     /////////////////////////////////////////////////
-    /// \brief This member function converts the
-    /// usual Excel indices into numerical ones.
+    /// \brief This member function is used to read
+    /// the data from the XLSX spreadsheet into the
+    /// internal storage. XLSX is a ZIP file
+    /// containing the data formatted as XML. The
+    /// sheets are inflated and parsed chunk-wise
+    /// and in parallel, while the cells are written
+    /// with their native types into the columns.
     ///
-    /// \param _sIndices const string&
-    /// \param nLine int&
-    /// \param nCol int&
     /// \return void
     ///
     /////////////////////////////////////////////////
-    void XLSXSpreadSheet::evalIndices(const string& _sIndices, int& nLine, int& nCol)
+    void XLSXSpreadSheet::readFile()
     {
-        //A1 -> IV65536
-        string sIndices = toUpperCase(_sIndices);
+        XlsxWorkbookReader workbook;
+
+        // Parse the workbook to obtain the number
+        // of sheets, which are associated with this
+        // workbook and ensure that we have at least
+        // one sheet
+        if (!streamZipFileItem("xl/workbook.xml", workbook) || !workbook.m_nSheets)
+            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+        // Get the shared strings and the styles, which
+        // are needed by all sheets
+        XlsxSharedStringsReader strings;
+        XlsxStylesReader styles;
+        streamZipFileItem("xl/sharedStrings.xml", strings);
+        streamZipFileItem("xl/styles.xml", styles);
+
+        std::vector<XlsxSheetReader> vSheets;
+        std::vector<std::exception_ptr> vExceptions(workbook.m_nSheets);
+        vSheets.reserve(workbook.m_nSheets);
 
-        for (size_t i = 0; i < sIndices.length(); i++)
+        for (size_t i = 0; i < workbook.m_nSheets; i++)
         {
-            // Find the first character,
-            // which is a digit: that's a
-            // line index
-            if (isdigit(sIndices[i]))
+            vSheets.emplace_back(strings.m_strings, styles.m_numFmts);
+        }
+
+        // Read the sheets in parallel. Each sheet uses
+        // its own ZIP handle
+        #pragma omp parallel for schedule(dynamic)
+        for (int i = 0; i < (int)vSheets.size(); i++)
+        {
+            try
+            {
+                // Ensure that the sheet is not empty
+                if (!streamZipFileItem("xl/worksheets/sheet"+toString(i+1)+".xml", vSheets[i]))
+                    throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+            }
+            catch (...)
             {
-                // Convert the line index
-                nLine = StrToInt(sIndices.substr(i))-1;
+                vExceptions[i] = std::current_exception();
+            }
+        }
 
-                // Convert the column index.
-                // This index might be two
-                // characters long
-                if (i == 2)
-                    nCol = (sIndices[0]-'A'+1)*26+sIndices[1]-'A';
-                else if (i == 1)
-                    nCol = sIndices[0]-'A';
+        for (std::exception_ptr& e : vExceptions)
+        {
+            if (e)
+                std::rethrow_exception(e);
+        }
 
-                break;
+        // Calculate the maximal number of needed
+        // rows to store all sheets next to each
+        // other and the total number of columns
+        nRows = 0;
+        nCols = 0;
+
+        for (const XlsxSheetReader& sheet : vSheets)
+        {
+            if (!sheet.m_hasRows)
+                continue;
+
+            nRows = std::max(nRows, (long long int)sheet.m_rowMax-sheet.m_rowMin+1-sheet.m_commentLines);
+            nCols += sheet.m_columns.size();
+            g_logger.info("headlines=" + toString(sheet.m_commentLines));
+        }
+
+        // Ensure that we found at least a single
+        // column
+        if (!nCols)
+            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+        // Allocate the memory
+        createStorage();
+
+        long long int nOffset = 0;
+
+        // Move the columns of all sheets into the
+        // final table
+        for (XlsxSheetReader& sheet : vSheets)
+        {
+            if (!sheet.m_hasRows)
+                continue;
+
+            for (TblColPtr& col : sheet.m_columns)
+            {
+                if (!col)
+                    col.reset(new StringColumn);
+
+                nRows = std::max(nRows, (long long int)col->size());
+                fileData->at(nOffset) = std::move(col);
+                nOffset++;
             }
         }
     }
@@ -24,8 +24,10 @@
 #include <cmath>
 #include <vector>
 #include <utility>
+#include <cstring>
 
 #include "../utils/zip++.hpp"
+#include "../utils/xmlstreamreader.hpp"
 #include "../utils/stringtools.hpp"
 #include "../ui/error.hpp"
 #include "../datamanagement/tablecolumn.hpp"
@@ -327,6 +329,77 @@ namespace NumeRe
                 return " ";
             }
 
+            /////////////////////////////////////////////////
+            /// \brief This method appends the textual
+            /// representation of the selected cell to the
+            /// passed line and aligns it to the right of
+            /// the passed width. Numerical values are
+            /// formatted into a stack buffer and do not need
+            /// any temporary strings. Invalid cells are
+            /// replaced by the passed string.
+            ///
+            /// \param sLine std::string&
+            /// \param nRow long long int
+            /// \param nCol long long int
+            /// \param nPrecision int
+            /// \param nWidth size_t
+            /// \param sInvalid const char*
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void appendCell(std::string& sLine, long long int nRow, long long int nCol, int nPrecision, size_t nWidth, const char* sInvalid) const
+            {
+                char buffer[NUMBERBUFFERSIZE];
+                std::string sValue;
+                const char* sCell = buffer;
+                size_t nLength;
+                const TableColumn* col = fileData->at(nCol).get();
+
+                if (!col || !col->isValid(nRow))
+                {
+                    sCell = sInvalid;
+                    nLength = strlen(sInvalid);
+                }
+                else if (col->m_type == TableColumn::TYPE_VALUE)
+                    nLength = formatNumber(buffer, NUMBERBUFFERSIZE, col->getValue(nRow), nPrecision);
+                else
+                {
+                    sValue = col->getValueAsInternalString(nRow);
+                    sCell = sValue.c_str();
+                    nLength = sValue.length();
+                }
+
+                if (nLength < nWidth)
+                    sLine.append(nWidth - nLength, ' ');
+
+                sLine.append(sCell, nLength);
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief This method determines, whether the
+            /// rows of the table may be formatted
+            /// concurrently. This is only worth it for
+            /// larger tables. Date-time columns are always
+            /// formatted serially, because their conversion
+            /// queries the system's time zone settings.
+            ///
+            /// \return bool
+            ///
+            /////////////////////////////////////////////////
+            bool canFormatInParallel() const
+            {
+                if (nRows * nCols < 100000)
+                    return false;
+
+                for (long long int j = 0; j < nCols; j++)
+                {
+                    if (fileData->at(j) && fileData->at(j)->m_type == TableColumn::TYPE_DATETIME)
+                        return false;
+                }
+
+                return true;
+            }
+
             /////////////////////////////////////////////////
             /// \brief This method is a template fo reading
             /// a numeric field of the selected template type
@@ -404,6 +477,55 @@ namespace NumeRe
                 return sFileItem;
             }
 
+            /////////////////////////////////////////////////
+            /// \brief This method inflates an embedded file
+            /// of a zipfile chunk-wise and passes the
+            /// contents directly to the XML event handler.
+            /// The embedded file is never held in memory
+            /// as a whole. Returns false, if the embedded
+            /// file does not exist or is empty and throws,
+            /// if its contents are not valid XML.
+            ///
+            /// \param filename const std::string&
+            /// \param handler XmlEventHandler&
+            /// \return bool
+            ///
+            /////////////////////////////////////////////////
+            bool streamZipFileItem(const std::string& filename, XmlEventHandler& handler)
+            {
+                // Every call uses its own zip handle, which
+                // allows reading multiple items concurrently
+                Zipfile _zip;
+
+                if (!_zip.open(sFileName))
+                    throw SyntaxError(SyntaxError::DATAFILE_NOT_EXIST, sFileName, SyntaxError::invalid_position, sFileName);
+
+                if (!_zip.openZipItem(filename))
+                    return false;
+
+                const size_t CHUNKSIZE = 1 << 18;
+                std::vector<char> vBuffer(CHUNKSIZE);
+                XmlStreamReader reader(handler);
+                size_t nBytes;
+                size_t nTotalBytes = 0;
+
+                while ((nBytes = _zip.readZipItem(&vBuffer[0], CHUNKSIZE)))
+                {
+                    if (!reader.feed(&vBuffer[0], nBytes))
+                        throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+                    nTotalBytes += nBytes;
+                }
+
+                if (!nTotalBytes)
+                    return false;
+
+                if (!reader.finish())
+                    throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+                return true;
+            }
+
             /////////////////////////////////////////////////
             /// \brief This method template is for reading a
             /// block of numeric data into memory in binary
@@ -1485,7 +1607,7 @@ namespace NumeRe
             void writeDummyHeader();
             void writeFile();
             void writeColumn(const TblColPtr& col);
-            void readHeader();
+            void readHeader(bool bVerifyChecksum = true);
             void skipDummyHeader();
             void readFile();
             void readColumn(TblColPtr& col);
@@ -1601,6 +1723,8 @@ namespace NumeRe
 
             void readCacheHeader();
             void writeCacheHeader();
+            void readTableInformation(size_t nthTable);
+            void readTable(size_t nthTable);
 
             /////////////////////////////////////////////////
             /// \brief Returns the number of tables stored in
@@ -1849,7 +1973,6 @@ namespace NumeRe
     {
         private:
             void readFile();
-            void evalIndices(const std::string& sIndices, int& nLine, int& nCol);
 
         public:
             XLSXSpreadSheet(const std::string& filename);
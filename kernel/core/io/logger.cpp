@@ -21,6 +21,7 @@
 #include <windows.h>
 
 DetachedLogger g_logger;
+thread_local std::vector<std::string>* DetachedLogger::m_deferred = nullptr;
 
 typedef BOOL (WINAPI* LPFN_ISWOW64PROCESS) (HANDLE, PBOOL);
 
@@ -264,6 +265,25 @@ void DetachedLogger::setLoggingLevel(Logger::LogLevel lvl)
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Collects all messages of the calling
+/// thread in the passed buffer instead of
+/// writing them, so that worker threads do not
+/// access the log concurrently. The messages
+/// have to be written by the caller with
+/// push_info(). Passing a nullptr ends the
+/// collection.
+///
+/// \param deferred std::vector<std::string>*
+/// \return void
+///
+/////////////////////////////////////////////////
+void DetachedLogger::deferMessages(std::vector<std::string>* deferred)
+{
+    m_deferred = deferred;
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Push a message to the logger, which
 /// is not dependend on the logging level and
@@ -275,7 +295,9 @@ void DetachedLogger::setLoggingLevel(Logger::LogLevel lvl)
 /////////////////////////////////////////////////
 void DetachedLogger::push_info(const std::string& sInfo)
 {
-    if (is_buffering())
+    if (m_deferred)
+        m_deferred->push_back(sInfo);
+    else if (is_buffering())
         m_buffer.push_back(sInfo);
     else
         Logger::push_line(sInfo);
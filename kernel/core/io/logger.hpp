@@ -71,6 +71,7 @@ class DetachedLogger : public Logger
     private:
         std::vector<std::string> m_buffer;
         Logger::LogLevel m_level;
+        static thread_local std::vector<std::string>* m_deferred;
 
     public:
         DetachedLogger(Logger::LogLevel lvl = Logger::LVL_INFO);
@@ -79,6 +80,7 @@ class DetachedLogger : public Logger
         bool is_buffering() const;
         bool open(const std::string& sLogFile);
         void setLoggingLevel(Logger::LogLevel lvl);
+        void deferMessages(std::vector<std::string>* deferred);
 
         void push_info(const std::string& sInfo);
         void write_system_information();
@@ -34,6 +34,10 @@
 #define TRAPEZOIDAL 1
 #define SIMPSON 2
 
+// Number of samples per block for reading and
+// writing audio files
+#define AUDIO_BLOCKSIZE (size_t)65536
+
 using namespace std;
 
 DefaultVariables _defVars;
@@ -3671,16 +3675,13 @@ bool writeAudioFile(CommandLineParser& cmdParser)
 
     _accessParser.evalIndices();
 
-    if (_idx.col.size() > 2)
-        return false;
-
     // Find the absolute maximal value
     dMin = fabs(_data.min(_accessParser.getDataObject(), _idx.row, _idx.col));
     dMax = fabs(_data.max(_accessParser.getDataObject(), _idx.row, _idx.col));
 
     dMax = std::max(dMin, dMax);
 
-    nChannels = _idx.col.size() > 1 ? 2 : 1;
+    nChannels = _idx.col.size();
 
     std::unique_ptr<Audio::File> audiofile(Audio::getAudioFileByType(sAudioFileName));
 
@@ -3694,15 +3695,78 @@ bool writeAudioFile(CommandLineParser& cmdParser)
     if (!audiofile.get()->isValid())
         return false;
 
-    for (size_t i = 0; i < _idx.row.size(); i++)
+    std::vector<std::vector<double>> vChannels(nChannels);
+
+    // Write the samples block-wise, i.e. read a block
+    // of each column and pass it to the encoder
+    for (size_t i = 0; i < _idx.row.size(); i += AUDIO_BLOCKSIZE)
     {
-        audiofile.get()->write(Audio::Sample(_data.getElement(_idx.row[i], _idx.col[0], _accessParser.getDataObject()).real() / dMax, nChannels > 1 ? _data.getElement(_idx.row[i], _idx.col[1], _accessParser.getDataObject()).real() / dMax : NAN));
+        VectorIndex vRows = _idx.row.subidx(i, AUDIO_BLOCKSIZE);
+
+        for (int c = 0; c < nChannels; c++)
+        {
+            std::vector<mu::value_type> vValues = _data.getElement(vRows, VectorIndex(_idx.col[c]), _accessParser.getDataObject());
+            vChannels[c].assign(vRows.size(), NAN);
+
+            for (size_t j = 0; j < std::min(vValues.size(), vRows.size()); j++)
+            {
+                vChannels[c][j] = vValues[j].real() / dMax;
+            }
+        }
+
+        audiofile.get()->writeBlock(vChannels, vRows.size());
     }
 
     return true;
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Static helper function to read nLen
+/// samples from the current position of the
+/// audio file block-wise and to write each
+/// channel into its target column. Returns the
+/// number of samples, which have been read.
+///
+/// \param audiofile Audio::File*
+/// \param _table Memory*
+/// \param _targetIdx const Indices&
+/// \param vCols const VectorIndex&
+/// \param nLen size_t
+/// \return size_t
+///
+/////////////////////////////////////////////////
+static size_t readAudioBlocks(Audio::File* audiofile, Memory* _table, const Indices& _targetIdx, const VectorIndex& vCols, size_t nLen)
+{
+    std::vector<std::vector<double>> vChannels;
+    size_t nRead = 0;
+
+    nLen = std::min(nLen, _targetIdx.row.size());
+
+    while (nRead < nLen)
+    {
+        size_t nSamples = audiofile->readBlock(vChannels, std::min(nLen - nRead, AUDIO_BLOCKSIZE));
+
+        if (!nSamples)
+            break;
+
+        for (size_t c = 0; c < std::min(vCols.size(), vChannels.size()); c++)
+        {
+            const std::vector<double>& vChannel = vChannels[c];
+
+            for (size_t i = 0; i < nSamples; i++)
+            {
+                _table->writeDataDirectUnsafe(_targetIdx.row[nRead+i], vCols[c], vChannel[i]);
+            }
+        }
+
+        nRead += nSamples;
+    }
+
+    return nRead;
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Reads either the audio file meta
 /// information or the whole audio file to memory.
@@ -3732,39 +3796,31 @@ bool readAudioFile(CommandLineParser& cmdParser)
         size_t nLen = audiofile.get()->getLength();
         size_t nChannels = audiofile.get()->getChannels();
 
+        // One target column per channel, as long as
+        // there are enough columns available
+        VectorIndex vCols = _targetIdx.col.subidx(0, nChannels);
+
         // Try to read the entire file
-        _data.resizeTable(nChannels > 1 && _targetIdx.col.size() > 1 ? _targetIdx.col.subidx(0, 2).max()+1 : _targetIdx.col.front()+1,
-                          sTarget);
+        _data.resizeTable(vCols.max()+1, sTarget);
 
         Memory* _table = _data.getTable(sTarget);
         int rowmax = _targetIdx.row.subidx(0, nLen).max();
 
         // Write the last row for preallocation
-        _table->writeData(rowmax, _targetIdx.col.front(), 0.0);
-
-        if (nChannels > 1 && _targetIdx.col.size() > 1)
-            _table->writeData(rowmax, _targetIdx.col[1], 0.0);
-
-        for (size_t i = 0; i < nLen; i++)
+        for (size_t c = 0; c < vCols.size(); c++)
         {
-            Audio::Sample sample = audiofile.get()->read();
-
-            if (_targetIdx.row.size() <= i)
-                break;
-
-            _table->writeDataDirectUnsafe(_targetIdx.row[i], _targetIdx.col[0], sample.leftOrMono);
-
-            if (nChannels > 1 && _targetIdx.col.size() > 1)
-                _table->writeDataDirectUnsafe(_targetIdx.row[i], _targetIdx.col[1], sample.right);
+            _table->writeData(rowmax, vCols[c], 0.0);
         }
 
+        readAudioBlocks(audiofile.get(), _table, _targetIdx, vCols, nLen);
+
         _table->markModified();
 
         // Create the storage indices
         std::vector<mu::value_type> vIndices = {_targetIdx.row.min()+1,
             _targetIdx.row.size() < nLen ? _targetIdx.row.max()+1 : _targetIdx.row.min()+nLen,
-            (nChannels > 1 && _targetIdx.col.size() > 1 ? _targetIdx.col.subidx(0, 2).min()+1 : _targetIdx.col.front()+1),
-            (nChannels > 1 && _targetIdx.col.size() > 1 ? _targetIdx.col.subidx(0, 2).max()+1 : _targetIdx.col.front()+1)};
+            vCols.min()+1,
+            vCols.max()+1};
 
         cmdParser.setReturnValue(vIndices);
         g_logger.info("Audiofile read.");
@@ -3829,32 +3885,22 @@ bool seekInAudioFile(CommandLineParser& cmdParser)
     seekable.get()->setPosition(std::max(vSeekIndices[0].real()-1, 0.0));
     nLen = std::min(nLen - seekable.get()->getPosition(), (size_t)(std::max(vSeekIndices[1].real(), 0.0)));
 
+    VectorIndex vCols = _targetIdx.col.subidx(0, nChannels);
+
     // Try to read the desired length from the file
-    _data.resizeTable(nChannels > 1 && _targetIdx.col.size() > 1 ? _targetIdx.col.subidx(0, 2).max()+1 : _targetIdx.col.front()+1,
-                      sTarget);
+    _data.resizeTable(vCols.max()+1, sTarget);
 
     Memory* _table = _data.getTable(sTarget);
     int rowmax = _targetIdx.row.subidx(0, nLen).max();
 
     // Write the last row for pre-allocation
-    _table->writeData(rowmax, _targetIdx.col.front(), 0.0);
-
-    if (nChannels > 1 && _targetIdx.col.size() > 1)
-        _table->writeData(rowmax, _targetIdx.col[1], 0.0);
-
-    for (size_t i = 0; i < nLen; i++)
+    for (size_t c = 0; c < vCols.size(); c++)
     {
-        Audio::Sample sample = seekable.get()->read();
-
-        if (_targetIdx.row.size() <= i)
-            break;
-
-        _table->writeDataDirectUnsafe(_targetIdx.row[i], _targetIdx.col[0], sample.leftOrMono);
-
-        if (nChannels > 1 && _targetIdx.col.size() > 1)
-            _table->writeDataDirectUnsafe(_targetIdx.row[i], _targetIdx.col[1], sample.right);
+        _table->writeData(rowmax, vCols[c], 0.0);
     }
 
+    readAudioBlocks(seekable.get(), _table, _targetIdx, vCols, nLen);
+
     _table->markModified();
     cmdParser.setReturnValue(toString(nLen));
     g_logger.info("Seeked portion read.");
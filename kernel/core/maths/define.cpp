@@ -18,6 +18,7 @@
 
 #include "define.hpp"
 #include "../../kernel.hpp"
+#include "../utils/symbolindex.hpp"
 
 using namespace mu;
 using namespace std;
@@ -59,6 +60,8 @@ FunctionDefinition& FunctionDefinition::operator=(const FunctionDefinition& _def
     vArguments = _def.vArguments;
     sComment = _def.sComment;
     sParsedDefinitionString = _def.sParsedDefinitionString;
+    vTemplateSegments = _def.vTemplateSegments;
+    vTemplateArguments = _def.vTemplateArguments;
 
     return *this;
 }
@@ -76,7 +79,6 @@ FunctionDefinition& FunctionDefinition::operator=(const FunctionDefinition& _def
 /////////////////////////////////////////////////
 string FunctionDefinition::parse(const string& _sArgList)
 {
-    string sParsedDefinition = sParsedDefinitionString;
     static const string sOperators = "+-*/^&|!?:{";
     string sArgs = _sArgList;
 
@@ -117,8 +119,8 @@ string FunctionDefinition::parse(const string& _sArgList)
         }
     }
 
-    // Replace the variables in the definition with
-    // the passed arguments
+    // Prepare the passed arguments for replacing the
+    // variables in the definition
     for (size_t n = 0; n < vArguments.size(); n++)
     {
         // If fewer values than required are passed,
@@ -142,12 +144,6 @@ string FunctionDefinition::parse(const string& _sArgList)
                 vArg.erase(vArg.begin()+n+1, vArg.end());
             }
         }
-
-        // Replace each occurence
-        while (sParsedDefinition.find(vArguments[n]) != string::npos)
-        {
-            sParsedDefinition.replace(sParsedDefinition.find(vArguments[n]), vArguments[n].length(), vArg[n]);
-        }
     }
 
     // Ensure that the number of passed values is not
@@ -155,6 +151,20 @@ string FunctionDefinition::parse(const string& _sArgList)
     if (vArg.size() > vArguments.size())
         throw SyntaxError(SyntaxError::TOO_MANY_ARGS_FOR_DEFINE, sDefinitionString, SyntaxError::invalid_position);
 
+    // The template is created only once per definition
+    if (vTemplateSegments.empty())
+        compileTemplate();
+
+    // Assemble the definition from the template
+    // segments and the passed arguments
+    string sParsedDefinition = vTemplateSegments.front();
+
+    for (size_t i = 0; i < vTemplateArguments.size(); i++)
+    {
+        sParsedDefinition += vArg[vTemplateArguments[i]];
+        sParsedDefinition += vTemplateSegments[i+1];
+    }
+
     // Remove obsolete surrounding whitespaces
     StripSpaces(sParsedDefinition);
 
@@ -196,6 +206,8 @@ bool FunctionDefinition::importFunction(const string& _sExportedString)
 {
     string sImport = _sExportedString;
     vArguments.clear();
+    vTemplateSegments.clear();
+    vTemplateArguments.clear();
 
     // Decode function identifier
     sName = sImport.substr(0, sImport.find(';'));
@@ -359,6 +371,10 @@ bool FunctionDefinition::decodeDefinition()
     if (isMultiValue(sParsedDefinitionString))
         sParsedDefinitionString = "{" + sParsedDefinitionString + "}";
 
+    // Split the parsed definition into its
+    // argument placeholders
+    compileTemplate();
+
     return true;
 }
 
@@ -494,6 +510,52 @@ bool FunctionDefinition::replaceArgumentOccurences()
 }
 
 
+/////////////////////////////////////////////////
+/// \brief This private member function splits
+/// the parsed definition string into the literal
+/// segments between the argument placeholders
+/// and the indices of the corresponding
+/// arguments. Calling the definition is then
+/// only a concatenation instead of a repeated
+/// search and replace.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void FunctionDefinition::compileTemplate()
+{
+    vTemplateSegments.clear();
+    vTemplateArguments.clear();
+
+    size_t nLastPos = 0;
+    size_t nPos = 0;
+
+    // Search for the next possible placeholder
+    while ((nPos = sParsedDefinitionString.find(">>", nPos)) != string::npos)
+    {
+        bool isPlaceholder = false;
+
+        for (size_t n = 0; n < vArguments.size(); n++)
+        {
+            if (sParsedDefinitionString.compare(nPos, vArguments[n].length(), vArguments[n]) == 0)
+            {
+                vTemplateSegments.push_back(sParsedDefinitionString.substr(nLastPos, nPos-nLastPos));
+                vTemplateArguments.push_back(n);
+                nPos += vArguments[n].length();
+                nLastPos = nPos;
+                isPlaceholder = true;
+                break;
+            }
+        }
+
+        if (!isPlaceholder)
+            nPos++;
+    }
+
+    vTemplateSegments.push_back(sParsedDefinitionString.substr(nLastPos));
+}
+
+
 
 //////////////////////////////////
 // CLASS FUNCTIONDEFINITIONMANAGER
@@ -511,6 +573,7 @@ FunctionDefinitionManager::FunctionDefinitionManager(bool _isLocal) : FileSystem
     sFileName = "<>/functions.def";
     sTables = "";
     isLocal = _isLocal;
+    nIrregularNames = -1;
 }
 
 
@@ -529,6 +592,7 @@ FunctionDefinitionManager::FunctionDefinitionManager(const FunctionDefinitionMan
 
     mFunctionsMap = _defined.mFunctionsMap;
     isLocal = _defined.isLocal;
+    invalidateCache();
 }
 
 
@@ -666,6 +730,7 @@ bool FunctionDefinitionManager::defineFunc(const string& sExpr, bool bRedefine,
         if (mFunctionsMap.find(sExpr.substr(0, sExpr.find("()"))) != mFunctionsMap.end())
         {
             mFunctionsMap[sExpr.substr(0, sExpr.find("()"))].appendComment(sComment);
+            invalidateCache();
 
             return true;
         }
@@ -725,6 +790,7 @@ bool FunctionDefinitionManager::defineFunc(const string& sExpr, bool bRedefine,
 
     // "define" the function
     mFunctionsMap[definition.sName] = definition;
+    invalidateCache();
 
     // Recreate the function string
     sFunctionString = definition.getDefinition().substr(definition.getDefinition().find(":=")+2);
@@ -741,6 +807,7 @@ bool FunctionDefinitionManager::defineFunc(const string& sExpr, bool bRedefine,
             else
                 mFunctionsMap[definition.sName] = fallback;
 
+            invalidateCache();
             return false;
         }
     }
@@ -751,6 +818,7 @@ bool FunctionDefinitionManager::defineFunc(const string& sExpr, bool bRedefine,
         else
             mFunctionsMap[definition.sName] = fallback;
 
+        invalidateCache();
         throw;
     }
 
@@ -772,7 +840,10 @@ bool FunctionDefinitionManager::defineFunc(const string& sExpr, bool bRedefine,
 bool FunctionDefinitionManager::undefineFunc(const string& sFunc)
 {
     if (mFunctionsMap.find(sFunc.substr(0, sFunc.find('('))) != mFunctionsMap.end())
+    {
         mFunctionsMap.erase(sFunc.substr(0, sFunc.find('(')));
+        invalidateCache();
+    }
 
     if (isLocal)
         return true;
@@ -791,7 +862,9 @@ bool FunctionDefinitionManager::undefineFunc(const string& sFunc)
 /// \brief This function searches for known
 /// custom definitions in the passed expression
 /// and replaces them with their parsed
-/// definition strings.
+/// definition strings. Expressions, which have
+/// already been expanded, are taken from the
+/// internal cache.
 ///
 /// \param sExpr string&
 /// \param nRecursion int
@@ -803,6 +876,119 @@ bool FunctionDefinitionManager::call(string& sExpr, int nRecursion)
     if (!NumeReKernel::getInstance())
         return false;
 
+    if (!sExpr.length())
+        return true;
+
+    // Nothing to replace. We only have to ensure
+    // the surrounding whitespaces
+    if (!mFunctionsMap.size())
+    {
+        if (sExpr.front() != ' ')
+            sExpr.insert(0, 1, ' ');
+
+        if (sExpr.back() != ' ')
+            sExpr += " ";
+
+        return true;
+    }
+
+    // Nested calls are not cached
+    if (nRecursion)
+        return expand(sExpr, nRecursion);
+
+    auto iter = mExpansionCache.find(sExpr);
+
+    if (iter != mExpansionCache.end())
+    {
+        sExpr = iter->second;
+        return true;
+    }
+
+    string sUnexpanded = sExpr;
+
+    if (!expand(sExpr, 0))
+        return false;
+
+    // Avoid an unbounded growth of the cache
+    if (mExpansionCache.size() >= 1024)
+        mExpansionCache.clear();
+
+    mExpansionCache[sUnexpanded] = sExpr;
+
+    return true;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This private member function scans the
+/// passed expression once and adds the names of
+/// all defined functions, which appear as an
+/// identifier followed by an opening
+/// parenthesis, to the set of candidates. If a
+/// function name cannot be found as a single
+/// token, all definitions are added instead.
+///
+/// \param sExpr const std::string&
+/// \param setCandidates std::set<std::string>&
+/// \return void
+///
+/////////////////////////////////////////////////
+void FunctionDefinitionManager::findCallCandidates(const std::string& sExpr, std::set<std::string>& setCandidates)
+{
+    static const IdentifierScanner scanner;
+
+    // Determine once, whether all names are
+    // regular identifiers
+    if (nIrregularNames < 0)
+    {
+        nIrregularNames = 0;
+
+        for (const auto& iter : mFunctionsMap)
+        {
+            if (!scanner.isRegular(iter.first))
+                nIrregularNames++;
+        }
+    }
+
+    if (nIrregularNames)
+    {
+        for (const auto& iter : mFunctionsMap)
+            setCandidates.insert(iter.first);
+
+        return;
+    }
+
+    std::vector<IdentifierToken> vTokens;
+    scanner.scan(sExpr, vTokens);
+    std::string sToken;
+
+    for (const IdentifierToken& token : vTokens)
+    {
+        if (sExpr[token.pos+token.length] != '(')
+            continue;
+
+        sToken.assign(sExpr, token.pos, token.length);
+
+        if (mFunctionsMap.find(sToken) != mFunctionsMap.end())
+            setCandidates.insert(sToken);
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This private member function performs
+/// the actual replacement of the custom defined
+/// functions in the passed expression. Will call
+/// itself recursively, as long as replacements
+/// were done.
+///
+/// \param sExpr string&
+/// \param nRecursion int
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool FunctionDefinitionManager::expand(string& sExpr, int nRecursion)
+{
     string sTemp = "";
     string sImpFunc = "";
     bool bDoRecursion = false;
@@ -828,14 +1014,26 @@ bool FunctionDefinitionManager::call(string& sExpr, int nRecursion)
     if (sExpr[sExpr.length()-1] != ' ')
         sExpr += " ";
 
-    // search through the whole set of definitions for
-    // possible matches
-    for (auto iter = mFunctionsMap.begin(); iter != mFunctionsMap.end(); ++iter)
+    // Tokenize the expression once and examine only
+    // those definitions, which are possibly called
+    std::set<std::string> setCandidates;
+    findCallCandidates(sExpr, setCandidates);
+
+    // Search through the set of candidates for actual
+    // matches. New candidates might be added while
+    // replacing the found calls
+    for (auto cand = setCandidates.begin(); cand != setCandidates.end(); ++cand)
     {
+        auto iter = mFunctionsMap.find(*cand);
+
+        if (iter == mFunctionsMap.end())
+            continue;
+
+        const string sCallName = iter->second.sName + "(";
         size_t nPos = 0;
 
         // Is there a possible match?
-        if (sExpr.find(iter->second.sName + "(") != string::npos)
+        if (sExpr.find(sCallName) != string::npos)
         {
             // Check for each occurence, whether the candidate
             // is an actual match and replace it with the parsed
@@ -843,20 +1041,20 @@ bool FunctionDefinitionManager::call(string& sExpr, int nRecursion)
             do
             {
                 // Is it an actual match?
-                if (!checkDelimiter(sExpr.substr(sExpr.find(iter->second.sName + "(", nPos)-1, iter->second.sName.length()+2))
-                    || isInQuotes(sExpr, sExpr.find(iter->second.sName + "(", nPos), true))
+                if (!checkDelimiter(sExpr.substr(sExpr.find(sCallName, nPos)-1, iter->second.sName.length()+2))
+                    || isInQuotes(sExpr, sExpr.find(sCallName, nPos), true))
                 {
-                    nPos = sExpr.find(iter->second.sName + "(", nPos) + iter->second.sName.length() + 1;
+                    nPos = sExpr.find(sCallName, nPos) + iter->second.sName.length() + 1;
                     continue;
                 }
 
                 // Copy the part in front of the match into a
                 // temporary buffer
-                sTemp = sExpr.substr(0, sExpr.find(iter->second.sName + "(", nPos));
+                sTemp = sExpr.substr(0, sExpr.find(sCallName, nPos));
 
                 // save the position of the argument's opening
                 // parenthesis
-                nPos = sExpr.find(iter->second.sName + "(",nPos) + iter->second.sName.length();
+                nPos = sExpr.find(sCallName,nPos) + iter->second.sName.length();
 
                 // Copy the calling arguments
                 string sArgs = sExpr.substr(nPos);
@@ -924,15 +1122,17 @@ bool FunctionDefinitionManager::call(string& sExpr, int nRecursion)
                 // boolean to true
                 if (!bDoRecursion)
                     bDoRecursion = true;
+
+                findCallCandidates(sExpr, setCandidates);
             }
-            while (sExpr.find(iter->second.sName + "(", nPos) != string::npos);
+            while (sExpr.find(sCallName, nPos) != string::npos);
         }
     }
 
     // If necessary, then perform another recursion
     if (bDoRecursion)
     {
-        if (!call(sExpr, nRecursion+1))
+        if (!expand(sExpr, nRecursion+1))
             return false;
     }
 
@@ -1040,6 +1240,7 @@ string FunctionDefinitionManager::getComment(size_t _i) const
 bool FunctionDefinitionManager::reset()
 {
     mFunctionsMap.clear();
+    invalidateCache();
 
     return true;
 }
@@ -1133,6 +1334,8 @@ bool FunctionDefinitionManager::load(const Settings& _option, bool bAutoLoad)
             mFunctionsMap[definition.sName] = definition;
         }
 
+        invalidateCache();
+
         if (!bAutoLoad && _option.systemPrints())
         {
             NumeReKernel::printPreFmt(toSystemCodePage(_lang.get("COMMON_SUCCESS")) + ".\n");
@@ -26,6 +26,8 @@
 #include <iostream>
 #include <fstream>
 #include <map>
+#include <set>
+#include <unordered_map>
 #include <vector>
 
 #include "../ui/error.hpp"
@@ -58,10 +60,14 @@ class FunctionDefinition
         bool appendComment(const std::string& _sComment);
 
     private:
+        std::vector<std::string> vTemplateSegments;
+        std::vector<size_t> vTemplateArguments;
+
         bool decodeDefinition();
         bool splitAndValidateArguments();
         bool convertToValues();
         bool replaceArgumentOccurences();
+        void compileTemplate();
 };
 
 
@@ -81,7 +87,28 @@ class FunctionDefinitionManager : public FileSystem
         std::string sTables;
         bool isLocal;
 
+        // Caches the expanded expressions. Has to be
+        // invalidated whenever a definition changes
+        std::unordered_map<std::string, std::string> mExpansionCache;
+        int nIrregularNames;
+
         std::string resolveRecursiveDefinitions(std::string sDefinition);
+        bool expand(std::string& sExpr, int nRecursion);
+        void findCallCandidates(const std::string& sExpr, std::set<std::string>& setCandidates);
+
+        /////////////////////////////////////////////////
+        /// \brief Removes all cached expansions. Has to
+        /// be called after every modification of the
+        /// function map.
+        ///
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        inline void invalidateCache()
+        {
+            mExpansionCache.clear();
+            nIrregularNames = -1;
+        }
         std::map<std::string, FunctionDefinition>::const_iterator findItemById(size_t id) const;
 
     public:
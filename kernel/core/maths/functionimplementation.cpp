@@ -44,6 +44,7 @@
 #include <omp.h>
 
 #include "student_t.hpp"
+#include "orderstatistics.hpp"
 #include "../datamanagement/memorymanager.hpp"
 #include "../utils/tools.hpp"
 #include "../version.h"
@@ -855,12 +856,10 @@ value_type parser_Norm(const value_type* vElements, int nElements)
 /////////////////////////////////////////////////
 value_type parser_Med(const value_type* vElements, int nElements)
 {
-    Memory _mem;
+    std::vector<double> vData;
+    appendFiniteValues(vData, vElements, nElements);
 
-    for (int i = 0; i < nElements; i++)
-        _mem.writeData(i, 0, vElements[i]);
-
-    return _mem.med(VectorIndex(0, nElements-1), VectorIndex(0));
+    return selectMedian(vData);
 }
 
 
@@ -875,12 +874,13 @@ value_type parser_Med(const value_type* vElements, int nElements)
 /////////////////////////////////////////////////
 value_type parser_Pct(const value_type* vElements, int nElements)
 {
-    Memory _mem;
+    if (vElements[nElements-1].real() >= 1 || vElements[nElements-1].real() <= 0)
+        return NAN;
 
-    for (int i = 0; i < nElements-1; i++)
-        _mem.writeData(i, 0, vElements[i]);
+    std::vector<double> vData;
+    appendFiniteValues(vData, vElements, nElements-1);
 
-    return _mem.pct(VectorIndex(0, nElements-2), VectorIndex(0), vElements[nElements-1]);
+    return selectQuantile(vData, vElements[nElements-1].real());
 }
 
 
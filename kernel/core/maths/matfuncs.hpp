@@ -32,6 +32,7 @@
 #include "../../kernel.hpp"
 #include "functionimplementation.hpp"
 #include "statslogic.hpp"
+#include "orderstatistics.hpp"
 
 // Forward declaration from tools.hpp
 std::mt19937& getRandGenInstance();
@@ -1736,19 +1737,10 @@ static Matrix matrixMed(const MatFuncData& funcData, const MatFuncErrorInfo& err
     if (funcData.mat1.isEmpty())
         throw SyntaxError(SyntaxError::MATRIX_CANNOT_HAVE_ZERO_SIZE, errorInfo.command, errorInfo.position);
 
-    Memory _mem;
-    size_t nElems = funcData.mat1.data().size();
+    std::vector<double> vData;
+    appendFiniteValues(vData, funcData.mat1.data().data(), funcData.mat1.data().size());
 
-    // Preallocate
-    _mem.writeData(nElems-1, 0, 0.0);
-
-    //#pragma omp parallel for
-    for (size_t i = 0; i < nElems; i++)
-    {
-        _mem.writeDataDirectUnsafe(i, 0, funcData.mat1.data()[i]);
-    }
-
-    return createFilledMatrix(1, 1, _mem.med(VectorIndex(0, funcData.mat1.rows()*funcData.mat1.cols()-1), VectorIndex(0)));
+    return createFilledMatrix(1, 1, selectMedian(vData));
 }
 
 
@@ -1779,7 +1771,8 @@ static Matrix matrixMovMed(const MatFuncData& funcData, const MatFuncErrorInfo&
         {
             if (!isnan(funcData.mat1(i, j)))
             {
-                Memory _mem;
+                std::vector<double> vWindow;
+                vWindow.reserve((2*funcData.nVal+1)*(2*funcData.mVal+1));
 
                 for (int n = 0; n < 2*funcData.nVal+1; n++)
                 {
@@ -1791,11 +1784,15 @@ static Matrix matrixMovMed(const MatFuncData& funcData, const MatFuncErrorInfo&
                         if (j+m-funcData.mVal < 0 || j+m-funcData.mVal >= (int)funcData.mat1.cols())
                             continue;
 
-                        _mem.writeData(m + n*(2*funcData.mVal+1), 0, funcData.mat1(i+n-funcData.nVal, j+m-funcData.mVal));
+                        const mu::value_type& val = funcData.mat1(i+n-funcData.nVal, j+m-funcData.mVal);
+
+                        // Infinite values are part of the window
+                        if (!mu::isnan(val))
+                            vWindow.push_back(val.real());
                     }
                 }
 
-                _mResult(i, j) = _mem.med(VectorIndex(0, (2*funcData.nVal+1)*(2*funcData.mVal+1)), VectorIndex(0));
+                _mResult(i, j) = selectMedian(vWindow);
             }
         }
     }
@@ -1818,19 +1815,13 @@ static Matrix matrixPct(const MatFuncData& funcData, const MatFuncErrorInfo& err
     if (funcData.mat1.isEmpty())
         throw SyntaxError(SyntaxError::MATRIX_CANNOT_HAVE_ZERO_SIZE, errorInfo.command, errorInfo.position);
 
-    Memory _mem;
-    size_t nElems = funcData.mat1.data().size();
-
-    // Preallocate
-    _mem.writeData(nElems-1, 0, 0.0);
+    if (funcData.fVal.real() >= 1 || funcData.fVal.real() <= 0)
+        return createFilledMatrix(1, 1, NAN);
 
-    //#pragma omp parallel for
-    for (size_t i = 0; i < nElems; i++)
-    {
-        _mem.writeDataDirectUnsafe(i, 0, funcData.mat1.data()[i]);
-    }
+    std::vector<double> vData;
+    appendFiniteValues(vData, funcData.mat1.data().data(), funcData.mat1.data().size());
 
-    return createFilledMatrix(1, 1, _mem.pct(VectorIndex(0, (long long int)(funcData.mat1.rows()*funcData.mat1.cols())-1), VectorIndex(0), funcData.fVal));
+    return createFilledMatrix(1, 1, selectQuantile(vData, funcData.fVal.real()));
 }
 
 
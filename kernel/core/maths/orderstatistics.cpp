@@ -0,0 +1,276 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2023  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "orderstatistics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <omp.h>
+
+// Minimal number of elements for using the parallel
+// selection
+#define PARALLEL_SELECTION_THRESHOLD 1000000
+
+// Number of elements used to estimate the pivots of
+// the parallel selection
+#define PARALLEL_SELECTION_SAMPLES 16384
+
+
+/////////////////////////////////////////////////
+/// \brief Appends all values of the passed array
+/// to the vector, which are finite numbers. Only
+/// the real parts are regarded.
+///
+/// \param vData std::vector<double>&
+/// \param values const mu::value_type*
+/// \param nCount size_t
+/// \return void
+///
+/////////////////////////////////////////////////
+void appendFiniteValues(std::vector<double>& vData, const mu::value_type* values, size_t nCount)
+{
+    vData.reserve(vData.size() + nCount);
+
+    for (size_t i = 0; i < nCount; i++)
+    {
+        if (!mu::isnan(values[i]) && std::isfinite(values[i].real()))
+            vData.push_back(values[i].real());
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper function implementing the
+/// parallel variant of the selection in the
+/// style of the Floyd-Rivest algorithm. Two
+/// pivots bracketing the requested ranks are
+/// estimated from a sample of the data, then all
+/// threads count the elements below the lower
+/// pivot and collect the elements between both
+/// pivots. The requested ranks are selected from
+/// this (small) candidate set afterwards. Returns
+/// false, if the ranks are not within the
+/// candidate set, i.e. the estimation failed.
+///
+/// \param vData const std::vector<double>&
+/// \param nFirstRank size_t
+/// \param nRanks size_t
+/// \param vResult double*
+/// \return bool
+///
+/////////////////////////////////////////////////
+static bool parallelSelectRanks(const std::vector<double>& vData, size_t nFirstRank, size_t nRanks, double* vResult)
+{
+    size_t nSize = vData.size();
+    size_t nLastRank = nFirstRank + nRanks - 1;
+
+    // Draw an evenly distributed sample
+    std::vector<double> vSample(PARALLEL_SELECTION_SAMPLES);
+
+    for (size_t i = 0; i < vSample.size(); i++)
+    {
+        vSample[i] = vData[(i * nSize) / vSample.size()];
+    }
+
+    std::sort(vSample.begin(), vSample.end());
+
+    // Enlarge the bracket by some standard deviations of
+    // the rank estimation to make a miss unlikely
+    long long int nMargin = 3 * (long long int)std::sqrt((double)vSample.size());
+    long long int nLowerSample = (long long int)((nFirstRank * vSample.size()) / nSize) - nMargin;
+    long long int nUpperSample = (long long int)((nLastRank * vSample.size()) / nSize) + nMargin;
+
+    bool bHasLower = nLowerSample >= 0;
+    bool bHasUpper = nUpperSample < (long long int)vSample.size();
+    double dLower = bHasLower ? vSample[nLowerSample] : 0.0;
+    double dUpper = bHasUpper ? vSample[nUpperSample] : 0.0;
+
+    size_t nBelow = 0;
+    std::vector<double> vCandidates;
+
+    #pragma omp parallel reduction(+:nBelow)
+    {
+        std::vector<double> vLocal;
+
+        #pragma omp for nowait
+        for (size_t i = 0; i < nSize; i++)
+        {
+            if (bHasLower && vData[i] < dLower)
+                nBelow++;
+            else if (!bHasUpper || vData[i] <= dUpper)
+                vLocal.push_back(vData[i]);
+        }
+
+        #pragma omp critical
+        vCandidates.insert(vCandidates.end(), vLocal.begin(), vLocal.end());
+    }
+
+    // Are the requested ranks part of the candidates?
+    if (nBelow > nFirstRank || nBelow + vCandidates.size() <= nLastRank)
+        return false;
+
+    std::nth_element(vCandidates.begin(), vCandidates.begin() + (nFirstRank-nBelow), vCandidates.end());
+    std::partial_sort(vCandidates.begin() + (nFirstRank-nBelow), vCandidates.begin() + (nLastRank-nBelow+1), vCandidates.end());
+    std::copy(vCandidates.begin() + (nFirstRank-nBelow), vCandidates.begin() + (nLastRank-nBelow+1), vResult);
+
+    return true;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper function returning the
+/// values at the passed consecutive ranks (i.e.
+/// the positions, which they would have in the
+/// sorted data) without sorting the whole data
+/// set. The vector is reordered during the
+/// selection.
+///
+/// All elements before nFrom are known to be
+/// not larger than the elements after it and are
+/// therefore skipped. The returned position may
+/// be used as nFrom for larger ranks in
+/// subsequent calls.
+///
+/// \param vData std::vector<double>&
+/// \param nFrom size_t
+/// \param nFirstRank size_t
+/// \param nRanks size_t
+/// \param vResult double*
+/// \return size_t
+///
+/////////////////////////////////////////////////
+static size_t selectRanks(std::vector<double>& vData, size_t nFrom, size_t nFirstRank, size_t nRanks, double* vResult)
+{
+    if (vData.size() >= PARALLEL_SELECTION_THRESHOLD
+        && omp_get_max_threads() > 1
+        && parallelSelectRanks(vData, nFirstRank, nRanks, vResult))
+        return nFrom;
+
+    // Introselect for the first rank followed by
+    // a partial sort of the remaining ones
+    std::nth_element(vData.begin() + nFrom, vData.begin() + nFirstRank, vData.end());
+
+    if (nRanks > 1)
+        std::partial_sort(vData.begin() + nFirstRank + 1, vData.begin() + nFirstRank + nRanks, vData.end());
+
+    std::copy(vData.begin() + nFirstRank, vData.begin() + nFirstRank + nRanks, vResult);
+    return nFirstRank;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Calculates the median of the passed
+/// values. Returns NaN for empty data sets.
+///
+/// \param vData std::vector<double>&
+/// \return double
+///
+/////////////////////////////////////////////////
+double selectMedian(std::vector<double>& vData)
+{
+    if (!vData.size())
+        return NAN;
+
+    size_t nSize = vData.size();
+    double dMiddle[2];
+
+    if (nSize % 2)
+    {
+        selectRanks(vData, 0, nSize / 2, 1, dMiddle);
+        return dMiddle[0];
+    }
+
+    selectRanks(vData, 0, nSize / 2 - 1, 2, dMiddle);
+    return (dMiddle[0] + dMiddle[1]) / 2.0;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Calculates the quantile of the passed
+/// values by linear interpolation between the
+/// neighbouring ranks. Returns NaN for empty data
+/// sets.
+///
+/// \param vData std::vector<double>&
+/// \param dQuantile double
+/// \return double
+///
+/////////////////////////////////////////////////
+double selectQuantile(std::vector<double>& vData, double dQuantile)
+{
+    return selectQuantiles(vData, std::vector<double>(1, dQuantile)).front();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Calculates several quantiles of the
+/// passed values in one call. The quantiles are
+/// selected in ascending order, so that every
+/// selection only has to regard the elements
+/// above the previously selected rank.
+///
+/// \param vData std::vector<double>&
+/// \param vQuantiles const std::vector<double>&
+/// \return std::vector<double>
+///
+/////////////////////////////////////////////////
+std::vector<double> selectQuantiles(std::vector<double>& vData, const std::vector<double>& vQuantiles)
+{
+    std::vector<double> vResults(vQuantiles.size(), NAN);
+
+    if (!vData.size())
+        return vResults;
+
+    // Process the quantiles in ascending order
+    std::vector<size_t> vOrder(vQuantiles.size());
+
+    for (size_t i = 0; i < vOrder.size(); i++)
+    {
+        vOrder[i] = i;
+    }
+
+    std::sort(vOrder.begin(), vOrder.end(), [&](size_t a, size_t b){return vQuantiles[a] < vQuantiles[b];});
+
+    size_t nSize = vData.size();
+    size_t nFrom = 0;
+
+    for (size_t i : vOrder)
+    {
+        if (std::isnan(vQuantiles[i]) || vQuantiles[i] < 0.0 || vQuantiles[i] > 1.0)
+            continue;
+
+        // Same interpolation as in gsl_stats_quantile_from_sorted_data()
+        double dIndex = vQuantiles[i] * (nSize - 1);
+        size_t nLower = (size_t)std::floor(dIndex);
+        double dDelta = dIndex - nLower;
+        double dNeighbours[2];
+
+        if (nLower + 1 < nSize && dDelta > 0.0)
+        {
+            nFrom = selectRanks(vData, nFrom, nLower, 2, dNeighbours);
+            vResults[i] = (1.0 - dDelta) * dNeighbours[0] + dDelta * dNeighbours[1];
+        }
+        else
+        {
+            nFrom = selectRanks(vData, nFrom, std::min(nLower, nSize-1), 1, dNeighbours);
+            vResults[i] = dNeighbours[0];
+        }
+    }
+
+    return vResults;
+}
+
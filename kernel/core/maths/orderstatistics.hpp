@@ -0,0 +1,38 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2023  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+#ifndef ORDERSTATISTICS_HPP
+#define ORDERSTATISTICS_HPP
+
+#include <vector>
+#include "../ParserLib/muParserDef.h"
+
+// The order statistics are calculated by partial
+// selection instead of sorting the whole data set.
+// The passed vectors contain only finite values and
+// are reordered by these functions. The results are
+// identical to the GSL functions operating on sorted
+// data.
+void appendFiniteValues(std::vector<double>& vData, const mu::value_type* values, size_t nCount);
+double selectMedian(std::vector<double>& vData);
+double selectQuantile(std::vector<double>& vData, double dQuantile);
+std::vector<double> selectQuantiles(std::vector<double>& vData, const std::vector<double>& vQuantiles);
+
+#endif // ORDERSTATISTICS_HPP
+
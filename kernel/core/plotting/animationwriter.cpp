@@ -0,0 +1,308 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2023  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "animationwriter.hpp"
+#include "../ui/error.hpp"
+#include "../utils/tools.hpp"
+#include <cstdio>
+#include <omp.h>
+#include <windows.h>
+
+// Size of the GIF header and the logical screen
+// descriptor
+#define GIF_HEADERSIZE 13
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper to skip a sequence of
+/// GIF data sub-blocks. Returns the position
+/// after the block terminator.
+///
+/// \param sData const std::string&
+/// \param pos size_t
+/// \return size_t
+///
+/////////////////////////////////////////////////
+static size_t skipSubBlocks(const std::string& sData, size_t pos)
+{
+    while (pos < sData.length() && sData[pos])
+        pos += (unsigned char)sData[pos] + 1;
+
+    return pos+1;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Removes the listed temporary files
+/// upon destruction, i.e. also if writing the
+/// animation fails.
+/////////////////////////////////////////////////
+struct TempFileGuard
+{
+    std::vector<std::string> vFiles;
+
+    ~TempFileGuard()
+    {
+        for (const std::string& sFile : vFiles)
+            remove(sFile.c_str());
+    }
+};
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper to create a new and
+/// unique directory in the temporary folder of
+/// the user. No existing directory is reused.
+///
+/// \param sFileName const std::string&
+/// \return std::string
+///
+/////////////////////////////////////////////////
+static std::string createTempDirectory(const std::string& sFileName)
+{
+    char sTempPath[MAX_PATH+1];
+
+    if (!GetTempPathA(MAX_PATH+1, sTempPath))
+        throw SyntaxError(SyntaxError::CANNOT_SAVE_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+    std::string sBaseName = std::string(sTempPath) + "numere_animation_" + toString((int)GetCurrentProcessId()) + "_";
+
+    for (int i = 0; i < 1000; i++)
+    {
+        std::string sTempDir = sBaseName + toString(i);
+
+        if (CreateDirectoryA(sTempDir.c_str(), nullptr))
+            return sTempDir;
+
+        if (GetLastError() != ERROR_ALREADY_EXISTS)
+            break;
+    }
+
+    throw SyntaxError(SyntaxError::CANNOT_SAVE_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Constructor. Opens the target file and
+/// creates the temporary directory for the
+/// frames.
+///
+/// \param _graph mglGraph*&
+/// \param sFileName const std::string&
+/// \param nFramesInFlight size_t
+/// \param nDelay int
+///
+/////////////////////////////////////////////////
+AnimationWriter::AnimationWriter(mglGraph*& _graph, const std::string& sFileName, size_t nFramesInFlight, int nDelay)
+    : m_sFileName(sFileName), m_graph(_graph), m_mainGraph(_graph), m_nFramesInFlight(nFramesInFlight), m_nWrittenFrames(0), m_nDelay(nDelay)
+{
+    // Default to two frames per thread, which
+    // keeps all threads busy during a batch
+    if (!m_nFramesInFlight)
+        m_nFramesInFlight = 2*omp_get_max_threads();
+
+    m_file.open(m_sFileName.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+    if (!m_file.good())
+        throw SyntaxError(SyntaxError::CANNOT_SAVE_FILE, m_sFileName, SyntaxError::invalid_position, m_sFileName);
+
+    m_sTempDir = createTempDirectory(m_sFileName);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Destructor. Deletes all pending frames,
+/// removes the temporary directory and restores
+/// the main graph.
+/////////////////////////////////////////////////
+AnimationWriter::~AnimationWriter()
+{
+    for (mglGraph* frame : m_frames)
+        delete frame;
+
+    RemoveDirectoryA(m_sTempDir.c_str());
+    m_graph = m_mainGraph;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Renders the pending frames
+/// concurrently into temporary single image GIF
+/// files and appends them in their order to the
+/// target file. The temporary files are removed
+/// in any case.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void AnimationWriter::flush()
+{
+    TempFileGuard frameFiles;
+    std::vector<std::string>& vFrameFiles = frameFiles.vFiles;
+
+    for (size_t i = 0; i < m_frames.size(); i++)
+    {
+        vFrameFiles.push_back(m_sTempDir + "/frame" + toString((int)(m_nWrittenFrames+i)) + ".gif");
+    }
+
+    // Rasterization and encoding only depend on the
+    // data of the corresponding graph
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < m_frames.size(); i++)
+    {
+        m_frames[i]->WriteGIF(vFrameFiles[i].c_str());
+    }
+
+    for (size_t i = 0; i < m_frames.size(); i++)
+    {
+        delete m_frames[i];
+        m_frames[i] = nullptr;
+
+        std::ifstream frameFile(vFrameFiles[i].c_str(), std::ios_base::in | std::ios_base::binary);
+        std::string sFrame((std::istreambuf_iterator<char>(frameFile)), std::istreambuf_iterator<char>());
+        frameFile.close();
+
+        appendFrame(sFrame);
+        m_nWrittenFrames++;
+    }
+
+    m_frames.clear();
+    m_graph = m_mainGraph;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Appends a single image GIF as frame to
+/// the animation. The global color table of the
+/// image is converted into a local one and a
+/// graphic control extension with the frame
+/// delay is inserted. The first frame also
+/// writes the header of the animation.
+///
+/// \param sFrame const std::string&
+/// \return void
+///
+/////////////////////////////////////////////////
+void AnimationWriter::appendFrame(const std::string& sFrame)
+{
+    if (sFrame.length() < GIF_HEADERSIZE || sFrame.substr(0, 4) != "GIF8")
+        throw SyntaxError(SyntaxError::CANNOT_SAVE_FILE, m_sFileName, SyntaxError::invalid_position, m_sFileName);
+
+    unsigned char screenFlags = sFrame[10];
+    std::string sColorTable;
+
+    if (screenFlags & 0x80)
+        sColorTable = sFrame.substr(GIF_HEADERSIZE, 3 * (2 << (screenFlags & 0x07)));
+
+    if (!m_nWrittenFrames)
+    {
+        // Header and logical screen descriptor without
+        // the global color table
+        m_file << "GIF89a" << sFrame.substr(6, 4) << (char)(screenFlags & 0x70) << '\0' << '\0';
+
+        // Application extension for an infinite loop
+        m_file << "\x21\xFF\x0B" << "NETSCAPE2.0" << "\x03\x01" << '\0' << '\0' << '\0';
+    }
+
+    size_t pos = GIF_HEADERSIZE + sColorTable.length();
+
+    while (pos < sFrame.length())
+    {
+        if (sFrame[pos] == '\x21')
+        {
+            // Extensions of the single image are not
+            // needed for the animation
+            pos = skipSubBlocks(sFrame, pos+2);
+        }
+        else if (sFrame[pos] == '\x2C' && pos + 10 <= sFrame.length())
+        {
+            // Graphic control extension with the delay
+            // in 1/100 sec
+            m_file << "\x21\xF9\x04\x04" << (char)(m_nDelay & 0xFF) << (char)((m_nDelay >> 8) & 0xFF) << '\0' << '\0';
+
+            unsigned char imageFlags = sFrame[pos+9];
+
+            if (!(imageFlags & 0x80) && sColorTable.length())
+                imageFlags = (imageFlags & 0x40) | 0x80 | (screenFlags & 0x07);
+
+            m_file << sFrame.substr(pos, 9) << (char)imageFlags;
+            pos += 10;
+
+            if (sFrame[pos-1] & 0x80)
+            {
+                // Copy the existing local color table
+                size_t nTableSize = 3 * (2 << (sFrame[pos-1] & 0x07));
+                m_file << sFrame.substr(pos, nTableSize);
+                pos += nTableSize;
+            }
+            else if (imageFlags & 0x80)
+                m_file << sColorTable;
+
+            // LZW minimal code size and the image data
+            size_t nDataEnd = skipSubBlocks(sFrame, pos+1);
+            m_file << sFrame.substr(pos, nDataEnd - pos);
+            pos = nDataEnd;
+        }
+        else
+            break;
+    }
+
+    if (!m_file.good())
+        throw SyntaxError(SyntaxError::CANNOT_SAVE_FILE, m_sFileName, SyntaxError::invalid_position, m_sFileName);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Creates a new graph for the next frame
+/// and sets the referenced graph pointer to it.
+/// If the number of frames in flight is
+/// reached, the pending frames are written
+/// first.
+///
+/// \return mglGraph*
+///
+/////////////////////////////////////////////////
+mglGraph* AnimationWriter::newFrame()
+{
+    if (m_frames.size() >= m_nFramesInFlight)
+        flush();
+
+    m_frames.push_back(new mglGraph());
+    m_graph = m_frames.back();
+
+    return m_graph;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Writes all pending frames and
+/// finalizes the animation.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void AnimationWriter::close()
+{
+    if (m_frames.size())
+        flush();
+
+    // GIF trailer
+    m_file << '\x3B';
+    m_file.close();
+}
+
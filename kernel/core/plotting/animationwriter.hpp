@@ -0,0 +1,67 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2023  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef ANIMATIONWRITER_HPP
+#define ANIMATIONWRITER_HPP
+
+#include <mgl2/mgl.h>
+#include <string>
+#include <vector>
+#include <fstream>
+
+/////////////////////////////////////////////////
+/// \brief This class writes an animated GIF
+/// from separate mglGraph instances, one for
+/// each frame. The frames are collected in
+/// batches, which are rasterized and encoded
+/// concurrently, and appended to the target
+/// file in their order. The number of frames in
+/// flight limits the memory usage. The encoded
+/// frames are written to a private temporary
+/// directory. While the
+/// writer is alive, the referenced graph pointer
+/// points to the current frame. It is restored
+/// upon destruction.
+/////////////////////////////////////////////////
+class AnimationWriter
+{
+    private:
+        std::string m_sFileName;
+        std::string m_sTempDir;
+        std::ofstream m_file;
+        std::vector<mglGraph*> m_frames;
+        mglGraph*& m_graph;
+        mglGraph* m_mainGraph;
+        size_t m_nFramesInFlight;
+        size_t m_nWrittenFrames;
+        int m_nDelay;
+
+        void flush();
+        void appendFrame(const std::string& sFrame);
+
+    public:
+        AnimationWriter(mglGraph*& _graph, const std::string& sFileName, size_t nFramesInFlight, int nDelay);
+        ~AnimationWriter();
+
+        mglGraph* newFrame();
+        void close();
+};
+
+
+#endif // ANIMATIONWRITER_HPP
+
@@ -17,6 +17,8 @@
 ******************************************************************************/
 
 #include "plotasset.hpp"
+#include <algorithm>
+#include <omp.h>
 
 mglData duplicatePoints(const mglData& _mData);
 
@@ -394,6 +396,318 @@ IntervalSet PlotAsset::getWeightedRanges(size_t layer, double dLowerPercentage,
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Static helper to convert a coordinate
+/// into a pixel bucket coordinate.
+///
+/// \param val double
+/// \param dMin double
+/// \param dScale double
+/// \param logscale bool
+/// \return double
+///
+/////////////////////////////////////////////////
+static double toBucketCoord(double val, double dMin, double dScale, bool logscale)
+{
+    if (logscale)
+        return (log10(val) - dMin) * dScale;
+
+    return (val - dMin) * dScale;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Reduces a 1D line plot to the points,
+/// which are necessary to draw it with the
+/// passed number of pixel buckets. For every
+/// bucket the first, the last, the minimal and
+/// the maximal point of every layer are kept
+/// (M4 decimation), which results in the same
+/// rasterized line. Requires a sorted axis.
+/// Returns false, if the asset was not changed.
+///
+/// \param nBuckets size_t
+/// \param visibleRange const Interval&
+/// \param logscale bool
+/// \param nMinPoints size_t
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool PlotAsset::decimateLines(size_t nBuckets, const Interval& visibleRange, bool logscale, size_t nMinPoints)
+{
+    if (type == PT_NONE || axes.size() != 1 || nBuckets < 2)
+        return false;
+
+    size_t nx = axes[0].nx;
+
+    if (nx <= 4*nBuckets)
+        return false;
+
+    for (size_t l = 0; l < data.size(); l++)
+    {
+        if (isComplex(l))
+            return false;
+    }
+
+    const mreal* x = axes[0].a;
+
+    // The buckets are determined by binary searches,
+    // which is only possible on a sorted axis
+    for (size_t i = 0; i < nx; i++)
+    {
+        if (std::isnan(x[i]) || (i && x[i] < x[i-1]))
+            return false;
+    }
+
+    double dMin = visibleRange.min();
+    double dMax = visibleRange.max();
+
+    if (logscale)
+    {
+        if (dMin <= 0.0)
+            return false;
+
+        dMin = log10(dMin);
+        dMax = log10(dMax);
+    }
+
+    if (!std::isfinite(dMin) || !std::isfinite(dMax) || dMax <= dMin)
+        return false;
+
+    double dStep = (dMax - dMin) / nBuckets;
+    std::vector<size_t> vBounds(nBuckets+1);
+
+    for (size_t b = 0; b < nBuckets; b++)
+    {
+        double dBound = dMin + b*dStep;
+        vBounds[b] = std::lower_bound(x, x+nx, logscale ? pow(10.0, dBound) : dBound) - x;
+    }
+
+    vBounds[nBuckets] = std::upper_bound(x, x+nx, visibleRange.max()) - x;
+
+    std::vector<char> vKeep(nx, 0);
+
+    // Keep the nearest points outside of the visible
+    // range to let the lines leave the plot correctly
+    if (vBounds.front())
+        vKeep[vBounds.front()-1] = 1;
+
+    if (vBounds.back() < nx)
+        vKeep[vBounds.back()] = 1;
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (size_t b = 0; b < nBuckets; b++)
+    {
+        size_t nStart = vBounds[b];
+        size_t nEnd = vBounds[b+1];
+
+        if (nStart >= nEnd)
+            continue;
+
+        vKeep[nStart] = 1;
+        vKeep[nEnd-1] = 1;
+
+        for (size_t l = 0; l < data.size(); l++)
+        {
+            const mreal* y = data[l].first.a;
+            size_t nMinPos = nEnd;
+            size_t nMaxPos = nEnd;
+
+            for (size_t i = nStart; i < nEnd; i++)
+            {
+                // Keep both sides of gaps in the line
+                if (i > nStart && std::isnan(y[i]) != std::isnan(y[i-1]))
+                {
+                    vKeep[i-1] = 1;
+                    vKeep[i] = 1;
+                }
+
+                if (std::isnan(y[i]))
+                    continue;
+
+                if (nMinPos == nEnd || y[i] < y[nMinPos])
+                    nMinPos = i;
+
+                if (nMaxPos == nEnd || y[i] > y[nMaxPos])
+                    nMaxPos = i;
+            }
+
+            if (nMinPos < nEnd)
+            {
+                vKeep[nMinPos] = 1;
+                vKeep[nMaxPos] = 1;
+            }
+        }
+    }
+
+    size_t nKept = std::count(vKeep.begin(), vKeep.end(), 1);
+
+    if (nKept < nMinPoints || nKept == nx)
+        return false;
+
+    keepPoints(vKeep, nKept);
+    return true;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Reduces a 1D point plot to a single
+/// point per occupied pixel cell and layer. The
+/// cells are determined from the passed ranges
+/// and points outside of these ranges are
+/// removed. Returns false, if the asset was not
+/// changed.
+///
+/// \param nBucketsX size_t
+/// \param nBucketsY size_t
+/// \param xRange const Interval&
+/// \param yRange const Interval&
+/// \param logX bool
+/// \param logY bool
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool PlotAsset::decimatePoints(size_t nBucketsX, size_t nBucketsY, const Interval& xRange, const Interval& yRange, bool logX, bool logY)
+{
+    if (type == PT_NONE || axes.size() != 1 || nBucketsX < 2 || nBucketsY < 2)
+        return false;
+
+    size_t nx = axes[0].nx;
+
+    if (nx <= 4*nBucketsX)
+        return false;
+
+    for (size_t l = 0; l < data.size(); l++)
+    {
+        if (isComplex(l))
+            return false;
+    }
+
+    double dMinX = logX ? log10(xRange.min()) : xRange.min();
+    double dMaxX = logX ? log10(xRange.max()) : xRange.max();
+    double dMinY = logY ? log10(yRange.min()) : yRange.min();
+    double dMaxY = logY ? log10(yRange.max()) : yRange.max();
+
+    if (!std::isfinite(dMinX) || !std::isfinite(dMaxX) || !std::isfinite(dMinY) || !std::isfinite(dMaxY))
+        return false;
+
+    // Degenerated ranges (e.g. constant data) use a
+    // single row or column of cells
+    double dScaleX = dMaxX > dMinX ? (nBucketsX - 1e-9) / (dMaxX - dMinX) : 0.0;
+    double dScaleY = dMaxY > dMinY ? (nBucketsY - 1e-9) / (dMaxY - dMinY) : 0.0;
+
+    const mreal* x = axes[0].a;
+    size_t nCells = nBucketsX * nBucketsY;
+    std::vector<char> vKeep(nx, 0);
+    int nThreads = std::min(omp_get_max_threads(), (int)std::max<size_t>(1, nx / (4*nBucketsX)));
+
+    for (size_t l = 0; l < data.size(); l++)
+    {
+        const mreal* y = data[l].first.a;
+        std::vector<std::vector<size_t>> vCandidates(nThreads);
+
+        // Every thread finds the first points per cell
+        // in its own contiguous chunk of the data
+        #pragma omp parallel num_threads(nThreads)
+        {
+            int nThread = omp_get_thread_num();
+            size_t nStart = nx * nThread / nThreads;
+            size_t nEnd = nx * (nThread+1) / nThreads;
+            std::vector<char> vOccupied(nCells, 0);
+
+            for (size_t i = nStart; i < nEnd; i++)
+            {
+                if (std::isnan(x[i]) || std::isnan(y[i]))
+                    continue;
+
+                double dCellX = toBucketCoord(x[i], dMinX, dScaleX, logX);
+                double dCellY = toBucketCoord(y[i], dMinY, dScaleY, logY);
+
+                if (!(dCellX >= 0.0 && dCellX < nBucketsX && dCellY >= 0.0 && dCellY < nBucketsY))
+                    continue;
+
+                size_t nCell = (size_t)dCellX + nBucketsX * (size_t)dCellY;
+
+                if (!vOccupied[nCell])
+                {
+                    vOccupied[nCell] = 1;
+                    vCandidates[nThread].push_back(i);
+                }
+            }
+        }
+
+        // Merge the candidates of all chunks in their
+        // index order to keep only the first point
+        std::vector<char> vOccupied(nCells, 0);
+
+        for (int t = 0; t < nThreads; t++)
+        {
+            for (size_t i : vCandidates[t])
+            {
+                size_t nCell = (size_t)toBucketCoord(x[i], dMinX, dScaleX, logX)
+                    + nBucketsX * (size_t)toBucketCoord(y[i], dMinY, dScaleY, logY);
+
+                if (!vOccupied[nCell])
+                {
+                    vOccupied[nCell] = 1;
+                    vKeep[i] = 1;
+                }
+            }
+        }
+    }
+
+    size_t nKept = std::count(vKeep.begin(), vKeep.end(), 1);
+
+    if (!nKept || nKept == nx)
+        return false;
+
+    keepPoints(vKeep, nKept);
+    return true;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Removes all points from the axis and
+/// all layers, which are not marked in the
+/// passed vector.
+///
+/// \param vKeep const std::vector<char>&
+/// \param nKept size_t
+/// \return void
+///
+/////////////////////////////////////////////////
+void PlotAsset::keepPoints(const std::vector<char>& vKeep, size_t nKept)
+{
+    std::vector<size_t> vIndex;
+    vIndex.reserve(nKept);
+
+    for (size_t i = 0; i < vKeep.size(); i++)
+    {
+        if (vKeep[i])
+            vIndex.push_back(i);
+    }
+
+    auto compact = [&vIndex](const mglData& source)
+    {
+        mglData target(vIndex.size());
+
+        #pragma omp parallel for
+        for (size_t i = 0; i < vIndex.size(); i++)
+            target.a[i] = source.a[vIndex[i]];
+
+        return target;
+    };
+
+    for (size_t l = 0; l < data.size(); l++)
+    {
+        data[l].first = compact(data[l].first);
+        data[l].second = compact(data[l].second);
+    }
+
+    axes[0] = compact(axes[0]);
+}
+
+
 
 /////////////////////////////////////////////////
 // PLOTASSETMANAGER
@@ -62,6 +62,9 @@ struct PlotAsset
     void applyModulus(PlotCoords c, double mod);
     mglData vectorsToMatrix() const;
     IntervalSet getWeightedRanges(size_t layer = 0, double dLowerPercentage = 1.0, double dUpperPercentage = 1.0) const;
+    bool decimateLines(size_t nBuckets, const Interval& visibleRange, bool logscale, size_t nMinPoints = 0);
+    bool decimatePoints(size_t nBucketsX, size_t nBucketsY, const Interval& xRange, const Interval& yRange, bool logX, bool logY);
+    void keepPoints(const std::vector<char>& vKeep, size_t nKept);
 
     /////////////////////////////////////////////////
     /// \brief Convenience member function for 1D
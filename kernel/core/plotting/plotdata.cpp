@@ -26,6 +26,46 @@
 extern mglGraph _fontData;
 const char* SECAXIS_DEFAULT_COLOR = "k";
 
+static std::string sPendingFontStyle;
+static std::string sPendingFontPath;
+
+
+/////////////////////////////////////////////////
+/// \brief Selects the font used for plotting.
+/// Loading the font is deferred until the font
+/// is actually needed.
+///
+/// \param sFontStyle const std::string&
+/// \param sFontPath const std::string&
+/// \return void
+///
+/////////////////////////////////////////////////
+void requestPlotFont(const std::string& sFontStyle, const std::string& sFontPath)
+{
+    sPendingFontStyle = sFontStyle;
+    sPendingFontPath = sFontPath;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the font used for plotting and
+/// loads it first, if a new font has been
+/// requested.
+///
+/// \return mglGraph&
+///
+/////////////////////////////////////////////////
+mglGraph& getPlotFont()
+{
+    if (sPendingFontStyle.length())
+    {
+        _fontData.LoadFont(sPendingFontStyle.c_str(), sPendingFontPath.c_str());
+        sPendingFontStyle.clear();
+    }
+
+    return _fontData;
+}
+
 // Function prototype
 bool isNotEmptyExpression(const std::string& sExpr);
 
@@ -151,6 +191,7 @@ static std::map<std::string,std::pair<PlotData::LogicalPlotSetting,PlotData::Par
     mGenericSwitches.emplace("open", std::make_pair(PlotData::LOG_OPENIMAGE, PlotData::SUPERGLOBAL));
     mGenericSwitches.emplace("silent", std::make_pair(PlotData::LOG_SILENTMODE, PlotData::SUPERGLOBAL));
     mGenericSwitches.emplace("cut", std::make_pair(PlotData::LOG_CUTBOX, PlotData::LOCAL));
+    mGenericSwitches.emplace("decimate", std::make_pair(PlotData::LOG_DECIMATE, PlotData::LOCAL));
     mGenericSwitches.emplace("flength", std::make_pair(PlotData::LOG_FIXEDLENGTH, PlotData::LOCAL));
     mGenericSwitches.emplace("colorbar", std::make_pair(PlotData::LOG_COLORBAR, PlotData::LOCAL));
     mGenericSwitches.emplace("orthoproject", std::make_pair(PlotData::LOG_ORTHOPROJECT, PlotData::GLOBAL));
@@ -678,6 +719,17 @@ void PlotData::setParams(const std::string& __sCmd, int nType)
             intSettings[INT_ANIMATESAMPLES] = 50;
     }
 
+    if (findParameter(sCmd, "framebuffer", '=') && (nType == ALL || nType & SUPERGLOBAL))
+    {
+        unsigned int nPos = findParameter(sCmd, "framebuffer", '=')+11;
+        _parser.SetExpr(getArgAtPos(__sCmd, nPos));
+        intSettings[INT_FRAMEBUFFER] = intCast(_parser.Eval());
+        if (isinf(_parser.Eval().real()) || isnan(_parser.Eval().real()) || intSettings[INT_FRAMEBUFFER] < 0)
+            intSettings[INT_FRAMEBUFFER] = 0;
+        if (intSettings[INT_FRAMEBUFFER] > 128)
+            intSettings[INT_FRAMEBUFFER] = 128;
+    }
+
     if (findParameter(sCmd, "marks", '=') && (nType == ALL || nType & LOCAL))
     {
         unsigned int nPos = findParameter(sCmd, "marks", '=')+5;
@@ -1584,7 +1636,7 @@ void PlotData::setParams(const std::string& __sCmd, int nType)
             )
         {
             stringSettings[STR_FONTSTYLE] = sTemp;
-            _fontData.LoadFont(stringSettings[STR_FONTSTYLE].c_str(), (sTokens[0][1]+ "\\fonts").c_str());
+            requestPlotFont(stringSettings[STR_FONTSTYLE], sTokens[0][1] + "\\fonts");
         }
     }
 
@@ -1943,6 +1995,7 @@ void PlotData::reset()
 
     logicalSettings[LOG_OPENIMAGE] = true;
     logicalSettings[LOG_COLORBAR] = true;
+    logicalSettings[LOG_DECIMATE] = true;
 
     for (size_t i = 0; i < INT_SETTING_SIZE; i++)
     {
@@ -1998,7 +2051,7 @@ void PlotData::reset()
     else
         stringSettings[STR_FONTSTYLE] = "pagella";
 
-    _fontData.LoadFont(stringSettings[STR_FONTSTYLE].c_str(), (sTokens[0][1] + "\\fonts").c_str());
+    requestPlotFont(stringSettings[STR_FONTSTYLE], sTokens[0][1] + "\\fonts");
 }
 
 
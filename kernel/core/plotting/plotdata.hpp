@@ -34,6 +34,12 @@
 
 extern const char* SECAXIS_DEFAULT_COLOR;
 
+class mglGraph;
+
+// The plotting font is loaded on its first use
+void requestPlotFont(const std::string& sFontStyle, const std::string& sFontPath);
+mglGraph& getPlotFont();
+
 /////////////////////////////////////////////////
 /// \brief This class contains all the plot
 /// settings usable by the plotting algorithm.
@@ -75,6 +81,7 @@ class PlotData : public FileSystem
             LOG_CONTPROJ,
             LOG_CRUST,
             LOG_CUTBOX,
+            LOG_DECIMATE,
             LOG_DRAWPOINTS,
             LOG_FIXEDLENGTH,
             LOG_FLOW,
@@ -102,6 +109,7 @@ class PlotData : public FileSystem
             INT_COMPLEXMODE,
             INT_CONTLINES,
             INT_COORDS,
+            INT_FRAMEBUFFER,
             INT_GRID,
             INT_HIGHRESLEVEL,
             INT_LEGENDPOSITION,
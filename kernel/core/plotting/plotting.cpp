@@ -17,15 +17,16 @@
 ******************************************************************************/
 
 #include <wx/image.h>
+#include <memory>
 
 #include "plotting.hpp"
 #include "plotasset.hpp"
+#include "animationwriter.hpp"
 #include "../maths/parser_functions.hpp"
 #include "../../kernel.hpp"
 
 
 extern DefaultVariables _defVars;
-extern mglGraph _fontData;
 
 
 std::string removeQuotationMarks(const std::string&);
@@ -923,7 +924,7 @@ void Plot::applyPlotSizeAndQualitySettings()
     }
 
     // Copy the font and select the font size
-    _graph->CopyFont(&_fontData);
+    _graph->CopyFont(&getPlotFont());
     //_graph->SetFontSizePT(8 * ((double)(1 + _pData.getSettings(PlotData::FLOAT_TEXTSIZE)) / 6.0), 72);
     _graph->SetFontSizeCM(0.22 * (1.0 + _pData.getSettings(PlotData::FLOAT_TEXTSIZE)) / 6.0, 72);
     _graph->SetFlagAdv(1, MGL_FULL_CURV);
@@ -954,10 +955,22 @@ void Plot::applyPlotSizeAndQualitySettings()
 bool Plot::createPlotOrAnimation(size_t nPlotCompose, size_t nPlotComposeSize, bool bNewSubPlot, bool bAnimateVar, vector<string>& vDrawVector, const vector<string>& vDataPlots)
 {
     mglData _mBackground;
+    std::unique_ptr<AnimationWriter> _animWriter;
+
+    // Animations, which are only saved to a file, are rendered into
+    // separate graphs for each frame. Those are rasterized and encoded
+    // concurrently. The graph viewer needs all frames in a single graph
+    bool bConcurrentFrames = _pData.getAnimateSamples()
+        && bAnimateVar
+        && bOutputDesired
+        && nPlotComposeSize == 1
+        && (_pData.getSettings(PlotData::LOG_SILENTMODE) || !_pData.getSettings(PlotData::LOG_OPENIMAGE));
 
     // If the animation is saved to a file, set the frame time
     // for the GIF image
-    if (_pData.getAnimateSamples() && bOutputDesired)
+    if (bConcurrentFrames)
+        _animWriter.reset(new AnimationWriter(_graph, sOutputName, _pData.getSettings(PlotData::INT_FRAMEBUFFER), 4));
+    else if (_pData.getAnimateSamples() && bOutputDesired)
         _graph->StartGIF(sOutputName.c_str(), 40); // 40msec = 2sec bei 50 Frames, d.h. 25 Bilder je Sekunde
 
     // Load the background image from the target file and apply the
@@ -981,6 +994,19 @@ bool Plot::createPlotOrAnimation(size_t nPlotCompose, size_t nPlotComposeSize, b
     // single plot or a set of frames for an animation
     for (int t_animate = 0; t_animate <= _pData.getAnimateSamples(); t_animate++)
     {
+        // Every frame gets its own graph with the settings
+        // of the main graph
+        if (bConcurrentFrames)
+        {
+            _animWriter->newFrame();
+            applyPlotSizeAndQualitySettings();
+
+            if (_pData.getSettings(PlotData::FLOAT_BARS) || _pData.getSettings(PlotData::FLOAT_HBARS))
+                _graph->SetBarWidth(_pData.getSettings(PlotData::FLOAT_BARS)
+                                    ? _pData.getSettings(PlotData::FLOAT_BARS)
+                                    : _pData.getSettings(PlotData::FLOAT_HBARS));
+        }
+
         // If it is an animation, then we're required to reset the plotting
         // variables for each frame. Additionally, we have to start a new
         // frame at this location.
@@ -990,7 +1016,8 @@ bool Plot::createPlotOrAnimation(size_t nPlotCompose, size_t nPlotComposeSize, b
             _pInfo.nStyle = 0;
 
             // Prepare a new frame
-            _graph->NewFrame();
+            if (!bConcurrentFrames)
+                _graph->NewFrame();
 
             // Reset the plotting variables (x, y and z) to their initial values
             // and increment the time variable one step further
@@ -1095,7 +1122,7 @@ bool Plot::createPlotOrAnimation(size_t nPlotCompose, size_t nPlotComposeSize, b
             createStd3dPlot(nPlotCompose, nPlotComposeSize);
 
         // Finalize the GIF frame
-        if (_pData.getAnimateSamples() && bAnimateVar)
+        if (_pData.getAnimateSamples() && bAnimateVar && !bConcurrentFrames)
             _graph->EndFrame();
 
         // If no animation was selected or the
@@ -1106,7 +1133,9 @@ bool Plot::createPlotOrAnimation(size_t nPlotCompose, size_t nPlotComposeSize, b
     }
 
     // Finalize the GIF completely
-    if (_pData.getAnimateSamples() && bAnimateVar && bOutputDesired)
+    if (bConcurrentFrames)
+        _animWriter->close();
+    else if (_pData.getAnimateSamples() && bAnimateVar && bOutputDesired)
         _graph->CloseGIF();
 
     return true;
@@ -3705,6 +3734,83 @@ std::vector<std::string> Plot::separateFunctionsAndData()
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Reduces the points of a large 1D data
+/// plot to the ones, which are distinguishable
+/// on the pixels of the final image. Lines are
+/// decimated with their minima and maxima per
+/// pixel column, points with one point per pixel
+/// cell. Plot styles depending on every single
+/// data point are not decimated.
+///
+/// \param asset PlotAsset&
+/// \return void
+///
+/////////////////////////////////////////////////
+void Plot::decimateDataPlot(PlotAsset& asset)
+{
+    // The graph viewer window allows zooming into the
+    // rendered image. We oversample the data to keep
+    // the details visible for moderate zoom levels
+    const size_t ZOOMOVERSAMPLING = 4;
+
+    if (!_pData.getSettings(PlotData::LOG_DECIMATE)
+        || _pData.getSettings(PlotData::INT_COORDS) != CARTESIAN
+        || _pData.getSettings(PlotData::LOG_XERROR)
+        || _pData.getSettings(PlotData::LOG_YERROR)
+        || _pData.getSettings(PlotData::LOG_BOXPLOT)
+        || _pData.getSettings(PlotData::LOG_OHLC)
+        || _pData.getSettings(PlotData::LOG_CANDLESTICK)
+        || _pData.getSettings(PlotData::LOG_PARAMETRIC)
+        || _pData.getSettings(PlotData::LOG_REGION)
+        || _pData.getSettings(PlotData::LOG_STEPPLOT)
+        || _pData.getSettings(PlotData::FLOAT_BARS) != 0.0
+        || _pData.getSettings(PlotData::FLOAT_HBARS) != 0.0
+        || asset.boundAxes.find_first_of("rt") != std::string::npos)
+        return;
+
+    size_t nWidth = std::max(_graph->GetWidth(), 1);
+    size_t nHeight = std::max(_graph->GetHeight(), 1);
+
+    if (!(_pData.getSettings(PlotData::INT_SIZE_X) > 0 && _pData.getSettings(PlotData::INT_SIZE_Y) > 0)
+        && !_pData.getSettings(PlotData::LOG_SILENTMODE)
+        && _pData.getSettings(PlotData::LOG_OPENIMAGE))
+    {
+        nWidth *= ZOOMOVERSAMPLING;
+        nHeight *= ZOOMOVERSAMPLING;
+    }
+
+    // Use the explicitly set ranges, if available.
+    // Otherwise the data ranges of this asset are
+    // at least as fine as the final pixel grid
+    Interval xRange = asset.getAxisInterval(XCOORD);
+
+    if (_pData.getGivenRanges() >= XRANGE+1 && _pData.getRangeSetting(XRANGE))
+        xRange = _pData.getRanges()[XRANGE];
+
+    if (_pData.getSettings(PlotData::LOG_CONNECTPOINTS) || _pData.getSettings(PlotData::LOG_INTERPOLATE))
+    {
+        // Interpolated plots switch to point plots, if
+        // less than the number of samples are available
+        asset.decimateLines(nWidth, xRange, _pData.getLogscale(XRANGE),
+                            _pData.getSettings(PlotData::LOG_INTERPOLATE) ? _pInfo.nSamples : 0);
+        return;
+    }
+
+    Interval yRange(asset.data[0].first.Minimal(), asset.data[0].first.Maximal());
+
+    for (size_t layer = 1; layer < asset.getLayers(); layer++)
+    {
+        yRange = yRange.combine(Interval(asset.data[layer].first.Minimal(), asset.data[layer].first.Maximal()));
+    }
+
+    if (_pData.getGivenRanges() >= YRANGE+1 && _pData.getRangeSetting(YRANGE))
+        yRange = _pData.getRanges()[YRANGE];
+
+    asset.decimatePoints(nWidth, nHeight, xRange, yRange, _pData.getLogscale(XRANGE), _pData.getLogscale(YRANGE));
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Creates the internal mglData objects
 /// and fills them with the data values from the
@@ -3912,6 +4018,11 @@ void Plot::extractDataValues(const std::vector<std::string>& vDataPlots)
                         dataRanges[YRANGE-isHbar] = dataRanges[YRANGE-isHbar].combine(datIvl[datIvlID]);
                 }
             }
+
+            // Reduce large data sets to the points, which are
+            // visible in the final image. This is done after
+            // the ranges have been calculated from the full data
+            decimateDataPlot(m_manager.assets[typeCounter]);
         }
         else if (isPlot3D(_pInfo.sCommand))
         {
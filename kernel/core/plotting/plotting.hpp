@@ -93,6 +93,7 @@ class Plot
         void displayMessage(bool bAnimateVar);
         std::vector<std::string> separateFunctionsAndData();
         void extractDataValues(const std::vector<std::string>& vDataPlots);
+        void decimateDataPlot(PlotAsset& asset);
         void createDataLegends();
         std::string constructDataLegendElement(std::string& sColumnIndices, const std::string& sTableName);
         size_t countValidElements(const mglData& _mData);
@@ -25,7 +25,6 @@
  */
 
 const std::string PI_HIST = "1.1.2";
-extern mglGraph _fontData;
 
 /////////////////////////////////////////////////
 /// \brief This enumeration defines the available
@@ -600,7 +599,7 @@ static mglGraph* prepareGraphForHist(double dAspect, PlotData& _pData, bool bSil
 
     // Get curret plot font, font size
     // and the width of the bars
-    _histGraph->CopyFont(&_fontData);
+    _histGraph->CopyFont(&getPlotFont());
     _histGraph->SetFontSizeCM(0.24 * ((double)(1 + _pData.getSettings(PlotData::FLOAT_TEXTSIZE)) / 6.0), 72);
     _histGraph->SetBarWidth(_pData.getSettings(PlotData::FLOAT_BARS) ? _pData.getSettings(PlotData::FLOAT_BARS) : 0.9);
 
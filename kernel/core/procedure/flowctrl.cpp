@@ -25,6 +25,8 @@
 #include "../built-in.hpp"
 #include "../utils/tools.hpp"
 #include "../plotting/plotting.hpp"
+#include "parallelloop.hpp"
+#include <omp.h>
 
 // Definition of special return values
 #define FLOWCTRL_ERROR -1
@@ -143,6 +145,8 @@ int FlowCtrl::getCurrentBlockDepth() const
 /////////////////////////////////////////////////
 int FlowCtrl::for_loop(int nth_Cmd, int nth_loop)
 {
+    NumeReProfiler::LineScope profilerLine(NumeReKernel::getInstance()->getProfiler(), vCmdArray[nth_Cmd].nInputLine, false);
+
     int nVarAdress = 0;
     int nInc = 1;
     int nLoopCount = 0;
@@ -203,6 +207,11 @@ int FlowCtrl::for_loop(int nth_Cmd, int nth_loop)
         bPrintedStatus = true;
     }
 
+    // A vectorized body processes the whole index range
+    // from the loop index to this variable at once
+    if (vCmdArray[nth_Cmd].bVectorized)
+        vVectorizedEnd = nLastVal;
+
     // Evaluate the whole for loop. The outer loop does the
     // loop index management (the actual "for" command), the
     // inner loop runs through the contained command lines
@@ -309,10 +318,41 @@ int FlowCtrl::for_loop(int nth_Cmd, int nth_loop)
             }
         }
 
+        // The vectorized body has already evaluated all
+        // iterations. The index keeps its last value
+        if (vCmdArray[nth_Cmd].bVectorized)
+        {
+            vVarArray[nVarAdress] = nLastVal;
+            break;
+        }
+
         // The variable value might have been changed
         // snychronize the index
         __i = intCast(vVarArray[nVarAdress]);
 
+        // The first iteration has compiled all lines of
+        // the body. Evaluate the remaining iterations
+        // concurrently, if the user requested it and the
+        // body allows it
+        if (vCmdArray[nth_Cmd].bParallel && __i == nFirstVal && __i != nLastVal)
+        {
+            ParallelLoop parLoop(*_parserRef, *_dataRef, &vVarArray[nVarAdress]);
+
+            if (prepareParallelLoop(nth_Cmd, parLoop))
+            {
+                // The parallel loop returns the first index,
+                // which has not been evaluated
+                __i = parLoop.run(__i + nInc, nLastVal, nInc) - nInc;
+                vVarArray[nVarAdress] = __i;
+            }
+            else
+            {
+                g_logger.info("The body of the loop in line " + toString(vCmdArray[nth_Cmd].nInputLine)
+                              + " cannot be evaluated concurrently. Evaluating it serially.");
+                vCmdArray[nth_Cmd].bParallel = false;
+            }
+        }
+
         // Print the status to the terminal, if it is required
         if (!nth_loop && !bMask && bSilent)
         {
@@ -369,6 +409,8 @@ enum RangeForVarType
 /////////////////////////////////////////////////
 int FlowCtrl::range_based_for_loop(int nth_Cmd, int nth_loop)
 {
+    NumeReProfiler::LineScope profilerLine(NumeReKernel::getInstance()->getProfiler(), vCmdArray[nth_Cmd].nInputLine, false);
+
     int nVarAdress = 0;
     int nLoopCount = 0;
     bPrintedStatus = false;
@@ -663,6 +705,8 @@ int FlowCtrl::range_based_for_loop(int nth_Cmd, int nth_loop)
 /////////////////////////////////////////////////
 int FlowCtrl::while_loop(int nth_Cmd, int nth_loop)
 {
+    NumeReProfiler::LineScope profilerLine(NumeReKernel::getInstance()->getProfiler(), vCmdArray[nth_Cmd].nInputLine, false);
+
     if (!vCmdArray[nth_Cmd].sFlowCtrlHeader.length())
         vCmdArray[nth_Cmd].sFlowCtrlHeader = extractHeaderExpression(vCmdArray[nth_Cmd].sCommand);
 
@@ -819,6 +863,8 @@ int FlowCtrl::while_loop(int nth_Cmd, int nth_loop)
 /////////////////////////////////////////////////
 int FlowCtrl::if_fork(int nth_Cmd, int nth_loop)
 {
+    NumeReProfiler::LineScope profilerLine(NumeReKernel::getInstance()->getProfiler(), vCmdArray[nth_Cmd].nInputLine, false);
+
     int nElse = nJumpTable[nth_Cmd][BLOCK_MIDDLE]; // Position of next else/elseif
     int nEndif = nJumpTable[nth_Cmd][BLOCK_END];
     bPrintedStatus = false;
@@ -1051,6 +1097,8 @@ int FlowCtrl::if_fork(int nth_Cmd, int nth_loop)
 /////////////////////////////////////////////////
 int FlowCtrl::switch_fork(int nth_Cmd, int nth_loop)
 {
+    NumeReProfiler::LineScope profilerLine(NumeReKernel::getInstance()->getProfiler(), vCmdArray[nth_Cmd].nInputLine, false);
+
     if (!vCmdArray[nth_Cmd].sFlowCtrlHeader.length())
         vCmdArray[nth_Cmd].sFlowCtrlHeader = extractHeaderExpression(vCmdArray[nth_Cmd].sCommand);
 
@@ -1191,6 +1239,8 @@ int FlowCtrl::switch_fork(int nth_Cmd, int nth_loop)
 /////////////////////////////////////////////////
 int FlowCtrl::try_catch(int nth_Cmd, int nth_loop)
 {
+    NumeReProfiler::LineScope profilerLine(NumeReKernel::getInstance()->getProfiler(), vCmdArray[nth_Cmd].nInputLine, false);
+
     int nNextCatch = nJumpTable[nth_Cmd][BLOCK_MIDDLE]; // Position of next case/default
     int nTryEnd = nJumpTable[nth_Cmd][BLOCK_END];
     bPrintedStatus = false;
@@ -2481,6 +2531,12 @@ void FlowCtrl::reset()
         }
     }
 
+    if (sVectorizedEndVar.length())
+    {
+        _parserRef->RemoveVar(sVectorizedEndVar);
+        sVectorizedEndVar.clear();
+    }
+
     if (mVarMap.size())
     {
         for (size_t i = 0; i < sVarArray.size(); i++)
@@ -3173,6 +3229,10 @@ int FlowCtrl::calc(StringView sLine, int nthCmd)
     int nNum = 0;
     NumeRe::Cluster& ans = NumeReKernel::getInstance()->getAns();
 
+    // Measure this line including the compilation
+    // of its bytecode, if necessary
+    NumeReProfiler::LineScope profilerLine(NumeReKernel::getInstance()->getProfiler(), vCmdArray[nthCmd].nInputLine, !nCalcType[nthCmd]);
+
     // No great impact on calctime
     _assertionHandler.reset();
     updateTestStats();
@@ -3963,6 +4023,7 @@ void FlowCtrl::fillJumpTableAndExpandRecursives()
                         else
                         {
                             nJumpTable[i][BLOCK_END] = j;
+                            vCmdArray[i].bParallel = findParameter(vCmdArray[j].sCommand, "parallel");
                             break;
                         }
                     }
@@ -4182,6 +4243,192 @@ void FlowCtrl::fillJumpTableAndExpandRecursives()
             StripSpaces(vCmdArray[i].sCommand);
         }
     }
+
+    // Rewrite element-wise for loops into a single
+    // vectorized assignment
+    for (size_t i = 0; i+2 < vCmdArray.size(); i++)
+    {
+        if (vCmdArray[i].fcFn == &FlowCtrl::for_loop && nJumpTable[i][BLOCK_END] == (int)i+2)
+            vectorizeElementWiseLoop(i);
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This member function rewrites a for
+/// loop, whose body consists of a single
+/// element-wise assignment like
+/// "tab(i, 3) = f(tab(i, 1), tab(i, 2));", into
+/// a single vectorized assignment over the whole
+/// index range. This is only done, if the loop
+/// index is used exclusively as row index of
+/// table accesses with constant columns, if all
+/// used functions work element-wise and if no
+/// other value may change between the
+/// iterations. Returns true, if the loop has been
+/// rewritten.
+///
+/// \param nth_Cmd int
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool FlowCtrl::vectorizeElementWiseLoop(int nth_Cmd)
+{
+    // Functions, which are applied to each element of
+    // a vector separately
+    static const std::string sElementWiseFunctions = ",sin,cos,tan,cot,sec,csc,asin,arcsin,acos,arccos,atan,arctan,"
+                                                     "sinh,cosh,tanh,sech,csch,asinh,arsinh,acosh,arcosh,atanh,artanh,"
+                                                     "log2,log10,log,ln,exp,sqrt,sign,rint,abs,floor,roof,real,imag,conj,"
+                                                     "erf,erfc,gamma,heaviside,sinc,radian,degree,is_nan,";
+
+    FlowCtrlCommand& body = vCmdArray[nth_Cmd+1];
+    std::string sBody = body.sCommand;
+    StripSpaces(sBody);
+
+    // Only single suppressed numerical assignments
+    // without clusters, strings, procedures, table
+    // methods or breakpoints are considered
+    if (body.bFlowCtrlStatement
+        || !sBody.length()
+        || sBody.back() != ';'
+        || sBody.find_first_of("{$\"#") != std::string::npos
+        || sBody.find(").") != std::string::npos
+        || sBody.substr(0, 2) == "|>")
+        return false;
+
+    sBody.pop_back();
+    size_t nAssign = findAssignmentOperator(sBody);
+
+    if (nAssign == std::string::npos)
+        return false;
+
+    // Get the name of the loop index
+    std::string sVar = vCmdArray[nth_Cmd].sCommand.substr(vCmdArray[nth_Cmd].sCommand.find(' ') + 1);
+
+    if (sVar.find('=') == std::string::npos)
+        return false;
+
+    sVar.erase(sVar.find('='));
+    StripSpaces(sVar);
+
+    if (sVar.substr(0, 2) == "|>")
+    {
+        sVar.erase(0, 2);
+        StripSpaces(sVar);
+    }
+
+    // Column indices have to be constant within the loop
+    auto isConstantColumn = [&sVar](const std::string& sCol)
+        {
+            return sCol.length()
+                && sCol != sVar
+                && sCol != "nlines" && sCol != "nrows" && sCol != "ncols"
+                && sCol.find_first_not_of("0123456789.abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_~") == std::string::npos;
+        };
+
+    std::vector<size_t> vRowIndices;
+    std::string sTargetTable;
+
+    for (size_t i = 0; i < sBody.length(); i++)
+    {
+        // Skip numerical literals
+        if (isdigit(sBody[i]) || sBody[i] == '.')
+        {
+            while (i+1 < sBody.length() && (isalnum(sBody[i+1]) || sBody[i+1] == '.'))
+                i++;
+
+            continue;
+        }
+
+        if (!isalpha(sBody[i]) && sBody[i] != '_' && sBody[i] != '~')
+            continue;
+
+        size_t nStart = i;
+
+        while (i+1 < sBody.length() && (isalnum(sBody[i+1]) || sBody[i+1] == '_' || sBody[i+1] == '~'))
+            i++;
+
+        std::string sToken = sBody.substr(nStart, i+1-nStart);
+
+        // The left-hand side has to be a single table
+        // access
+        if (nStart && nStart < nAssign)
+            return false;
+
+        if (i+1 < sBody.length() && sBody[i+1] == '(')
+        {
+            size_t nParens = i+1;
+
+            if (sToken != "string" && _dataRef->isTable(sToken))
+            {
+                size_t nClosing = getMatchingParenthesis(StringView(sBody, nParens));
+
+                if (nClosing == std::string::npos)
+                    return false;
+
+                std::string sArgs = sBody.substr(nParens+1, nClosing-1);
+                std::string sRow = getNextArgument(sArgs, true);
+                std::string sCol = getNextArgument(sArgs, true);
+                StripSpaces(sRow);
+                StripSpaces(sCol);
+
+                // The loop index has to be the row index
+                if (sArgs.length() || sRow != sVar || !isConstantColumn(sCol))
+                    return false;
+
+                if (!nStart)
+                {
+                    if (sBody.find_first_not_of(' ', nParens+nClosing+1) != nAssign)
+                        return false;
+
+                    sTargetTable = sToken;
+                }
+
+                vRowIndices.push_back(sBody.find(sVar, nParens+1));
+                i = nParens+nClosing;
+                continue;
+            }
+
+            if (sElementWiseFunctions.find("," + sToken + ",") == std::string::npos)
+                return false;
+
+            continue;
+        }
+
+        // Any other occurence of the loop index or of values,
+        // which depend on the previous iteration, prevent
+        // the vectorization
+        if (!nStart
+            || sToken == sVar
+            || sToken == "ans"
+            || sToken == "nlines"
+            || sToken == "nrows"
+            || sToken == "ncols"
+            || _dataRef->isTable(sToken)
+            || NumeReKernel::getInstance()->getStringParser().isStringVar(sToken))
+            return false;
+    }
+
+    if (!sTargetTable.length())
+        return false;
+
+    if (!sVectorizedEndVar.length())
+    {
+        sVectorizedEndVar = "_~LOOPEND_" + toString(nthRecursion);
+        _parserRef->DefineVar(sVectorizedEndVar, &vVectorizedEnd);
+    }
+
+    // Extend the row indices to the whole range
+    for (auto iter = vRowIndices.rbegin(); iter != vRowIndices.rend(); ++iter)
+    {
+        sBody.insert(*iter + sVar.length(), ":" + sVectorizedEndVar);
+    }
+
+    body.sCommand = sBody + ";";
+    vCmdArray[nth_Cmd].bVectorized = true;
+    g_logger.info("Vectorized the element-wise for loop in line " + toString(vCmdArray[nth_Cmd].nInputLine) + ".");
+
+    return true;
 }
 
 
@@ -4428,6 +4675,69 @@ void FlowCtrl::updateTestStats()
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Fills the passed ParallelLoop with the
+/// compiled command lines of the body of the
+/// selected for loop. Returns false, if the body
+/// contains anything else than numerical
+/// expressions and cached table accesses with
+/// suppressed output or if the current state of
+/// the flow control does not allow a concurrent
+/// evaluation (e.g. if the debugger is active).
+///
+/// \param nth_Cmd int
+/// \param parLoop ParallelLoop&
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool FlowCtrl::prepareParallelLoop(int nth_Cmd, ParallelLoop& parLoop)
+{
+    if (!bUseLoopParsingMode
+        || bLockedPauseMode
+        || !bFunctionsReplaced
+        || nLoopSafety > 0
+        || nDebuggerCode == NumeReKernel::DEBUGGER_STEP
+        || omp_get_max_threads() < 2)
+        return false;
+
+    const int ALLOWED_CALCTYPES = CALCTYPE_NUMERICAL | CALCTYPE_DATAACCESS | CALCTYPE_SUPPRESSANSWER;
+
+    for (int j = nth_Cmd+1; j < nJumpTable[nth_Cmd][BLOCK_END]; j++)
+    {
+        if (vCmdArray[j].fcFn
+            || nJumpTable[j][PROCEDURE_INTERFACE] > 0
+            || !(nCalcType[j] & CALCTYPE_SUPPRESSANSWER)
+            || !(nCalcType[j] & (CALCTYPE_NUMERICAL | CALCTYPE_DATAACCESS))
+            || (nCalcType[j] & ~ALLOWED_CALCTYPES))
+            return false;
+
+        if (nCalcType[j] & CALCTYPE_NUMERICAL)
+        {
+            parLoop.addLine(vCmdArray[j].sCommand);
+            continue;
+        }
+
+        // Get the cached accesses of this line
+        _parserRef->SetIndex(j);
+
+        if (!_parserRef->CanCacheAccess() || !_parserRef->GetCachedEquation().length())
+            return false;
+
+        std::vector<mu::CachedDataAccess> vAccesses;
+
+        for (size_t n = 0; n < _parserRef->HasCachedAccess(); n++)
+        {
+            vAccesses.push_back(_parserRef->GetCachedAccess(n));
+        }
+
+        if (!parLoop.addLine(_parserRef->GetCachedEquation(), vAccesses, _parserRef->GetCachedTarget()))
+            return false;
+    }
+
+    return parLoop.isSafe();
+}
+
+
 /////////////////////////////////////////////////
 /// \brief This member function returns the
 /// current line number as enumerated during
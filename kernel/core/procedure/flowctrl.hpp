@@ -39,6 +39,7 @@
 using namespace mu;
 
 struct FlowCtrlCommand;
+class ParallelLoop;
 
 
 class FlowCtrl
@@ -102,6 +103,8 @@ class FlowCtrl
         std::vector<FlowCtrlCommand> vCmdArray;
         std::vector<value_type> vVarArray;
         std::vector<std::string> sVarArray;
+        value_type vVectorizedEnd;
+        std::string sVectorizedEndVar;
         varmap_type vVars;
         std::vector<std::vector<int>> nJumpTable;
         std::vector<int> nCalcType;
@@ -153,10 +156,12 @@ class FlowCtrl
 
         std::string extractFlagsAndIndexVariables();
         void fillJumpTableAndExpandRecursives();
+        bool vectorizeElementWiseLoop(int nth_Cmd);
         void prepareSwitchExpression(int nSwitchStart);
         void checkParsingModeAndExpandDefinitions();
         void prepareLocalVarsAndReplace(std::string& sVars);
         void updateTestStats();
+        bool prepareParallelLoop(int nth_Cmd, ParallelLoop& parLoop);
 
 
         virtual int procedureCmdInterface(std::string& sLine);
@@ -208,12 +213,14 @@ struct FlowCtrlCommand
     std::string sFlowCtrlHeader;
     int nVarIndex;
     size_t nRFStepping;
+    bool bParallel;
+    bool bVectorized;
 
     FlowCtrl::FlowCtrlFunction fcFn;
 
 
     FlowCtrlCommand(const std::string& sCmd, int nLine, bool bStatement = false, FlowCtrl::FlowCtrlFunction fn = nullptr)
-        : sCommand(sCmd), nInputLine(nLine), bFlowCtrlStatement(bStatement), sFlowCtrlHeader(""), nVarIndex(-1), nRFStepping(0u), fcFn(fn) {}
+        : sCommand(sCmd), nInputLine(nLine), bFlowCtrlStatement(bStatement), sFlowCtrlHeader(""), nVarIndex(-1), nRFStepping(0u), bParallel(false), bVectorized(false), fcFn(fn) {}
 };
 
 #endif
@@ -0,0 +1,616 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2023  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "parallelloop.hpp"
+#include "../datamanagement/dataaccess.hpp"
+#include "../ui/error.hpp"
+#include "../utils/tools.hpp"
+#include "../utils/symbolindex.hpp"
+#include "../../kernel.hpp"
+#include <algorithm>
+#include <omp.h>
+
+// Number of iterations per thread, which are
+// evaluated before the buffered writes are applied
+#define PARALLEL_BLOCKSIZE 4096
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper to detect the usage of
+/// the table dimension variables, whose values
+/// depend on the evaluation order.
+///
+/// \param sExpr const std::string&
+/// \return bool
+///
+/////////////////////////////////////////////////
+static bool usesDimensionVariables(const std::string& sExpr)
+{
+    return sExpr.find("nlines") != std::string::npos
+        || sExpr.find("nrows") != std::string::npos
+        || sExpr.find("ncols") != std::string::npos;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper to detect calls to the
+/// random number functions. Their results depend
+/// on the thread and the evaluation order, which
+/// would make the loop nondeterministic.
+///
+/// \param sExpr const std::string&
+/// \return bool
+///
+/////////////////////////////////////////////////
+static bool usesRandomNumbers(const std::string& sExpr)
+{
+    IdentifierScanner scanner;
+    std::vector<IdentifierToken> vTokens;
+    scanner.scan(sExpr, vTokens);
+
+    for (const IdentifierToken& token : vTokens)
+    {
+        if (sExpr[token.pos+token.length] != '(')
+            continue;
+
+        std::string sToken = sExpr.substr(token.pos, token.length);
+
+        // All random distributions end with "_rd"
+        if (sToken == "rand"
+            || sToken == "gauss"
+            || (sToken.length() > 3 && sToken.substr(sToken.length()-3) == "_rd"))
+            return true;
+    }
+
+    return false;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Adds a pure numerical command line to
+/// the loop body.
+///
+/// \param sEquation const std::string&
+/// \return void
+///
+/////////////////////////////////////////////////
+void ParallelLoop::addLine(const std::string& sEquation)
+{
+    Line line;
+    line.sEquation = sEquation;
+    line.bNumerical = true;
+    m_lines.push_back(line);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Adds a command line with cached table
+/// accesses and an optional target table to the
+/// loop body. Returns false, if the accesses
+/// cannot be evaluated concurrently (e.g.
+/// because they access clusters or their
+/// indices could not be precompiled).
+///
+/// \param sEquation const std::string&
+/// \param vAccesses const std::vector<mu::CachedDataAccess>&
+/// \param sTarget const std::string&
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool ParallelLoop::addLine(const std::string& sEquation, const std::vector<mu::CachedDataAccess>& vAccesses, const std::string& sTarget)
+{
+    Line line;
+    line.sEquation = sEquation;
+    line.bNumerical = false;
+    line.vAccesses = vAccesses;
+
+    for (const mu::CachedDataAccess& _access : vAccesses)
+    {
+        if (_access.flags != mu::CachedDataAccess::NO_FLAG || !_access.program.m_compiled)
+            return false;
+
+        // The read tables are not modified within the
+        // loop (see isSafe()), so their dimensions are
+        // constant
+        line.vDimensions.push_back(std::make_pair(m_data.getLines(_access.sCacheName, false),
+                                                  m_data.getCols(_access.sCacheName, false)));
+    }
+
+    if (sTarget.length())
+    {
+        size_t pos = sTarget.find_first_of("({");
+
+        if (pos == std::string::npos
+            || sTarget[pos] == '{'
+            || !compileIndexProgram(sTarget, line.target, m_data))
+            return false;
+
+        line.sTargetTable = sTarget.substr(0, pos);
+        StripSpaces(line.sTargetTable);
+        line.sTargetAccess = sTarget;
+    }
+
+    m_lines.push_back(line);
+    return true;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns true, if the collected loop
+/// body can be evaluated concurrently, i.e. no
+/// table is read, which is written within the
+/// loop, and the written indices and values do
+/// not depend on the current table dimensions.
+/// Lines drawing random numbers are evaluated
+/// serially.
+///
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool ParallelLoop::isSafe() const
+{
+    std::vector<std::string> vWrittenTables;
+
+    for (const Line& line : m_lines)
+    {
+        if (usesRandomNumbers(line.sEquation)
+            || usesRandomNumbers(line.target.m_rowExpr)
+            || usesRandomNumbers(line.target.m_colExpr)
+            || usesRandomNumbers(line.target.m_casualExpr))
+            return false;
+
+        if (!line.sTargetTable.length())
+            continue;
+
+        if (usesDimensionVariables(line.sEquation)
+            || usesDimensionVariables(line.target.m_rowExpr)
+            || usesDimensionVariables(line.target.m_colExpr)
+            || usesDimensionVariables(line.target.m_casualExpr))
+            return false;
+
+        vWrittenTables.push_back(line.sTargetTable);
+    }
+
+    for (const Line& line : m_lines)
+    {
+        for (const mu::CachedDataAccess& _access : line.vAccesses)
+        {
+            if (std::find(vWrittenTables.begin(), vWrittenTables.end(), _access.sCacheName) != vWrittenTables.end())
+                return false;
+        }
+    }
+
+    return m_lines.size() && !hasLoopCarriedDependency();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper to find the position of
+/// the assignment operator in the passed
+/// equation. Returns std::string::npos, if the
+/// equation does not contain an assignment.
+///
+/// \param sEquation const std::string&
+/// \return size_t
+///
+/////////////////////////////////////////////////
+static size_t findAssignment(const std::string& sEquation)
+{
+    for (size_t i = 0; i < sEquation.length(); i++)
+    {
+        if (sEquation[i] == '='
+            && (!i || std::string("<>!=").find(sEquation[i-1]) == std::string::npos)
+            && sEquation[i+1] != '=')
+            return i;
+    }
+
+    return std::string::npos;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Detects variables, which carry a value
+/// from one iteration to the next, i.e. which are
+/// read before they are assigned in the loop body
+/// (e.g. sums like "s = s + x"). Those cannot be
+/// evaluated with thread-private variables.
+/// Comma-separated expressions in a line are
+/// examined separately in their order of
+/// evaluation. Assigning the loop index and
+/// reading the answer variable are also
+/// rejected.
+///
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool ParallelLoop::hasLoopCarriedDependency() const
+{
+    IdentifierScanner scanner;
+    std::vector<IdentifierToken> vTokens;
+    std::vector<std::pair<std::string, size_t>> vAssigned; // name and assigning expression
+    std::vector<std::pair<std::string, size_t>> vRead; // name and first reading expression
+    size_t nExpr = 0;
+
+    for (size_t n = 0; n < m_lines.size(); n++)
+    {
+        std::string sEquation = m_lines[n].sEquation;
+
+        // Multiple expressions (e.g. "c = b*2, b = i")
+        // are evaluated from left to right
+        while (sEquation.length())
+        {
+            std::string sExpr = getNextArgument(sEquation, true);
+            size_t nAssignment = findAssignment(sExpr);
+            scanner.scan(sExpr, vTokens);
+
+            for (const IdentifierToken& token : vTokens)
+            {
+                std::string sToken = sExpr.substr(token.pos, token.length);
+
+                if (nAssignment != std::string::npos && token.pos < nAssignment)
+                {
+                    if (std::find_if(vAssigned.begin(), vAssigned.end(),
+                                     [&](const std::pair<std::string, size_t>& a){return a.first == sToken;}) == vAssigned.end())
+                        vAssigned.push_back(std::make_pair(sToken, nExpr));
+                }
+                else if (std::find_if(vRead.begin(), vRead.end(),
+                                      [&](const std::pair<std::string, size_t>& r){return r.first == sToken;}) == vRead.end())
+                    vRead.push_back(std::make_pair(sToken, nExpr));
+            }
+
+            nExpr++;
+        }
+    }
+
+    // The name of the loop index
+    std::string sLoopVar;
+    const mu::varmap_type& vars = m_parser.GetVar();
+
+    for (const auto& iter : vars)
+    {
+        if (iter.second == m_loopVar)
+        {
+            sLoopVar = iter.first;
+            break;
+        }
+    }
+
+    // The answer variable contains the result of
+    // the previous line or iteration
+    if (std::find_if(vRead.begin(), vRead.end(),
+                     [](const std::pair<std::string, size_t>& r){return r.first == "ans";}) != vRead.end())
+        return true;
+
+    for (const auto& assigned : vAssigned)
+    {
+        if (assigned.first == sLoopVar)
+            return true;
+
+        for (const auto& read : vRead)
+        {
+            // Reading in the assigning expression or
+            // before uses the value of the previous
+            // iteration
+            if (read.first == assigned.first && read.second <= assigned.second)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Creates an evaluation context for each
+/// thread. All variables of the copied parser
+/// are bound to thread-private storage. Aliases
+/// (i.e. different names for the same address)
+/// keep sharing their storage.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void ParallelLoop::createWorkers()
+{
+    int nThreads = omp_get_max_threads();
+    const std::map<std::string, std::vector<mu::value_type>>& mVectors = m_parser.GetVectors();
+
+    for (int n = 0; n < nThreads; n++)
+    {
+        m_workers.emplace_back(new Worker(m_parser));
+        Worker& worker = *m_workers.back();
+
+        // Copy the map, because it is modified while
+        // redefining the variables
+        mu::varmap_type vars = worker._parser.GetVar();
+
+        for (const auto& iter : vars)
+        {
+            auto privateVar = worker.mPrivateVars.find(iter.second);
+
+            if (privateVar == worker.mPrivateVars.end())
+            {
+                worker.vStorage.push_back(*iter.second);
+                privateVar = worker.mPrivateVars.insert(std::make_pair(iter.second, &worker.vStorage.back())).first;
+            }
+
+            worker._parser.DefineVar(iter.first, privateVar->second);
+        }
+
+        for (const auto& iter : mVectors)
+        {
+            worker._parser.SetVectorVar(iter.first, iter.second);
+        }
+
+        for (const Line& line : m_lines)
+        {
+            for (const mu::CachedDataAccess& _access : line.vAccesses)
+            {
+                if (!worker._parser.GetVectorVar(_access.sVectorName))
+                    worker._parser.SetVectorVar(_access.sVectorName, std::vector<mu::value_type>(1, NAN));
+            }
+        }
+
+        auto iter = worker.mPrivateVars.find(m_loopVar);
+        worker.loopVar = iter != worker.mPrivateVars.end() ? iter->second : nullptr;
+
+        iter = worker.mPrivateVars.find(&m_data.tableLinesCount);
+        worker.linesCount = iter != worker.mPrivateVars.end() ? iter->second : nullptr;
+
+        iter = worker.mPrivateVars.find(&m_data.tableColumnsCount);
+        worker.colsCount = iter != worker.mPrivateVars.end() ? iter->second : nullptr;
+
+        // Every command line of the body gets its own
+        // bytecode stack
+        worker._parser.ActivateLoopMode(m_lines.size());
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Evaluates a single iteration of the
+/// loop body with the passed thread context. This
+/// follows the evaluation order of
+/// FlowCtrl::calc() for cached data accesses.
+///
+/// \param worker Worker&
+/// \param nIteration size_t
+/// \param nValue int
+/// \return void
+///
+/////////////////////////////////////////////////
+void ParallelLoop::runIteration(Worker& worker, size_t nIteration, int nValue)
+{
+    mu::Parser& _parser = worker._parser;
+    *worker.loopVar = nValue;
+
+    for (size_t n = 0; n < m_lines.size(); n++)
+    {
+        const Line& line = m_lines[n];
+        mu::value_type* v;
+        int nNum;
+
+        _parser.SetIndex(n);
+
+        // Read the cached data accesses
+        for (size_t i = 0; i < line.vAccesses.size(); i++)
+        {
+            const mu::CachedDataAccess& _access = line.vAccesses[i];
+            const std::pair<int,int>& dims = line.vDimensions[i];
+            Indices _idx;
+
+            if (worker.linesCount)
+                *worker.linesCount = dims.first;
+
+            if (worker.colsCount)
+                *worker.colsCount = dims.second;
+
+            evalIndexProgram(_access.program, _idx, _parser, _access.sAccessEquation);
+
+            if (!isValidIndexSet(_idx))
+                throw SyntaxError(SyntaxError::INVALID_INDEX, _access.sAccessEquation, SyntaxError::invalid_position, _idx.row.to_string() + ", " + _idx.col.to_string());
+
+            if (_idx.row.isOpenEnd() && _idx.col.isOpenEnd())
+                throw SyntaxError(SyntaxError::NO_MATRIX, _access.sAccessEquation, SyntaxError::invalid_position);
+
+            if (_idx.row.isOpenEnd())
+                _idx.row.setRange(0, dims.first-1);
+
+            if (_idx.col.isOpenEnd())
+                _idx.col.setRange(0, dims.second-1);
+
+            // String-like columns require the string parser
+            if (m_data.getType(_idx.col, _access.sCacheName) >= TableColumn::STRINGLIKE)
+                throw SyntaxError(SyntaxError::INVALID_DATA_ACCESS, _access.sAccessEquation, SyntaxError::invalid_position);
+
+            size_t nElems;
+            const mu::value_type* data = m_data.getContiguousValues(_idx.row, _idx.col, _access.sCacheName, nElems);
+
+            if (!data || !_parser.BindVectorVar(_access.sVectorName, data, nElems))
+                m_data.copyElementsInto(_parser.GetVectorVar(_access.sVectorName), _idx.row, _idx.col, _access.sCacheName);
+
+            _parser.UpdateVectorVar(_access.sVectorName);
+        }
+
+        // Get the target indices
+        Indices _target;
+
+        if (line.sTargetTable.length())
+        {
+            evalIndexProgram(line.target, _target, _parser, line.sTargetAccess);
+
+            if (!isValidIndexSet(_target))
+                throw SyntaxError(SyntaxError::INVALID_INDEX, line.sTargetAccess, SyntaxError::invalid_position, _target.row.to_string() + ", " + _target.col.to_string());
+
+            if (_target.row.isOpenEnd() && _target.col.isOpenEnd())
+                throw SyntaxError(SyntaxError::NO_MATRIX, line.sTargetAccess, SyntaxError::invalid_position);
+        }
+
+        if (!_parser.IsAlreadyParsed(line.sEquation))
+            _parser.SetExpr(line.sEquation);
+
+        if (line.bNumerical)
+        {
+            // Evaluate all remaining equations in the stack
+            do
+            {
+                v = _parser.Eval(nNum);
+            } while (_parser.IsNotLastStackItem());
+        }
+        else
+            v = _parser.Eval(nNum);
+
+        // Buffer the write access
+        if (line.sTargetTable.length())
+            worker.vWrites.push_back({nIteration, n, _target, std::vector<mu::value_type>(v, v+nNum)});
+    }
+
+    worker.nLastIteration = nIteration;
+    worker.hasRun = true;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Applies the buffered writes of the
+/// current block in iteration order and copies
+/// the thread-private variables of the last
+/// iteration back to the kernel's variables.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void ParallelLoop::applyWrites()
+{
+    std::vector<PendingWrite*> vWrites;
+    Worker* lastWorker = nullptr;
+
+    for (auto& worker : m_workers)
+    {
+        for (PendingWrite& write : worker->vWrites)
+        {
+            vWrites.push_back(&write);
+        }
+
+        if (worker->hasRun && (!lastWorker || worker->nLastIteration > lastWorker->nLastIteration))
+            lastWorker = worker.get();
+    }
+
+    std::sort(vWrites.begin(), vWrites.end(), [](const PendingWrite* a, const PendingWrite* b)
+              {
+                  return a->nIteration < b->nIteration || (a->nIteration == b->nIteration && a->nLine < b->nLine);
+              });
+
+    for (PendingWrite* write : vWrites)
+    {
+        m_data.writeToTable(write->_idx, m_lines[write->nLine].sTargetTable, write->vValues.data(), write->vValues.size());
+    }
+
+    if (lastWorker)
+    {
+        for (const auto& iter : lastWorker->mPrivateVars)
+        {
+            *iter.first = *iter.second;
+        }
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Evaluates the iterations from nFirstVal
+/// to nLastVal concurrently in blocks. Returns
+/// the first loop index, which has not been
+/// evaluated. If an iteration fails, its whole
+/// block is discarded and the index of its first
+/// iteration is returned, so that the caller can
+/// continue serially and report the error in the
+/// usual way.
+///
+/// \param nFirstVal int
+/// \param nLastVal int
+/// \param nInc int
+/// \return int
+///
+/////////////////////////////////////////////////
+int ParallelLoop::run(int nFirstVal, int nLastVal, int nInc)
+{
+    if (nInc * nFirstVal > nInc * nLastVal)
+        return nFirstVal;
+
+    createWorkers();
+
+    if (!m_workers.size() || !m_workers.front()->loopVar)
+        return nFirstVal;
+
+    long long int nIterations = (nLastVal - nFirstVal) / nInc + 1;
+    long long int nBlockSize = PARALLEL_BLOCKSIZE * (long long int)m_workers.size();
+
+    for (long long int nBlockStart = 0; nBlockStart < nIterations; nBlockStart += nBlockSize)
+    {
+        if (NumeReKernel::GetAsyncCancelState())
+            throw SyntaxError(SyntaxError::PROCESS_ABORTED_BY_USER, "", SyntaxError::invalid_position);
+
+        long long int nBlockEnd = std::min(nBlockStart + nBlockSize, nIterations);
+        bool bFailed = false;
+
+        // Initialize the thread-private variables with
+        // the current values
+        for (auto& worker : m_workers)
+        {
+            for (const auto& iter : worker->mPrivateVars)
+            {
+                *iter.second = *iter.first;
+            }
+
+            worker->vWrites.clear();
+            worker->hasRun = false;
+        }
+
+        #pragma omp parallel for schedule(static) num_threads(m_workers.size())
+        for (long long int n = nBlockStart; n < nBlockEnd; n++)
+        {
+            bool bSkip;
+
+            #pragma omp atomic read
+            bSkip = bFailed;
+
+            if (bSkip)
+                continue;
+
+            try
+            {
+                runIteration(*m_workers[omp_get_thread_num()], n, nFirstVal + n*nInc);
+            }
+            catch (...)
+            {
+                #pragma omp atomic write
+                bFailed = true;
+            }
+        }
+
+        if (bFailed)
+        {
+            g_logger.debug("Parallel loop evaluation failed. Continuing serially.");
+            return nFirstVal + nBlockStart*nInc;
+        }
+
+        applyWrites();
+    }
+
+    return nLastVal + nInc;
+}
+
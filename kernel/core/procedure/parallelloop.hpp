@@ -0,0 +1,115 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2023  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef PARALLELLOOP_HPP
+#define PARALLELLOOP_HPP
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+
+#include "../ParserLib/muParser.h"
+#include "../datamanagement/memorymanager.hpp"
+#include "../structures.hpp"
+
+/////////////////////////////////////////////////
+/// \brief This class evaluates the remaining
+/// iterations of a for loop concurrently. It is
+/// filled by FlowCtrl with the already compiled
+/// command lines of the loop body, i.e. pure
+/// numerical expressions and cached table
+/// accesses. Every thread uses a copy of the
+/// kernel parser, whose variables are bound to
+/// thread-private storage. Table writes are
+/// buffered and applied in iteration order after
+/// each block of iterations, so that the tables
+/// are never modified concurrently.
+/////////////////////////////////////////////////
+class ParallelLoop
+{
+    private:
+        /////////////////////////////////////////////////
+        /// \brief A single command line of the loop
+        /// body.
+        /////////////////////////////////////////////////
+        struct Line
+        {
+            std::string sEquation;
+            std::vector<mu::CachedDataAccess> vAccesses;
+            std::vector<std::pair<int,int>> vDimensions;
+            std::string sTargetTable;
+            std::string sTargetAccess;
+            mu::IndexProgram target;
+            bool bNumerical;
+        };
+
+        /////////////////////////////////////////////////
+        /// \brief A buffered write to a table.
+        /////////////////////////////////////////////////
+        struct PendingWrite
+        {
+            size_t nIteration;
+            size_t nLine;
+            Indices _idx;
+            std::vector<mu::value_type> vValues;
+        };
+
+        /////////////////////////////////////////////////
+        /// \brief The evaluation context of a single
+        /// thread.
+        /////////////////////////////////////////////////
+        struct Worker
+        {
+            mu::Parser _parser;
+            std::deque<mu::value_type> vStorage;
+            std::map<mu::value_type*, mu::value_type*> mPrivateVars;
+            mu::value_type* loopVar;
+            mu::value_type* linesCount;
+            mu::value_type* colsCount;
+            std::vector<PendingWrite> vWrites;
+            size_t nLastIteration;
+            bool hasRun;
+
+            Worker(const mu::Parser& _kernelParser) : _parser(_kernelParser), loopVar(nullptr), linesCount(nullptr), colsCount(nullptr), nLastIteration(0), hasRun(false) {}
+        };
+
+        mu::Parser& m_parser;
+        MemoryManager& m_data;
+        mu::value_type* m_loopVar;
+        std::vector<Line> m_lines;
+        std::vector<std::unique_ptr<Worker>> m_workers;
+
+        void createWorkers();
+        void runIteration(Worker& worker, size_t nIteration, int nValue);
+        void applyWrites();
+        bool hasLoopCarriedDependency() const;
+
+    public:
+        ParallelLoop(mu::Parser& _parser, MemoryManager& _data, mu::value_type* loopVar) : m_parser(_parser), m_data(_data), m_loopVar(loopVar) {}
+
+        void addLine(const std::string& sEquation);
+        bool addLine(const std::string& sEquation, const std::vector<mu::CachedDataAccess>& vAccesses, const std::string& sTarget);
+        bool isSafe() const;
+        int run(int nFirstVal, int nLastVal, int nInc);
+};
+
+
+#endif // PARALLELLOOP_HPP
+
@@ -733,6 +733,13 @@ Returnvalue Procedure::execute(string sProc, string sVarList, Parser& _parser, F
             nFlags &= ~ProcedureCommandLine::FLAG_MASK;
     }
 
+    // Profile this call, if the profiler is running or
+    // if the procedure requests to be profiled
+    NumeReProfiler& _profiler = NumeReKernel::getInstance()->getProfiler();
+    NumeReProfiler::ProcedureScope profilerScope(_profiler,
+                                                 "$" + (sThisNameSpace != "main" ? sThisNameSpace + "~" : std::string()) + sProc,
+                                                 nFlags & ProcedureCommandLine::FLAG_PROFILE);
+
     // Get the argument list and evaluate it
     string sVarDeclarationList = currentLine.second.getArgumentList();
 
@@ -799,6 +806,10 @@ Returnvalue Procedure::execute(string sProc, string sVarList, Parser& _parser, F
     // this line
     while (!ProcElement->isLastLine(currentLine.first))
     {
+        // Measures the current line, if the profiler is
+        // active
+        NumeReProfiler::LineScope profilerLine(_profiler);
+
         // Set the bytecode from the last calculation
         ProcElement->setByteCode(nCurrentByteCode | nByteCode, currentLine.first);
         bProcSupressAnswer = false;
@@ -830,6 +841,8 @@ Returnvalue Procedure::execute(string sProc, string sVarList, Parser& _parser, F
             if (currentLine.second.getType() == ProcedureCommandLine::TYPE_PROCEDURE_FOOT)
                 break;
 
+            profilerLine.begin(nCurrentLine, nCurrentByteCode == ProcedureCommandLine::BYTECODE_NOT_PARSED);
+
             // Remove the trailing output suppressing semicolon
             while (sProcCommandLine.back() == ';')
             {
@@ -853,6 +866,8 @@ Returnvalue Procedure::execute(string sProc, string sVarList, Parser& _parser, F
         {
             if (commandQueue.size())
             {
+                profilerLine.begin(nCurrentLine, false);
+
                 // The command cache is not empty
                 // Get the next task from the command cache
                 sProcCommandLine = commandQueue.front();
@@ -932,6 +947,12 @@ Returnvalue Procedure::execute(string sProc, string sVarList, Parser& _parser, F
             nByteCode |= ProcedureCommandLine::BYTECODE_FLOWCTRLSTATEMENT;
         }
 
+        // Flow control lines are only collected here. They
+        // are measured, when the flow control logic executes
+        // them
+        if (nCurrentByteCode & ProcedureCommandLine::BYTECODE_FLOWCTRLSTATEMENT)
+            profilerLine.drop();
+
         // Handle breakpoints and always remove hardcoded ones
         bool isBreakPoint = sProcCommandLine.substr(sProcCommandLine.find_first_not_of(' '), 2) == "|>";
 
@@ -2696,6 +2717,8 @@ size_t Procedure::replaceReturnVal(string& sLine, Parser& _parser, const Returnv
 /////////////////////////////////////////////////
 void Procedure::resetProcedure(Parser& _parser, bool bSupressAnswer)
 {
+    bool isOutermost = !nthRecursion;
+
     // Remove the current procedure from the call stack
     NumeReKernel::getInstance()->getDebugger().popStackItem();
 
@@ -2718,6 +2741,12 @@ void Procedure::resetProcedure(Parser& _parser, bool bSupressAnswer)
         _varFactory = nullptr;
     }
 
+    // The call frames are kept for the next calls and
+    // only trimmed, once the outermost procedure
+    // returns
+    if (isOutermost)
+        ProcedureVarFactory::trimCallFrames();
+
     // Remove the last procedure in the current stack
     if (sProcNames.length())
     {
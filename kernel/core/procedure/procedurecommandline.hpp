@@ -55,7 +55,8 @@ class ProcedureCommandLine
             FLAG_TEMPLATE = 0x10,
             FLAG_EVENT = 0x20,
             FLAG_MACRO = 0x40,
-            FLAG_TEST = 0x80
+            FLAG_TEST = 0x80,
+            FLAG_PROFILE = 0x100
         };
 
         enum ByteCodes
@@ -137,6 +138,13 @@ class ProcedureCommandLine
                 nByteCode = _nByteCode;
         }
 
+        // Reset the byte code, e.g. if a called
+        // procedure has been modified
+        void resetByteCode()
+        {
+            nByteCode = BYTECODE_NOT_PARSED;
+        }
+
         // Get the information on whether the
         // (whole) procedure is inlinable
         int isInlineable() const
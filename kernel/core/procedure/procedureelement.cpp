@@ -220,6 +220,9 @@ ProcedureElement::ProcedureElement(const StyledTextFile& procedureContents, cons
 
                 if (sFlags.find("test") != std::string::npos)
                     nFlags |= ProcedureCommandLine::FLAG_TEST;
+
+                if (sFlags.find("profile") != std::string::npos)
+                    nFlags |= ProcedureCommandLine::FLAG_PROFILE;
             }
 
             // Extract procedure name and argument list
@@ -474,6 +477,24 @@ void ProcedureElement::setByteCode(int _nByteCode, int nCurrentLine)
 }
 
 
+/////////////////////////////////////////////////
+/// \brief This member function resets the byte
+/// codes of all lines, e.g. because a called
+/// procedure has been modified and the stored
+/// byte codes might not be valid anymore.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void ProcedureElement::resetByteCode()
+{
+    for (auto& line : mProcedureContents)
+    {
+        line.second.resetByteCode();
+    }
+}
+
+
 /////////////////////////////////////////////////
 /// \brief This member function returns the
 /// first-level dependencies of the current
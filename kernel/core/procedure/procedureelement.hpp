@@ -58,6 +58,7 @@ class ProcedureElement
 
         bool isLastLine(int currentline);
         void setByteCode(int _nByteCode, int nCurrentLine);
+        void resetByteCode();
         Dependencies* getDependencies();
 };
 
@@ -17,8 +17,54 @@
 ******************************************************************************/
 
 #include "procedurelibrary.hpp"
+#include "dependency.hpp"
 #include "../ui/error.hpp"
 #include "../utils/tools.hpp"
+#include <sys/stat.h>
+
+// The minimal interval between two checks of a
+// file for modifications
+#define CHECK_INTERVAL std::chrono::seconds(2)
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper function returning the
+/// modification time of the passed file or -1, if
+/// the file does not exist.
+///
+/// \param sFileName const std::string&
+/// \return long long int
+///
+/////////////////////////////////////////////////
+static long long int getModificationTime(const std::string& sFileName)
+{
+    struct stat fileStat;
+
+    if (stat(sFileName.c_str(), &fileStat))
+        return -1;
+
+    return fileStat.st_mtime;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper function calculating a
+/// hash of the contents of the passed file.
+///
+/// \param sFileName const std::string&
+/// \return size_t
+///
+/////////////////////////////////////////////////
+static size_t getContentHash(const std::string& sFileName)
+{
+    std::ifstream file(sFileName, std::ios_base::binary);
+
+    if (!file.good())
+        return 0;
+
+    std::string sContents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return std::hash<std::string>()(sContents);
+}
 
 
 /////////////////////////////////////////////////
@@ -29,7 +75,10 @@
 ProcedureLibrary::~ProcedureLibrary()
 {
     for (auto iter = mLibraryEntries.begin(); iter != mLibraryEntries.end(); ++iter)
-        delete (iter->second);
+        delete (iter->second.element);
+
+    for (ProcedureElement* element : vRetiredElements)
+        delete element;
 }
 
 
@@ -72,60 +121,193 @@ StyledTextFile ProcedureLibrary::getFileContents(const std::string& sProcedureFi
 
 
 /////////////////////////////////////////////////
-/// \brief Returns the ProcedureElement pointer
-/// to the desired procedure file. It also
-/// creates the element, if it doesn't already
-/// exist.
+/// \brief Checks, whether the file of the passed
+/// entry has been modified since it has been
+/// read. The modification time is compared first
+/// and the contents are only hashed, if it
+/// differs or if the check has been requested
+/// explicitly. Returns false, if the file does
+/// not exist anymore.
 ///
 /// \param sProcedureFileName const std::string&
-/// \return ProcedureElement*
+/// \param entry ProcedureLibraryEntry&
+/// \return bool
 ///
 /////////////////////////////////////////////////
-ProcedureElement* ProcedureLibrary::getProcedureContents(const std::string& sProcedureFileName)
+bool ProcedureLibrary::validateEntry(const std::string& sProcedureFileName, ProcedureLibraryEntry& entry)
 {
-    if (mLibraryEntries.find(sProcedureFileName) == mLibraryEntries.end())
-    {
-        ProcedureElement* element = constructProcedureElement(sProcedureFileName);
+    bool isRequested = entry.needsCheck;
+    entry.needsCheck = false;
+    entry.lastCheck = std::chrono::steady_clock::now();
 
-        if (element)
-            mLibraryEntries[sProcedureFileName] = element;
-        else
-            throw SyntaxError(SyntaxError::FILE_NOT_EXIST, sProcedureFileName, SyntaxError::invalid_position, sProcedureFileName);
+    long long int modificationTime = getModificationTime(sProcedureFileName);
+
+    if (modificationTime < 0)
+        return false;
+
+    // The modification time has a resolution of one
+    // second and misses saves within the same second
+    // as the last read. Requested checks do therefore
+    // always compare the contents
+    if (modificationTime == entry.modificationTime && !isRequested)
+        return true;
+
+    size_t contentHash = getContentHash(sProcedureFileName);
+
+    // Only the time stamp changed
+    if (contentHash == entry.contentHash)
+    {
+        entry.modificationTime = modificationTime;
+        return true;
     }
 
-    return mLibraryEntries[sProcedureFileName];
+    // Construct the new element first, because this
+    // might throw. The entry is left untouched in
+    // this case
+    ProcedureElement* element = constructProcedureElement(sProcedureFileName);
+
+    if (!element)
+        return false;
+
+    // The elements might still be in use by the
+    // current call stack and are therefore only
+    // deleted during the next update
+    vRetiredElements.push_back(entry.element);
+    entry.element = element;
+    entry.modificationTime = modificationTime;
+    entry.contentHash = contentHash;
+
+    invalidateDependents(sProcedureFileName);
+
+    return true;
 }
 
 
 /////////////////////////////////////////////////
-/// \brief Perform an update, e.g. if a procedure
-/// was deleted.
+/// \brief Resets the byte codes of all cached
+/// procedure files, which call procedures from
+/// the passed file, because they might depend on
+/// the previous contents of this file.
 ///
+/// \param sProcedureFileName const std::string&
 /// \return void
 ///
 /////////////////////////////////////////////////
-void ProcedureLibrary::updateLibrary()
+void ProcedureLibrary::invalidateDependents(const std::string& sProcedureFileName)
 {
-    for (auto iter = mLibraryEntries.begin(); iter != mLibraryEntries.end(); )
+    for (auto& iter : mLibraryEntries)
     {
-        delete (iter->second);
+        if (iter.first == sProcedureFileName || !iter.second.element)
+            continue;
 
         try
         {
-            ProcedureElement* element = constructProcedureElement(iter->first);
+            std::map<std::string, DependencyList>& mDependencies = iter.second.element->getDependencies()->getDependencyMap();
 
-            if (element)
+            for (auto& procDeps : mDependencies)
             {
-                iter->second = element;
-                iter++;
+                auto depIter = std::find_if(procDeps.second.begin(), procDeps.second.end(),
+                                            [&](Dependency& dep){return dep.getFileName() == sProcedureFileName;});
+
+                if (depIter != procDeps.second.end())
+                {
+                    iter.second.element->resetByteCode();
+                    break;
+                }
             }
-            else
-                iter = mLibraryEntries.erase(iter);
         }
         catch (...)
         {
-            iter = mLibraryEntries.erase(iter);
+            // Elements with invalid dependencies lose their
+            // byte codes
+            iter.second.element->resetByteCode();
         }
     }
 }
 
+
+/////////////////////////////////////////////////
+/// \brief Returns the ProcedureElement pointer
+/// to the desired procedure file. It also
+/// creates the element, if it doesn't already
+/// exist, and rebuilds it, if the file has been
+/// modified.
+///
+/// \param sProcedureFileName const std::string&
+/// \return ProcedureElement*
+///
+/////////////////////////////////////////////////
+ProcedureElement* ProcedureLibrary::getProcedureContents(const std::string& sProcedureFileName)
+{
+    auto iter = mLibraryEntries.find(sProcedureFileName);
+
+    if (iter == mLibraryEntries.end())
+    {
+        ProcedureLibraryEntry entry;
+        entry.modificationTime = getModificationTime(sProcedureFileName);
+        entry.contentHash = getContentHash(sProcedureFileName);
+        entry.lastCheck = std::chrono::steady_clock::now();
+        entry.element = constructProcedureElement(sProcedureFileName);
+
+        if (!entry.element)
+            throw SyntaxError(SyntaxError::FILE_NOT_EXIST, sProcedureFileName, SyntaxError::invalid_position, sProcedureFileName);
+
+        return (mLibraryEntries[sProcedureFileName] = entry).element;
+    }
+
+    // Check the file for modifications, if an update
+    // was requested or the last check is outdated
+    if (iter->second.needsCheck || std::chrono::steady_clock::now() - iter->second.lastCheck > CHECK_INTERVAL)
+    {
+        bool isValid = false;
+
+        try
+        {
+            isValid = validateEntry(sProcedureFileName, iter->second);
+        }
+        catch (...)
+        {
+            // Remove the entry, if the file cannot be read
+            // anymore. It will be reconstructed on its next use
+            if (iter->second.element)
+                vRetiredElements.push_back(iter->second.element);
+
+            mLibraryEntries.erase(iter);
+            throw;
+        }
+
+        if (!isValid)
+        {
+            if (iter->second.element)
+                vRetiredElements.push_back(iter->second.element);
+
+            mLibraryEntries.erase(iter);
+            throw SyntaxError(SyntaxError::FILE_NOT_EXIST, sProcedureFileName, SyntaxError::invalid_position, sProcedureFileName);
+        }
+    }
+
+    return iter->second.element;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Perform an update, e.g. if a procedure
+/// was saved or deleted. The entries are only
+/// marked for checking and rebuilt lazily on
+/// their next use, if their files changed.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void ProcedureLibrary::updateLibrary()
+{
+    for (auto& iter : mLibraryEntries)
+        iter.second.needsCheck = true;
+
+    // No procedure is running during the update,
+    // wherefore the replaced elements can be deleted
+    for (ProcedureElement* element : vRetiredElements)
+        delete element;
+
+    vRetiredElements.clear();
+}
@@ -21,10 +21,28 @@
 #include <fstream>
 #include <map>
 #include <vector>
+#include <chrono>
 
 #ifndef PROCEDURELIBRARY_HPP
 #define PROCEDURELIBRARY_HPP
 
+/////////////////////////////////////////////////
+/// \brief This structure contains a cached
+/// procedure file together with the information
+/// needed to detect changes of the file.
+/////////////////////////////////////////////////
+struct ProcedureLibraryEntry
+{
+    ProcedureElement* element;
+    long long int modificationTime;
+    size_t contentHash;
+    std::chrono::steady_clock::time_point lastCheck;
+    bool needsCheck;
+
+    ProcedureLibraryEntry() : element(nullptr), modificationTime(0), contentHash(0), needsCheck(false) {}
+};
+
+
 /////////////////////////////////////////////////
 /// \brief This class manages all already read
 /// and possibly pre-parsed procedure files for
@@ -33,10 +51,13 @@
 class ProcedureLibrary
 {
     private:
-        std::map<std::string, ProcedureElement*> mLibraryEntries;
+        std::map<std::string, ProcedureLibraryEntry> mLibraryEntries;
+        std::vector<ProcedureElement*> vRetiredElements;
 
         ProcedureElement* constructProcedureElement(const std::string& sProcedureFileName);
         StyledTextFile getFileContents(const std::string& sProcedureFileName);
+        bool validateEntry(const std::string& sProcedureFileName, ProcedureLibraryEntry& entry);
+        void invalidateDependents(const std::string& sProcedureFileName);
 
     public:
         ~ProcedureLibrary();
@@ -20,6 +20,7 @@
 #include "procedurevarfactory.hpp"
 #include "procedure.hpp"
 #include "../../kernel.hpp"
+#include <algorithm>
 
 using namespace std;
 
@@ -62,10 +63,91 @@ static bool containsFreeOperators(const string& sString)
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Static helper function returning the
+/// scanner for procedure command lines. Local
+/// symbols are additionally separated by the
+/// namespace tilde and the method dot.
+///
+/// \return const IdentifierScanner&
+///
+/////////////////////////////////////////////////
+static const IdentifierScanner& getLocalSymbolScanner()
+{
+    static const IdentifierScanner scanner("~.");
+    return scanner;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper function returning the
+/// pool of procedure call frames. The frames are
+/// identified by the mangled procedure name and
+/// the recursion depth.
+///
+/// \return std::map<std::string, ProcedureCallFrame>&
+///
+/////////////////////////////////////////////////
+static std::map<std::string, ProcedureCallFrame>& getCallFrames()
+{
+    static std::map<std::string, ProcedureCallFrame> mCallFrames;
+    return mCallFrames;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the slot for the variable with
+/// the passed mangled name. The slot is created
+/// on the first request and keeps its address
+/// afterwards.
+///
+/// \param sMangledName const std::string&
+/// \return mu::value_type*
+///
+/////////////////////////////////////////////////
+mu::value_type* ProcedureCallFrame::getSlot(const std::string& sMangledName)
+{
+    auto iter = m_slotIndex.find(sMangledName);
+
+    if (iter != m_slotIndex.end())
+        return iter->second;
+
+    m_slots.push_back(0.0);
+    m_slotIndex[sMangledName] = &m_slots.back();
+
+    return &m_slots.back();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the cache of resolved command
+/// lines for the passed symbol bindings.
+///
+/// \param sBindings const std::string&
+/// \return std::unordered_map<std::string, std::string>&
+///
+/////////////////////////////////////////////////
+std::unordered_map<std::string, std::string>& ProcedureCallFrame::getResolvedLines(const std::string& sBindings)
+{
+    // The bindings differ for every set of references
+    // passed to the procedure. Limit the number of
+    // cached sets
+    if (m_resolvedLines.size() >= 16 && m_resolvedLines.find(sBindings) == m_resolvedLines.end())
+        m_resolvedLines.clear();
+
+    std::unordered_map<std::string, std::string>& mLines = m_resolvedLines[sBindings];
+
+    if (mLines.size() >= 1024)
+        mLines.clear();
+
+    return mLines;
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Constructor
 /////////////////////////////////////////////////
-ProcedureVarFactory::ProcedureVarFactory()
+ProcedureVarFactory::ProcedureVarFactory() : m_symbolIndex(getLocalSymbolScanner())
 {
     init();
 }
@@ -81,7 +163,7 @@ ProcedureVarFactory::ProcedureVarFactory()
 /// \param _inliningMode bool
 ///
 /////////////////////////////////////////////////
-ProcedureVarFactory::ProcedureVarFactory(Procedure* _procedure, const string& sProc, unsigned int currentProc, bool _inliningMode)
+ProcedureVarFactory::ProcedureVarFactory(Procedure* _procedure, const string& sProc, unsigned int currentProc, bool _inliningMode) : m_symbolIndex(getLocalSymbolScanner())
 {
     init();
     _currentProcedure = _procedure;
@@ -89,6 +171,14 @@ ProcedureVarFactory::ProcedureVarFactory(Procedure* _procedure, const string& sP
     sProcName = sProc;
     nth_procedure = currentProc;
     inliningMode = _inliningMode;
+
+    // Inlined procedures redirect their variables
+    // to clusters and do not use a call frame
+    if (!inliningMode)
+    {
+        m_frame = &getCallFrames()["_~"+sProcName+"_"+toString((int)nth_procedure)];
+        m_frame->m_users++;
+    }
 }
 
 
@@ -98,6 +188,9 @@ ProcedureVarFactory::ProcedureVarFactory(Procedure* _procedure, const string& sP
 ProcedureVarFactory::~ProcedureVarFactory()
 {
     reset();
+
+    if (m_frame)
+        m_frame->m_users--;
 }
 
 
@@ -111,6 +204,7 @@ ProcedureVarFactory::~ProcedureVarFactory()
 void ProcedureVarFactory::init()
 {
     _currentProcedure = nullptr;
+    m_frame = nullptr;
 
     // Get the addresses of the kernel objects
     _parserRef = &NumeReKernel::getInstance()->getParser();
@@ -143,13 +237,20 @@ void ProcedureVarFactory::init()
 /////////////////////////////////////////////////
 void ProcedureVarFactory::reset()
 {
+    // The set of local symbols changes
+    m_symbolIndex.invalidate();
+
     // Clear the local copies of the arguments
     if (mLocalArgs.size())
     {
         for (auto iter : mLocalArgs)
         {
+            // Numerical arguments stay in their slots
             if (iter.second == NUMTYPE)
-                _parserRef->RemoveVar(iter.first);
+            {
+                if (!m_frame)
+                    _parserRef->RemoveVar(iter.first);
+            }
             else if (iter.second == STRINGTYPE)
                 NumeReKernel::getInstance()->getStringParser().removeStringVar(iter.first);
             else if (iter.second == CLUSTERTYPE)
@@ -163,13 +264,18 @@ void ProcedureVarFactory::reset()
 
     if (mLocalVars.size())
     {
-        for (auto iter : mLocalVars)
+        // Numerical variables in the slots of the call
+        // frame stay defined for the next call
+        if (!m_frame)
         {
-            if (_parserRef)
-                _parserRef->RemoveVar(iter.second.first);
+            for (auto iter : mLocalVars)
+            {
+                if (_parserRef)
+                    _parserRef->RemoveVar(iter.second.first);
 
-            // Deleting a nullptr is harmless
-            delete iter.second.second;
+                // Deleting a nullptr is harmless
+                delete iter.second.second;
+            }
         }
 
         mLocalVars.clear();
@@ -220,6 +326,9 @@ void ProcedureVarFactory::reset()
 /////////////////////////////////////////////////
 bool ProcedureVarFactory::delayDeletionOfReturnedTable(const std::string& sTableName)
 {
+    // The set of local symbols changes
+    m_symbolIndex.invalidate();
+
     // Search for a corresponding local table
     for (auto iter = mLocalTables.begin(); iter != mLocalTables.end(); ++iter)
     {
@@ -418,6 +527,34 @@ void ProcedureVarFactory::checkArgumentValue(const string& sArgument, const stri
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Binds the numerical variable with the
+/// passed mangled name to its slot in the call
+/// frame and assigns the value. The variable is
+/// only defined in the parser, if the parser does
+/// not already refer to this slot, which avoids
+/// the reinitialization of the parser.
+///
+/// \param sMangledName const std::string&
+/// \param val const mu::value_type&
+/// \return mu::value_type*
+///
+/////////////////////////////////////////////////
+mu::value_type* ProcedureVarFactory::bindNumericalVar(const std::string& sMangledName, const mu::value_type& val)
+{
+    mu::value_type* slot = m_frame->getSlot(sMangledName);
+    *slot = val;
+
+    const mu::varmap_type& varMap = _parserRef->GetVar();
+    auto iter = varMap.find(sMangledName);
+
+    if (iter == varMap.end() || iter->second != slot)
+        _parserRef->DefineVar(sMangledName, slot);
+
+    return slot;
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Checks for invalid characters or
 /// similar.
@@ -619,6 +756,9 @@ map<string,string> ProcedureVarFactory::createProcedureArguments(string sArgumen
     map<string,string> mVarMap;
     NumeReDebugger& _debugger = NumeReKernel::getInstance()->getDebugger();
 
+    // The set of local symbols changes
+    m_symbolIndex.invalidate();
+
     if (!sArgumentList.length() && sArgumentValues.length())
     {
         if (_optionRef->useDebugger())
@@ -1067,10 +1207,7 @@ void ProcedureVarFactory::evaluateProcedureArguments(std::string& currentArg, st
                     }
                     else
                     {
-                        mu::value_type* newVar = new mu::value_type;
-                        *newVar = v[0];
-                        _parserRef->m_lDataStorage.push_back(newVar);
-                        _parserRef->DefineVar(sNewArgName, newVar);
+                        bindNumericalVar(sNewArgName, v[0]);
                         currentValue = sNewArgName;
                         mLocalArgs[sNewArgName] = NUMTYPE;
                     }
@@ -1101,9 +1238,10 @@ void ProcedureVarFactory::evaluateProcedureArguments(std::string& currentArg, st
                         }
                     }
 
-                    // Evaluate numerical expressions
-                    _parserRef->SetExpr(sNewArgName + " = " + currentValue);
-                    _parserRef->Eval();
+                    // Evaluate numerical expressions and bind
+                    // the result to the slot of the argument
+                    _parserRef->SetExpr(currentValue);
+                    bindNumericalVar(sNewArgName, _parserRef->Eval());
                 }
             }
             catch (...)
@@ -1136,6 +1274,9 @@ void ProcedureVarFactory::createLocalVars(string sVarList)
     if (!_currentProcedure)
         return;
 
+    // The set of local symbols changes
+    m_symbolIndex.invalidate();
+
     if (inliningMode)
     {
         createLocalInlineVars(sVarList);
@@ -1222,10 +1363,7 @@ void ProcedureVarFactory::createLocalVars(string sVarList)
         StripSpaces(currentDef);
         std::string currentVar = createMangledVarName(currentDef);
 
-        mLocalVars[currentDef] = std::make_pair(currentVar, new mu::value_type);
-        *mLocalVars[currentDef].second = currentVal;
-
-        _parserRef->DefineVar(currentVar, mLocalVars[currentDef].second);
+        mLocalVars[currentDef] = std::make_pair(currentVar, bindNumericalVar(currentVar, currentVal));
     }
 }
 
@@ -1244,6 +1382,9 @@ void ProcedureVarFactory::createLocalStrings(string sStringList)
     if (!_currentProcedure)
         return;
 
+    // The set of local symbols changes
+    m_symbolIndex.invalidate();
+
     if (inliningMode)
     {
         createLocalInlineStrings(sStringList);
@@ -1345,6 +1486,9 @@ void ProcedureVarFactory::createLocalTables(string sTableList)
     if (!_currentProcedure)
         return;
 
+    // The set of local symbols changes
+    m_symbolIndex.invalidate();
+
     if (inliningMode)
         return;
 
@@ -1464,6 +1608,9 @@ void ProcedureVarFactory::createLocalClusters(string sClusterList)
     if (!_currentProcedure)
         return;
 
+    // The set of local symbols changes
+    m_symbolIndex.invalidate();
+
     if (inliningMode)
         return;
 
@@ -1564,6 +1711,9 @@ void ProcedureVarFactory::createLocalClusters(string sClusterList)
 /////////////////////////////////////////////////
 std::string ProcedureVarFactory::createTestStatsCluster()
 {
+    // The set of local symbols changes
+    m_symbolIndex.invalidate();
+
     const std::string currentDef = "TESTINFO";
     std::string currentVar = createMangledVarName(currentDef);
     NumeRe::Cluster& testCluster = _dataRef->newCluster(currentVar);
@@ -1598,36 +1748,7 @@ string ProcedureVarFactory::resolveArguments(string sProcedureCommandLine, size_
 
     for (const auto& iter : mArguments)
     {
-        unsigned int nPos = 0;
-        size_t nArgumentBaseLength = iter.first.length();
-
-        if (iter.first.back() == '(' || iter.first.back() == '{')
-            nArgumentBaseLength--;
-
-        while ((nPos = sProcedureCommandLine.find(iter.first.substr(0, nArgumentBaseLength), nPos)) != string::npos)
-        {
-            if ((sProcedureCommandLine[nPos-1] == '~' && sProcedureCommandLine[sProcedureCommandLine.find_last_not_of('~',nPos-1)] != '#')
-                || (iter.first.back() != '(' && sProcedureCommandLine[nPos+nArgumentBaseLength] == '(')
-                || (iter.first.back() != '{' && sProcedureCommandLine[nPos+nArgumentBaseLength] == '{'))
-            {
-                nPos += iter.first.length();
-                continue;
-            }
-
-            if (checkDelimiter(sProcedureCommandLine.substr(nPos-1, nArgumentBaseLength+2), true)
-                && (!isInQuotes(sProcedureCommandLine, nPos, true)
-                    || isToCmd(sProcedureCommandLine, nPos)))
-            {
-                if ((iter.second.front() == '{' || iter.second.back() == ')') && iter.first.back() == '{')
-                    sProcedureCommandLine.replace(nPos, getMatchingParenthesis(sProcedureCommandLine.substr(nPos))+1, iter.second);
-                else
-                    sProcedureCommandLine.replace(nPos, nArgumentBaseLength, iter.second);
-
-                nPos += iter.second.length();
-            }
-            else
-                nPos += nArgumentBaseLength;
-        }
+        replaceArgument(sProcedureCommandLine, iter.first, iter.second);
     }
 
     return sProcedureCommandLine;
@@ -1651,33 +1772,7 @@ string ProcedureVarFactory::resolveLocalVars(string sProcedureCommandLine, size_
 
     for (const auto& iter : mLocalVars)
     {
-        size_t nPos = 0;
-        size_t nDelimCheck = 0;
-
-        while ((nPos = sProcedureCommandLine.find(iter.first, nPos)) != string::npos)
-        {
-            if ((sProcedureCommandLine[nPos-1] == '~' && sProcedureCommandLine[sProcedureCommandLine.find_last_not_of('~', nPos-1)] != '#')
-                || sProcedureCommandLine[nPos+iter.first.length()] == '(')
-            {
-                nPos += iter.first.length();
-                continue;
-            }
-
-            nDelimCheck = nPos-1;
-
-            if ((sProcedureCommandLine[nDelimCheck] == '~' && sProcedureCommandLine[sProcedureCommandLine.find_last_not_of('~', nDelimCheck)] == '#'))
-                nDelimCheck = sProcedureCommandLine.find_last_not_of('~', nDelimCheck);
-
-            if (checkDelimiter(sProcedureCommandLine.substr(nDelimCheck, iter.first.length() + 1 + nPos - nDelimCheck))
-                && (!isInQuotes(sProcedureCommandLine, nPos, true)
-                    || isToCmd(sProcedureCommandLine, nPos)))
-            {
-                sProcedureCommandLine.replace(nPos, iter.first.length(), iter.second.first);
-                nPos += iter.second.first.length();
-            }
-            else
-                nPos += iter.first.length();
-        }
+        replaceLocalVar(sProcedureCommandLine, iter.first, iter.second.first);
     }
 
     return sProcedureCommandLine;
@@ -1701,36 +1796,7 @@ string ProcedureVarFactory::resolveLocalStrings(string sProcedureCommandLine, si
 
     for (const auto& iter : mLocalStrings)
     {
-        size_t nPos = 0;
-        size_t nDelimCheck = 0;
-
-        while ((nPos = sProcedureCommandLine.find(iter.first, nPos)) != string::npos)
-        {
-            if ((sProcedureCommandLine[nPos-1] == '~' && sProcedureCommandLine[sProcedureCommandLine.find_last_not_of('~', nPos-1)] != '#')
-                || sProcedureCommandLine[nPos+iter.first.length()] == '(')
-            {
-                nPos += iter.first.length();
-                continue;
-            }
-
-            nDelimCheck = nPos-1;
-
-            if ((sProcedureCommandLine[nDelimCheck] == '~' && sProcedureCommandLine[sProcedureCommandLine.find_last_not_of('~', nDelimCheck)] == '#'))
-                nDelimCheck = sProcedureCommandLine.find_last_not_of('~', nDelimCheck);
-
-            if (checkDelimiter(sProcedureCommandLine.substr(nDelimCheck, iter.first.length() + 1 + nPos - nDelimCheck), true)
-                && (!isInQuotes(sProcedureCommandLine, nPos, true) || isToCmd(sProcedureCommandLine, nPos)))
-            {
-                if (inliningMode)
-                    replaceStringMethod(sProcedureCommandLine, nPos, iter.first.length(), iter.second.first);
-                else
-                    sProcedureCommandLine.replace(nPos, iter.first.length(), iter.second.first);
-
-                nPos += iter.second.first.length();
-            }
-            else
-                nPos += iter.first.length();
-        }
+        replaceLocalString(sProcedureCommandLine, iter.first, iter.second.first);
     }
 
     return sProcedureCommandLine;
@@ -1754,32 +1820,7 @@ string ProcedureVarFactory::resolveLocalTables(string sProcedureCommandLine, siz
 
     for (const auto& iter : mLocalTables)
     {
-        size_t nPos = 0;
-        size_t nDelimCheck = 0;
-
-        while ((nPos = sProcedureCommandLine.find(iter.first + "(", nPos)) != string::npos)
-        {
-            if ((sProcedureCommandLine[nPos-1] == '~' && sProcedureCommandLine[sProcedureCommandLine.find_last_not_of('~', nPos-1)] != '#')
-                || sProcedureCommandLine[nPos-1] == '$')
-            {
-                nPos += iter.first.length();
-                continue;
-            }
-
-            nDelimCheck = nPos-1;
-
-            if ((sProcedureCommandLine[nDelimCheck] == '~' && sProcedureCommandLine[sProcedureCommandLine.find_last_not_of('~', nDelimCheck)] == '#'))
-                nDelimCheck = sProcedureCommandLine.find_last_not_of('~', nDelimCheck);
-
-            if (checkDelimiter(sProcedureCommandLine.substr(nDelimCheck, iter.first.length() + 1 + nPos - nDelimCheck), true)
-                && (!isInQuotes(sProcedureCommandLine, nPos, true) || isToCmd(sProcedureCommandLine, nPos)))
-            {
-                sProcedureCommandLine.replace(nPos, iter.first.length(), iter.second);
-                nPos += iter.second.length();
-            }
-            else
-                nPos += iter.first.length();
-        }
+        replaceLocalTable(sProcedureCommandLine, iter.first, iter.second);
     }
 
     return sProcedureCommandLine;
@@ -1803,34 +1844,499 @@ string ProcedureVarFactory::resolveLocalClusters(string sProcedureCommandLine, s
 
     for (const auto& iter : mLocalClusters)
     {
-        size_t nPos = 0;
-        size_t nDelimCheck = 0;
+        replaceLocalCluster(sProcedureCommandLine, iter.first, iter.second);
+    }
+
+    return sProcedureCommandLine;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This private member function replaces
+/// all calls to the selected argument in the
+/// passed procedure command line. Returns true,
+/// if at least one replacement was done.
+///
+/// \param sProcedureCommandLine std::string&
+/// \param sArgName const std::string&
+/// \param sArgValue const std::string&
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool ProcedureVarFactory::replaceArgument(std::string& sProcedureCommandLine, const std::string& sArgName, const std::string& sArgValue) const
+{
+    size_t nPos = 0;
+    size_t nArgumentBaseLength = sArgName.length();
+    bool bReplaced = false;
+
+    if (sArgName.back() == '(' || sArgName.back() == '{')
+        nArgumentBaseLength--;
+
+    while ((nPos = sProcedureCommandLine.find(sArgName.substr(0, nArgumentBaseLength), nPos)) != string::npos)
+    {
+        if ((sProcedureCommandLine[nPos-1] == '~' && sProcedureCommandLine[sProcedureCommandLine.find_last_not_of('~',nPos-1)] != '#')
+            || (sArgName.back() != '(' && sProcedureCommandLine[nPos+nArgumentBaseLength] == '(')
+            || (sArgName.back() != '{' && sProcedureCommandLine[nPos+nArgumentBaseLength] == '{'))
+        {
+            nPos += sArgName.length();
+            continue;
+        }
 
-        while ((nPos = sProcedureCommandLine.find(iter.first + "{", nPos)) != string::npos)
+        if (checkDelimiter(sProcedureCommandLine.substr(nPos-1, nArgumentBaseLength+2), true)
+            && (!isInQuotes(sProcedureCommandLine, nPos, true)
+                || isToCmd(sProcedureCommandLine, nPos)))
         {
-            if ((sProcedureCommandLine[nPos-1] == '~' && sProcedureCommandLine[sProcedureCommandLine.find_last_not_of('~', nPos-1)] != '#'))
-            {
-                nPos += iter.first.length();
-                continue;
-            }
+            if ((sArgValue.front() == '{' || sArgValue.back() == ')') && sArgName.back() == '{')
+                sProcedureCommandLine.replace(nPos, getMatchingParenthesis(sProcedureCommandLine.substr(nPos))+1, sArgValue);
+            else
+                sProcedureCommandLine.replace(nPos, nArgumentBaseLength, sArgValue);
+
+            nPos += sArgValue.length();
+            bReplaced = true;
+        }
+        else
+            nPos += nArgumentBaseLength;
+    }
 
-            nDelimCheck = nPos-1;
+    return bReplaced;
+}
 
-            if ((sProcedureCommandLine[nDelimCheck] == '~' && sProcedureCommandLine[sProcedureCommandLine.find_last_not_of('~', nDelimCheck)] == '#'))
-                nDelimCheck = sProcedureCommandLine.find_last_not_of('~', nDelimCheck);
 
-            if (checkDelimiter(sProcedureCommandLine.substr(nDelimCheck, iter.first.length() + 1 + nPos - nDelimCheck), true)
-                && (!isInQuotes(sProcedureCommandLine, nPos, true) || isToCmd(sProcedureCommandLine, nPos)))
-            {
-                sProcedureCommandLine.replace(nPos, iter.first.length(), iter.second);
-                nPos += iter.second.length();
-            }
+/////////////////////////////////////////////////
+/// \brief This private member function replaces
+/// all calls to the selected numerical variable
+/// in the passed procedure command line. Returns
+/// true, if at least one replacement was done.
+///
+/// \param sProcedureCommandLine std::string&
+/// \param sVarName const std::string&
+/// \param sMangledName const std::string&
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool ProcedureVarFactory::replaceLocalVar(std::string& sProcedureCommandLine, const std::string& sVarName, const std::string& sMangledName) const
+{
+    size_t nPos = 0;
+    size_t nDelimCheck = 0;
+    bool bReplaced = false;
+
+    while ((nPos = sProcedureCommandLine.find(sVarName, nPos)) != string::npos)
+    {
+        if ((sProcedureCommandLine[nPos-1] == '~' && sProcedureCommandLine[sProcedureCommandLine.find_last_not_of('~', nPos-1)] != '#')
+            || sProcedureCommandLine[nPos+sVarName.length()] == '(')
+        {
+            nPos += sVarName.length();
+            continue;
+        }
+
+        nDelimCheck = nPos-1;
+
+        if ((sProcedureCommandLine[nDelimCheck] == '~' && sProcedureCommandLine[sProcedureCommandLine.find_last_not_of('~', nDelimCheck)] == '#'))
+            nDelimCheck = sProcedureCommandLine.find_last_not_of('~', nDelimCheck);
+
+        if (checkDelimiter(sProcedureCommandLine.substr(nDelimCheck, sVarName.length() + 1 + nPos - nDelimCheck))
+            && (!isInQuotes(sProcedureCommandLine, nPos, true)
+                || isToCmd(sProcedureCommandLine, nPos)))
+        {
+            sProcedureCommandLine.replace(nPos, sVarName.length(), sMangledName);
+            nPos += sMangledName.length();
+            bReplaced = true;
+        }
+        else
+            nPos += sVarName.length();
+    }
+
+    return bReplaced;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This private member function replaces
+/// all calls to the selected string variable in
+/// the passed procedure command line. Returns
+/// true, if at least one replacement was done.
+///
+/// \param sProcedureCommandLine std::string&
+/// \param sVarName const std::string&
+/// \param sMangledName const std::string&
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool ProcedureVarFactory::replaceLocalString(std::string& sProcedureCommandLine, const std::string& sVarName, const std::string& sMangledName) const
+{
+    size_t nPos = 0;
+    size_t nDelimCheck = 0;
+    bool bReplaced = false;
+
+    while ((nPos = sProcedureCommandLine.find(sVarName, nPos)) != string::npos)
+    {
+        if ((sProcedureCommandLine[nPos-1] == '~' && sProcedureCommandLine[sProcedureCommandLine.find_last_not_of('~', nPos-1)] != '#')
+            || sProcedureCommandLine[nPos+sVarName.length()] == '(')
+        {
+            nPos += sVarName.length();
+            continue;
+        }
+
+        nDelimCheck = nPos-1;
+
+        if ((sProcedureCommandLine[nDelimCheck] == '~' && sProcedureCommandLine[sProcedureCommandLine.find_last_not_of('~', nDelimCheck)] == '#'))
+            nDelimCheck = sProcedureCommandLine.find_last_not_of('~', nDelimCheck);
+
+        if (checkDelimiter(sProcedureCommandLine.substr(nDelimCheck, sVarName.length() + 1 + nPos - nDelimCheck), true)
+            && (!isInQuotes(sProcedureCommandLine, nPos, true) || isToCmd(sProcedureCommandLine, nPos)))
+        {
+            if (inliningMode)
+                replaceStringMethod(sProcedureCommandLine, nPos, sVarName.length(), sMangledName);
             else
-                nPos += iter.first.length();
+                sProcedureCommandLine.replace(nPos, sVarName.length(), sMangledName);
+
+            nPos += sMangledName.length();
+            bReplaced = true;
         }
+        else
+            nPos += sVarName.length();
     }
 
-    return sProcedureCommandLine;
+    return bReplaced;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This private member function replaces
+/// all calls to the selected local table in the
+/// passed procedure command line. Returns true,
+/// if at least one replacement was done.
+///
+/// \param sProcedureCommandLine std::string&
+/// \param sTableName const std::string&
+/// \param sMangledName const std::string&
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool ProcedureVarFactory::replaceLocalTable(std::string& sProcedureCommandLine, const std::string& sTableName, const std::string& sMangledName) const
+{
+    size_t nPos = 0;
+    size_t nDelimCheck = 0;
+    bool bReplaced = false;
+
+    while ((nPos = sProcedureCommandLine.find(sTableName + "(", nPos)) != string::npos)
+    {
+        if ((sProcedureCommandLine[nPos-1] == '~' && sProcedureCommandLine[sProcedureCommandLine.find_last_not_of('~', nPos-1)] != '#')
+            || sProcedureCommandLine[nPos-1] == '$')
+        {
+            nPos += sTableName.length();
+            continue;
+        }
+
+        nDelimCheck = nPos-1;
+
+        if ((sProcedureCommandLine[nDelimCheck] == '~' && sProcedureCommandLine[sProcedureCommandLine.find_last_not_of('~', nDelimCheck)] == '#'))
+            nDelimCheck = sProcedureCommandLine.find_last_not_of('~', nDelimCheck);
+
+        if (checkDelimiter(sProcedureCommandLine.substr(nDelimCheck, sTableName.length() + 1 + nPos - nDelimCheck), true)
+            && (!isInQuotes(sProcedureCommandLine, nPos, true) || isToCmd(sProcedureCommandLine, nPos)))
+        {
+            sProcedureCommandLine.replace(nPos, sTableName.length(), sMangledName);
+            nPos += sMangledName.length();
+            bReplaced = true;
+        }
+        else
+            nPos += sTableName.length();
+    }
+
+    return bReplaced;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This private member function replaces
+/// all calls to the selected local cluster in
+/// the passed procedure command line. Returns
+/// true, if at least one replacement was done.
+///
+/// \param sProcedureCommandLine std::string&
+/// \param sClusterName const std::string&
+/// \param sMangledName const std::string&
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool ProcedureVarFactory::replaceLocalCluster(std::string& sProcedureCommandLine, const std::string& sClusterName, const std::string& sMangledName) const
+{
+    size_t nPos = 0;
+    size_t nDelimCheck = 0;
+    bool bReplaced = false;
+
+    while ((nPos = sProcedureCommandLine.find(sClusterName + "{", nPos)) != string::npos)
+    {
+        if ((sProcedureCommandLine[nPos-1] == '~' && sProcedureCommandLine[sProcedureCommandLine.find_last_not_of('~', nPos-1)] != '#'))
+        {
+            nPos += sClusterName.length();
+            continue;
+        }
+
+        nDelimCheck = nPos-1;
+
+        if ((sProcedureCommandLine[nDelimCheck] == '~' && sProcedureCommandLine[sProcedureCommandLine.find_last_not_of('~', nDelimCheck)] == '#'))
+            nDelimCheck = sProcedureCommandLine.find_last_not_of('~', nDelimCheck);
+
+        if (checkDelimiter(sProcedureCommandLine.substr(nDelimCheck, sClusterName.length() + 1 + nPos - nDelimCheck), true)
+            && (!isInQuotes(sProcedureCommandLine, nPos, true) || isToCmd(sProcedureCommandLine, nPos)))
+        {
+            sProcedureCommandLine.replace(nPos, sClusterName.length(), sMangledName);
+            nPos += sMangledName.length();
+            bReplaced = true;
+        }
+        else
+            nPos += sClusterName.length();
+    }
+
+    return bReplaced;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This private member function rebuilds
+/// the symbol index from the names of all
+/// arguments and local symbols.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void ProcedureVarFactory::indexLocalSymbols()
+{
+    m_symbolIndex.clear();
+
+    // The bindings identify the resolved command
+    // lines in the cache of the call frame. The
+    // mangled names of the local symbols only
+    // depend on their declared names
+    m_sBindings.clear();
+
+    for (const auto& iter : mArguments)
+    {
+        if (iter.first.back() == '(' || iter.first.back() == '{')
+            m_symbolIndex.add(iter.first.substr(0, iter.first.length()-1), SymbolIndex::SYM_ARGUMENT);
+        else
+            m_symbolIndex.add(iter.first, SymbolIndex::SYM_ARGUMENT);
+
+        m_sBindings += "A" + iter.first + "=" + iter.second + ";";
+    }
+
+    for (const auto& iter : mLocalVars)
+    {
+        m_symbolIndex.add(iter.first, SymbolIndex::SYM_NUMERICAL);
+        m_sBindings += "V" + iter.first + ";";
+    }
+
+    for (const auto& iter : mLocalStrings)
+    {
+        m_symbolIndex.add(iter.first, SymbolIndex::SYM_STRING);
+        m_sBindings += "S" + iter.first + ";";
+    }
+
+    for (const auto& iter : mLocalTables)
+    {
+        m_symbolIndex.add(iter.first, SymbolIndex::SYM_TABLE);
+        m_sBindings += "T" + iter.first + "=" + iter.second + ";";
+    }
+
+    for (const auto& iter : mLocalClusters)
+    {
+        m_symbolIndex.add(iter.first, SymbolIndex::SYM_CLUSTER);
+        m_sBindings += "C" + iter.first + "=" + iter.second + ";";
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This member function resolves all
+/// arguments and local symbols in the passed
+/// procedure command line. The line is tokenized
+/// once and the tokens are looked up in the
+/// symbol index, so that only the symbols, which
+/// actually appear in the line, have to be
+/// replaced. The line is only tokenized again,
+/// if one of the replacement stages modified it.
+///
+/// \param sProcedureCommandLine const std::string&
+/// \return std::string
+///
+/////////////////////////////////////////////////
+std::string ProcedureVarFactory::resolveVariables(const std::string& sProcedureCommandLine)
+{
+    if (!m_symbolIndex.isValid())
+        indexLocalSymbols();
+
+    // Lines of a call frame are resolved only once
+    // for every set of bindings
+    std::unordered_map<std::string, std::string>* mResolvedLines = nullptr;
+
+    if (m_frame)
+    {
+        mResolvedLines = &m_frame->getResolvedLines(m_sBindings);
+        auto iter = mResolvedLines->find(sProcedureCommandLine);
+
+        if (iter != mResolvedLines->end())
+            return iter->second;
+    }
+
+    std::string sLine = sProcedureCommandLine;
+    std::vector<std::pair<std::string, int>> vMatches;
+    int nIrregular = m_symbolIndex.getIrregularTypes();
+    int nTypes = m_symbolIndex.find(sLine, vMatches);
+    bool bModified = false;
+
+    // Numerical variables
+    if (nIrregular & SymbolIndex::SYM_NUMERICAL)
+        sLine = resolveLocalVars(sLine);
+    else if (nTypes & SymbolIndex::SYM_NUMERICAL)
+    {
+        for (const auto& match : vMatches)
+        {
+            auto iter = mLocalVars.find(match.first);
+
+            if ((match.second & SymbolIndex::SYM_NUMERICAL) && iter != mLocalVars.end())
+                bModified = replaceLocalVar(sLine, iter->first, iter->second.first) || bModified;
+        }
+    }
+
+    if (bModified || (nIrregular & SymbolIndex::SYM_NUMERICAL))
+        nTypes = m_symbolIndex.find(sLine, vMatches);
+
+    bModified = false;
+
+    // String variables
+    if (nIrregular & SymbolIndex::SYM_STRING)
+        sLine = resolveLocalStrings(sLine);
+    else if (nTypes & SymbolIndex::SYM_STRING)
+    {
+        for (const auto& match : vMatches)
+        {
+            auto iter = mLocalStrings.find(match.first);
+
+            if ((match.second & SymbolIndex::SYM_STRING) && iter != mLocalStrings.end())
+                bModified = replaceLocalString(sLine, iter->first, iter->second.first) || bModified;
+        }
+    }
+
+    if (bModified || (nIrregular & SymbolIndex::SYM_STRING))
+        nTypes = m_symbolIndex.find(sLine, vMatches);
+
+    bModified = false;
+
+    // Arguments. Their names may carry a trailing
+    // parenthesis or brace, therefore we collect the
+    // actual names first to keep their ordering
+    if (nIrregular & SymbolIndex::SYM_ARGUMENT)
+        sLine = resolveArguments(sLine);
+    else if (nTypes & SymbolIndex::SYM_ARGUMENT)
+    {
+        std::vector<std::string> vArgs;
+
+        for (const auto& match : vMatches)
+        {
+            if (!(match.second & SymbolIndex::SYM_ARGUMENT))
+                continue;
+
+            if (mArguments.find(match.first) != mArguments.end())
+                vArgs.push_back(match.first);
+
+            if (mArguments.find(match.first + "(") != mArguments.end())
+                vArgs.push_back(match.first + "(");
+
+            if (mArguments.find(match.first + "{") != mArguments.end())
+                vArgs.push_back(match.first + "{");
+        }
+
+        std::sort(vArgs.begin(), vArgs.end());
+
+        for (const std::string& sArg : vArgs)
+        {
+            bModified = replaceArgument(sLine, sArg, mArguments[sArg]) || bModified;
+        }
+    }
+
+    if (bModified || (nIrregular & SymbolIndex::SYM_ARGUMENT))
+        nTypes = m_symbolIndex.find(sLine, vMatches);
+
+    bModified = false;
+
+    // Clusters
+    if (nIrregular & SymbolIndex::SYM_CLUSTER)
+        sLine = resolveLocalClusters(sLine);
+    else if (nTypes & SymbolIndex::SYM_CLUSTER)
+    {
+        for (const auto& match : vMatches)
+        {
+            auto iter = mLocalClusters.find(match.first);
+
+            if ((match.second & SymbolIndex::SYM_CLUSTER) && iter != mLocalClusters.end())
+                bModified = replaceLocalCluster(sLine, iter->first, iter->second) || bModified;
+        }
+    }
+
+    if (bModified || (nIrregular & SymbolIndex::SYM_CLUSTER))
+        nTypes = m_symbolIndex.find(sLine, vMatches);
+
+    // Tables
+    if (nIrregular & SymbolIndex::SYM_TABLE)
+        sLine = resolveLocalTables(sLine);
+    else if (nTypes & SymbolIndex::SYM_TABLE)
+    {
+        for (const auto& match : vMatches)
+        {
+            auto iter = mLocalTables.find(match.first);
+
+            if ((match.second & SymbolIndex::SYM_TABLE) && iter != mLocalTables.end())
+                replaceLocalTable(sLine, iter->first, iter->second);
+        }
+    }
+
+    if (mResolvedLines)
+        mResolvedLines->emplace(sProcedureCommandLine, sLine);
+
+    return sLine;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Releases all call frames, which are
+/// currently not used by any procedure, and
+/// removes their variables from the parser, if
+/// the number of frames exceeds its limit.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void ProcedureVarFactory::trimCallFrames()
+{
+    std::map<std::string, ProcedureCallFrame>& mCallFrames = getCallFrames();
+
+    if (mCallFrames.size() < 256)
+        return;
+
+    mu::Parser& _parser = NumeReKernel::getInstance()->getParser();
+
+    for (auto iter = mCallFrames.begin(); iter != mCallFrames.end(); )
+    {
+        if (iter->second.m_users)
+        {
+            ++iter;
+            continue;
+        }
+
+        for (const auto& slot : iter->second.m_slotIndex)
+        {
+            // Only remove the variable, if it still refers
+            // to the slot
+            auto var = _parser.GetVar().find(slot.first);
+
+            if (var != _parser.GetVar().end() && var->second == slot.second)
+                _parser.RemoveVar(slot.first);
+        }
+
+        iter = mCallFrames.erase(iter);
+    }
 }
 
 
@@ -18,6 +18,8 @@
 
 #include <string>
 #include <map>
+#include <deque>
+#include <unordered_map>
 
 #include "../utils/tools.hpp"
 #include "../ui/error.hpp"
@@ -28,6 +30,7 @@
 #include "../io/output.hpp"
 #include "../plotting/plotdata.hpp"
 #include "../script.hpp"
+#include "../utils/symbolindex.hpp"
 
 #ifndef PROCEDUREVARFACTORY_HPP
 #define PROCEDUREVARFACTORY_HPP
@@ -35,6 +38,30 @@
 // forward declaration of the procedure class
 class Procedure;
 
+
+/////////////////////////////////////////////////
+/// \brief This structure represents the call
+/// frame of a procedure at a certain recursion
+/// depth. The numerical locals and arguments live
+/// in its slots, whose addresses stay valid
+/// between calls. This avoids redefining the
+/// variables in the parser for every call.
+/// Additionally, the resolved command lines are
+/// cached for each set of symbol bindings.
+/////////////////////////////////////////////////
+struct ProcedureCallFrame
+{
+    std::deque<mu::value_type> m_slots;
+    std::map<std::string, mu::value_type*> m_slotIndex;
+    std::unordered_map<std::string, std::unordered_map<std::string, std::string>> m_resolvedLines;
+    size_t m_users;
+
+    ProcedureCallFrame() : m_users(0) {}
+
+    mu::value_type* getSlot(const std::string& sMangledName);
+    std::unordered_map<std::string, std::string>& getResolvedLines(const std::string& sBindings);
+};
+
 /////////////////////////////////////////////////
 /// \brief This class is the variable factory
 /// used by procedure instances to create their
@@ -66,6 +93,9 @@ class ProcedureVarFactory
         };
 
         std::map<std::string,VarType> mLocalArgs;
+        SymbolIndex m_symbolIndex;
+        ProcedureCallFrame* m_frame;
+        std::string m_sBindings;
 
         void init();
 
@@ -78,6 +108,12 @@ class ProcedureVarFactory
         std::string resolveLocalStrings(std::string sProcedureCommandLine, size_t nMapSize = std::string::npos);
         std::string resolveLocalTables(std::string sProcedureCommandLine, size_t nMapSize = std::string::npos);
         std::string resolveLocalClusters(std::string sProcedureCommandLine, size_t nMapSize = std::string::npos);
+        bool replaceArgument(std::string& sProcedureCommandLine, const std::string& sArgName, const std::string& sArgValue) const;
+        bool replaceLocalVar(std::string& sProcedureCommandLine, const std::string& sVarName, const std::string& sMangledName) const;
+        bool replaceLocalString(std::string& sProcedureCommandLine, const std::string& sVarName, const std::string& sMangledName) const;
+        bool replaceLocalTable(std::string& sProcedureCommandLine, const std::string& sTableName, const std::string& sMangledName) const;
+        bool replaceLocalCluster(std::string& sProcedureCommandLine, const std::string& sClusterName, const std::string& sMangledName) const;
+        void indexLocalSymbols();
         unsigned int countVarListElements(const std::string& sVarList);
         void checkArgument(const std::string& sArgument, const std::string& sArgumentList, unsigned int nCurrentIndex);
         void checkArgumentValue(const std::string& sArgument, const std::string& sArgumentList, unsigned int nCurrentIndex);
@@ -85,6 +121,7 @@ class ProcedureVarFactory
         void createLocalInlineVars(std::string sVarList);
         void createLocalInlineStrings(std::string sVarList);
         void evaluateProcedureArguments(std::string& currentArg, std::string& currentValue, const std::string& sArgumentList);
+        mu::value_type* bindNumericalVar(const std::string& sMangledName, const mu::value_type& val);
 
     public:
         std::map<std::string, std::string> mArguments;
@@ -111,10 +148,9 @@ class ProcedureVarFactory
         void createLocalClusters(std::string sClusterList);
         std::string createTestStatsCluster();
 
-        std::string resolveVariables(const std::string& sProcedureCommandLine)
-            {
-                return resolveLocalTables(resolveLocalClusters(resolveArguments(resolveLocalStrings(resolveLocalVars(sProcedureCommandLine)))));
-            }
+        std::string resolveVariables(const std::string& sProcedureCommandLine);
+
+        static void trimCallFrames();
 };
 
 
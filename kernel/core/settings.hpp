@@ -55,6 +55,7 @@
 #define SETTING_S_TERMINALFONT        "terminal.font"
 #define SETTING_S_HISTORYFONT         "history.font"
 #define SETTING_V_AUTOSAVE            "table.autosave"
+#define SETTING_V_LOADTHREADS         "io.loadthreads"
 #define SETTING_S_EXEPATH             "path.exepath"
 #define SETTING_S_SAVEPATH            "path.savepath"
 #define SETTING_S_LOADPATH            "path.loadpath"
@@ -1082,6 +1083,17 @@ class Settings : public Documentation
 		inline size_t getAutoSaveInterval() const
             {return m_settings.at(SETTING_V_AUTOSAVE).value();}
 
+        /////////////////////////////////////////////////
+        /// \brief Returns the maximal number of files,
+        /// which are read concurrently, if multiple files
+        /// are loaded at once.
+        ///
+        /// \return size_t
+        ///
+        /////////////////////////////////////////////////
+        inline size_t getLoadThreads() const
+            {return m_settings.at(SETTING_V_LOADTHREADS).value();}
+
         /////////////////////////////////////////////////
         /// \brief Returns the current terminal buffer
         /// size.
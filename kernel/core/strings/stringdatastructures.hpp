@@ -216,6 +216,32 @@ struct StringStackItem
 };
 
 
+/////////////////////////////////////////////////
+/// \brief The compiled representation of a string
+/// expression. It contains the RPN stack together
+/// with the type of each of its items. Literals
+/// are converted only once during compilation.
+/// The views in the RPN stack refer to the key of
+/// the expression cache in the StringParser,
+/// which never moves in memory.
+/////////////////////////////////////////////////
+struct CompiledStringExpression
+{
+    enum ItemType
+    {
+        ITEM_OPERATOR,
+        ITEM_LITERAL,
+        ITEM_VECTORVAR,
+        ITEM_DYNAMIC
+    };
+
+    std::vector<StringStackItem> rpnStack;
+    std::vector<ItemType> vTypes;
+    std::vector<std::string> vValues;
+    std::vector<StringVector> vLiterals;
+};
+
+
 /////////////////////////////////////////////////
 /// \brief Simple abbreviation
 /////////////////////////////////////////////////
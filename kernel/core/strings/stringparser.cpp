@@ -1586,31 +1586,104 @@ namespace NumeRe
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief Returns the compiled representation of
+    /// the passed expression. Expressions are only
+    /// tokenized once and reused from the cache
+    /// afterwards. This is possible, because the
+    /// preceding steps replace all string variables
+    /// and function results with string vector
+    /// variables, whose names only depend on the
+    /// position in the command line, so that the
+    /// expressions are identical in every iteration
+    /// of a loop.
+    ///
+    /// \param sExpr const std::string&
+    /// \return const CompiledStringExpression&
+    ///
+    /////////////////////////////////////////////////
+    const CompiledStringExpression& StringParser::compileExpression(const std::string& sExpr)
+    {
+        auto iter = m_mCompiledExpressions.find(sExpr);
+
+        if (iter != m_mCompiledExpressions.end())
+            return iter->second;
+
+        // Avoid an unbounded growth of the cache
+        if (m_mCompiledExpressions.size() >= 1024)
+            m_mCompiledExpressions.clear();
+
+        // The key of the map owns the viewed string.
+        // Remove the entry again, if the expression
+        // cannot be compiled
+        iter = m_mCompiledExpressions.emplace(sExpr, CompiledStringExpression()).first;
+        CompiledStringExpression& expr = iter->second;
+
+        try
+        {
+            expr.rpnStack = createStack(StringView(iter->first));
+        }
+        catch (...)
+        {
+            m_mCompiledExpressions.erase(iter);
+            throw;
+        }
+
+        expr.vTypes.resize(expr.rpnStack.size(), CompiledStringExpression::ITEM_OPERATOR);
+        expr.vValues.resize(expr.rpnStack.size());
+        expr.vLiterals.resize(expr.rpnStack.size());
+
+        // Determine the type of the values
+        for (size_t i = 0; i < expr.rpnStack.size(); i++)
+        {
+            if (expr.rpnStack[i].m_val >= 0)
+                continue;
+
+            expr.vValues[i] = expr.rpnStack[i].m_data.to_string();
+
+            if (expr.vValues[i].front() == '"') // This is needed because the math parser does not handle string literals
+            {
+                expr.vTypes[i] = CompiledStringExpression::ITEM_LITERAL;
+                expr.vLiterals[i] = StringVector::convert_literal(expr.vValues[i]);
+            }
+            else if (expr.vValues[i].find("STRVECT[") != std::string::npos && isStringVectorVar(expr.vValues[i]))
+                expr.vTypes[i] = CompiledStringExpression::ITEM_VECTORVAR;
+            else
+                expr.vTypes[i] = CompiledStringExpression::ITEM_DYNAMIC;
+        }
+
+        return expr;
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief Evaluate the created RPN stack between
     /// the selected start and end points.
     ///
-    /// \param rpnStack const std::vector<StringStackItem>&
+    /// \param expr const CompiledStringExpression&
     /// \param from size_t
     /// \param to size_t
     /// \return StringVector
     ///
     /////////////////////////////////////////////////
-    StringVector StringParser::evaluateStack(const std::vector<StringStackItem>& rpnStack, size_t from, size_t to)
+    StringVector StringParser::evaluateStack(const CompiledStringExpression& expr, size_t from, size_t to)
     {
+        const std::vector<StringStackItem>& rpnStack = expr.rpnStack;
         std::stack<StringVector> valueStack;
         size_t nReturnValues = 1;
 
         for (size_t i = from; i < to; i++)
         {
             // This is a value/variable
-            if (rpnStack[i].m_val < 0)
+            if (expr.vTypes[i] == CompiledStringExpression::ITEM_LITERAL)
+                valueStack.push(expr.vLiterals[i]);
+            else if (expr.vTypes[i] == CompiledStringExpression::ITEM_VECTORVAR && isStringVectorVar(expr.vValues[i]))
+                valueStack.push(getStringVectorVar(expr.vValues[i]));
+            else if (expr.vTypes[i] != CompiledStringExpression::ITEM_OPERATOR)
             {
-                std::string sValue = rpnStack[i].m_data.to_string();
+                const std::string& sValue = expr.vValues[i];
 
-                if (sValue.front() == '"') // This is needed because the math parser does not handle string literals
-                    valueStack.push(StringVector::convert_literal(sValue));
-                else if (isStringVectorVar(sValue))
+                if (isStringVectorVar(sValue))
                     valueStack.push(getStringVectorVar(sValue));
                 else if (containsStringVectorVars(sValue) || _parser.ContainsVectorVars(sValue, false))
                     valueStack.push(evaluateStringVectors(sValue));
@@ -1621,7 +1694,7 @@ namespace NumeRe
             {
                 if (rpnStack[i].m_data == "+")
                 {
-                    StringVector op = valueStack.top();
+                    StringVector op = std::move(valueStack.top());
                     valueStack.pop();
                     valueStack.top() += op;
                 }
@@ -1632,55 +1705,55 @@ namespace NumeRe
                 }
                 else if (rpnStack[i].m_data == "==")
                 {
-                    StringVector op = valueStack.top();
+                    StringVector op = std::move(valueStack.top());
                     valueStack.pop();
                     valueStack.top() = valueStack.top() == op;
                 }
                 else if (rpnStack[i].m_data == "!=")
                 {
-                    StringVector op = valueStack.top();
+                    StringVector op = std::move(valueStack.top());
                     valueStack.pop();
                     valueStack.top() = valueStack.top() != op;
                 }
                 else if (rpnStack[i].m_data == ">=")
                 {
-                    StringVector op = valueStack.top();
+                    StringVector op = std::move(valueStack.top());
                     valueStack.pop();
                     valueStack.top() = valueStack.top() >= op;
                 }
                 else if (rpnStack[i].m_data == "<=")
                 {
-                    StringVector op = valueStack.top();
+                    StringVector op = std::move(valueStack.top());
                     valueStack.pop();
                     valueStack.top() = valueStack.top() <= op;
                 }
                 else if (rpnStack[i].m_data == ">")
                 {
-                    StringVector op = valueStack.top();
+                    StringVector op = std::move(valueStack.top());
                     valueStack.pop();
                     valueStack.top() = valueStack.top() > op;
                 }
                 else if (rpnStack[i].m_data == "<")
                 {
-                    StringVector op = valueStack.top();
+                    StringVector op = std::move(valueStack.top());
                     valueStack.pop();
                     valueStack.top() = valueStack.top() < op;
                 }
                 else if (rpnStack[i].m_data == "&&")
                 {
-                    StringVector op = valueStack.top();
+                    StringVector op = std::move(valueStack.top());
                     valueStack.pop();
                     valueStack.top() = valueStack.top().and_f(op);
                 }
                 else if (rpnStack[i].m_data == "||")
                 {
-                    StringVector op = valueStack.top();
+                    StringVector op = std::move(valueStack.top());
                     valueStack.pop();
                     valueStack.top() = valueStack.top().or_f(op);
                 }
                 else if (rpnStack[i].m_data == "|||")
                 {
-                    StringVector op = valueStack.top();
+                    StringVector op = std::move(valueStack.top());
                     valueStack.pop();
                     valueStack.top() = valueStack.top().xor_f(op);
                 }
@@ -1692,8 +1765,8 @@ namespace NumeRe
 
                     // Evaluate the results recursively (lazy is not possible within this logic)
                     valueStack.top().evalIfElse(valueStack.top(),
-                                                evaluateStack(rpnStack, i+1, nIfEnd),
-                                                evaluateStack(rpnStack, nIfEnd+1, nElseEnd));
+                                                evaluateStack(expr, i+1, nIfEnd),
+                                                evaluateStack(expr, nIfEnd+1, nElseEnd));
                     // Jump this evaluation to the end of the else
                     // statement (most probably also the end of the
                     // end of the current stack)
@@ -1715,7 +1788,7 @@ namespace NumeRe
         if (nReturnValues > valueStack.size())
             throw std::out_of_range("Stack size (" + toString(valueStack.size()) + ") is smaller than the requested number of return values (" + toString(nReturnValues) + ").");
 
-        StringVector vRet = valueStack.top();
+        StringVector vRet = std::move(valueStack.top());
         valueStack.pop();
         nReturnValues--;
 
@@ -1734,16 +1807,16 @@ namespace NumeRe
     /// \brief Create a stack from the expression and
     /// evaluate it.
     ///
-    /// \param sExpr StringView
+    /// \param sExpr const std::string&
     /// \return StringResult
     ///
     /////////////////////////////////////////////////
-    StringResult StringParser::createAndEvaluateStack(StringView sExpr)
+    StringResult StringParser::createAndEvaluateStack(const std::string& sExpr)
     {
-        std::vector<StringStackItem> rpnStack = createStack(sExpr);
+        const CompiledStringExpression& expr = compileExpression(sExpr);
         StringResult res;
 
-        res.vResult = evaluateStack(rpnStack, 0, rpnStack.size());
+        res.vResult = evaluateStack(expr, 0, expr.rpnStack.size());
         res.vNoStringVal.resize(res.vResult.size());
         res.bOnlyLogicals = true;
 
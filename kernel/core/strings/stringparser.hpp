@@ -21,6 +21,7 @@
 
 #include <string>
 #include <map>
+#include <unordered_map>
 #include "stringdatastructures.hpp"
 #include "stringvarfactory.hpp"
 #include "stringlogicparser.hpp"
@@ -41,6 +42,7 @@ namespace NumeRe
     {
         private:
             std::map<std::string, int> m_mStringParams;
+            std::unordered_map<std::string, CompiledStringExpression> m_mCompiledExpressions;
             mu::Parser& _parser;
             MemoryManager& _data;
             Settings& _option;
@@ -53,8 +55,9 @@ namespace NumeRe
             std::string createStringOutput(StringResult& strRes, std::string& sLine, int parserFlags, bool bSilent);
             std::string createTerminalOutput(StringResult& strRes, int parserFlags);
             std::vector<StringStackItem> createStack(StringView sExpr) const;
-            StringVector evaluateStack(const std::vector<StringStackItem>& rpnStack, size_t from, size_t to);
-            StringResult createAndEvaluateStack(StringView sExpr);
+            const CompiledStringExpression& compileExpression(const std::string& sExpr);
+            StringVector evaluateStack(const CompiledStringExpression& expr, size_t from, size_t to);
+            StringResult createAndEvaluateStack(const std::string& sExpr);
             std::vector<bool> applyElementaryStringOperations(std::vector<std::string>& vFinal, bool& bReturningLogicals);
             void storeStringToDataObjects(StringResult& strRes, std::string& sObject, size_t& nCurrentComponent, size_t nStrings);
             void storeStringToStringObject(const std::vector<std::string>& vFinal, std::string& sObject, size_t& nCurrentComponent, size_t nStrings);
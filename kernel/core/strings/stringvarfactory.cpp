@@ -18,6 +18,8 @@
 
 #include "stringvarfactory.hpp"
 #include "../../kernel.hpp"
+#include "../utils/symbolindex.hpp"
+#include <algorithm>
 
 using namespace std;
 
@@ -372,6 +374,70 @@ namespace NumeRe
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief Static helper function returning the
+    /// scanner used to find string variables. The
+    /// trailing dot of a string method separates
+    /// the identifiers as well.
+    ///
+    /// \return const IdentifierScanner&
+    ///
+    /////////////////////////////////////////////////
+    static const IdentifierScanner& getStringVarScanner()
+    {
+        static const IdentifierScanner scanner(".");
+        return scanner;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief This private member function scans the
+    /// passed line once and returns the names of all
+    /// declared string variables, which appear as an
+    /// identifier. The names are sorted and unique.
+    /// Whether an occurence is actually delimited
+    /// correctly, has to be checked by the caller.
+    ///
+    /// \param sLine const std::string&
+    /// \return std::vector<std::string>
+    ///
+    /////////////////////////////////////////////////
+    std::vector<std::string> StringVarFactory::findStringVarCandidates(const std::string& sLine) const
+    {
+        auto cached = m_mCandidateCache.find(sLine);
+
+        if (cached != m_mCandidateCache.end())
+            return cached->second;
+
+        std::vector<IdentifierToken> vTokens;
+        std::vector<std::string> vCandidates;
+        getStringVarScanner().scan(sLine, vTokens);
+        std::string sToken;
+
+        for (const IdentifierToken& token : vTokens)
+        {
+            sToken.assign(sLine, token.pos, token.length);
+
+            if (m_mStringVars.find(sToken) != m_mStringVars.end())
+                vCandidates.push_back(sToken);
+        }
+
+        if (vCandidates.size() > 1)
+        {
+            std::sort(vCandidates.begin(), vCandidates.end());
+            vCandidates.erase(std::unique(vCandidates.begin(), vCandidates.end()), vCandidates.end());
+        }
+
+        // Avoid an unbounded growth of the cache
+        if (m_mCandidateCache.size() >= 1024)
+            m_mCandidateCache.clear();
+
+        m_mCandidateCache[sLine] = vCandidates;
+
+        return vCandidates;
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief Replaces all found vectors of the
     /// passed map with their nCurrentComponent
@@ -476,24 +542,29 @@ namespace NumeRe
         // Add whitespaces for safety
         string sLine = " " + _sLine + " ";
 
-        // Search for the first match of all declared string variables
-        for (auto iter = m_mStringVars.begin(); iter != m_mStringVars.end(); ++iter)
+        // Only lines containing declared string variables
+        // as identifiers have to be examined in detail
+        if (findStringVarCandidates(sLine).empty())
+            return false;
+
+        std::vector<IdentifierToken> vTokens;
+        getStringVarScanner().scan(sLine, vTokens);
+        std::string sToken;
+
+        // Look up every identifier of the line in the map of
+        // declared string variables
+        for (const IdentifierToken& token : vTokens)
         {
-            size_t pos = 0;
+            sToken.assign(sLine, token.pos, token.length);
 
-            // Examine all possible candidates for string variables,
-            // because the first one might be a false-positive
-            while ((pos = sLine.find(iter->first, pos)) != std::string::npos)
-            {
-                // Compare the located match to the delimiters and return
-                // true, if the match is delimited on both sides
-                if (sLine[pos+(iter->first).length()] != '('
-                    && checkStringvarDelimiter(sLine.substr(pos-1, (iter->first).length()+2))
-                    )
-                    return true;
-
-                pos++;
-            }
+            if (m_mStringVars.find(sToken) == m_mStringVars.end())
+                continue;
+
+            // Compare the located match to the delimiters and return
+            // true, if the match is delimited on both sides
+            if (sLine[token.pos+token.length] != '('
+                && checkStringvarDelimiter(sLine.substr(token.pos-1, token.length+2)))
+                return true;
         }
 
         // No match found
@@ -537,10 +608,15 @@ namespace NumeRe
         unsigned int __nPos;
         sLine += " ";
 
+        // Only the string variables, which appear as identifiers
+        // in the passed string, have to be replaced
+        std::vector<std::string> vCandidates = findStringVarCandidates(sLine);
+
         // Try to find every string variable into the passed string and
         // replace it correspondingly
-        for (auto iter = m_mStringVars.begin(); iter != m_mStringVars.end(); ++iter)
+        for (const std::string& sCandidate : vCandidates)
         {
+            auto iter = m_mStringVars.find(sCandidate);
             __nPos = nPos;
             std::string sVectVar;
 
@@ -615,10 +691,15 @@ namespace NumeRe
         unsigned int __nPos;
         sLine += " ";
 
+        // Only the string variables, which appear as identifiers
+        // in the passed string, have to be replaced
+        std::vector<std::string> vCandidates = findStringVarCandidates(sLine);
+
         // Try to find every string variable into the passed string and
         // replace it correspondingly
-        for (auto iter = m_mStringVars.begin(); iter != m_mStringVars.end(); ++iter)
+        for (const std::string& sCandidate : vCandidates)
         {
+            auto iter = m_mStringVars.find(sCandidate);
             __nPos = 0;
             std::string sVectVar;
 
@@ -717,6 +798,11 @@ namespace NumeRe
                 throw SyntaxError(SyntaxError::STRINGVARS_MUSTNT_CONTAIN, "", SyntaxError::invalid_position, sVar.substr(i,1));
         }
 
+        // A new variable changes the results of the
+        // candidate search
+        if (m_mStringVars.find(sVar) == m_mStringVars.end())
+            m_mCandidateCache.clear();
+
         // Create or update the variable name with the passed value.
         // Omit the surrounding quotation marks
         if (sValue[0] == '"' && sValue[sValue.length()-1] == '"')
@@ -743,7 +829,10 @@ namespace NumeRe
         // Delete the string variable, if it exists
         auto iter = m_mStringVars.find(sVar);
         if (iter != m_mStringVars.end())
+        {
             m_mStringVars.erase(iter);
+            m_mCandidateCache.clear();
+        }
     }
 
 }
@@ -21,6 +21,7 @@
 
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include "stringdatastructures.hpp"
 
@@ -37,8 +38,14 @@ namespace NumeRe
             std::map<std::string,StringVector> m_mTempStringVectorVars;
             std::map<std::string,std::string> m_mStringVars;
 
+            // Caches the string variables found in a line.
+            // Has to be invalidated whenever a string
+            // variable is declared or removed
+            mutable std::unordered_map<std::string,std::vector<std::string>> m_mCandidateCache;
+
             bool isNumericCandidate(const std::string& sComponent);
             bool checkStringvarDelimiter(const std::string& sToken) const;
+            std::vector<std::string> findStringVarCandidates(const std::string& sLine) const;
             void replaceStringVectorVars(std::map<std::string,StringVector>& mVectorVarMap, std::string& currentline, size_t nCurrentComponent, bool& bHasComponents);
             std::string findVectorInMap(const std::map<std::string,StringVector>& mVectorVarMap, const std::vector<std::string>& vStringVector);
 
@@ -93,6 +93,56 @@ class VectorIndex
             STRING = -3
         };
 
+        /////////////////////////////////////////////////
+        /// \brief Describes a contiguous and ascending
+        /// range of indices by its first index and its
+        /// number of elements.
+        /////////////////////////////////////////////////
+        struct Span
+        {
+            int first;
+            size_t length;
+        };
+
+        /////////////////////////////////////////////////
+        /// \brief A forward iterator over the indices
+        /// described by a VectorIndex. Contiguous ranges
+        /// are iterated without decoding the internal
+        /// storage.
+        /////////////////////////////////////////////////
+        class const_iterator
+        {
+            private:
+                const VectorIndex* m_index;
+                size_t m_pos;
+                int m_first;
+
+            public:
+                const_iterator(const VectorIndex* index, size_t pos)
+                    : m_index(index), m_pos(pos), m_first(index->isContiguous() ? index->front() : INVALID) {}
+
+                int operator*() const
+                {
+                    return m_first != INVALID ? m_first + (int)m_pos : m_index->getIndex(m_pos);
+                }
+
+                const_iterator& operator++()
+                {
+                    m_pos++;
+                    return *this;
+                }
+
+                bool operator==(const const_iterator& other) const
+                {
+                    return m_pos == other.m_pos;
+                }
+
+                bool operator!=(const const_iterator& other) const
+                {
+                    return m_pos != other.m_pos;
+                }
+        };
+
         /////////////////////////////////////////////////
         /// \brief Default constructor.
         ///
@@ -300,6 +350,80 @@ class VectorIndex
             return getIndex(n);
         }
 
+        /////////////////////////////////////////////////
+        /// \brief Returns an iterator to the first
+        /// index.
+        ///
+        /// \return const_iterator
+        ///
+        /////////////////////////////////////////////////
+        const_iterator begin() const
+        {
+            return const_iterator(this, 0);
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Returns an iterator after the last
+        /// index. Open ends have to be resolved with
+        /// setOpenEndIndex() before iterating.
+        ///
+        /// \return const_iterator
+        ///
+        /////////////////////////////////////////////////
+        const_iterator end() const
+        {
+            return const_iterator(this, size());
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief This member function determines,
+        /// whether the index set is a plain ascending
+        /// and contiguous range of valid indices, which
+        /// may also have an open end. Such ranges may
+        /// be accessed via getSpan() instead of
+        /// decoding every single index.
+        ///
+        /// \return bool
+        ///
+        /////////////////////////////////////////////////
+        inline bool isContiguous() const
+        {
+            return expand
+                && vStorage.size() == 2
+                && vStorage.front() >= 0
+                && (vStorage.back() >= vStorage.front() || vStorage.back() == INVALID || vStorage.back() == OPEN_END);
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief This member function returns the part
+        /// of a contiguous range, which is located
+        /// within the first nElems elements of a
+        /// container. An open end is resolved to the
+        /// end of the container. Only valid, if
+        /// isContiguous() returns true.
+        ///
+        /// \param nElems size_t
+        /// \return Span
+        ///
+        /////////////////////////////////////////////////
+        Span getSpan(size_t nElems) const
+        {
+            Span span = {vStorage.front(), 0};
+
+            if ((size_t)span.first >= nElems)
+                return span;
+
+            size_t nLast = nElems-1;
+
+            if (vStorage.back() == INVALID)
+                nLast = span.first;
+            else if (vStorage.back() != OPEN_END && (size_t)vStorage.back() < nLast)
+                nLast = vStorage.back();
+
+            span.length = nLast - span.first + 1;
+            return span;
+        }
+
         /////////////////////////////////////////////////
         /// \brief This member function returns the size
         /// of the indices stored in this class.
@@ -22,13 +22,113 @@
 #include "fast_float/fast_float.h"
 
 #include <cstring>
+#include <cstdio>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+
+// Maximal precision supported by formatNumber()
+// to fit into a buffer of NUMBERBUFFERSIZE
+#define MAXNUMBERPRECISION 100
 
 // Forward declarations
 std::string getNextArgument(std::string& sArgList, bool bCut);
 double intPower(double, int);
 
+/////////////////////////////////////////////////
+/// \brief Formats a double into the passed
+/// buffer using the passed precision. The result
+/// is identical to writing the number into a
+/// std::ostream with the same precision but does
+/// neither allocate memory nor depend on the
+/// locale. The buffer is not null-terminated.
+/// Returns the number of written characters.
+///
+/// \param buffer char*
+/// \param nBufferSize size_t
+/// \param dNumber double
+/// \param nPrecision int
+/// \return size_t
+///
+/////////////////////////////////////////////////
+size_t formatNumber(char* buffer, size_t nBufferSize, double dNumber, int nPrecision)
+{
+    if (nPrecision < 0)
+        nPrecision = 6;
+
+    nPrecision = std::min(nPrecision, MAXNUMBERPRECISION);
+
+#ifdef __cpp_lib_to_chars
+    std::to_chars_result res = std::to_chars(buffer, buffer+nBufferSize, dNumber, std::chars_format::general, nPrecision);
+
+    if (res.ec == std::errc())
+        return res.ptr - buffer;
+
+    return 0;
+#else
+    int nLength = snprintf(buffer, nBufferSize, "%.*g", nPrecision, dNumber);
+
+    if (nLength < 0)
+        return 0;
+
+    return std::min((size_t)nLength, nBufferSize-1);
+#endif
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Formats a complex number into the
+/// passed buffer. The result is identical to
+/// toString(const std::complex<double>&, int).
+/// The buffer is not null-terminated. Returns
+/// the number of written characters.
+///
+/// \param buffer char*
+/// \param nBufferSize size_t
+/// \param dNumber const std::complex<double>&
+/// \param nPrecision int
+/// \return size_t
+///
+/////////////////////////////////////////////////
+size_t formatNumber(char* buffer, size_t nBufferSize, const std::complex<double>& dNumber, int nPrecision)
+{
+    size_t nLength = 0;
+
+    // Appends a literal to the buffer
+    auto append = [&](const char* sLiteral)
+    {
+        for (; *sLiteral && nLength < nBufferSize; sLiteral++)
+            buffer[nLength++] = *sLiteral;
+    };
+
+    if (std::isnan(dNumber.real()) && std::isnan(dNumber.imag()))
+    {
+        append("nan");
+        return nLength;
+    }
+
+    nPrecision = std::rint(nPrecision / (dNumber.real() != 0.0 && dNumber.imag() != 0.0 && !std::isnan(dNumber.imag()) ? 2 : 1));
+
+    if (dNumber.real() || !dNumber.imag())
+        nLength = formatNumber(buffer, nBufferSize, dNumber.real(), nPrecision);
+
+    if (dNumber.imag())
+    {
+        if ((dNumber.imag() > 0.0 || std::isnan(dNumber.imag())) && dNumber.real() != 0.0)
+            append("+");
+
+        nLength += formatNumber(buffer+nLength, nBufferSize-nLength, dNumber.imag(), nPrecision);
+        append(std::isnan(dNumber.imag()) || std::isinf(dNumber.imag()) ? " i" : "i");
+    }
+
+    return nLength;
+}
+
+
 // toString function implementations
 // There's an overwrite for mostly every variable type
 //
@@ -72,10 +172,8 @@ std::string toString(double dNumber, const Settings& _option)
 /////////////////////////////////////////////////
 std::string toString(double dNumber, int nPrecision)
 {
-    std::ostringstream Temp;
-    Temp.precision(nPrecision);
-    Temp << dNumber;
-    return Temp.str();
+    char buffer[NUMBERBUFFERSIZE];
+    return std::string(buffer, formatNumber(buffer, NUMBERBUFFERSIZE, dNumber, nPrecision));
 }
 
 /////////////////////////////////////////////////
@@ -89,24 +187,8 @@ std::string toString(double dNumber, int nPrecision)
 /////////////////////////////////////////////////
 std::string toString(const std::complex<double>& dNumber, int nPrecision)
 {
-    if (std::isnan(dNumber.real()) && std::isnan(dNumber.imag()))
-        return "nan";
-
-    std::ostringstream Temp;
-    Temp.precision(std::rint(nPrecision / (dNumber.real() != 0.0 && dNumber.imag() != 0.0 && !std::isnan(dNumber.imag()) ? 2 : 1)));
-
-    if (dNumber.real() || !dNumber.imag())
-        Temp << dNumber.real();
-
-    if (dNumber.imag())
-    {
-        if ((dNumber.imag() > 0.0 || std::isnan(dNumber.imag())) && dNumber.real() != 0.0)
-            Temp << "+";
-
-        Temp << dNumber.imag() << (std::isnan(dNumber.imag()) || std::isinf(dNumber.imag()) ? " i" : "i");
-    }
-
-    return Temp.str();
+    char buffer[NUMBERBUFFERSIZE];
+    return std::string(buffer, formatNumber(buffer, NUMBERBUFFERSIZE, dNumber, nPrecision));
 }
 
 
@@ -273,9 +355,7 @@ std::string toString(sys_time_point tp, int timeStampFlags)
 /////////////////////////////////////////////////
 std::string toString(long long int nNumber)
 {
-    std::ostringstream Temp;
-    Temp << nNumber;
-    return Temp.str();
+    return std::to_string(nNumber);
 }
 
 
@@ -65,6 +65,12 @@ enum TimeDateFormat
     TD_SEP_SLASH = 0x800000
 };
 
+// Size of a character buffer, which is large
+// enough for formatNumber()
+#define NUMBERBUFFERSIZE 256
+
+size_t formatNumber(char* buffer, size_t nBufferSize, double dNumber, int nPrecision);
+size_t formatNumber(char* buffer, size_t nBufferSize, const std::complex<double>& dNumber, int nPrecision);
 std::string toString(int nNumber, const Settings& _option);
 std::string toString(double dNumber, const Settings& _option);
 std::string toString(double dNumber, int nPrecision = 7);
@@ -0,0 +1,188 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2023  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "symbolindex.hpp"
+#include "tools.hpp"
+#include <algorithm>
+
+
+/////////////////////////////////////////////////
+/// \brief Constructor. Creates the separator
+/// lookup table from the standard delimiters and
+/// the passed additional separators.
+///
+/// \param sAdditionalSeparators const std::string&
+///
+/////////////////////////////////////////////////
+IdentifierScanner::IdentifierScanner(const std::string& sAdditionalSeparators)
+{
+    for (size_t c = 0; c < 256; c++)
+    {
+        m_isSeparator[c] = isDelimiter((char)c);
+    }
+
+    for (char c : sAdditionalSeparators)
+    {
+        m_isSeparator[(unsigned char)c] = true;
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns true, if the passed symbol name
+/// does not contain any separator and will
+/// therefore be found as a single token.
+///
+/// \param sSymbol const std::string&
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool IdentifierScanner::isRegular(const std::string& sSymbol) const
+{
+    if (!sSymbol.length())
+        return false;
+
+    for (char c : sSymbol)
+    {
+        if (isSeparator(c))
+            return false;
+    }
+
+    return true;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Splits the passed line into its
+/// identifier tokens. The token vector is
+/// cleared first, but its memory is reused.
+///
+/// \param sLine const std::string&
+/// \param vTokens std::vector<IdentifierToken>&
+/// \return void
+///
+/////////////////////////////////////////////////
+void IdentifierScanner::scan(const std::string& sLine, std::vector<IdentifierToken>& vTokens) const
+{
+    vTokens.clear();
+    size_t nStart = std::string::npos;
+
+    for (size_t i = 0; i < sLine.length(); i++)
+    {
+        if (isSeparator(sLine[i]))
+        {
+            if (nStart != std::string::npos)
+            {
+                vTokens.push_back({nStart, i-nStart});
+                nStart = std::string::npos;
+            }
+        }
+        else if (nStart == std::string::npos)
+            nStart = i;
+    }
+
+    if (nStart != std::string::npos)
+        vTokens.push_back({nStart, sLine.length()-nStart});
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Adds a symbol with the passed type to
+/// the index. Symbols may have more than one
+/// type.
+///
+/// \param sSymbol const std::string&
+/// \param type int
+/// \return void
+///
+/////////////////////////////////////////////////
+void SymbolIndex::add(const std::string& sSymbol, int type)
+{
+    m_symbols[sSymbol] |= type;
+
+    if (!m_scanner.isRegular(sSymbol))
+        m_irregularTypes |= type;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Removes all symbols from the index.
+/// The index is considered as valid afterwards,
+/// because this function is used to start
+/// rebuilding it.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void SymbolIndex::clear()
+{
+    m_symbols.clear();
+    m_irregularTypes = SYM_NONE;
+    m_isValid = true;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Resolves the passed line against the
+/// index. All known symbols found as tokens are
+/// returned together with their types, sorted
+/// by their names and without duplicates. The
+/// return value is the combination of all found
+/// types. Note that the matches are only
+/// candidates: the caller still has to check the
+/// context of each occurence.
+///
+/// \param sLine const std::string&
+/// \param vMatches std::vector<std::pair<std::string, int>>&
+/// \return int
+///
+/////////////////////////////////////////////////
+int SymbolIndex::find(const std::string& sLine, std::vector<std::pair<std::string, int>>& vMatches) const
+{
+    vMatches.clear();
+
+    if (m_symbols.empty())
+        return SYM_NONE;
+
+    std::vector<IdentifierToken> vTokens;
+    m_scanner.scan(sLine, vTokens);
+
+    std::string sToken;
+    int nTypes = SYM_NONE;
+
+    for (const IdentifierToken& token : vTokens)
+    {
+        sToken.assign(sLine, token.pos, token.length);
+        auto iter = m_symbols.find(sToken);
+
+        if (iter != m_symbols.end())
+        {
+            vMatches.push_back(*iter);
+            nTypes |= iter->second;
+        }
+    }
+
+    if (vMatches.size() > 1)
+    {
+        std::sort(vMatches.begin(), vMatches.end());
+        vMatches.erase(std::unique(vMatches.begin(), vMatches.end()), vMatches.end());
+    }
+
+    return nTypes;
+}
+
@@ -0,0 +1,154 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2023  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef SYMBOLINDEX_HPP
+#define SYMBOLINDEX_HPP
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+
+/////////////////////////////////////////////////
+/// \brief Describes a single identifier token
+/// located by the IdentifierScanner.
+/////////////////////////////////////////////////
+struct IdentifierToken
+{
+    size_t pos;
+    size_t length;
+};
+
+
+/////////////////////////////////////////////////
+/// \brief This class splits a command line into
+/// identifier tokens in a single pass. The
+/// tokens are the maximal runs of characters,
+/// which are neither a delimiter (in the sense
+/// of isDelimiter()) nor one of the additional
+/// separators passed to the constructor.
+/// Every correctly delimited occurence of a
+/// symbol name is therefore exactly one token,
+/// as long as the name itself does not contain
+/// any separator (see isRegular()).
+/////////////////////////////////////////////////
+class IdentifierScanner
+{
+    private:
+        bool m_isSeparator[256];
+
+    public:
+        IdentifierScanner(const std::string& sAdditionalSeparators = "");
+
+        /////////////////////////////////////////////////
+        /// \brief Returns true, if the passed character
+        /// separates two tokens.
+        ///
+        /// \param c char
+        /// \return bool
+        ///
+        /////////////////////////////////////////////////
+        bool isSeparator(char c) const
+        {
+            return m_isSeparator[(unsigned char)c];
+        }
+
+        bool isRegular(const std::string& sSymbol) const;
+        void scan(const std::string& sLine, std::vector<IdentifierToken>& vTokens) const;
+};
+
+
+/////////////////////////////////////////////////
+/// \brief This class is a hashed symbol table,
+/// which maps symbol names to a combination of
+/// symbol types. A command line is resolved
+/// against the table by scanning it once with an
+/// IdentifierScanner and looking up each token,
+/// instead of searching the line for each of the
+/// known symbols separately.
+/////////////////////////////////////////////////
+class SymbolIndex
+{
+    public:
+        enum SymbolType
+        {
+            SYM_NONE = 0x0,
+            SYM_NUMERICAL = 0x1,
+            SYM_STRING = 0x2,
+            SYM_ARGUMENT = 0x4,
+            SYM_TABLE = 0x8,
+            SYM_CLUSTER = 0x10,
+            SYM_FUNCTION = 0x20
+        };
+
+    private:
+        const IdentifierScanner& m_scanner;
+        std::unordered_map<std::string, int> m_symbols;
+        int m_irregularTypes;
+        bool m_isValid;
+
+    public:
+        SymbolIndex(const IdentifierScanner& scanner) : m_scanner(scanner), m_irregularTypes(SYM_NONE), m_isValid(false) {}
+
+        void add(const std::string& sSymbol, int type);
+        void clear();
+        int find(const std::string& sLine, std::vector<std::pair<std::string, int>>& vMatches) const;
+
+        /////////////////////////////////////////////////
+        /// \brief Marks the index as outdated. It has
+        /// to be rebuilt by its owner before the next
+        /// lookup.
+        ///
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void invalidate()
+        {
+            m_isValid = false;
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Returns true, if the index reflects the
+        /// current set of symbols.
+        ///
+        /// \return bool
+        ///
+        /////////////////////////////////////////////////
+        bool isValid() const
+        {
+            return m_isValid;
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Returns the combination of symbol
+        /// types, for which at least one name could not
+        /// be tokenized. Those types have to be searched
+        /// for in the traditional way.
+        ///
+        /// \return int
+        ///
+        /////////////////////////////////////////////////
+        int getIrregularTypes() const
+        {
+            return m_irregularTypes;
+        }
+};
+
+
+#endif // SYMBOLINDEX_HPP
+
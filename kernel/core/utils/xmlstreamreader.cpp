@@ -0,0 +1,473 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2023  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "xmlstreamreader.hpp"
+#include <cstdlib>
+#include <cstring>
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper to detect XML
+/// whitespace characters.
+///
+/// \param c char
+/// \return bool
+///
+/////////////////////////////////////////////////
+static inline bool isXmlSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper to append a unicode code
+/// point as UTF-8 sequence to the target string.
+///
+/// \param nCodePoint unsigned long
+/// \param sTarget std::string&
+/// \return void
+///
+/////////////////////////////////////////////////
+static void appendUtf8(unsigned long nCodePoint, std::string& sTarget)
+{
+    if (nCodePoint < 0x80)
+        sTarget += (char)nCodePoint;
+    else if (nCodePoint < 0x800)
+    {
+        sTarget += (char)(0xC0 | (nCodePoint >> 6));
+        sTarget += (char)(0x80 | (nCodePoint & 0x3F));
+    }
+    else if (nCodePoint < 0x10000)
+    {
+        sTarget += (char)(0xE0 | (nCodePoint >> 12));
+        sTarget += (char)(0x80 | ((nCodePoint >> 6) & 0x3F));
+        sTarget += (char)(0x80 | (nCodePoint & 0x3F));
+    }
+    else
+    {
+        sTarget += (char)(0xF0 | (nCodePoint >> 18));
+        sTarget += (char)(0x80 | ((nCodePoint >> 12) & 0x3F));
+        sTarget += (char)(0x80 | ((nCodePoint >> 6) & 0x3F));
+        sTarget += (char)(0x80 | (nCodePoint & 0x3F));
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the value of the selected
+/// attribute converted to an integer or the
+/// passed default value, if the attribute does
+/// not exist.
+///
+/// \param sName const char*
+/// \param nDefault int
+/// \return int
+///
+/////////////////////////////////////////////////
+int XmlAttributes::getInt(const char* sName, int nDefault) const
+{
+    const std::string* attr = get(sName);
+
+    if (!attr || attr->empty())
+        return nDefault;
+
+    return std::strtol(attr->c_str(), nullptr, 10);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Constructor. Binds the reader to the
+/// passed event handler.
+///
+/// \param handler XmlEventHandler&
+///
+/////////////////////////////////////////////////
+XmlStreamReader::XmlStreamReader(XmlEventHandler& handler) : m_handler(handler), m_error(false)
+{
+    //
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Feed the next chunk of the XML
+/// document to the reader. All complete tokens
+/// are passed to the event handler, the
+/// remaining incomplete token is kept for the
+/// next call.
+///
+/// \param sData const char*
+/// \param len size_t
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool XmlStreamReader::feed(const char* sData, size_t len)
+{
+    if (m_error)
+        return false;
+
+    m_buffer.append(sData, len);
+    size_t pos = 0;
+
+    while (pos < m_buffer.length() && !m_error)
+    {
+        if (m_buffer[pos] == '<')
+        {
+            size_t next = parseMarkup(pos);
+
+            // Incomplete markup: wait for the next chunk
+            if (next == std::string::npos)
+                break;
+
+            pos = next;
+        }
+        else
+        {
+            size_t nextTag = m_buffer.find('<', pos);
+
+            // The text might continue in the next chunk
+            if (nextTag == std::string::npos)
+                break;
+
+            emitText(m_buffer.c_str()+pos, nextTag-pos, true);
+            pos = nextTag;
+        }
+    }
+
+    m_buffer.erase(0, pos);
+    return !m_error;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Signals the end of the document. Will
+/// return false, if the document was not
+/// complete or contained errors.
+///
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool XmlStreamReader::finish()
+{
+    for (char c : m_buffer)
+    {
+        if (!isXmlSpace(c))
+        {
+            m_error = true;
+            break;
+        }
+    }
+
+    m_buffer.clear();
+    return !m_error;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Handles the markup starting at the
+/// passed position and returns the position
+/// directly after it or std::string::npos, if
+/// the markup is not yet complete.
+///
+/// \param pos size_t
+/// \return size_t
+///
+/////////////////////////////////////////////////
+size_t XmlStreamReader::parseMarkup(size_t pos)
+{
+    size_t remaining = m_buffer.length() - pos;
+
+    if (remaining < 2)
+        return std::string::npos;
+
+    // Processing instructions are ignored
+    if (m_buffer[pos+1] == '?')
+    {
+        size_t end = m_buffer.find("?>", pos+2);
+        return end == std::string::npos ? end : end+2;
+    }
+
+    if (m_buffer[pos+1] == '!')
+    {
+        // Comments are ignored
+        if (m_buffer.compare(pos, 4, "<!--") == 0)
+        {
+            size_t end = m_buffer.find("-->", pos+4);
+            return end == std::string::npos ? end : end+3;
+        }
+
+        // CDATA is passed verbatim
+        if (m_buffer.compare(pos, 9, "<![CDATA[") == 0)
+        {
+            size_t end = m_buffer.find("]]>", pos+9);
+
+            if (end == std::string::npos)
+                return end;
+
+            emitText(m_buffer.c_str()+pos+9, end-pos-9, false);
+            return end+3;
+        }
+
+        // We cannot decide yet
+        if (remaining < 9)
+            return std::string::npos;
+
+        // DOCTYPE and similar declarations are ignored
+        size_t end = m_buffer.find('>', pos+2);
+        return end == std::string::npos ? end : end+1;
+    }
+
+    // Find the end of the tag while respecting
+    // quoted attribute values
+    char cQuote = 0;
+
+    for (size_t i = pos+1; i < m_buffer.length(); i++)
+    {
+        if (cQuote)
+        {
+            if (m_buffer[i] == cQuote)
+                cQuote = 0;
+        }
+        else if (m_buffer[i] == '"' || m_buffer[i] == '\'')
+            cQuote = m_buffer[i];
+        else if (m_buffer[i] == '>')
+        {
+            parseTag(pos, i);
+            return i+1;
+        }
+    }
+
+    return std::string::npos;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Decodes a complete start or end tag
+/// located between pos and end (the position of
+/// the closing angle bracket) and passes the
+/// corresponding events to the handler.
+///
+/// \param pos size_t
+/// \param end size_t
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool XmlStreamReader::parseTag(size_t pos, size_t end)
+{
+    const char* sTag = m_buffer.c_str();
+
+    // End tag
+    if (sTag[pos+1] == '/')
+    {
+        size_t nameStart = pos+2;
+        size_t nameEnd = nameStart;
+
+        while (nameEnd < end && !isXmlSpace(sTag[nameEnd]))
+            nameEnd++;
+
+        if (nameEnd == nameStart)
+        {
+            m_error = true;
+            return false;
+        }
+
+        m_name.assign(sTag+nameStart, nameEnd-nameStart);
+        m_handler.endElement(m_name);
+        return true;
+    }
+
+    bool isEmptyElement = sTag[end-1] == '/';
+
+    if (isEmptyElement)
+        end--;
+
+    // Decode the element's name
+    size_t i = pos+1;
+
+    while (i < end && !isXmlSpace(sTag[i]))
+        i++;
+
+    if (i == pos+1)
+    {
+        m_error = true;
+        return false;
+    }
+
+    m_name.assign(sTag+pos+1, i-pos-1);
+    m_attributes.clear();
+
+    // Decode the attributes
+    while (i < end)
+    {
+        while (i < end && isXmlSpace(sTag[i]))
+            i++;
+
+        if (i >= end)
+            break;
+
+        size_t nameStart = i;
+
+        while (i < end && sTag[i] != '=' && !isXmlSpace(sTag[i]))
+            i++;
+
+        size_t nameEnd = i;
+
+        while (i < end && isXmlSpace(sTag[i]))
+            i++;
+
+        if (i >= end || sTag[i] != '=' || nameEnd == nameStart)
+        {
+            m_error = true;
+            return false;
+        }
+
+        i++;
+
+        while (i < end && isXmlSpace(sTag[i]))
+            i++;
+
+        if (i >= end || (sTag[i] != '"' && sTag[i] != '\''))
+        {
+            m_error = true;
+            return false;
+        }
+
+        char cQuote = sTag[i];
+        size_t valueStart = ++i;
+
+        while (i < end && sTag[i] != cQuote)
+            i++;
+
+        if (i >= end)
+        {
+            m_error = true;
+            return false;
+        }
+
+        std::pair<std::string, std::string>& attr = m_attributes.next();
+        attr.first.assign(sTag+nameStart, nameEnd-nameStart);
+        decodeEntities(sTag+valueStart, i-valueStart, attr.second);
+        i++;
+    }
+
+    m_handler.startElement(m_name, m_attributes);
+
+    if (isEmptyElement)
+        m_handler.endElement(m_name);
+
+    return true;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Passes a text node to the handler.
+///
+/// \param sText const char*
+/// \param len size_t
+/// \param decode bool
+/// \return void
+///
+/////////////////////////////////////////////////
+void XmlStreamReader::emitText(const char* sText, size_t len, bool decode)
+{
+    m_text.clear();
+
+    if (decode)
+        decodeEntities(sText, len, m_text);
+    else
+        m_text.assign(sText, len);
+
+    m_handler.characters(m_text);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Static member function to replace the
+/// predefined XML entities and the numerical
+/// character references with their actual
+/// characters. The result is appended to the
+/// target string.
+///
+/// \param sText const char*
+/// \param len size_t
+/// \param sTarget std::string&
+/// \return void
+///
+/////////////////////////////////////////////////
+void XmlStreamReader::decodeEntities(const char* sText, size_t len, std::string& sTarget)
+{
+    const char* sAmp = (const char*)std::memchr(sText, '&', len);
+
+    // Fast path for the most common case
+    if (!sAmp)
+    {
+        sTarget.append(sText, len);
+        return;
+    }
+
+    size_t i = 0;
+
+    while (i < len)
+    {
+        if (sText[i] != '&')
+        {
+            const char* sNext = (const char*)std::memchr(sText+i, '&', len-i);
+            size_t nextPos = sNext ? sNext-sText : len;
+            sTarget.append(sText+i, nextPos-i);
+            i = nextPos;
+            continue;
+        }
+
+        size_t semicolon = i+1;
+
+        while (semicolon < len && semicolon-i < 12 && sText[semicolon] != ';')
+            semicolon++;
+
+        if (semicolon >= len || sText[semicolon] != ';')
+        {
+            sTarget += '&';
+            i++;
+            continue;
+        }
+
+        std::string sEntity(sText+i+1, semicolon-i-1);
+
+        if (sEntity == "amp")
+            sTarget += '&';
+        else if (sEntity == "lt")
+            sTarget += '<';
+        else if (sEntity == "gt")
+            sTarget += '>';
+        else if (sEntity == "quot")
+            sTarget += '"';
+        else if (sEntity == "apos")
+            sTarget += '\'';
+        else if (sEntity.length() > 1 && sEntity[0] == '#')
+        {
+            if (sEntity[1] == 'x' || sEntity[1] == 'X')
+                appendUtf8(std::strtoul(sEntity.c_str()+2, nullptr, 16), sTarget);
+            else
+                appendUtf8(std::strtoul(sEntity.c_str()+1, nullptr, 10), sTarget);
+        }
+        else
+            sTarget.append(sText+i, semicolon-i+1);
+
+        i = semicolon+1;
+    }
+}
+
@@ -0,0 +1,178 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2023  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef XMLSTREAMREADER_HPP
+#define XMLSTREAMREADER_HPP
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+/////////////////////////////////////////////////
+/// \brief This class represents the attribute
+/// list of a single XML element as it is passed
+/// to the XmlEventHandler. The list is reused
+/// between elements to avoid re-allocations.
+/////////////////////////////////////////////////
+class XmlAttributes
+{
+    private:
+        std::vector<std::pair<std::string, std::string>> m_attributes;
+        size_t m_size;
+
+    public:
+        XmlAttributes() : m_size(0) {}
+
+        /////////////////////////////////////////////////
+        /// \brief Remove all attributes but keep the
+        /// allocated memory.
+        ///
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void clear()
+        {
+            m_size = 0;
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Return a reference to the next free
+        /// attribute slot.
+        ///
+        /// \return std::pair<std::string, std::string>&
+        ///
+        /////////////////////////////////////////////////
+        std::pair<std::string, std::string>& next()
+        {
+            if (m_size >= m_attributes.size())
+                m_attributes.emplace_back();
+
+            m_attributes[m_size].first.clear();
+            m_attributes[m_size].second.clear();
+
+            return m_attributes[m_size++];
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Return the value of the selected
+        /// attribute or a nullptr, if the attribute does
+        /// not exist.
+        ///
+        /// \param sName const char*
+        /// \return const std::string*
+        ///
+        /////////////////////////////////////////////////
+        const std::string* get(const char* sName) const
+        {
+            for (size_t i = 0; i < m_size; i++)
+            {
+                if (m_attributes[i].first == sName)
+                    return &m_attributes[i].second;
+            }
+
+            return nullptr;
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Returns true, if the selected
+        /// attribute exists and has the passed value.
+        ///
+        /// \param sName const char*
+        /// \param sValue const char*
+        /// \return bool
+        ///
+        /////////////////////////////////////////////////
+        bool is(const char* sName, const char* sValue) const
+        {
+            const std::string* attr = get(sName);
+            return attr && *attr == sValue;
+        }
+
+        int getInt(const char* sName, int nDefault = 0) const;
+
+        size_t size() const
+        {
+            return m_size;
+        }
+};
+
+
+/////////////////////////////////////////////////
+/// \brief Abstract handler interface for the
+/// XmlStreamReader. Derive from this class and
+/// override the events you're interested in.
+/////////////////////////////////////////////////
+class XmlEventHandler
+{
+    public:
+        virtual ~XmlEventHandler() {}
+
+        virtual void startElement(const std::string& sName, const XmlAttributes& attributes) {}
+        virtual void endElement(const std::string& sName) {}
+        virtual void characters(const std::string& sText) {}
+};
+
+
+/////////////////////////////////////////////////
+/// \brief This class implements an event-driven
+/// (SAX-style) XML tokenizer, which may be fed
+/// with arbitrary chunks of the XML document.
+/// Incomplete tokens at the end of a chunk are
+/// kept until the next chunk arrives, i.e. the
+/// document never has to be present in memory
+/// as a whole.
+/////////////////////////////////////////////////
+class XmlStreamReader
+{
+    private:
+        XmlEventHandler& m_handler;
+        std::string m_buffer;
+        std::string m_name;
+        std::string m_text;
+        XmlAttributes m_attributes;
+        bool m_error;
+
+        size_t parseMarkup(size_t pos);
+        bool parseTag(size_t pos, size_t end);
+        void emitText(const char* sText, size_t len, bool decode);
+
+    public:
+        XmlStreamReader(XmlEventHandler& handler);
+
+        bool feed(const char* sData, size_t len);
+        bool finish();
+
+        /////////////////////////////////////////////////
+        /// \brief Returns true, if a syntax error was
+        /// detected in the XML stream.
+        ///
+        /// \return bool
+        ///
+        /////////////////////////////////////////////////
+        bool hasError() const
+        {
+            return m_error;
+        }
+
+        static void decodeEntities(const char* sText, size_t len, std::string& sTarget);
+};
+
+
+#endif // XMLSTREAMREADER_HPP
+
@@ -24,6 +24,9 @@ Zipfile::Zipfile()
 {
     hZip = NULL;
     bIsOpen = false;
+    nItemIndex = -1;
+    nItemBytesRead = 0;
+    bItemHasMore = false;
 }
 
 Zipfile::~Zipfile()
@@ -126,3 +129,53 @@ std::string Zipfile::getZipItem(const std::string& sFilename)
     return "";
 }
 
+
+// Prepares the selected item for being inflated
+// chunk-wise using readZipItem(). Returns false,
+// if the item does not exist
+bool Zipfile::openZipItem(const std::string& sFilename)
+{
+    nItemIndex = -1;
+    nItemBytesRead = 0;
+    bItemHasMore = false;
+
+    if (!bIsOpen || hZip == NULL)
+        return false;
+
+    if (FindZipItem(hZip, sFilename.c_str(), true, &nItemIndex, &zEntry) != ZR_OK)
+    {
+        nItemIndex = -1;
+        return false;
+    }
+
+    bItemHasMore = true;
+    return true;
+}
+
+
+// Inflates the next chunk of the item opened with
+// openZipItem() into the passed buffer and returns
+// the number of written bytes. Returns zero, if the
+// item is completely read or an error occured
+size_t Zipfile::readZipItem(char* cBuffer, size_t nBufferSize)
+{
+    if (!bIsOpen || hZip == NULL || nItemIndex < 0 || !bItemHasMore)
+        return 0;
+
+    ZRESULT zRes = UnzipItem(hZip, nItemIndex, cBuffer, nBufferSize);
+    size_t nBytes = nBufferSize;
+
+    if (zRes == ZR_OK)
+    {
+        nBytes = zEntry.unc_size - nItemBytesRead;
+        bItemHasMore = false;
+    }
+    else if (zRes != ZR_MORE)
+    {
+        bItemHasMore = false;
+        return 0;
+    }
+
+    nItemBytesRead += nBytes;
+    return nBytes;
+}
@@ -37,6 +37,9 @@ class Zipfile
         HZIP hZip;
         ZIPENTRY zEntry;
         bool bIsOpen;
+        int nItemIndex;
+        unsigned long int nItemBytesRead;
+        bool bItemHasMore;
 
     public:
         Zipfile();
@@ -48,6 +51,8 @@ class Zipfile
         bool addFile(const std::string& sFilename);
         std::string getZipContent();
         std::string getZipItem(const std::string& sFilename);
+        bool openZipItem(const std::string& sFilename);
+        size_t readZipItem(char* cBuffer, size_t nBufferSize);
 };
 
 #endif
@@ -24,6 +24,9 @@
 #include "core/io/logger.hpp"
 #include "core/plotting/plotting.hpp"
 
+#include <chrono>
+#include <exception>
+
 #define KERNEL_PRINT_SLEEP 2
 #define TERMINAL_FORMAT_FIELD_LENOFFSET 16
 #define DEFAULT_NUM_PRECISION 7
@@ -45,6 +48,7 @@ __time64_t tTimeZero = _time64(0);
 
 // Initialization of the static member variables
 NumeReKernel* NumeReKernel::kernelInstance = nullptr;
+thread_local std::vector<std::string>* NumeReKernel::m_deferredWarnings = nullptr;
 int* NumeReKernel::baseStackPosition = nullptr;
 NumeReTerminal* NumeReKernel::m_parent = nullptr;
 std::queue<NumeReTask> NumeReKernel::taskQueue;
@@ -129,6 +133,36 @@ void NumeReKernel::Autosave()
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Static helper function returning the
+/// milliseconds elapsed since the passed time
+/// point.
+///
+/// \param start const std::chrono::steady_clock::time_point&
+/// \return double
+///
+/////////////////////////////////////////////////
+static double getElapsedMs(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper function to format a
+/// start-up phase duration for the log file.
+///
+/// \param sPhase const std::string&
+/// \param dMilliSeconds double
+/// \return std::string
+///
+/////////////////////////////////////////////////
+static std::string formatPhaseTime(const std::string& sPhase, double dMilliSeconds)
+{
+    return "Start-up phase \"" + sPhase + "\" took " + toString(dMilliSeconds, 4) + " ms.";
+}
+
+
 /////////////////////////////////////////////////
 /// \brief This is the kernel "booting" function.
 ///
@@ -141,6 +175,11 @@ void NumeReKernel::Autosave()
 /// and constants used for the numerical parser.
 /// loads possible available autosaves and
 /// definition files for functions and plugins.
+/// Independent loaders run concurrently, while
+/// the documentation index, the plotting font
+/// and the tables of the last session are loaded
+/// on their first use. The duration of every
+/// phase is written to the log file.
 /////////////////////////////////////////////////
 void NumeReKernel::StartUp(NumeReTerminal* _parent, const std::string& __sPath, const std::string& sPredefinedFunctions)
 {
@@ -148,6 +187,9 @@ void NumeReKernel::StartUp(NumeReTerminal* _parent, const std::string& __sPath,
         m_parent = _parent;
     //Do some start-up stuff here
 
+    auto startUpTime = std::chrono::steady_clock::now();
+    auto phaseTime = startUpTime;
+
     std::string sTime = getTimeStamp(false);
     std::string sLogFile = "numere.log";
     std::string sPath = __sPath;
@@ -176,6 +218,9 @@ void NumeReKernel::StartUp(NumeReTerminal* _parent, const std::string& __sPath,
     else
         g_logger.setLoggingLevel(Logger::LVL_DISABLED);
 
+    g_logger.info(formatPhaseTime("settings", getElapsedMs(phaseTime)));
+    phaseTime = std::chrono::steady_clock::now();
+
     g_logger.info("Verifying file system.");
     // Set the path tokens for all relevant objects
     _fSys.setTokens(_option.getTokenPaths());
@@ -223,44 +268,119 @@ void NumeReKernel::StartUp(NumeReTerminal* _parent, const std::string& __sPath,
     _functions.setPath(_option.getExePath(), false, sPath);
     _fSys.setPath(_option.getExePath(), false, sPath);
     g_logger.info("File system was verified.");
+    g_logger.info(formatPhaseTime("file system", getElapsedMs(phaseTime)));
 
-    // Load the documentation index file
-    g_logger.info("Loading documentation index.");
-    _option.createDocumentationIndex(_option.useCustomLangFiles());
-
-    // Load the language strings
-    g_logger.info("Loading kernel language files.");
-    _lang.loadStrings(_option.useCustomLangFiles());
+    // The documentation index and the plotting font
+    // are loaded on their first use
+    _option.deferDocumentationIndex(_option.useCustomLangFiles());
+    requestPlotFont(_option.getDefaultPlotFont(), _option.getExePath() + "\\fonts");
 
     std::string sCacheFile = _option.getExePath() + "/numere.cache";
+    bool hasPlugins = fileExists(_procedure.getPluginInfoPath());
+    bool hasDefinitions = _option.controlDefinitions() && fileExists(_option.getExePath() + "\\functions.def");
+    bool hasCacheFile = fileExists(sCacheFile);
+
+    // The following loaders do not depend on each
+    // other and run concurrently. The logger is not
+    // thread-safe, therefore the durations are
+    // logged afterwards. Only the index of the cache
+    // file is read, the tables themselves are
+    // loaded on their first access
+    g_logger.info("Loading language files, plugins, function definitions and the table index.");
+    double dLoaderTimes[4] = {0.0, 0.0, 0.0, 0.0};
+    std::exception_ptr loaderErrors[4];
+
+    #pragma omp parallel sections
+    {
+        #pragma omp section
+        {
+            auto start = std::chrono::steady_clock::now();
 
-    // Load the plugin informations
-    if (fileExists(_procedure.getPluginInfoPath()))
-    {
-        g_logger.info("Loading plugins.");
-        _procedure.loadPlugins();
-        _memoryManager.setPluginCommands(_procedure.getPluginNames());
-        _lang.addToLanguage(getPluginLanguageStrings());
+            try
+            {
+                _lang.loadStrings(_option.useCustomLangFiles());
+            }
+            catch (...)
+            {
+                loaderErrors[0] = std::current_exception();
+            }
+
+            dLoaderTimes[0] = getElapsedMs(start);
+        }
+
+        #pragma omp section
+        {
+            auto start = std::chrono::steady_clock::now();
+
+            try
+            {
+                if (hasPlugins)
+                    _procedure.loadPlugins();
+            }
+            catch (...)
+            {
+                loaderErrors[1] = std::current_exception();
+            }
+
+            dLoaderTimes[1] = getElapsedMs(start);
+        }
+
+        #pragma omp section
+        {
+            auto start = std::chrono::steady_clock::now();
+
+            try
+            {
+                if (hasDefinitions)
+                    _functions.load(_option, true);
+            }
+            catch (...)
+            {
+                loaderErrors[2] = std::current_exception();
+            }
+
+            dLoaderTimes[2] = getElapsedMs(start);
+        }
+
+        #pragma omp section
+        {
+            auto start = std::chrono::steady_clock::now();
+
+            try
+            {
+                if (hasCacheFile)
+                    _memoryManager.loadFromCacheFile();
+            }
+            catch (...)
+            {
+                loaderErrors[3] = std::current_exception();
+            }
+
+            dLoaderTimes[3] = getElapsedMs(start);
+        }
     }
 
-    // Load the function definitions
-    if (_option.controlDefinitions() && fileExists(_option.getExePath() + "\\functions.def"))
+    g_logger.info(formatPhaseTime("language files", dLoaderTimes[0]));
+    g_logger.info(formatPhaseTime("plugins", dLoaderTimes[1]));
+    g_logger.info(formatPhaseTime("function definitions", dLoaderTimes[2]));
+    g_logger.info(formatPhaseTime("table index", dLoaderTimes[3]));
+
+    for (std::exception_ptr& e_ptr : loaderErrors)
     {
-        g_logger.info("Loading custom function definitions.");
-        _functions.load(_option, true);
+        if (e_ptr)
+            std::rethrow_exception(e_ptr);
     }
 
-    // Load the binary plot font
-    g_logger.info("Loading plotting font.");
-    _fontData.LoadFont(_option.getDefaultPlotFont().c_str(), (_option.getExePath() + "\\fonts").c_str());
-
-    // Load the autosave file
-    if (fileExists(sCacheFile))
+    // The plugin commands and language strings have
+    // to wait for the other loaders
+    if (hasPlugins)
     {
-        g_logger.info("Loading tables from last session.");
-        _memoryManager.loadFromCacheFile();
+        _memoryManager.setPluginCommands(_procedure.getPluginNames());
+        _lang.addToLanguage(getPluginLanguageStrings());
     }
 
+    phaseTime = std::chrono::steady_clock::now();
+
     // Declare the default variables
     _parser.DefineVar("ans", &vAns);        // Deklariere die spezielle Variable "ans", die stets, das letzte Ergebnis speichert und die vier Standardvariablen
     _parser.DefineVar(_defVars.sName[0], &_defVars.vValue[0][0]);
@@ -290,7 +410,8 @@ void NumeReKernel::StartUp(NumeReTerminal* _parent, const std::string& __sPath,
     g_logger.debug("Defining functions.");
     defineFunctions();
 
-    g_logger.info("Kernel ready.");
+    g_logger.info(formatPhaseTime("parser", getElapsedMs(phaseTime)));
+    g_logger.info("Kernel ready after " + toString(getElapsedMs(startUpTime), 4) + " ms.");
 }
 
 
@@ -2534,6 +2655,13 @@ NumeReVariables NumeReKernel::getVariableList()
             sCurrentLine = iter->first + "()\t" + toString(_memoryManager.getStringElements()) + " x " + toString(_memoryManager.getStringCols());
             sCurrentLine += "\tstring\t{\"" + replaceControlCharacters(_memoryManager.minString()) + "\", ..., \"" + replaceControlCharacters(_memoryManager.maxString()) + "\"}\tstring()\t" + formatByteSize(_memoryManager.getStringSize());
         }
+        else if (!_memoryManager.isLoaded(iter->first))
+        {
+            // Do not load the tables from the last session
+            // only for displaying them
+            sCurrentLine = iter->first + "()\t" + toString(_memoryManager.getLines(iter->first, false)) + " x " + toString(_memoryManager.getCols(iter->first, false));
+            sCurrentLine += "\ttable\t{...}\t" + iter->first + "()\t---";
+        }
         else
         {
             sCurrentLine = iter->first + "()\t" + toString(_memoryManager.getLines(iter->first, false)) + " x " + toString(_memoryManager.getCols(iter->first, false));
@@ -2892,6 +3020,14 @@ std::string NumeReKernel::formatResultOutput(const std::vector<std::string>& vSt
 /////////////////////////////////////////////////
 void NumeReKernel::issueWarning(std::string sWarningMessage)
 {
+    // Collect the warning, if the calling thread
+    // defers its warnings
+    if (m_deferredWarnings)
+    {
+        m_deferredWarnings->push_back(sWarningMessage);
+        return;
+    }
+
     if (!m_parent)
         return;
     else
@@ -2914,6 +3050,24 @@ void NumeReKernel::issueWarning(std::string sWarningMessage)
 }
 
 
+/////////////////////////////////////////////////
+/// \brief This static function collects all
+/// warnings issued by the calling thread in the
+/// passed buffer instead of printing them. This
+/// allows worker threads to issue warnings,
+/// which are printed afterwards by the caller.
+/// Passing a nullptr ends the collection.
+///
+/// \param deferredWarnings std::vector<std::string>*
+/// \return void
+///
+/////////////////////////////////////////////////
+void NumeReKernel::deferWarnings(std::vector<std::string>* deferredWarnings)
+{
+    m_deferredWarnings = deferredWarnings;
+}
+
+
 /////////////////////////////////////////////////
 /// \brief This static function may be used to
 /// print a test failure message in the terminal.
@@ -35,6 +35,7 @@
 #include "core/datamanagement/memorymanager.hpp"
 
 #include "core/debugger/debugger.hpp"
+#include "core/debugger/profiler.hpp"
 
 #include "core/io/output.hpp"
 
@@ -142,6 +143,7 @@ class NumeReKernel
         bool refreshTree;
 
         static NumeReKernel* kernelInstance;
+        static thread_local std::vector<std::string>* m_deferredWarnings;
 
         //datasets
         FileSystem _fSys;
@@ -155,6 +157,7 @@ class NumeReKernel
         Script _script;
         Procedure _procedure;
         NumeReDebugger _debugger;
+        NumeReProfiler _profiler;
         NumeRe::WindowManager _manager;
         NumeRe::Cluster* _ans;
 
@@ -231,6 +234,7 @@ class NumeReKernel
         static std::string formatResultOutput(int nNum, mu::value_type* v);
         static std::string formatResultOutput(const std::vector<std::string>& vStringResults);
         static void issueWarning(std::string sWarningMessage);
+        static void deferWarnings(std::vector<std::string>* deferredWarnings);
         static void failMessage(std::string sFailMessage);
         static int numberOfNumbersPerLine();
         static void progressBar(int nStep, int nFirstStep, int nFinalStep, const std::string& sType);
@@ -330,6 +334,11 @@ class NumeReKernel
             return _debugger;
         }
 
+        NumeReProfiler& getProfiler()
+        {
+            return _profiler;
+        }
+
         NumeRe::WindowManager& getWindowManager()
         {
             return _manager;
@@ -19,12 +19,29 @@
 
 #include "syntax.hpp"
 #include "core/utils/tools.hpp"
+#include <algorithm>
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper to determine, whether
+/// the passed string starts with the passed
+/// prefix.
+///
+/// \param sString const std::string&
+/// \param sPrefix const std::string&
+/// \return bool
+///
+/////////////////////////////////////////////////
+static bool hasPrefix(const std::string& sString, const std::string& sPrefix)
+{
+    return sString.compare(0, sPrefix.length(), sPrefix) == 0;
+}
 
 
 /////////////////////////////////////////////////
 /// \brief Default constructor.
 /////////////////////////////////////////////////
-NumeReSyntax::NumeReSyntax() : sPath("")
+NumeReSyntax::NumeReSyntax() : nBuiltInCommands(1), sPath("")
 {
     vNSCRCommands.push_back("NO_SYNTAX_ELEMENTS");
     vNPRCCommands.push_back("NO_SYNTAX_ELEMENTS");
@@ -44,6 +61,8 @@ NumeReSyntax::NumeReSyntax() : sPath("")
 
     // The operator characters are always the same
     sSingleOperators = "+-*/?=()[]{},;#^!&|<>%:";
+
+    buildLookupTables();
 }
 
 
@@ -74,7 +93,7 @@ NumeReSyntax::NumeReSyntax(const std::string& _sPath) : NumeReSyntax()
 /////////////////////////////////////////////////
 NumeReSyntax::NumeReSyntax(const std::string& _sPath, const std::vector<std::string>& vPlugins) : NumeReSyntax(_sPath)
 {
-    vNSCRCommands.insert(vNSCRCommands.end(), vPlugins.begin(), vPlugins.end());
+    addPlugins(vPlugins);
 }
 
 
@@ -149,14 +168,48 @@ void NumeReSyntax::loadSyntax(const std::string& _sPath)
         else if (sLine.substr(0, 11) == "TEXKEYWORDS")
             vTeXKeyWords = splitString(sLine.substr(sLine.find('=')+1));
     }
+
+    // Reloading replaces all commands including the
+    // plugins and invalidates the autocompletion lists
+    nBuiltInCommands = vNSCRCommands.size();
+    vPlugins.clear();
+    mAutoCompList.clear();
+    mAutoCompListMATLAB.clear();
+    mAutoCompListCPP.clear();
+    mAutoCompListTeX.clear();
+
+    buildLookupTables();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Compiles the keyword lists into hashed
+/// sets, which are used for the exact lookups
+/// during highlighting.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void NumeReSyntax::buildLookupTables()
+{
+    setNSCRCommands = std::unordered_set<std::string>(vNSCRCommands.begin(), vNSCRCommands.begin()+nBuiltInCommands);
+    setPluginCommands = std::unordered_set<std::string>(vPlugins.begin(), vPlugins.end());
+    setNPRCCommands = std::unordered_set<std::string>(vNPRCCommands.begin(), vNPRCCommands.end());
+    setOptions = std::unordered_set<std::string>(vOptions.begin(), vOptions.end());
+    setFunctions = std::unordered_set<std::string>(vFunctions.begin(), vFunctions.end());
+    setMethods = std::unordered_set<std::string>(vMethods.begin(), vMethods.end());
+    setMethods.insert(vMethodsArgs.begin(), vMethodsArgs.end());
+    setConstants = std::unordered_set<std::string>(vConstants.begin(), vConstants.end());
+    setSpecialValues = std::unordered_set<std::string>(vSpecialValues.begin(), vSpecialValues.end());
 }
 
 
 /////////////////////////////////////////////////
 /// \brief Add the plugin definitions to the
-/// command strings. Will reload the standard
-/// settings in advance to restore the default
-/// state.
+/// command strings. Replaces the previously
+/// added plugins, while the standard commands
+/// are kept. Nothing is done, if the plugins did
+/// not change.
 ///
 /// \param vPlugins const std::vector<std::string>&
 /// \return void
@@ -164,10 +217,16 @@ void NumeReSyntax::loadSyntax(const std::string& _sPath)
 /////////////////////////////////////////////////
 void NumeReSyntax::addPlugins(const std::vector<std::string>& vPlugins)
 {
-    mAutoCompList.clear();
+    if (vPlugins == this->vPlugins)
+        return;
 
-    loadSyntax();
+    this->vPlugins = vPlugins;
+    vNSCRCommands.resize(nBuiltInCommands);
     vNSCRCommands.insert(vNSCRCommands.end(), vPlugins.begin(), vPlugins.end());
+    setPluginCommands = std::unordered_set<std::string>(vPlugins.begin(), vPlugins.end());
+
+    // Will be refilled lazily
+    mAutoCompList.clear();
 }
 
 
@@ -183,6 +242,7 @@ void NumeReSyntax::setProcedureTree(const std::vector<std::string>& vTree)
 {
     // Copy the tree
     vProcedureTree = vTree;
+    mProcedureIndex.clear();
 
     // Replace the path separators with namespace characters
     // Also remove the file extensions
@@ -196,6 +256,9 @@ void NumeReSyntax::setProcedureTree(const std::vector<std::string>& vTree)
 
         if (vProcedureTree[i].find(".nprc") != std::string::npos)
             vProcedureTree[i].erase(vProcedureTree[i].rfind(".nprc"));
+
+        // Sorted prefix index for the autocompletion
+        mProcedureIndex.insert(std::make_pair(toLowerCase(vProcedureTree[i]), i));
     }
 }
 
@@ -330,24 +393,16 @@ std::vector<SyntaxBlockDefinition> NumeReSyntax::splitDefs(std::string sDefStrin
 
 /////////////////////////////////////////////////
 /// \brief This function searches for a match of
-/// the passed string in the passed vector.
+/// the passed string in the passed set.
 ///
-/// \param vVector const std::vector<std::string>&
+/// \param setItems const std::unordered_set<std::string>&
 /// \param sString const std::string&
 /// \return bool
 ///
 /////////////////////////////////////////////////
-bool NumeReSyntax::matchItem(const std::vector<std::string>& vVector, const std::string& sString)
+bool NumeReSyntax::matchItem(const std::unordered_set<std::string>& setItems, const std::string& sString) const
 {
-    for (size_t i = 0; i < vVector.size(); i++)
-    {
-        // Match found -> return true
-        if (vVector[i] == sString)
-            return true;
-    }
-
-    // Nothing found
-    return false;
+    return setItems.find(sString) != setItems.end();
 }
 
 
@@ -556,13 +611,14 @@ std::string NumeReSyntax::highlightLine(const std::string& sCommandLine)
             }
 
             // Color the actual syntax elements
-            if (matchItem(vNSCRCommands, sCommandLine.substr(i,nLen)))
+            if (matchItem(setNSCRCommands, sCommandLine.substr(i,nLen))
+                || matchItem(setPluginCommands, sCommandLine.substr(i,nLen)))
             {
                 // Commands
                 colors.replace(i, nLen, nLen, '0'+SYNTAX_COMMAND);
             }
 
-            if (matchItem(vNPRCCommands, sCommandLine.substr(i,nLen)))
+            if (matchItem(setNPRCCommands, sCommandLine.substr(i,nLen)))
             {
                 // Commands for NPRC in NSCR (highlighted differently)
                 colors.replace(i, nLen, nLen, '0'+SYNTAX_COMMAND); // Changed for debug viewer
@@ -577,16 +633,14 @@ std::string NumeReSyntax::highlightLine(const std::string& sCommandLine)
                 {
                     if (sCommandLine[n] == '.')
                     {
-                        if (matchItem(vMethods, sCommandLine.substr(nPos, n-nPos))
-                            || matchItem(vMethodsArgs, sCommandLine.substr(nPos, n-nPos)))
+                        if (matchItem(setMethods, sCommandLine.substr(nPos, n-nPos)))
                             colors.replace(nPos, n-nPos, n-nPos, '0'+SYNTAX_METHODS);
                         nPos = n+1;
                     }
 
                     if (n+1 == i+nLen)
                     {
-                        if (matchItem(vMethods, sCommandLine.substr(nPos, n-nPos+1))
-                            || matchItem(vMethodsArgs, sCommandLine.substr(nPos, n-nPos+1)))
+                        if (matchItem(setMethods, sCommandLine.substr(nPos, n-nPos+1)))
                             colors.replace(nPos, n-nPos+1, n-nPos+1, '0'+SYNTAX_METHODS);
                         nPos = n+1;
                     }
@@ -594,22 +648,22 @@ std::string NumeReSyntax::highlightLine(const std::string& sCommandLine)
             }
             else if (i+nLen < sCommandLine.length()
                 && sCommandLine[i+nLen] == '('
-                && matchItem(vFunctions, sCommandLine.substr(i,nLen)))
+                && matchItem(setFunctions, sCommandLine.substr(i,nLen)))
             {
                 // Functions
                 colors.replace(i, nLen, nLen, '0'+SYNTAX_FUNCTION);
             }
-            else if (matchItem(vOptions, sCommandLine.substr(i,nLen)))
+            else if (matchItem(setOptions, sCommandLine.substr(i,nLen)))
             {
                 // Command line options
                 colors.replace(i, nLen, nLen, '0'+SYNTAX_OPTION);
             }
-            else if (matchItem(vConstants, sCommandLine.substr(i,nLen)))
+            else if (matchItem(setConstants, sCommandLine.substr(i,nLen)))
             {
                 // Constants
                 colors.replace(i, nLen, nLen, '0'+SYNTAX_CONSTANT);
             }
-            else if (matchItem(vSpecialValues, sCommandLine.substr(i,nLen)))
+            else if (matchItem(setSpecialValues, sCommandLine.substr(i,nLen)))
             {
                 // Special variables
                 colors.replace(i, nLen, nLen, '0'+SYNTAX_SPECIALVAL);
@@ -728,24 +782,20 @@ std::string NumeReSyntax::getAutoCompList(std::string sFirstChars, bool useSmart
     if (selectMethods)
         sFirstChars.erase(0, 1);
 
-    // Try to find the correspondig elements in the map
-    for (auto iter = mAutoCompList.begin(); iter != mAutoCompList.end(); ++iter)
+    // The map is sorted, i.e. all elements starting with
+    // the passed characters form a contiguous range
+    for (auto iter = mAutoCompList.lower_bound(sFirstChars);
+         iter != mAutoCompList.end() && hasPrefix(iter->first, sFirstChars); ++iter)
     {
-        if ((iter->first).front() == sFirstChars.front())
+        if (useSmartSense)
         {
-            if (useSmartSense)
-            {
-                if (selectMethods && iter->second.second != SYNTAX_METHODS)
-                    continue;
-                else if (!selectMethods && iter->second.second == SYNTAX_METHODS)
-                    continue;
-            }
-
-            if (sFirstChars == (iter->first).substr(0, sFirstChars.length()))
-                sAutoCompList += iter->second.first + " ";
+            if (selectMethods && iter->second.second != SYNTAX_METHODS)
+                continue;
+            else if (!selectMethods && iter->second.second == SYNTAX_METHODS)
+                continue;
         }
-        else if ((iter->first).front() > sFirstChars.front())
-            break;
+
+        sAutoCompList += iter->second.first + " ";
     }
 
     // return the created list
@@ -753,6 +803,32 @@ std::string NumeReSyntax::getAutoCompList(std::string sFirstChars, bool useSmart
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Returns the autocompletion list of the
+/// passed language specific map, whose keys are
+/// the lower case keywords followed by " |" and
+/// the original keyword.
+///
+/// \param mAutoComp const std::map<std::string, int>&
+/// \param sFirstChars std::string
+/// \return std::string
+///
+/////////////////////////////////////////////////
+std::string NumeReSyntax::getAutoCompListFromMap(const std::map<std::string, int>& mAutoComp, std::string sFirstChars) const
+{
+    std::string sAutoCompList;
+    sFirstChars = toLowerCase(sFirstChars);
+
+    for (auto iter = mAutoComp.lower_bound(sFirstChars);
+         iter != mAutoComp.end() && hasPrefix(iter->first, sFirstChars); ++iter)
+    {
+        sAutoCompList += (iter->first).substr((iter->first).find('|')+1) + "?" + toString((int)(iter->second)) + " ";
+    }
+
+    return sAutoCompList;
+}
+
+
 /////////////////////////////////////////////////
 /// \brief The same as above but specialized for
 /// MATLAB commands.
@@ -763,8 +839,6 @@ std::string NumeReSyntax::getAutoCompList(std::string sFirstChars, bool useSmart
 /////////////////////////////////////////////////
 std::string NumeReSyntax::getAutoCompListMATLAB(std::string sFirstChars)
 {
-    std::string sAutoCompList;
-
     if (!mAutoCompListMATLAB.size())
     {
         for (size_t i = 0; i < vMatlabKeyWords.size(); i++)
@@ -774,20 +848,7 @@ std::string NumeReSyntax::getAutoCompListMATLAB(std::string sFirstChars)
             mAutoCompListMATLAB[toLowerCase(vMatlabFunctions[i])+" |"+vMatlabFunctions[i]+"("] = SYNTAX_FUNCTION;
     }
 
-    sFirstChars = toLowerCase(sFirstChars);
-
-    for (auto iter = mAutoCompListMATLAB.begin(); iter != mAutoCompListMATLAB.end(); ++iter)
-    {
-        if ((iter->first).front() == sFirstChars.front())
-        {
-            if (sFirstChars == (iter->first).substr(0,sFirstChars.length()))
-                sAutoCompList += (iter->first).substr((iter->first).find('|')+1) + "?" + toString((int)(iter->second)) + " ";
-        }
-        else if ((iter->first).front() > sFirstChars.front())
-            break;
-    }
-
-    return sAutoCompList;
+    return getAutoCompListFromMap(mAutoCompListMATLAB, sFirstChars);
 }
 
 
@@ -801,8 +862,6 @@ std::string NumeReSyntax::getAutoCompListMATLAB(std::string sFirstChars)
 /////////////////////////////////////////////////
 std::string NumeReSyntax::getAutoCompListCPP(std::string sFirstChars)
 {
-    std::string sAutoCompList;
-
     if (!mAutoCompListCPP.size())
     {
         for (size_t i = 0; i < vCppKeyWords.size(); i++)
@@ -812,20 +871,7 @@ std::string NumeReSyntax::getAutoCompListCPP(std::string sFirstChars)
             mAutoCompListCPP[toLowerCase(vCppFunctions[i])+" |"+vCppFunctions[i]+"("] = SYNTAX_FUNCTION;
     }
 
-    sFirstChars = toLowerCase(sFirstChars);
-
-    for (auto iter = mAutoCompListCPP.begin(); iter != mAutoCompListCPP.end(); ++iter)
-    {
-        if ((iter->first).front() == sFirstChars.front())
-        {
-            if (sFirstChars == (iter->first).substr(0,sFirstChars.length()))
-                sAutoCompList += (iter->first).substr((iter->first).find('|')+1) + "?" + toString((int)(iter->second)) + " ";
-        }
-        else if ((iter->first).front() > sFirstChars.front())
-            break;
-    }
-
-    return sAutoCompList;
+    return getAutoCompListFromMap(mAutoCompListCPP, sFirstChars);
 }
 
 
@@ -839,28 +885,13 @@ std::string NumeReSyntax::getAutoCompListCPP(std::string sFirstChars)
 /////////////////////////////////////////////////
 std::string NumeReSyntax::getAutoCompListTeX(std::string sFirstChars)
 {
-    std::string sAutoCompList;
-
     if (!mAutoCompListTeX.size())
     {
         for (size_t i = 0; i < vTeXKeyWords.size(); i++)
             mAutoCompListTeX[toLowerCase(vTeXKeyWords[i])+" |"+vTeXKeyWords[i]] = SYNTAX_COMMAND;
     }
 
-    sFirstChars = toLowerCase(sFirstChars);
-
-    for (auto iter = mAutoCompListTeX.begin(); iter != mAutoCompListTeX.end(); ++iter)
-    {
-        if ((iter->first).front() == sFirstChars.front())
-        {
-            if (sFirstChars == (iter->first).substr(0,sFirstChars.length()))
-                sAutoCompList += (iter->first).substr((iter->first).find('|')+1) + "?" + toString((int)(iter->second)) + " ";
-        }
-        else if ((iter->first).front() > sFirstChars.front())
-            break;
-    }
-
-    return sAutoCompList;
+    return getAutoCompListFromMap(mAutoCompListTeX, sFirstChars);
 }
 
 
@@ -905,6 +936,9 @@ std::string NumeReSyntax::getProcAutoCompList(std::string sFirstChars, std::stri
     sProcName = toLowerCase(sProcName);
 
     std::string sAutoCompList = " ";
+    std::string sToken;
+    std::unordered_set<std::string> setTokens;
+    std::vector<size_t> vMatches;
 
     // If no namespace was pre-selected, provide the standard namespaces
     if (!sSelectedNameSpace.length())
@@ -912,50 +946,57 @@ std::string NumeReSyntax::getProcAutoCompList(std::string sFirstChars, std::stri
         for (size_t i = 0; i < 3; i++)
         {
             if (sStandardNamespaces[i].substr(0, sFirstChars.length()) == sFirstChars)
-                sAutoCompList += sStandardNamespaces[i] + "?" + toString((int)(SYNTAX_PROCEDURE)) + " ";
+            {
+                sToken = sStandardNamespaces[i] + "?" + toString((int)(SYNTAX_PROCEDURE)) + " ";
+                sAutoCompList += sToken;
+                setTokens.insert(sToken);
+            }
         }
     }
 
-    std::string sToken;
+    // Find the procedures corresponding to the passed procedure
+    // fragment in the sorted index and restore the tree order
+    for (auto iter = mProcedureIndex.lower_bound(sProcName);
+         iter != mProcedureIndex.end() && hasPrefix(iter->first, sProcName); ++iter)
+    {
+        vMatches.push_back(iter->second);
+    }
 
-    // Go through the complete procedure tree
-    for (size_t i = 0; i < vProcedureTree.size(); i++)
+    std::sort(vMatches.begin(), vMatches.end());
+
+    for (size_t i : vMatches)
     {
-        // If the procedure in the tree corresponds to the passed procedure fragment
-        if (toLowerCase(vProcedureTree[i].substr(0, sProcName.length())) == sProcName)
+        // Only add the namespace if it's needed
+        if (sSelectedNameSpace.length())
         {
-            // Only add the namespace if it's needed
-            if (sSelectedNameSpace.length())
-            {
-                sToken = vProcedureTree[i].substr(sSelectedNameSpace.length());
+            sToken = vProcedureTree[i].substr(sSelectedNameSpace.length());
 
-                if (sToken.find('~', sFirstChars.length()) != std::string::npos)
-                {
-                    sToken.erase(sToken.find('~', sFirstChars.length())+1);
-                    sToken += "?" + toString((int)(SYNTAX_PROCEDURE)) + " ";
-                }
-                else
-                    sToken += "(?" + toString((int)(SYNTAX_PROCEDURE)) + " ";
+            if (sToken.find('~', sFirstChars.length()) != std::string::npos)
+            {
+                sToken.erase(sToken.find('~', sFirstChars.length())+1);
+                sToken += "?" + toString((int)(SYNTAX_PROCEDURE)) + " ";
             }
-            else if (vProcedureTree[i].find('~', sProcName.length()) != std::string::npos)
-                sToken = vProcedureTree[i].substr(0, vProcedureTree[i].find('~', sFirstChars.length())+1) + "?" + toString((int)(SYNTAX_PROCEDURE)) + " ";
             else
-                sToken = vProcedureTree[i] + "(?" + toString((int)(SYNTAX_PROCEDURE)) + " ";
-
-            // Remove the base namespace, if it is available in the current token
-            if (!sSelectedNameSpace.length())
-            {
-                if (toLowerCase(sToken.substr(0, sBaseNameSpace.length())) == toLowerCase(sBaseNameSpace))
-                    sToken.erase(0, sBaseNameSpace.length());
+                sToken += "(?" + toString((int)(SYNTAX_PROCEDURE)) + " ";
+        }
+        else if (vProcedureTree[i].find('~', sProcName.length()) != std::string::npos)
+            sToken = vProcedureTree[i].substr(0, vProcedureTree[i].find('~', sFirstChars.length())+1) + "?" + toString((int)(SYNTAX_PROCEDURE)) + " ";
+        else
+            sToken = vProcedureTree[i] + "(?" + toString((int)(SYNTAX_PROCEDURE)) + " ";
 
-                if (sToken.front() == '~')
-                    sToken.erase(0,1);
-            }
+        // Remove the base namespace, if it is available in the current token
+        if (!sSelectedNameSpace.length())
+        {
+            if (toLowerCase(sToken.substr(0, sBaseNameSpace.length())) == toLowerCase(sBaseNameSpace))
+                sToken.erase(0, sBaseNameSpace.length());
 
-            // Only add the current element to the autocompletion list, if it is not already available
-            if (sAutoCompList.find(" " + sToken) == std::string::npos)
-                sAutoCompList += sToken;
+            if (sToken.front() == '~')
+                sToken.erase(0,1);
         }
+
+        // Only add the current element to the autocompletion list, if it is not already available
+        if (setTokens.insert(sToken).second)
+            sAutoCompList += sToken;
     }
 
     // Return the autocompletion list (the first character is always a whitespace character)
@@ -980,25 +1021,44 @@ std::string NumeReSyntax::getNameSpaceAutoCompList(std::string sFirstChars)
     static std::string sStandardNamespaces[] = {"main~", "this~", "thisfile~"};
     sProcName = sFirstChars;
     std::string sAutoCompList = " ";
+    std::string sToken;
+    std::unordered_set<std::string> setTokens;
+    std::vector<size_t> vMatches;
 
     // Provide the standard namespaces first
     for (size_t i = 0; i < 3; i++)
     {
         if (sStandardNamespaces[i].substr(0, sFirstChars.length()) == sFirstChars)
-            sAutoCompList += sStandardNamespaces[i] + "?" + toString((int)(SYNTAX_PROCEDURE)) + " ";
+        {
+            sToken = sStandardNamespaces[i] + "?" + toString((int)(SYNTAX_PROCEDURE)) + " ";
+            sAutoCompList += sToken;
+            setTokens.insert(sToken);
+        }
     }
 
+    // The index is case-insensitive, therefore the candidates
+    // are checked again below
+    std::string sLowerProcName = toLowerCase(sProcName);
+
+    for (auto iter = mProcedureIndex.lower_bound(sLowerProcName);
+         iter != mProcedureIndex.end() && hasPrefix(iter->first, sLowerProcName); ++iter)
+    {
+        vMatches.push_back(iter->second);
+    }
+
+    std::sort(vMatches.begin(), vMatches.end());
+
     // Append all available namespaces
-    std::string sToken;
+    sToken.clear();
 
-    for (size_t i = 0; i < vProcedureTree.size(); i++)
+    for (size_t i : vMatches)
     {
-        if (vProcedureTree[i].substr(0, sProcName.length()) == sProcName)
+        if (hasPrefix(vProcedureTree[i], sProcName))
         {
             if (vProcedureTree[i].find('~', sProcName.length()) != std::string::npos)
                 sToken = vProcedureTree[i].substr(0, vProcedureTree[i].find('~', sProcName.length())+1) + "?" + toString((int)(SYNTAX_PROCEDURE)) + " ";
 
-            if (sAutoCompList.find(" " + sToken) == std::string::npos)
+            if (sToken.length() && setTokens.insert(sToken).second)
                 sAutoCompList += sToken;
         }
     }
@@ -25,6 +25,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_set>
 #include <fstream>
 
 /////////////////////////////////////////////////
@@ -72,6 +73,18 @@ class NumeReSyntax
         std::vector<std::string> vTeXKeyWords;
 
         std::vector<std::string> vProcedureTree;
+        std::vector<std::string> vPlugins;
+        size_t nBuiltInCommands;
+
+        std::unordered_set<std::string> setNSCRCommands;
+        std::unordered_set<std::string> setPluginCommands;
+        std::unordered_set<std::string> setNPRCCommands;
+        std::unordered_set<std::string> setOptions;
+        std::unordered_set<std::string> setFunctions;
+        std::unordered_set<std::string> setMethods;
+        std::unordered_set<std::string> setConstants;
+        std::unordered_set<std::string> setSpecialValues;
+        std::multimap<std::string, size_t> mProcedureIndex;
 
         std::string sSingleOperators;
         std::map<std::string, std::pair<std::string, int>> mAutoCompList;
@@ -84,7 +97,9 @@ class NumeReSyntax
         std::string constructString(const std::vector<std::string>& vVector) const;
         std::vector<std::string> splitString(std::string sString);
         std::vector<SyntaxBlockDefinition> splitDefs(std::string sDefString);
-        bool matchItem(const std::vector<std::string>& vVector, const std::string& sString);
+        void buildLookupTables();
+        bool matchItem(const std::unordered_set<std::string>& setItems, const std::string& sString) const;
+        std::string getAutoCompListFromMap(const std::map<std::string, int>& mAutoComp, std::string sFirstChars) const;
     public:
         enum SyntaxColors
         {